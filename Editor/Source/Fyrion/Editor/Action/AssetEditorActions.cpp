@@ -46,31 +46,35 @@ namespace Fyrion
     {
     }
 
-    UpdateAssetAction::UpdateAssetAction(Asset* asset, Asset* newValue) : asset(asset)
-    {
-        JsonAssetWriter writer;
-        currentStrValue = JsonAssetWriter::Stringify(Serialization::Serialize(asset->GetHandler()->GetType(), writer, asset));
-        newStrValue = JsonAssetWriter::Stringify(Serialization::Serialize(asset->GetHandler()->GetType(), writer, newValue));
-    }
+    UpdateAssetAction::UpdateAssetAction(Asset* asset, Asset* newValue) : asset(asset), delta(asset->GetHandler()->GetType(), asset, newValue) {}
 
     void UpdateAssetAction::Commit()
     {
-        JsonAssetReader reader(newStrValue);
-        Serialization::Deserialize(asset->GetHandler()->GetType(), reader, reader.ReadObject(), asset);
+        delta.ApplyNew(asset);
 
         ImGui::ClearDrawData(asset);
         asset->SetModified();
     }
     void UpdateAssetAction::Rollback()
     {
-        JsonAssetReader reader(currentStrValue);
-        Serialization::Deserialize(asset->GetHandler()->GetType(), reader, reader.ReadObject(), asset);
+        delta.ApplyOld(asset);
 
         ImGui::ClearDrawData(asset);
 
         asset->SetModified();
     }
 
+    bool UpdateAssetAction::Merge(EditorAction* next)
+    {
+        UpdateAssetAction* nextAction = static_cast<UpdateAssetAction*>(next);
+        return asset == nextAction->asset && delta.Merge(nextAction->delta);
+    }
+
+    usize UpdateAssetAction::GetMemorySize() const
+    {
+        return delta.GetMemorySize();
+    }
+
     void UpdateAssetAction::RegisterType(NativeTypeHandler<UpdateAssetAction>& type)
     {
     }
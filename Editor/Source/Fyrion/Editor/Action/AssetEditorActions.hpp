@@ -2,6 +2,7 @@
 #include "EditorAction.hpp"
 #include "Fyrion/Core/Registry.hpp"
 #include "Fyrion/Core/UUID.hpp"
+#include "Fyrion/Asset/ObjectDelta.hpp"
 
 
 namespace Fyrion
@@ -52,14 +53,15 @@ namespace Fyrion
     {
         FY_BASE_TYPES(EditorAction);
 
-        Asset* asset;
-        String currentStrValue;
-        String newStrValue;
+        Asset*      asset;
+        ObjectDelta delta;
 
         UpdateAssetAction(Asset* assetHandler, Asset* newValue);
 
-        void Commit() override;
-        void Rollback() override;
+        void  Commit() override;
+        void  Rollback() override;
+        bool  Merge(EditorAction* next) override;
+        usize GetMemorySize() const override;
 
         static void RegisterType(NativeTypeHandler<UpdateAssetAction>& type);
     };
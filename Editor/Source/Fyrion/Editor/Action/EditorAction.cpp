@@ -78,6 +78,43 @@ namespace Fyrion
         }
     }
 
+    void EditorTransaction::SetGesture(u64 gesture)
+    {
+        this->gesture = gesture;
+    }
+
+    bool EditorTransaction::Merge(EditorTransaction& next)
+    {
+        if (gesture == 0 || gesture != next.gesture)
+        {
+            return false;
+        }
+
+        if (actions.Size() != 1 || next.actions.Size() != 1 || !preExecute.Empty() || !next.preExecute.Empty())
+        {
+            return false;
+        }
+
+        Pair<TypeHandler*, EditorAction*>& nextAction = next.actions[0];
+        if (actions[0].first != nextAction.first || !actions[0].second->Merge(nextAction.second))
+        {
+            return false;
+        }
+
+        nextAction.first->Destroy(nextAction.second);
+        next.actions.Clear();
+        return true;
+    }
+
+    usize EditorTransaction::GetMemorySize() const
+    {
+        usize size = sizeof(EditorTransaction);
+        for (const auto& action : actions)
+        {
+            size += action.first->GetTypeInfo().size + action.second->GetMemorySize();
+        }
+        return size;
+    }
 
     void InitEditorAction()
     {
@@ -17,6 +17,17 @@ namespace Fyrion
 
         virtual void Commit() = 0;
         virtual void Rollback() = 0;
+
+        //absorbs a following action of the same gesture that edits the same target, next is destroyed when it returns true
+        virtual bool Merge(EditorAction* next)
+        {
+            return false;
+        }
+
+        virtual usize GetMemorySize() const
+        {
+            return 0;
+        }
     };
 
 
@@ -54,8 +65,14 @@ namespace Fyrion
         virtual void Commit();
         virtual void Rollback();
 
+        //transactions of the same continuous interaction share a gesture, transactions without a gesture (0) are never merged
+        void  SetGesture(u64 gesture);
+        bool  Merge(EditorTransaction& next);
+        usize GetMemorySize() const;
+
     private:
         Array<Pair<TypeHandler*, EditorAction*>> actions;
         Array<PreExecuteContext> preExecute;
+        u64 gesture{};
     };
 }
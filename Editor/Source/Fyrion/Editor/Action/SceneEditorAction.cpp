@@ -154,14 +154,12 @@ namespace Fyrion
         type.Constructor<SceneEditor, SceneObject*, TypeHandler*>();
     }
 
-    UpdateComponentSceneObjectAction::UpdateComponentSceneObjectAction(SceneEditor& sceneEditor, Component* component, Component* newValue) : sceneEditor(sceneEditor), component(component)
+    UpdateComponentSceneObjectAction::UpdateComponentSceneObjectAction(SceneEditor& sceneEditor, Component* component, Component* newValue)
+        : sceneEditor(sceneEditor),
+          component(component),
+          delta(component->typeHandler, component, newValue)
     {
-        JsonAssetWriter writer(SerializationOptions::IncludeNullOrEmptyValues);
-        currentStrValue = JsonAssetWriter::Stringify(Serialization::Serialize(component->typeHandler, writer, component));
-        newStrValue = JsonAssetWriter::Stringify(Serialization::Serialize(component->typeHandler, writer, newValue));
-
-        JsonAssetReader reader(newStrValue);
-        Serialization::Deserialize(component->typeHandler, reader, reader.ReadObject(), component);
+        delta.ApplyNew(component);
 
         sceneEditor.Modify();
         component->OnChange();
@@ -171,8 +169,7 @@ namespace Fyrion
 
     void UpdateComponentSceneObjectAction::Commit()
     {
-        JsonAssetReader reader(newStrValue);
-        Serialization::Deserialize(component->typeHandler, reader, reader.ReadObject(), component);
+        delta.ApplyNew(component);
 
         ImGui::ClearDrawData(component);
 
@@ -182,8 +179,7 @@ namespace Fyrion
 
     void UpdateComponentSceneObjectAction::Rollback()
     {
-        JsonAssetReader reader(currentStrValue);
-        Serialization::Deserialize(component->typeHandler, reader, reader.ReadObject(), component);
+        delta.ApplyOld(component);
 
         ImGui::ClearDrawData(component);
 
@@ -191,6 +187,17 @@ namespace Fyrion
         component->OnChange();
     }
 
+    bool UpdateComponentSceneObjectAction::Merge(EditorAction* next)
+    {
+        UpdateComponentSceneObjectAction* nextAction = static_cast<UpdateComponentSceneObjectAction*>(next);
+        return component == nextAction->component && delta.Merge(nextAction->delta);
+    }
+
+    usize UpdateComponentSceneObjectAction::GetMemorySize() const
+    {
+        return delta.GetMemorySize();
+    }
+
     void UpdateComponentSceneObjectAction::RegisterType(NativeTypeHandler<UpdateComponentSceneObjectAction>& type)
     {
         type.Constructor<SceneEditor, Component*, Component*>();
@@ -203,8 +210,8 @@ namespace Fyrion
 
     void RemoveComponentObjectAction::Commit()
     {
-        JsonAssetWriter writer;
-        value = JsonAssetWriter::Stringify(Serialization::Serialize(typeHandler, writer, component));
+        BinaryAssetWriter writer;
+        value = writer.Encode(Serialization::Serialize(typeHandler, writer, component));
         object->RemoveComponent(component);
         sceneEditor.Modify();
         typeHandler->Destroy(component);
@@ -214,12 +221,17 @@ namespace Fyrion
     {
         component = &object->CreateComponent(typeHandler);
 
-        JsonAssetReader reader(value);
+        BinaryAssetReader reader(value);
         Serialization::Deserialize(typeHandler, reader, reader.ReadObject(), component);
         component->OnChange();
         sceneEditor.Modify();
     }
 
+    usize RemoveComponentObjectAction::GetMemorySize() const
+    {
+        return value.Capacity();
+    }
+
     void RemoveComponentObjectAction::RegisterType(NativeTypeHandler<RemoveComponentObjectAction>& type)
     {
         type.Constructor<SceneEditor, SceneObject*, Component*>();
@@ -244,8 +256,8 @@ namespace Fyrion
 
     void RemoveOverridePrototypeComponentAction::Commit()
     {
-        JsonAssetWriter writer;
-        value = JsonAssetWriter::Stringify(Serialization::Serialize(component->typeHandler, writer, component));
+        BinaryAssetWriter writer;
+        value = writer.Encode(Serialization::Serialize(component->typeHandler, writer, component));
 
         object->RemoveOverridePrototypeComponent(component);
         sceneEditor.Modify();
@@ -257,7 +269,7 @@ namespace Fyrion
     {
         object->OverridePrototypeComponent(component);
 
-        JsonAssetReader reader(value);
+        BinaryAssetReader reader(value);
         Serialization::Deserialize(component->typeHandler, reader, reader.ReadObject(), component);
         component->OnChange();
 
@@ -266,6 +278,11 @@ namespace Fyrion
         ImGui::ClearDrawData(component);
     }
 
+    usize RemoveOverridePrototypeComponentAction::GetMemorySize() const
+    {
+        return value.Capacity();
+    }
+
     void RemoveOverridePrototypeComponentAction::RegisterType(NativeTypeHandler<RemoveOverridePrototypeComponentAction>& type)
     {
         type.Constructor<SceneEditor, SceneObject*, Component*>();
@@ -296,6 +313,17 @@ namespace Fyrion
         ImGui::ClearDrawData(transformComponent);
     }
 
+    bool MoveTransformObjectAction::Merge(EditorAction* next)
+    {
+        MoveTransformObjectAction* nextAction = static_cast<MoveTransformObjectAction*>(next);
+        if (transformComponent != nextAction->transformComponent)
+        {
+            return false;
+        }
+        newTransform = nextAction->newTransform;
+        return true;
+    }
+
     void MoveTransformObjectAction::RegisterType(NativeTypeHandler<MoveTransformObjectAction>& type)
     {
         type.Constructor<SceneEditor, SceneObject*, TransformComponent*, Transform>();
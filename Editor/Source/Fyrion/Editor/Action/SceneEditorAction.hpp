@@ -1,5 +1,6 @@
 #pragma once
 #include "EditorAction.hpp"
+#include "Fyrion/Asset/ObjectDelta.hpp"
 #include "Fyrion/Core/Registry.hpp"
 #include "Fyrion/Scene/SceneObject.hpp"
 #include "Fyrion/Scene/Assets/SceneObjectAsset.hpp"
@@ -110,13 +111,14 @@ namespace Fyrion
 
         SceneEditor& sceneEditor;
         Component*   component;
-        String       currentStrValue;
-        String       newStrValue;
+        ObjectDelta  delta;
 
         UpdateComponentSceneObjectAction(SceneEditor& sceneEditor, Component* component, Component* newValue);
 
-        void Commit() override;
-        void Rollback() override;
+        void  Commit() override;
+        void  Rollback() override;
+        bool  Merge(EditorAction* next) override;
+        usize GetMemorySize() const override;
 
         static void RegisterType(NativeTypeHandler<UpdateComponentSceneObjectAction>& type);
     };
@@ -129,12 +131,13 @@ namespace Fyrion
         Component*   component;
         TypeHandler* typeHandler;
         SceneObject* object;
-        String       value;
+        Array<u8>    value;
 
         RemoveComponentObjectAction(SceneEditor& sceneEditor, SceneObject* object, Component* component);
 
-        void Commit() override;
-        void Rollback() override;
+        void  Commit() override;
+        void  Rollback() override;
+        usize GetMemorySize() const override;
 
         static void RegisterType(NativeTypeHandler<RemoveComponentObjectAction>& type);
     };
@@ -162,12 +165,13 @@ namespace Fyrion
         SceneEditor& sceneEditor;
         SceneObject* object;
         Component*   component;
-        String       value;
+        Array<u8>    value;
 
         RemoveOverridePrototypeComponentAction(SceneEditor& sceneEditor, SceneObject* object, Component* component) : sceneEditor(sceneEditor), object(object), component(component) {}
 
-        void Commit() override;
-        void Rollback() override;
+        void  Commit() override;
+        void  Rollback() override;
+        usize GetMemorySize() const override;
 
         static void RegisterType(NativeTypeHandler<RemoveOverridePrototypeComponentAction>& type);
     };
@@ -187,6 +191,7 @@ namespace Fyrion
 
         void Commit() override;
         void Rollback() override;
+        bool Merge(EditorAction* next) override;
 
         static void RegisterType(NativeTypeHandler<MoveTransformObjectAction>& type);
     };
@@ -62,6 +62,9 @@ namespace Fyrion
 
         Array<SharedPtr<EditorTransaction>> undoActions{};
         Array<SharedPtr<EditorTransaction>> redoActions{};
+        usize                               historyBudget = 64 * 1024 * 1024;
+        ImGuiID                             gestureItem{};
+        u64                                 gestureCounter{};
 
         void SaveAll();
 
@@ -137,13 +140,83 @@ namespace Fyrion
             SaveAll();
         }
 
+        void CookPackages(const MenuItemEventData& eventData)
+        {
+            SaveAll();
+
+            String buildPath = Path::Join(projectPath, "Build");
+            if (!FileSystem::GetFileStatus(buildPath).exists)
+            {
+                FileSystem::CreateDirectory(buildPath);
+            }
+
+            for (DirectoryAssetHandler* directory : directories)
+            {
+                AssetManager::SaveToPackage(directory,
+                                            Path::Join(buildPath, directory->GetName(), ".pak"),
+                                            Path::Join(buildPath, directory->GetName(), ".bin"));
+            }
+        }
+
         void ShowImGuiDemo(const MenuItemEventData& eventData)
         {
             showImGuiDemo = true;
         }
 
+        //edits made while the same ImGui item stays active (ex: dragging a value) belong to the same gesture
+        u64 GetCurrentGesture()
+        {
+            ImGuiID activeId = ImGui::GetActiveID();
+            if (activeId == 0)
+            {
+                return 0;
+            }
+
+            if (activeId != gestureItem)
+            {
+                gestureItem = activeId;
+                gestureCounter++;
+            }
+            return gestureCounter;
+        }
+
+        void MergeLastTransaction()
+        {
+            //the last transaction receives its actions after CreateTransaction, so it's merged only when the next one starts
+            if (undoActions.Size() > 1 && undoActions[undoActions.Size() - 2]->Merge(*undoActions.Back()))
+            {
+                undoActions.PopBack();
+            }
+        }
+
+        void EnforceHistoryBudget()
+        {
+            if (undoActions.Empty()) return;
+
+            //keeps the newest transactions that fit in the budget, the last one is kept even if it doesn't fit
+            usize size = 0;
+            usize first = undoActions.Size();
+            while (first > 0)
+            {
+                size += undoActions[first - 1]->GetMemorySize();
+                if (size > historyBudget)
+                {
+                    break;
+                }
+                first--;
+            }
+
+            usize evict = first < undoActions.Size() ? first : undoActions.Size() - 1;
+            if (evict > 0)
+            {
+                undoActions.Erase(undoActions.begin(), undoActions.begin() + evict);
+            }
+        }
+
         void Undo(const MenuItemEventData& eventData)
         {
+            MergeLastTransaction();
+
             SharedPtr<EditorTransaction> action = undoActions.Back();
             action->Rollback();
             redoActions.EmplaceBack(action);
@@ -179,6 +252,7 @@ namespace Fyrion
             Editor::AddMenuItem(MenuItemCreation{.itemName = "Edit/Undo", .priority = 10, .itemShortcut{.ctrl = true, .presKey = Key::Z}, .action = Undo, .enable = UndoEnabled});
             Editor::AddMenuItem(MenuItemCreation{.itemName = "Edit/Redo", .priority = 20, .itemShortcut{.ctrl = true, .shift = true, .presKey = Key::Z}, .action = Redo, .enable = RedoEnabled});
             Editor::AddMenuItem(MenuItemCreation{.itemName = "Build", .priority = 40});
+            Editor::AddMenuItem(MenuItemCreation{.itemName = "Build/Cook Packages", .priority = 10, .action = CookPackages});
             Editor::AddMenuItem(MenuItemCreation{.itemName = "Window", .priority = 50});
             Editor::AddMenuItem(MenuItemCreation{.itemName = "Help", .priority = 60});
             Editor::AddMenuItem(MenuItemCreation{.itemName = "Window/Dear ImGui Demo", .priority = I32_MAX, .action = ShowImGuiDemo});
@@ -380,6 +454,12 @@ namespace Fyrion
             ImGui::End();
 
             ProjectUpdate();
+
+            //the gesture ends when its item is released, editing the same item again starts a new one
+            if (gestureItem != 0 && ImGui::GetActiveID() != gestureItem)
+            {
+                gestureItem = 0;
+            }
         }
 
         void OnEditorShutdownRequest(bool* canClose)
@@ -431,9 +511,18 @@ namespace Fyrion
     EditorTransaction* Editor::CreateTransaction()
     {
         redoActions.Clear();
-        return undoActions.EmplaceBack(MakeShared<EditorTransaction>()).Get();
+        MergeLastTransaction();
+        EnforceHistoryBudget();
+        EditorTransaction* transaction = undoActions.EmplaceBack(MakeShared<EditorTransaction>()).Get();
+        transaction->SetGesture(GetCurrentGesture());
+        return transaction;
     }
 
+    void Editor::SetHistoryBudget(usize bytes)
+    {
+        historyBudget = bytes;
+        EnforceHistoryBudget();
+    }
 
     void Editor::AddMenuItem(const MenuItemCreation& menuItem)
     {
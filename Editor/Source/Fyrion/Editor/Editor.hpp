@@ -16,6 +16,7 @@ namespace Fyrion::Editor
     FY_API Span<DirectoryAssetHandler*> GetOpenDirectories();
     FY_API SceneEditor&                 GetSceneEditor();
     FY_API EditorTransaction*           CreateTransaction();
+    FY_API void                         SetHistoryBudget(usize bytes);
     FY_API String                       CreateProject(StringView newProjectPath, StringView projectName);
 
 
@@ -259,6 +259,42 @@ namespace Fyrion
 
             ImGui::PopStyleColor(2);
 
+            importsCache.Clear();
+            AssetManager::GetAssetImports(importsCache);
+
+            if (!importsCache.Empty())
+            {
+                f32 progress = 0;
+                for (const AssetImportInfo& importInfo : importsCache)
+                {
+                    progress += importInfo.progress;
+                }
+                progress /= static_cast<f32>(importsCache.Size());
+
+                stringCache.Clear();
+                stringCache.Append("Importing ").Append(importsCache.Size()).Append(importsCache.Size() == 1 ? " asset" : " assets");
+
+                ImGui::ProgressBar(progress, ImVec2(200 * style.ScaleFactor, 0), stringCache.CStr());
+                if (ImGui::IsItemHovered())
+                {
+                    ImGui::BeginTooltip();
+                    for (const AssetImportInfo& importInfo : importsCache)
+                    {
+                        ImGui::Text("%s %.0f%%%s", importInfo.assetHandler->GetName().CStr(), importInfo.progress * 100.f,
+                                    importInfo.status == AssetImportStatus::Queued ? " (queued)" : "");
+                    }
+                    ImGui::EndTooltip();
+                }
+
+                if (ImGui::Button(ICON_FA_XMARK))
+                {
+                    for (const AssetImportInfo& importInfo : importsCache)
+                    {
+                        AssetManager::CancelAssetImport(importInfo.assetHandler);
+                    }
+                }
+            }
+
             ImGui::SetNextItemWidth(400 * style.ScaleFactor);
             ImGui::SearchInputText(id + 20, searchString);
 
@@ -5,6 +5,7 @@
 #include "Fyrion/Editor/MenuItem.hpp"
 #include "Fyrion/Core/Registry.hpp"
 #include "Fyrion/Graphics/GraphicsTypes.hpp"
+#include "Fyrion/Asset/AssetManager.hpp"
 
 
 namespace Fyrion
@@ -38,6 +39,7 @@ namespace Fyrion
         HashMap<DirectoryAssetHandler*, bool> openTreeFolders{};
         f32                                   contentBrowserZoom = 0.8;
         Array<DirectoryAssetHandler*>         directoryCache;
+        Array<AssetImportInfo>                importsCache;
         EventHandler<OnAssetSelection>        onAssetSelectionHandler{};
 
         inline static DirectoryAssetHandler* lastOpenedDirectory = nullptr;
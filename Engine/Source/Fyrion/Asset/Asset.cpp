@@ -48,6 +48,15 @@ namespace Fyrion
         return {};
     }
 
+    AssetBufferView Asset::MapBuffer(AssetBuffer buffer) const
+    {
+        if (AssetBufferManager* bufferManager = handler->GetBufferManager())
+        {
+            return bufferManager->MapBuffer(buffer);
+        }
+        return {};
+    }
+
     bool Asset::HasBuffer(AssetBuffer buffer) const
     {
         if (AssetBufferManager* bufferManager = handler->GetBufferManager())
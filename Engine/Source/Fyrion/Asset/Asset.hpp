@@ -36,15 +36,16 @@ namespace Fyrion
     public:
         virtual ~Asset() = default;
 
-        AssetHandler* GetHandler() const;
-        void          SetHandler(AssetHandler* handler);
-        void          SetModified();
-        ArchiveObject Serialize(ArchiveWriter& writer) const;
-        void          Deserialize(ArchiveReader& reader, ArchiveObject object);
-        void          SaveBuffer(AssetBuffer& buffer, ConstPtr data, usize dataSize);
-        Array<u8>     LoadBuffer(AssetBuffer buffer) const;
-        bool          HasBuffer(AssetBuffer buffer) const;
-        Asset*        GetParent() const;
+        AssetHandler*   GetHandler() const;
+        void            SetHandler(AssetHandler* handler);
+        void            SetModified();
+        ArchiveObject   Serialize(ArchiveWriter& writer) const;
+        void            Deserialize(ArchiveReader& reader, ArchiveObject object);
+        void            SaveBuffer(AssetBuffer& buffer, ConstPtr data, usize dataSize);
+        Array<u8>       LoadBuffer(AssetBuffer buffer) const;
+        AssetBufferView MapBuffer(AssetBuffer buffer) const;
+        bool            HasBuffer(AssetBuffer buffer) const;
+        Asset*          GetParent() const;
 
         virtual void OnModified() {}
         virtual void OnDestroyed() {}
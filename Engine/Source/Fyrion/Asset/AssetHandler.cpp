@@ -3,12 +3,16 @@
 #include "Asset.hpp"
 #include "AssetTypes.hpp"
 #include "AssetSerialization.hpp"
+#include "AssetPackage.hpp"
 #include "Fyrion/Core/Logger.hpp"
 #include "Fyrion/Core/Registry.hpp"
 #include "Fyrion/Core/StringUtils.hpp"
 #include "Fyrion/IO/FileSystem.hpp"
 #include "Fyrion/IO/Path.hpp"
 
+#include <functional>
+#include <thread>
+
 namespace Fyrion
 {
     void AssetManagerAddHandler(AssetHandler* assetHandler);
@@ -20,6 +24,18 @@ namespace Fyrion
     namespace
     {
         Logger& logger = Logger::GetLogger("Fyrion::AssetHandler");
+
+        void PackageRead(AssetPackage* package, VoidPtr data, usize size, u64 offset)
+        {
+            if (package->binMapping)
+            {
+                MemCopy(data, package->binMapping->GetData() + offset, size);
+            }
+            else
+            {
+                FileSystem::ReadFileAt(package->binFile, data, size, offset);
+            }
+        }
     }
 
     Asset* AssetHandler::GetInstance() const
@@ -449,6 +465,7 @@ namespace Fyrion
 
     Asset* ChildAssetHandler::LoadInstance()
     {
+        std::lock_guard lock(instanceMutex);
         if (!instance && GetType() != nullptr)
         {
             instance = GetType()->Cast<Asset>(GetType()->NewInstance());
@@ -497,6 +514,139 @@ namespace Fyrion
         return handler;
     }
 
+    AssetBufferMapping::~AssetBufferMapping()
+    {
+        if (map)
+        {
+            FileSystem::UnmapViewOfFile(map);
+        }
+
+        if (fileMapping)
+        {
+            FileSystem::CloseFileMapping(fileMapping);
+        }
+
+        if (file)
+        {
+            FileSystem::CloseFile(file);
+        }
+    }
+
+    const u8* AssetBufferMapping::GetData() const
+    {
+        return map != nullptr ? static_cast<const u8*>(map) : bytes.Data();
+    }
+
+    usize AssetBufferMapping::GetSize() const
+    {
+        return map != nullptr ? size : bytes.Size();
+    }
+
+    void AssetBufferMapping::AddReference()
+    {
+        references.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void AssetBufferMapping::RemoveReference()
+    {
+        if (references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            MemoryGlobals::GetDefaultAllocator().DestroyAndFree(this);
+        }
+    }
+
+    AssetBufferMapping* AssetBufferMapping::MapFile(StringView path)
+    {
+        FileHandler file = FileSystem::OpenFile(path, AccessMode::ReadOnly);
+        if (!file)
+        {
+            return nullptr;
+        }
+
+        usize       size = FileSystem::GetFileSize(file);
+        FileHandler fileMapping = size > 0 ? FileSystem::CreateFileMapping(file, AccessMode::ReadOnly, 0) : FileHandler{};
+        VoidPtr     map = fileMapping ? FileSystem::MapViewOfFile(fileMapping) : nullptr;
+
+        if (map == nullptr)
+        {
+            if (fileMapping)
+            {
+                FileSystem::CloseFileMapping(fileMapping);
+            }
+            FileSystem::CloseFile(file);
+            return nullptr;
+        }
+
+        AssetBufferMapping* mapping = MemoryGlobals::GetDefaultAllocator().Alloc<AssetBufferMapping>();
+        mapping->file = file;
+        mapping->fileMapping = fileMapping;
+        mapping->map = map;
+        mapping->size = size;
+        return mapping;
+    }
+
+    AssetBufferMapping* AssetBufferMapping::FromBytes(Array<u8>&& bytes)
+    {
+        AssetBufferMapping* mapping = MemoryGlobals::GetDefaultAllocator().Alloc<AssetBufferMapping>();
+        mapping->bytes = Traits::Move(bytes);
+        return mapping;
+    }
+
+    AssetBufferView::AssetBufferView(AssetBufferMapping* mapping, const u8* data, usize size) : mapping(mapping), data(data), size(size)
+    {
+        if (mapping)
+        {
+            mapping->AddReference();
+        }
+    }
+
+    AssetBufferView::AssetBufferView(const AssetBufferView& other) : AssetBufferView(other.mapping, other.data, other.size) {}
+
+    AssetBufferView::AssetBufferView(AssetBufferView&& other) noexcept : mapping(other.mapping), data(other.data), size(other.size)
+    {
+        other.mapping = nullptr;
+        other.data = nullptr;
+        other.size = 0;
+    }
+
+    AssetBufferView::~AssetBufferView()
+    {
+        if (mapping)
+        {
+            mapping->RemoveReference();
+        }
+    }
+
+    AssetBufferView& AssetBufferView::operator=(const AssetBufferView& other)
+    {
+        if (this != &other)
+        {
+            AssetBufferView copy(other);
+            *this = Traits::Move(copy);
+        }
+        return *this;
+    }
+
+    AssetBufferView& AssetBufferView::operator=(AssetBufferView&& other) noexcept
+    {
+        if (this != &other)
+        {
+            if (mapping)
+            {
+                mapping->RemoveReference();
+            }
+
+            mapping = other.mapping;
+            data = other.data;
+            size = other.size;
+
+            other.mapping = nullptr;
+            other.data = nullptr;
+            other.size = 0;
+        }
+        return *this;
+    }
+
     void FileAssetBufferManager::SaveBuffer(AssetBuffer& buffer, ConstPtr data, usize dataSize)
     {
         if (!buffer)
@@ -511,10 +661,23 @@ namespace Fyrion
             {
                 FileSystem::CreateDirectory(dataPath);
             }
+            //written to a temp file and renamed over the buffer, views mapping the previous file keep reading it
             String      bufferPath = Path::Join(dataPath, buffer.ToString());
-            FileHandler file = FileSystem::OpenFile(bufferPath, AccessMode::WriteOnly);
+            String      tempPath = String(bufferPath).Append(".").Append(static_cast<u64>(std::hash<std::thread::id>{}(std::this_thread::get_id()))).Append(".tmp");
+            FileHandler file = FileSystem::OpenFile(tempPath, AccessMode::WriteOnly);
+            if (!file)
+            {
+                logger.Error("failed to write buffer {} ", bufferPath);
+                return;
+            }
             FileSystem::WriteFile(file, data, dataSize);
             FileSystem::CloseFile(file);
+
+            if (!FileSystem::Rename(tempPath, bufferPath))
+            {
+                FileSystem::Remove(bufferPath);
+                FileSystem::Rename(tempPath, bufferPath);
+            }
         }
     }
 
@@ -523,16 +686,35 @@ namespace Fyrion
         String dataDir = assetHandler->GetDataPath();
         if (!dataDir.Empty())
         {
-            String      bufferPath = Path::Join(dataDir, buffer.ToString());
-            FileHandler file = FileSystem::OpenFile(bufferPath, AccessMode::ReadOnly);
-            Array<u8>   data(FileSystem::GetFileSize(file));
-            FileSystem::ReadFile(file, data.Data(), data.Size());
-            FileSystem::CloseFile(file);
-            return data;
+            String bufferPath = Path::Join(dataDir, buffer.ToString());
+            if (FileHandler file = FileSystem::OpenFile(bufferPath, AccessMode::ReadOnly))
+            {
+                Array<u8> data(FileSystem::GetFileSize(file));
+                FileSystem::ReadFile(file, data.Data(), data.Size());
+                FileSystem::CloseFile(file);
+                return data;
+            }
         }
         return {};
     }
 
+    AssetBufferView FileAssetBufferManager::MapBuffer(const AssetBuffer& buffer) const
+    {
+        String dataDir = assetHandler->GetDataPath();
+        if (dataDir.Empty())
+        {
+            return {};
+        }
+
+        AssetBufferMapping* mapping = AssetBufferMapping::MapFile(Path::Join(dataDir, buffer.ToString()));
+        if (mapping == nullptr)
+        {
+            //empty files or platforms without mapping support
+            mapping = AssetBufferMapping::FromBytes(LoadBuffer(buffer));
+        }
+        return {mapping, mapping->GetData(), mapping->GetSize()};
+    }
+
     bool FileAssetBufferManager::HasBuffer(AssetBuffer& buffer) const
     {
         String dataDir = assetHandler->GetDataPath();
@@ -752,31 +934,51 @@ namespace Fyrion
 
     Asset* ImportedAssetHandler::LoadInstance()
     {
-        if (instance == nullptr && GetType() != nullptr)
         {
-            instance = GetType()->Cast<Asset>(GetType()->NewInstance());
-            instance->SetHandler(this);
-
-            if (pendingImport)
+            std::lock_guard lock(instanceMutex);
+            if (instance == nullptr && GetType() != nullptr && !pendingImport)
             {
-                u64 lastModifiedTime = FileSystem::GetFileStatus(importedFilePath).lastModifiedTime;
-                this->lastModifiedTime = lastModifiedTime;
-                AssetManager::QueueAssetImport(io, this);
-                pendingImport = false;
-            }
+                instance = GetType()->Cast<Asset>(GetType()->NewInstance());
+                instance->SetHandler(this);
 
-            if (FileSystem::GetFileStatus(assetPath).exists)
-            {
-                if (const String str = FileSystem::ReadFileAsString(assetPath); !str.Empty())
+                if (FileSystem::GetFileStatus(assetPath).exists)
                 {
-                    JsonAssetReader reader(str);
-                    instance->Deserialize(reader, reader.ReadObject());
+                    if (const String str = FileSystem::ReadFileAsString(assetPath); !str.Empty())
+                    {
+                        JsonAssetReader reader(str);
+                        instance->Deserialize(reader, reader.ReadObject());
+                    }
                 }
             }
         }
+
+        QueuePendingImport();
+        AssetManager::WaitAssetImport(this);
+
         return instance;
     }
 
+    void ImportedAssetHandler::QueuePendingImport()
+    {
+        {
+            std::lock_guard lock(instanceMutex);
+            if (!pendingImport || GetType() == nullptr)
+            {
+                return;
+            }
+
+            if (instance == nullptr)
+            {
+                instance = GetType()->Cast<Asset>(GetType()->NewInstance());
+                instance->SetHandler(this);
+            }
+
+            lastModifiedTime = FileSystem::GetFileStatus(importedFilePath).lastModifiedTime;
+            pendingImport = false;
+        }
+        AssetManager::QueueAssetImport(io, this);
+    }
+
     StringView ImportedAssetHandler::GetDataPath()
     {
         return dataPath;
@@ -900,4 +1102,141 @@ namespace Fyrion
         ChildAssetHandler* handler = ChildAssetHandler::Create(name, this);
         return handler;
     }
+
+    void PackageBufferManager::SaveBuffer(AssetBuffer& buffer, ConstPtr data, usize dataSize)
+    {
+        FY_ASSERT(false, "packages are read-only");
+    }
+
+    const AssetPackageBuffer* PackageBufferManager::FindBuffer(const AssetBuffer& buffer) const
+    {
+        const AssetPackageBuffer* begin = package->GetBuffers() + entry->firstBuffer;
+        const AssetPackageBuffer* end = begin + entry->bufferCount;
+
+        while (begin < end)
+        {
+            const AssetPackageBuffer* middle = begin + (end - begin) / 2;
+            if (middle->id < buffer.id)
+            {
+                begin = middle + 1;
+            }
+            else
+            {
+                end = middle;
+            }
+        }
+
+        if (begin != package->GetBuffers() + entry->firstBuffer + entry->bufferCount && begin->id == buffer.id)
+        {
+            return begin;
+        }
+        return nullptr;
+    }
+
+    Array<u8> PackageBufferManager::LoadBuffer(const AssetBuffer& buffer) const
+    {
+        if (const AssetPackageBuffer* packageBuffer = FindBuffer(buffer))
+        {
+            Array<u8> data(packageBuffer->size);
+            PackageRead(package, data.Data(), data.Size(), packageBuffer->offset);
+            return data;
+        }
+        return {};
+    }
+
+    AssetBufferView PackageBufferManager::MapBuffer(const AssetBuffer& buffer) const
+    {
+        const AssetPackageBuffer* packageBuffer = FindBuffer(buffer);
+        if (packageBuffer == nullptr)
+        {
+            return {};
+        }
+
+        //views share the mapping of the whole .bin
+        if (package->binMapping)
+        {
+            return {package->binMapping, package->binMapping->GetData() + packageBuffer->offset, packageBuffer->size};
+        }
+
+        AssetBufferMapping* mapping = AssetBufferMapping::FromBytes(LoadBuffer(buffer));
+        return {mapping, mapping->GetData(), mapping->GetSize()};
+    }
+
+    bool PackageBufferManager::HasBuffer(AssetBuffer& buffer) const
+    {
+        return FindBuffer(buffer) != nullptr;
+    }
+
+    StringView PackageAssetHandler::GetAbsolutePath() const
+    {
+        return {};
+    }
+
+    void PackageAssetHandler::UpdatePath()
+    {
+        //child assets don't have paths.
+        StringView packagePath = package->GetString(entry->path);
+        if (parent != nullptr && !packagePath.Empty())
+        {
+            String newPath = String().Append(parent->GetPath()).Append("/").Append(name).Append(Path::Extension(packagePath));
+            if (relativePath != newPath)
+            {
+                AssetManagerUpdatePath(this, relativePath, newPath);
+            }
+            relativePath = newPath;
+        }
+    }
+
+    void PackageAssetHandler::Save()
+    {
+        //packages are read-only
+    }
+
+    void PackageAssetHandler::Delete()
+    {
+        logger.Warn("{} cannot be deleted, packages are read-only", name);
+    }
+
+    Asset* PackageAssetHandler::LoadInstance()
+    {
+        std::lock_guard lock(instanceMutex);
+        if (instance == nullptr && GetType() != nullptr)
+        {
+            instance = GetType()->Cast<Asset>(GetType()->NewInstance());
+            instance->SetHandler(this);
+
+            if (entry->dataSize > 0)
+            {
+                Array<u8> data{};
+                data.Resize(entry->dataSize);
+                PackageRead(package, data.Data(), entry->dataSize, entry->dataOffset);
+
+                BinaryAssetReader reader(Traits::Move(data));
+                instance->Deserialize(reader, reader.ReadObject());
+            }
+        }
+        return instance;
+    }
+
+    AssetHandler* PackageAssetHandler::CreateChild(StringView name)
+    {
+        FY_ASSERT(false, "packages are read-only");
+        return nullptr;
+    }
+
+    AssetBufferManager* PackageAssetHandler::GetBufferManager()
+    {
+        return &bufferManager;
+    }
+
+    PackageAssetHandler* PackageAssetHandler::Create(AssetPackage* package, const AssetPackageEntry* entry, AssetHandler* parent)
+    {
+        PackageAssetHandler* handler = MemoryGlobals::GetDefaultAllocator().Alloc<PackageAssetHandler>(package, entry);
+        handler->name = package->GetString(entry->name);
+        handler->SetType(Registry::FindTypeByName(package->GetString(entry->typeName)));
+        handler->SetUUID(entry->uuid);
+        parent->AddChild(handler);
+        AssetManagerAddHandler(handler);
+        return handler;
+    }
 }
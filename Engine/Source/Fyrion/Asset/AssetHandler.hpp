@@ -1,22 +1,101 @@
 #pragma once
 #include "../../../ThirdParty/freetype/src/gzip/ftzconf.h"
+#include "Fyrion/Core/Span.hpp"
 #include "Fyrion/Core/UUID.hpp"
+#include "Fyrion/IO/FileTypes.hpp"
+
+#include <atomic>
+#include <mutex>
 
 
 namespace Fyrion
 {
     struct AssetBuffer;
     struct AssetIO;
+    struct AssetPackage;
+    struct AssetPackageEntry;
+    struct AssetPackageBuffer;
     class Asset;
 
+    //memory of mapped buffers, released when the last view is destroyed.
+    class FY_API AssetBufferMapping
+    {
+    public:
+        FY_NO_COPY_CONSTRUCTOR(AssetBufferMapping);
+
+        AssetBufferMapping() = default;
+        ~AssetBufferMapping();
+
+        const u8* GetData() const;
+        usize     GetSize() const;
+        void      AddReference();
+        void      RemoveReference();
+
+        //returns nullptr if the file can't be mapped
+        static AssetBufferMapping* MapFile(StringView path);
+        static AssetBufferMapping* FromBytes(Array<u8>&& bytes);
+
+    private:
+        std::atomic<u32> references{};
+        FileHandler      file{};
+        FileHandler      fileMapping{};
+        VoidPtr          map{};
+        usize            size{};
+        Array<u8>        bytes{};
+    };
+
+    class FY_API AssetBufferView
+    {
+    public:
+        AssetBufferView() = default;
+        AssetBufferView(AssetBufferMapping* mapping, const u8* data, usize size);
+        AssetBufferView(const AssetBufferView& other);
+        AssetBufferView(AssetBufferView&& other) noexcept;
+        ~AssetBufferView();
+
+        AssetBufferView& operator=(const AssetBufferView& other);
+        AssetBufferView& operator=(AssetBufferView&& other) noexcept;
+
+        const u8* Data() const
+        {
+            return data;
+        }
+
+        usize Size() const
+        {
+            return size;
+        }
+
+        bool Empty() const
+        {
+            return size == 0;
+        }
+
+        explicit operator bool() const
+        {
+            return data != nullptr && size > 0;
+        }
+
+        operator Span<const u8>() const
+        {
+            return {data, size};
+        }
+
+    private:
+        AssetBufferMapping* mapping{};
+        const u8*           data{};
+        usize               size{};
+    };
+
     class AssetBufferManager
     {
     public:
         virtual ~AssetBufferManager() = default;
 
-        virtual void      SaveBuffer(AssetBuffer& buffer, ConstPtr data, usize dataSize) = 0;
-        virtual Array<u8> LoadBuffer(const AssetBuffer& buffer) const = 0;
-        virtual bool      HasBuffer(AssetBuffer& buffer) const = 0;
+        virtual void            SaveBuffer(AssetBuffer& buffer, ConstPtr data, usize dataSize) = 0;
+        virtual Array<u8>       LoadBuffer(const AssetBuffer& buffer) const = 0;
+        virtual AssetBufferView MapBuffer(const AssetBuffer& buffer) const = 0;
+        virtual bool            HasBuffer(AssetBuffer& buffer) const = 0;
     };
 
     class FY_API AssetHandler
@@ -80,10 +159,11 @@ namespace Fyrion
     class FY_API FileAssetBufferManager : public AssetBufferManager
     {
     public:
-        explicit  FileAssetBufferManager(AssetHandler* assetHandler) : assetHandler(assetHandler) {}
-        void      SaveBuffer(AssetBuffer& buffer, ConstPtr data, usize dataSize) override;
-        Array<u8> LoadBuffer(const AssetBuffer& buffer) const override;
-        bool      HasBuffer(AssetBuffer& buffer) const override;
+        explicit        FileAssetBufferManager(AssetHandler* assetHandler) : assetHandler(assetHandler) {}
+        void            SaveBuffer(AssetBuffer& buffer, ConstPtr data, usize dataSize) override;
+        Array<u8>       LoadBuffer(const AssetBuffer& buffer) const override;
+        AssetBufferView MapBuffer(const AssetBuffer& buffer) const override;
+        bool            HasBuffer(AssetBuffer& buffer) const override;
 
     private:
         AssetHandler* assetHandler;
@@ -133,6 +213,7 @@ namespace Fyrion
     private:
         FileAssetBufferManager bufferManager{this};
         String                 dataPath{};
+        std::mutex             instanceMutex{};
     };
 
     class FY_API JsonAssetHandler final : public AssetHandler
@@ -176,6 +257,7 @@ namespace Fyrion
         ArchiveObject       Serialize(ArchiveWriter& writer) const override;
         void                Deserialize(ArchiveReader& reader, ArchiveObject object) override;
         AssetBufferManager* GetBufferManager() override;
+        void                QueuePendingImport();
 
         static ImportedAssetHandler* Create(AssetIO* io, StringView importedFilePath, DirectoryAssetHandler* directory);
 
@@ -189,5 +271,45 @@ namespace Fyrion
         String                 assetPath{};
         Array<String>          relatedFiles{};
         bool                   pendingImport{};
+        std::mutex             instanceMutex{};
+    };
+
+    class FY_API PackageBufferManager : public AssetBufferManager
+    {
+    public:
+        PackageBufferManager(AssetPackage* package, const AssetPackageEntry* entry) : package(package), entry(entry) {}
+        void            SaveBuffer(AssetBuffer& buffer, ConstPtr data, usize dataSize) override;
+        Array<u8>       LoadBuffer(const AssetBuffer& buffer) const override;
+        AssetBufferView MapBuffer(const AssetBuffer& buffer) const override;
+        bool            HasBuffer(AssetBuffer& buffer) const override;
+
+    private:
+        AssetPackage*            package;
+        const AssetPackageEntry* entry;
+
+        const AssetPackageBuffer* FindBuffer(const AssetBuffer& buffer) const;
+    };
+
+    //read-only handler for assets loaded from a .pak/.bin package.
+    class FY_API PackageAssetHandler final : public AssetHandler
+    {
+    public:
+        PackageAssetHandler(AssetPackage* package, const AssetPackageEntry* entry) : bufferManager(package, entry), package(package), entry(entry) {}
+
+        StringView          GetAbsolutePath() const override;
+        void                UpdatePath() override;
+        void                Save() override;
+        void                Delete() override;
+        Asset*              LoadInstance() override;
+        AssetHandler*       CreateChild(StringView name) override;
+        AssetBufferManager* GetBufferManager() override;
+
+        static PackageAssetHandler* Create(AssetPackage* package, const AssetPackageEntry* entry, AssetHandler* parent);
+
+    private:
+        PackageBufferManager     bufferManager;
+        AssetPackage*            package;
+        const AssetPackageEntry* entry;
+        std::mutex               instanceMutex{};
     };
 }
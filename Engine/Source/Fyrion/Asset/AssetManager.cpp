@@ -1,12 +1,17 @@
 #include "AssetManager.hpp"
 #include <memory>
+#include <mutex>
+#include <thread>
 
 #include "AssetHandler.hpp"
+#include "AssetPackage.hpp"
 #include "AssetSerialization.hpp"
 #include "AssetTypes.hpp"
 #include "Fyrion/Engine.hpp"
 #include "Fyrion/IO/FileWatcher.hpp"
+#include "Fyrion/Core/FlatHashMap.hpp"
 #include "Fyrion/Core/HashMap.hpp"
+#include "Fyrion/Core/JobSystem.hpp"
 #include "Fyrion/Core/Logger.hpp"
 #include "Fyrion/IO/FileSystem.hpp"
 #include "Fyrion/IO/Path.hpp"
@@ -16,17 +21,64 @@ namespace Fyrion
 {
     namespace
     {
+        enum class AssetRegistrationType
+        {
+            Add,
+            UUID,
+            Path,
+            Type,
+            CleanRefs
+        };
+
+        struct AssetRegistration
+        {
+            AssetRegistrationType type{};
+            AssetHandler*         assetHandler{};
+            UUID                  uuid{};
+            String                oldPath{};
+            String                newPath{};
+            TypeHandler*          typeHandler{};
+        };
+
+        struct AssetImportCommit
+        {
+            VoidPtr        userData{};
+            FnImportCommit commit{};
+        };
+
+        struct AssetImportJob
+        {
+            AssetIO*                       io{};
+            AssetHandler*                  assetHandler{};
+            std::atomic<f32>               progress{};
+            std::atomic<AssetImportStatus> status{AssetImportStatus::Queued};
+            std::atomic<bool>              cancelled{};
+            std::atomic<bool>              scheduled{};
+            bool                           waiting{}; //scheduled after the previous import of the asset is committed
+            JobCounter                     counter{};
+            Array<AssetRegistration>       registrations{};
+            Array<AssetImportCommit>       commits{};
+        };
+
         bool RegisterEvents();
 
         String                                dataDirectory;
         Array<AssetHandler*>                  assets;
-        HashMap<UUID, AssetHandler*>          assetsById;
-        HashMap<String, AssetHandler*>        assetsByPath;
+        FlatHashMap<UUID, AssetHandler*>      assetsById;
+        FlatHashMap<String, AssetHandler*>    assetsByPath;
         Array<Pair<TypeID, AssetIO*>>         assetIOs;
         HashMap<String, AssetIO*>             importers;
         HashMap<TypeID, Array<AssetHandler*>> assetsByType;
         FileWatcher                           fileWatcher;
         bool                                  hotReloadEnabled = false;
+        std::mutex                            assetMutex;
+
+        std::mutex                            importMutex;
+        Array<AssetImportJob*>                importJobs;
+        std::thread::id                       mainThreadId;
+        thread_local AssetImportJob*          currentImportJob = nullptr;
+
+        Array<AssetPackage*>                  packages;
 
         Logger& logger = Logger::GetLogger("Fyrion::AssetManager");
 
@@ -58,82 +110,151 @@ namespace Fyrion
         }
     }
 
-    void AssetManagerAddHandler(AssetHandler* assetHandler)
+    void AssetManagerApplyRegistration(const AssetRegistration& registration)
     {
-        assets.EmplaceBack(assetHandler);
-    }
+        std::lock_guard lock(assetMutex);
 
-    void AssetManagerUpdateType(AssetHandler* assetHandler, TypeHandler* typeHandler)
-    {
-        auto itByType = assetsByType.Find(typeHandler->GetTypeInfo().typeId);
-        if (itByType == assetsByType.end())
+        AssetHandler* assetHandler = registration.assetHandler;
+
+        switch (registration.type)
         {
-            itByType = assetsByType.Emplace(typeHandler->GetTypeInfo().typeId, {}).first;
-        }
-        itByType->second.EmplaceBack(assetHandler);
-    }
+            case AssetRegistrationType::Add:
+            {
+                assets.EmplaceBack(assetHandler);
+                break;
+            }
+            case AssetRegistrationType::UUID:
+            {
+                if (assetHandler->GetUUID())
+                {
+                    assetsById.Erase(assetHandler->GetUUID());
+                }
 
-    void AssetManagerCleanRefs(AssetHandler* assetHandler)
-    {
-        assetsById.Erase(assetHandler->GetUUID());
-        assetsByPath.Erase(assetHandler->GetPath());
+                if (registration.uuid)
+                {
+                    assetsById.Insert(registration.uuid, assetHandler);
+                }
+                break;
+            }
+            case AssetRegistrationType::Path:
+            {
+                if (!registration.oldPath.Empty())
+                {
+                    assetsByPath.Erase(registration.oldPath);
+                }
+                assetsByPath.Insert(registration.newPath, assetHandler);
+                logger.Debug("asset {} registred to path {} ", assetHandler->GetName(), registration.newPath);
+                break;
+            }
+            case AssetRegistrationType::Type:
+            {
+                TypeID typeId = registration.typeHandler->GetTypeInfo().typeId;
 
-        if(assetHandler->GetType() != nullptr)
-        {
-            if (auto it = assetsByType.Find(assetHandler->GetType()->GetTypeInfo().typeId))
+                auto itByType = assetsByType.Find(typeId);
+                if (itByType == assetsByType.end())
+                {
+                    itByType = assetsByType.Emplace(typeId, {}).first;
+                }
+                itByType->second.EmplaceBack(assetHandler);
+                break;
+            }
+            case AssetRegistrationType::CleanRefs:
             {
-                if (const auto itArr = FindFirst(it->second.begin(), it->second.end(), assetHandler))
+                assetsById.Erase(assetHandler->GetUUID());
+                assetsByPath.Erase(assetHandler->GetPath());
+
+                if (assetHandler->GetType() != nullptr)
                 {
-                    it->second.Erase(itArr);
+                    if (auto it = assetsByType.Find(assetHandler->GetType()->GetTypeInfo().typeId))
+                    {
+                        if (const auto itArr = FindFirst(it->second.begin(), it->second.end(), assetHandler))
+                        {
+                            it->second.Erase(itArr);
+                        }
+                    }
                 }
+                break;
             }
         }
     }
 
-    void AssetManagerUpdatePath(AssetHandler* assetHandler, const StringView& oldPath, const StringView& newPath)
+    void AssetManagerRegister(AssetRegistration&& registration)
     {
-        if (!oldPath.Empty())
+        //assets created by import jobs are only visible after the import is committed on the main thread.
+        if (currentImportJob != nullptr)
         {
-            assetsByPath.Erase(oldPath);
+            currentImportJob->registrations.EmplaceBack(Traits::Move(registration));
+            return;
         }
-        assetsByPath.Insert(String{newPath}, assetHandler);
-        logger.Debug("asset {} registred to path {} ", assetHandler->GetName(), newPath);
+        AssetManagerApplyRegistration(registration);
     }
 
-    void AssetManagerUpdateUUID(AssetHandler* assetHandler, const UUID& newUUID)
+    void AssetManagerAddHandler(AssetHandler* assetHandler)
     {
-        if (assetHandler->GetUUID())
-        {
-            assetsById.Erase(assetHandler->GetUUID());
-        }
+        AssetManagerRegister(AssetRegistration{
+            .type = AssetRegistrationType::Add,
+            .assetHandler = assetHandler
+        });
+    }
 
-        if (newUUID)
-        {
-            assetsById.Insert(newUUID, assetHandler);
-        }
+    void AssetManagerUpdateType(AssetHandler* assetHandler, TypeHandler* typeHandler)
+    {
+        AssetManagerRegister(AssetRegistration{
+            .type = AssetRegistrationType::Type,
+            .assetHandler = assetHandler,
+            .typeHandler = typeHandler
+        });
     }
 
+    void AssetManagerCleanRefs(AssetHandler* assetHandler)
+    {
+        AssetManagerRegister(AssetRegistration{
+            .type = AssetRegistrationType::CleanRefs,
+            .assetHandler = assetHandler
+        });
+    }
+
+    void AssetManagerUpdatePath(AssetHandler* assetHandler, const StringView& oldPath, const StringView& newPath)
+    {
+        AssetManagerRegister(AssetRegistration{
+            .type = AssetRegistrationType::Path,
+            .assetHandler = assetHandler,
+            .oldPath = oldPath,
+            .newPath = newPath
+        });
+    }
+
+    void AssetManagerUpdateUUID(AssetHandler* assetHandler, const UUID& newUUID)
+    {
+        AssetManagerRegister(AssetRegistration{
+            .type = AssetRegistrationType::UUID,
+            .assetHandler = assetHandler,
+            .uuid = newUUID
+        });
+    }
 
     Asset* AssetManager::LoadById(const UUID& assetId)
     {
-        if (auto it = assetsById.Find(assetId))
+        AssetHandler* assetHandler = nullptr;
         {
-            return it->second->LoadInstance();
+            std::lock_guard lock(assetMutex);
+            if (auto it = assetsById.Find(assetId))
+            {
+                assetHandler = it->second;
+            }
         }
-        return nullptr;
+        return assetHandler != nullptr ? assetHandler->LoadInstance() : nullptr;
     }
 
     Asset* AssetManager::LoadByPath(const StringView& path)
     {
-        if (auto it = assetsByPath.Find(path))
-        {
-            return it->second->LoadInstance();
-        }
-        return nullptr;
+        AssetHandler* assetHandler = FindHandlerByPath(path);
+        return assetHandler != nullptr ? assetHandler->LoadInstance() : nullptr;
     }
 
-    Span<AssetHandler*> AssetManager::FindAssetsByType(TypeID typeId)
+    Array<AssetHandler*> AssetManager::FindAssetsByType(TypeID typeId)
     {
+        std::lock_guard lock(assetMutex);
         if (auto it = assetsByType.Find(typeId))
         {
             return it->second;
@@ -143,6 +264,7 @@ namespace Fyrion
 
     AssetHandler* AssetManager::FindHandlerByPath(const StringView& path)
     {
+        std::lock_guard lock(assetMutex);
         if (auto it = assetsByPath.Find(path))
         {
             return it->second;
@@ -161,6 +283,8 @@ namespace Fyrion
 
     Asset* AssetManager::Create(TypeHandler* typeHandler, const AssetCreation& assetCreation)
     {
+        FY_ASSERT(currentImportJob == nullptr, "imports can't create assets, use AddImportCommit");
+
         String name = !assetCreation.name.Empty() ? String(assetCreation.name) : String("New ").Append(AssetHandler::GetDisplayName(typeHandler));
 
         if (assetCreation.directoryAsset != nullptr)
@@ -205,7 +329,7 @@ namespace Fyrion
         return handler;
     }
 
-    void AssetManager::LoadAssetFile(DirectoryAssetHandler* parentDirectory, const StringView& filePath)
+    void AssetManager::LoadAssetFile(DirectoryAssetHandler* parentDirectory, const StringView& filePath, bool queueImport)
     {
         String extension = Path::Extension(filePath);
         if (extension == FY_DATA_EXTENSION) return;
@@ -219,7 +343,7 @@ namespace Fyrion
 
             for (const auto& entry : DirectoryEntries{filePath})
             {
-                LoadAssetFile(handler, entry);
+                LoadAssetFile(handler, entry, queueImport);
             }
 
             fileWatcher.Watch(handler, filePath);
@@ -233,21 +357,289 @@ namespace Fyrion
             AssetIO* io = importer->second;
             ImportedAssetHandler* handler = ImportedAssetHandler::Create(io, filePath, parentDirectory);
             fileWatcher.Watch(handler, filePath);
+
+            if (queueImport)
+            {
+                handler->QueuePendingImport();
+            }
+        }
+    }
+
+
+    void AssetImportExecute(VoidPtr userData)
+    {
+        AssetImportJob* job = static_cast<AssetImportJob*>(userData);
+        if (job->cancelled)
+        {
+            job->status = AssetImportStatus::Cancelled;
+            return;
+        }
+
+        job->status = AssetImportStatus::Running;
+
+        AssetImportJob* previousJob = currentImportJob;
+        currentImportJob = job;
+
+        logger.Debug("Importing file {} ", job->assetHandler->GetAbsolutePath());
+        bool imported = job->io->importAsset(job->assetHandler->GetAbsolutePath(), job->assetHandler->LoadInstance());
+
+        currentImportJob = previousJob;
+
+        if (job->cancelled)
+        {
+            job->status = AssetImportStatus::Cancelled;
+        }
+        else
+        {
+            job->progress = 1.0f;
+            job->status = imported ? AssetImportStatus::Completed : AssetImportStatus::Failed;
+        }
+    }
+
+    void AssetManagerScheduleImport(AssetImportJob* job)
+    {
+        if (!job->io->asyncImport)
+        {
+            //IO depends on main thread resources, runs inline.
+            AssetImportExecute(job);
+        }
+        else
+        {
+            JobSystem::Run(AssetImportExecute, job, &job->counter);
+        }
+        job->scheduled = true;
+    }
+
+    AssetImportJob* AssetManagerFindImportJob(AssetHandler* assetHandler)
+    {
+        for (usize i = importJobs.Size(); i > 0; --i)
+        {
+            if (importJobs[i - 1]->assetHandler == assetHandler)
+            {
+                return importJobs[i - 1];
+            }
+        }
+        return nullptr;
+    }
+
+    void AssetManagerCommitImports()
+    {
+        Array<AssetImportJob*> finishedJobs{};
+        {
+            std::lock_guard lock(importMutex);
+            for (usize i = 0; i < importJobs.Size();)
+            {
+                if (importJobs[i]->scheduled && importJobs[i]->counter.IsDone())
+                {
+                    finishedJobs.EmplaceBack(importJobs[i]);
+                    importJobs.Erase(importJobs.begin() + i);
+                    continue;
+                }
+                i++;
+            }
+        }
+
+        for (AssetImportJob* job : finishedJobs)
+        {
+            const bool completed = job->status == AssetImportStatus::Completed;
+            if (completed)
+            {
+                for (const AssetRegistration& registration : job->registrations)
+                {
+                    AssetManagerApplyRegistration(registration);
+                }
+            }
+
+            for (const AssetImportCommit& commit : job->commits)
+            {
+                commit.commit(commit.userData, completed);
+            }
+
+            if (completed)
+            {
+                job->assetHandler->Save();
+            }
+            else if (job->status == AssetImportStatus::Failed)
+            {
+                logger.Error("Failed to import file {} ", job->assetHandler->GetAbsolutePath());
+            }
+
+            MemoryGlobals::GetDefaultAllocator().DestroyAndFree(job);
+        }
+
+        //the next import of the same asset only starts after the previous one is committed
+        Array<AssetImportJob*> readyJobs{};
+        {
+            std::lock_guard lock(importMutex);
+            for (usize i = 0; i < importJobs.Size(); ++i)
+            {
+                AssetImportJob* job = importJobs[i];
+                if (!job->waiting)
+                {
+                    continue;
+                }
+
+                bool ready = true;
+                for (usize j = 0; j < i; ++j)
+                {
+                    if (importJobs[j]->assetHandler == job->assetHandler)
+                    {
+                        ready = false;
+                        break;
+                    }
+                }
+
+                if (ready)
+                {
+                    job->waiting = false;
+                    readyJobs.EmplaceBack(job);
+                }
+            }
+        }
+
+        for (AssetImportJob* job : readyJobs)
+        {
+            AssetManagerScheduleImport(job);
         }
     }
 
+    //waits and commits the imports of the asset, or all imports if assetHandler is null. only called on the main thread.
+    void AssetManagerFlushImports(AssetHandler* assetHandler)
+    {
+        while (true)
+        {
+            AssetImportJob* job = nullptr;
+            {
+                std::lock_guard lock(importMutex);
+                for (AssetImportJob* it : importJobs)
+                {
+                    if (assetHandler == nullptr || it->assetHandler == assetHandler)
+                    {
+                        job = it;
+                        break;
+                    }
+                }
+            }
+
+            if (job == nullptr)
+            {
+                break;
+            }
+
+            //the first import of an asset is never waiting, it can still be being scheduled by another thread.
+            if (job->scheduled)
+            {
+                JobSystem::Wait(job->counter);
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+
+            AssetManagerCommitImports();
+        }
+    }
 
     void AssetManager::QueueAssetImport(AssetIO* io, AssetHandler* assetHandler)
     {
-        //TODO enqueue to a thread pool
-        if (io->importAsset)
+        if (!io->importAsset)
         {
-            logger.Debug("Importing file {} ", assetHandler->GetAbsolutePath());
-            if (io->importAsset(assetHandler->GetAbsolutePath(), assetHandler->LoadInstance()))
+            return;
+        }
+
+        AssetImportJob* job = nullptr;
+        {
+            std::lock_guard lock(importMutex);
+            AssetImportJob* previousJob = AssetManagerFindImportJob(assetHandler);
+            if (previousJob != nullptr && previousJob->status == AssetImportStatus::Queued && !previousJob->cancelled)
             {
-                assetHandler->Save();
+                return;
+            }
+
+            job = MemoryGlobals::GetDefaultAllocator().Alloc<AssetImportJob>();
+            job->io = io;
+            job->assetHandler = assetHandler;
+            job->waiting = previousJob != nullptr;
+            importJobs.EmplaceBack(job);
+
+            if (job->waiting)
+            {
+                return;
             }
         }
+
+        AssetManagerScheduleImport(job);
+
+        if (std::this_thread::get_id() == mainThreadId && currentImportJob == nullptr && job->counter.IsDone())
+        {
+            AssetManagerCommitImports();
+        }
+    }
+
+    void AssetManager::WaitAssetImport(AssetHandler* assetHandler)
+    {
+        //the imported data is only applied on the main thread, other threads and imports get the instance as it is.
+        if (std::this_thread::get_id() != mainThreadId || currentImportJob != nullptr)
+        {
+            return;
+        }
+
+        AssetManagerFlushImports(assetHandler);
+    }
+
+    void AssetManager::CancelAssetImport(AssetHandler* assetHandler)
+    {
+        std::lock_guard lock(importMutex);
+        for (AssetImportJob* job : importJobs)
+        {
+            if (job->assetHandler == assetHandler)
+            {
+                job->cancelled = true;
+            }
+        }
+    }
+
+    void AssetManager::GetAssetImports(Array<AssetImportInfo>& imports)
+    {
+        std::lock_guard lock(importMutex);
+        imports.Reserve(imports.Size() + importJobs.Size());
+        for (AssetImportJob* job : importJobs)
+        {
+            imports.EmplaceBack(AssetImportInfo{
+                .assetHandler = job->assetHandler,
+                .progress = job->progress,
+                .status = job->status
+            });
+        }
+    }
+
+    bool AssetManager::HasPendingImports()
+    {
+        std::lock_guard lock(importMutex);
+        return !importJobs.Empty();
+    }
+
+    void AssetManager::SetImportProgress(f32 progress)
+    {
+        if (currentImportJob)
+        {
+            currentImportJob->progress = progress;
+        }
+    }
+
+    bool AssetManager::IsImportCancelled()
+    {
+        return currentImportJob != nullptr && currentImportJob->cancelled;
+    }
+
+    void AssetManager::AddImportCommit(VoidPtr userData, FnImportCommit commit)
+    {
+        if (currentImportJob != nullptr)
+        {
+            currentImportJob->commits.EmplaceBack(AssetImportCommit{userData, commit});
+            return;
+        }
+        commit(userData, true);
     }
 
     void AssetManager::SaveOnDirectory(DirectoryAssetHandler* directoryAssetHandler, const StringView& directoryPath)
@@ -305,10 +697,339 @@ namespace Fyrion
     }
 
 
+    namespace
+    {
+        struct AssetPackageWriter
+        {
+            Array<AssetPackageEntry>         entries{};
+            Array<AssetPackageBuffer>        buffers{};
+            Array<Array<AssetPackageBuffer>> entryBuffers{};
+            String                           strings{};
+            FileHandler                      binFile{};
+            u64                              binOffset{};
+
+            AssetPackageString AddString(StringView string)
+            {
+                AssetPackageString packageString{static_cast<u32>(strings.Size()), static_cast<u32>(string.Size())};
+                strings.Append(string.begin(), string.end());
+                return packageString;
+            }
+
+            u64 Write(ConstPtr data, usize size)
+            {
+                u64 padding = (AssetPackageAlignment - binOffset % AssetPackageAlignment) % AssetPackageAlignment;
+                if (padding > 0)
+                {
+                    u8 zeros[AssetPackageAlignment]{};
+                    FileSystem::WriteFile(binFile, zeros, padding);
+                    binOffset += padding;
+                }
+
+                u64 offset = binOffset;
+                FileSystem::WriteFile(binFile, data, size);
+                binOffset += size;
+                return offset;
+            }
+
+            void AddHandler(AssetHandler* assetHandler, u32 parent)
+            {
+                u32 index = entries.Size();
+
+                AssetPackageEntry& entry = entries.EmplaceBack();
+                entry.parent = parent;
+                entry.name = AddString(assetHandler->GetName());
+                entry.path = AddString(assetHandler->GetPath());
+
+                Array<AssetPackageBuffer>& assetBuffers = entryBuffers.EmplaceBack();
+
+                if (dynamic_cast<DirectoryAssetHandler*>(assetHandler))
+                {
+                    entry.type = AssetPackageEntryType::Directory;
+                }
+                else if (Asset* asset = assetHandler->LoadInstance())
+                {
+                    entry.type = AssetPackageEntryType::Asset;
+                    entry.uuid = assetHandler->GetUUID();
+                    entry.typeName = AddString(assetHandler->GetType()->GetName());
+
+                    BinaryAssetWriter writer;
+                    Array<u8> data = writer.Encode(asset->Serialize(writer));
+                    entry.dataOffset = Write(data.Data(), data.Size());
+                    entry.dataSize = data.Size();
+
+                    //buffers are stored as files named by the buffer id on the data path.
+                    StringView dataPath = assetHandler->GetDataPath();
+                    if (AssetBufferManager* bufferManager = assetHandler->GetBufferManager(); bufferManager != nullptr && !dataPath.Empty() && FileSystem::GetFileStatus(dataPath).exists)
+                    {
+                        for (const String& bufferPath : DirectoryEntries{dataPath})
+                        {
+                            if (FileSystem::GetFileStatus(bufferPath).isDirectory || !Path::Extension(bufferPath).Empty())
+                            {
+                                continue;
+                            }
+
+                            AssetBuffer buffer = AssetBuffer::FromString(Path::Name(bufferPath));
+                            Array<u8>   bufferData = bufferManager->LoadBuffer(buffer);
+
+                            assetBuffers.EmplaceBack(AssetPackageBuffer{
+                                .id = buffer.id,
+                                .offset = Write(bufferData.Data(), bufferData.Size()),
+                                .size = bufferData.Size()
+                            });
+                        }
+                    }
+                }
+                else
+                {
+                    logger.Warn("asset {} could not be loaded, it will not be added to the package", assetHandler->GetPath());
+                    entries.PopBack();
+                    entryBuffers.PopBack();
+                    return;
+                }
+
+                for (AssetHandler* child : assetHandler->GetChildren())
+                {
+                    AddHandler(child, index);
+                }
+            }
+        };
+    }
+
+    bool AssetManager::SaveToPackage(DirectoryAssetHandler* directoryAssetHandler, const StringView& pakFile, const StringView& binFile)
+    {
+        AssetPackageWriter writer{};
+        writer.binFile = FileSystem::OpenFile(binFile, AccessMode::WriteOnly);
+        if (!writer.binFile)
+        {
+            logger.Error("failed to open {} ", binFile);
+            return false;
+        }
+
+        for (AssetHandler* child : directoryAssetHandler->GetChildren())
+        {
+            writer.AddHandler(child, AssetPackageNoParent);
+        }
+
+        FileSystem::CloseFile(writer.binFile);
+
+        //sort entries by uuid and remap parents
+        Array<u32> order{};
+        order.Resize(writer.entries.Size());
+        for (u32 i = 0; i < order.Size(); ++i)
+        {
+            order[i] = i;
+        }
+
+        Sort(order.begin(), order.end(), [&](u32 a, u32 b)
+        {
+            const UUID& l = writer.entries[a].uuid;
+            const UUID& r = writer.entries[b].uuid;
+            return l.firstValue != r.firstValue ? l.firstValue < r.firstValue : l.secondValue < r.secondValue;
+        });
+
+        Array<u32> remap{};
+        remap.Resize(order.Size());
+        for (u32 i = 0; i < order.Size(); ++i)
+        {
+            remap[order[i]] = i;
+        }
+
+        Array<AssetPackageEntry> entries{};
+        entries.Reserve(writer.entries.Size());
+
+        for (u32 index : order)
+        {
+            AssetPackageEntry entry = writer.entries[index];
+            entry.parent = entry.parent != AssetPackageNoParent ? remap[entry.parent] : AssetPackageNoParent;
+
+            Array<AssetPackageBuffer>& assetBuffers = writer.entryBuffers[index];
+            Sort(assetBuffers.begin(), assetBuffers.end(), [](const AssetPackageBuffer& a, const AssetPackageBuffer& b)
+            {
+                return a.id < b.id;
+            });
+
+            entry.firstBuffer = writer.buffers.Size();
+            entry.bufferCount = assetBuffers.Size();
+            writer.buffers.Insert(writer.buffers.end(), assetBuffers.begin(), assetBuffers.end());
+
+            entries.EmplaceBack(entry);
+        }
+
+        AssetPackageHeader header{
+            .magic = AssetPackageMagic,
+            .version = AssetPackageVersion,
+            .entryCount = static_cast<u32>(entries.Size()),
+            .bufferCount = static_cast<u32>(writer.buffers.Size()),
+            .stringsSize = writer.strings.Size()
+        };
+
+        FileHandler file = FileSystem::OpenFile(pakFile, AccessMode::WriteOnly);
+        if (!file)
+        {
+            logger.Error("failed to open {} ", pakFile);
+            return false;
+        }
+
+        FileSystem::WriteFile(file, &header, sizeof(AssetPackageHeader));
+        FileSystem::WriteFile(file, entries.Data(), entries.Size() * sizeof(AssetPackageEntry));
+        FileSystem::WriteFile(file, writer.buffers.Data(), writer.buffers.Size() * sizeof(AssetPackageBuffer));
+        FileSystem::WriteFile(file, writer.strings.CStr(), writer.strings.Size());
+        FileSystem::CloseFile(file);
+
+        logger.Info("package {} saved with {} assets and {} buffers", pakFile, header.entryCount, header.bufferCount);
+
+        return true;
+    }
+
+    //checks the ranges of the package table, strings must be inside the strings table and data and buffers inside the bin file.
+    bool AssetManagerValidatePackage(const AssetPackage* package, u64 binSize)
+    {
+        const AssetPackageHeader& header = package->GetHeader();
+        const AssetPackageEntry*  entries = package->GetEntries();
+        const AssetPackageBuffer* buffers = package->GetBuffers();
+
+        auto inBinFile = [&](u64 offset, u64 size)
+        {
+            return size <= binSize && offset <= binSize - size;
+        };
+
+        auto inStrings = [&](const AssetPackageString& string)
+        {
+            return string.size <= header.stringsSize && string.offset <= header.stringsSize - string.size;
+        };
+
+        for (u32 i = 0; i < header.entryCount; ++i)
+        {
+            const AssetPackageEntry& entry = entries[i];
+            if ((entry.parent != AssetPackageNoParent && (entry.parent >= header.entryCount || entries[entry.parent].type != AssetPackageEntryType::Directory)) ||
+                !inStrings(entry.name) || !inStrings(entry.typeName) || !inStrings(entry.path) ||
+                entry.firstBuffer > header.bufferCount || entry.bufferCount > header.bufferCount - entry.firstBuffer ||
+                !inBinFile(entry.dataOffset, entry.dataSize))
+            {
+                return false;
+            }
+        }
+
+        //parents are created recursively, a chain that revisits an entry never ends.
+        //0 = not visited, 1 = in the current chain, 2 = chain already checked
+        Array<u8> visited(header.entryCount, 0);
+        for (u32 i = 0; i < header.entryCount; ++i)
+        {
+            u32 current = i;
+            while (current != AssetPackageNoParent && visited[current] == 0)
+            {
+                visited[current] = 1;
+                current = entries[current].parent;
+            }
+
+            if (current != AssetPackageNoParent && visited[current] == 1)
+            {
+                return false;
+            }
+
+            for (u32 it = i; it != current; it = entries[it].parent)
+            {
+                visited[it] = 2;
+            }
+        }
+
+        for (u32 i = 0; i < header.bufferCount; ++i)
+        {
+            if (!inBinFile(buffers[i].offset, buffers[i].size))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
     DirectoryAssetHandler* AssetManager::LoadFromPackage(const StringView& name, const StringView& file, const StringView& binFile)
     {
-        FY_ASSERT(false, "not implemented");
-        return nullptr;
+        AssetPackage* package = MemoryGlobals::GetDefaultAllocator().Alloc<AssetPackage>();
+        package->index = FileSystem::ReadFileAsByteArray(file);
+
+        bool valid = package->index.Size() >= sizeof(AssetPackageHeader);
+        if (valid)
+        {
+            const AssetPackageHeader& header = package->GetHeader();
+            valid = header.magic == AssetPackageMagic &&
+                header.version == AssetPackageVersion &&
+                package->index.Size() == sizeof(AssetPackageHeader) +
+                header.entryCount * sizeof(AssetPackageEntry) +
+                header.bufferCount * sizeof(AssetPackageBuffer) +
+                header.stringsSize;
+        }
+
+        if (!valid)
+        {
+            logger.Error("invalid package {} ", file);
+            MemoryGlobals::GetDefaultAllocator().DestroyAndFree(package);
+            return nullptr;
+        }
+
+        package->binFile = FileSystem::OpenFile(binFile, AccessMode::ReadOnly);
+        if (!package->binFile)
+        {
+            logger.Error("failed to open {} ", binFile);
+            MemoryGlobals::GetDefaultAllocator().DestroyAndFree(package);
+            return nullptr;
+        }
+
+        if (!AssetManagerValidatePackage(package, FileSystem::GetFileSize(package->binFile)))
+        {
+            logger.Error("package {} has entries outside of {} ", file, binFile);
+            FileSystem::CloseFile(package->binFile);
+            MemoryGlobals::GetDefaultAllocator().DestroyAndFree(package);
+            return nullptr;
+        }
+
+        package->binMapping = AssetBufferMapping::MapFile(binFile);
+        if (package->binMapping)
+        {
+            package->binMapping->AddReference();
+        }
+
+        packages.EmplaceBack(package);
+
+        DirectoryAssetHandler* root = DirectoryAssetHandler::Create(name, "", nullptr);
+
+        u32                      entryCount = package->GetHeader().entryCount;
+        const AssetPackageEntry* entries = package->GetEntries();
+
+        Array<AssetHandler*> handlers{};
+        handlers.Resize(entryCount, nullptr);
+
+        //entries are sorted by uuid, parents need to be created before their children.
+        auto createHandler = [&](auto& self, u32 index) -> AssetHandler*
+        {
+            if (handlers[index] != nullptr)
+            {
+                return handlers[index];
+            }
+
+            const AssetPackageEntry& entry = entries[index];
+            AssetHandler* parent = entry.parent != AssetPackageNoParent ? self(self, entry.parent) : root;
+
+            if (entry.type == AssetPackageEntryType::Directory)
+            {
+                handlers[index] = DirectoryAssetHandler::Create(package->GetString(entry.name), "", static_cast<DirectoryAssetHandler*>(parent));
+            }
+            else
+            {
+                handlers[index] = PackageAssetHandler::Create(package, &entry, parent);
+            }
+            return handlers[index];
+        };
+
+        for (u32 i = 0; i < entryCount; ++i)
+        {
+            createHandler(createHandler, i);
+        }
+
+        logger.Debug("package {} loaded with {} assets", file, entryCount);
+
+        return root;
     }
 
     void AssetManager::ImportAsset(DirectoryAssetHandler* directory, const StringView& path)
@@ -347,8 +1068,10 @@ namespace Fyrion
         assets.Clear();
         assets.ShrinkToFit();
 
-        assetsById.Clear();
-        assetsByPath.Clear();
+        //flat maps keep their storage on Clear
+        assetsById = {};
+        assetsByPath = {};
+        assetsByType.Clear();
     }
 
     void AssetManager::OnUpdate(f64 deltaTime)
@@ -369,7 +1092,7 @@ namespace Fyrion
                     logger.Debug("FileWatcher FileNotifyEvent::Added {} ", modified.path);
                     if (DirectoryAssetHandler* directory = dynamic_cast<DirectoryAssetHandler*>(assetHandler); assetHandler->FindChildByAbsolutePath(modified.path) == nullptr)
                     {
-                        LoadAssetFile(directory, modified.path);
+                        LoadAssetFile(directory, modified.path, true);
                     }
                     break;
                 }
@@ -393,10 +1116,14 @@ namespace Fyrion
                     break;
             }
         });
+
+        AssetManagerCommitImports();
     }
 
     void AssetDatabaseInit()
     {
+        mainThreadId = std::this_thread::get_id();
+
         if (hotReloadEnabled)
         {
             fileWatcher.Start();
@@ -424,8 +1151,30 @@ namespace Fyrion
         hotReloadEnabled = false;
         fileWatcher.Stop();
 
+        {
+            std::unique_lock lock(importMutex);
+            for (AssetImportJob* job : importJobs)
+            {
+                job->cancelled = true;
+            }
+        }
+
+        AssetManagerFlushImports(nullptr);
+
         AssetManager::DestroyAssets();
 
+        for (AssetPackage* package : packages)
+        {
+            if (package->binMapping)
+            {
+                package->binMapping->RemoveReference();
+            }
+            FileSystem::CloseFile(package->binFile);
+            MemoryGlobals::GetDefaultAllocator().DestroyAndFree(package);
+        }
+        packages.Clear();
+        packages.ShrinkToFit();
+
         for (const auto& assetIo : assetIOs)
         {
             if (TypeHandler* typeHandler = Registry::FindTypeById(assetIo.first))
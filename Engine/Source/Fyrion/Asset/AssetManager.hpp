@@ -33,6 +33,25 @@ namespace Fyrion
         StringView desiredPath{};
     };
 
+    enum class AssetImportStatus
+    {
+        Queued,
+        Running,
+        Completed,
+        Failed,
+        Cancelled
+    };
+
+    struct AssetImportInfo
+    {
+        AssetHandler*     assetHandler{};
+        f32               progress{};
+        AssetImportStatus status{};
+    };
+
+    //called on the main thread when the import is committed, apply is false when the import failed or was cancelled and the data must only be released.
+    typedef void (*FnImportCommit)(VoidPtr userData, bool apply);
+
     class FY_API AssetManager
     {
     public:
@@ -42,13 +61,21 @@ namespace Fyrion
         static StringView             GetDataDirectory();
         static void                   GetUpdatedAssets(DirectoryAssetHandler* directoryAssetHandler, Array<AssetHandler*>& updatedAssets);
         static DirectoryAssetHandler* LoadFromPackage(const StringView& name, const StringView& pakFile, const StringView& binFile);
+        static bool                   SaveToPackage(DirectoryAssetHandler* directoryAssetHandler, const StringView& pakFile, const StringView& binFile);
         static void                   ImportAsset(DirectoryAssetHandler* directoryAssetHandler, const StringView& path);
         static bool                   CanReimportAsset(AssetHandler* assetHandler);
         static void                   ReimportAsset(AssetHandler* asset);
         static void                   QueueAssetImport(AssetIO* io, AssetHandler* assetHandler);
+        static void                   WaitAssetImport(AssetHandler* assetHandler);
+        static void                   CancelAssetImport(AssetHandler* assetHandler);
+        static void                   GetAssetImports(Array<AssetImportInfo>& imports);
+        static bool                   HasPendingImports();
+        static void                   SetImportProgress(f32 progress);
+        static bool                   IsImportCancelled();
+        static void                   AddImportCommit(VoidPtr userData, FnImportCommit commit);
         static Asset*                 LoadById(const UUID& assetId);
         static Asset*                 LoadByPath(const StringView& path);
-        static Span<AssetHandler*>    FindAssetsByType(TypeID typeId);
+        static Array<AssetHandler*>   FindAssetsByType(TypeID typeId);
         static AssetHandler*          FindHandlerByPath(const StringView& path);
         static DirectoryAssetHandler* CreateDirectory(DirectoryAssetHandler* parent, StringView name);
         static Asset*                 Create(TypeHandler* typeHandler, const AssetCreation& assetCreation);
@@ -85,6 +112,6 @@ namespace Fyrion
         friend class AssetHandler;
 
     private:
-        static void LoadAssetFile(DirectoryAssetHandler* directoryAssetHandler, const StringView& filePath);
+        static void LoadAssetFile(DirectoryAssetHandler* directoryAssetHandler, const StringView& filePath, bool queueImport = false);
     };
 }
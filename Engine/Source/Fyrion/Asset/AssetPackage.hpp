@@ -0,0 +1,91 @@
+#pragma once
+
+#include "Fyrion/Common.hpp"
+#include "Fyrion/Core/Array.hpp"
+#include "Fyrion/Core/StringView.hpp"
+#include "Fyrion/Core/UUID.hpp"
+#include "Fyrion/IO/FileTypes.hpp"
+
+namespace Fyrion
+{
+    //.pak layout: AssetPackageHeader | AssetPackageEntry[entryCount] | AssetPackageBuffer[bufferCount] | strings
+    //entries are sorted by uuid, buffers of each entry are stored contiguously and sorted by id.
+    //asset data (as binary archives) and buffer contents are stored in the .bin file.
+
+    constexpr u32 AssetPackageMagic = 0x4B505946; //FYPK
+    constexpr u32 AssetPackageVersion = 2;
+    constexpr u32 AssetPackageNoParent = U32_MAX;
+    constexpr u64 AssetPackageAlignment = 16;
+
+    enum class AssetPackageEntryType : u32
+    {
+        Directory = 0,
+        Asset     = 1
+    };
+
+    struct AssetPackageHeader
+    {
+        u32 magic;
+        u32 version;
+        u32 entryCount;
+        u32 bufferCount;
+        u64 stringsSize;
+    };
+
+    struct AssetPackageString
+    {
+        u32 offset;
+        u32 size;
+    };
+
+    struct AssetPackageEntry
+    {
+        UUID                  uuid;
+        u32                   parent;
+        AssetPackageEntryType type;
+        AssetPackageString    name;
+        AssetPackageString    typeName;
+        AssetPackageString    path;
+        u32                   firstBuffer;
+        u32                   bufferCount;
+        u64                   dataOffset;
+        u64                   dataSize;
+    };
+
+    struct AssetPackageBuffer
+    {
+        u64 id;
+        u64 offset;
+        u64 size;
+    };
+
+    class AssetBufferMapping;
+
+    struct AssetPackage
+    {
+        Array<u8>           index{};
+        FileHandler         binFile{};
+        AssetBufferMapping* binMapping{};
+
+        const AssetPackageHeader& GetHeader() const
+        {
+            return *reinterpret_cast<const AssetPackageHeader*>(index.Data());
+        }
+
+        const AssetPackageEntry* GetEntries() const
+        {
+            return reinterpret_cast<const AssetPackageEntry*>(index.Data() + sizeof(AssetPackageHeader));
+        }
+
+        const AssetPackageBuffer* GetBuffers() const
+        {
+            return reinterpret_cast<const AssetPackageBuffer*>(GetEntries() + GetHeader().entryCount);
+        }
+
+        StringView GetString(const AssetPackageString& string) const
+        {
+            const char* strings = reinterpret_cast<const char*>(GetBuffers() + GetHeader().bufferCount);
+            return {strings + string.offset, string.size};
+        }
+    };
+}
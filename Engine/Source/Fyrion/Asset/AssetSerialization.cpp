@@ -1,5 +1,7 @@
 #include "AssetSerialization.hpp"
 #include "yyjson.h"
+#include "Fyrion/Core/Algorithm.hpp"
+#include "Fyrion/Core/Logger.hpp"
 #include "Fyrion/Core/UUID.hpp"
 
 namespace Fyrion
@@ -27,6 +29,98 @@ namespace Fyrion
             .free = Free,
             .ctx = nullptr
         };
+
+        Logger& logger = Logger::GetLogger("Fyrion::AssetSerialization");
+
+        constexpr u32 InvalidIndex = U32_MAX;
+        constexpr u32 MaxDepth = 256;
+
+        FY_FINLINE VoidPtr ToHandler(u32 index)
+        {
+            return reinterpret_cast<VoidPtr>(static_cast<usize>(index) + 1);
+        }
+
+        FY_FINLINE u32 ToIndex(ArchiveObject object)
+        {
+            return static_cast<u32>(reinterpret_cast<usize>(object.handler) - 1);
+        }
+
+        void WriteVarInt(Array<u8>& out, u64 value)
+        {
+            while (value >= 0x80)
+            {
+                out.EmplaceBack(static_cast<u8>(value | 0x80));
+                value >>= 7;
+            }
+            out.EmplaceBack(static_cast<u8>(value));
+        }
+
+        bool ReadVarInt(const u8*& it, const u8* end, u64& value)
+        {
+            value = 0;
+            for (u32 shift = 0; shift < 64 && it != end; shift += 7)
+            {
+                u8 byte = *it++;
+                value |= static_cast<u64>(byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        FY_FINLINE u64 ZigZagEncode(i64 value)
+        {
+            return (static_cast<u64>(value) << 1) ^ static_cast<u64>(value >> 63);
+        }
+
+        FY_FINLINE i64 ZigZagDecode(u64 value)
+        {
+            return static_cast<i64>(value >> 1) ^ -static_cast<i64>(value & 1);
+        }
+
+        void WriteFixed(Array<u8>& out, u64 value, u32 size)
+        {
+            for (u32 i = 0; i < size; ++i)
+            {
+                out.EmplaceBack(static_cast<u8>(value >> (i * 8)));
+            }
+        }
+
+        bool ReadFixed(const u8*& it, const u8* end, u32 size, u64& value)
+        {
+            if (static_cast<usize>(end - it) < size)
+            {
+                return false;
+            }
+
+            value = 0;
+            for (u32 i = 0; i < size; ++i)
+            {
+                value |= static_cast<u64>(*it++) << (i * 8);
+            }
+            return true;
+        }
+
+        //strings are stored with a null terminator so readers can return views that are also valid c strings.
+        void WriteBytes(Array<u8>& out, const StringView& value)
+        {
+            WriteVarInt(out, value.Size());
+            const u8* data = reinterpret_cast<const u8*>(value.CStr());
+            out.Insert(out.end(), data, data + value.Size());
+            out.EmplaceBack(0);
+        }
+
+        bool ReadBytes(const u8*& it, const u8* end, u64& size)
+        {
+            if (!ReadVarInt(it, end, size) || size >= static_cast<u64>(end - it) || it[size] != 0)
+            {
+                return false;
+            }
+            it += size + 1;
+            return true;
+        }
     }
 
     JsonAssetWriter::JsonAssetWriter(SerializationOptions serializationOptions) : serializationOptions(serializationOptions)
@@ -254,4 +348,496 @@ namespace Fyrion
     {
         yyjson_doc_free(doc);
     }
+
+
+    BinaryAssetWriter::BinaryAssetWriter(SerializationOptions serializationOptions) : serializationOptions(serializationOptions) {}
+
+    ArchiveObject BinaryAssetWriter::CreateObject()
+    {
+        nodes.EmplaceBack(Node{BinaryArchiveType::Object, 0, InvalidIndex, InvalidIndex});
+        return {ToHandler(nodes.Size() - 1)};
+    }
+
+    ArchiveObject BinaryAssetWriter::CreateArray()
+    {
+        nodes.EmplaceBack(Node{BinaryArchiveType::Array, 0, InvalidIndex, InvalidIndex});
+        return {ToHandler(nodes.Size() - 1)};
+    }
+
+    u32 BinaryAssetWriter::InternName(const StringView& name)
+    {
+        auto it = nameIds.Find(name);
+        if (it != nameIds.end())
+        {
+            return it->second;
+        }
+
+        u32 id = names.Size();
+        names.EmplaceBack(name);
+        nameIds.Insert(names.Back(), id);
+        return id;
+    }
+
+    void BinaryAssetWriter::Push(ArchiveObject object, u32 name, BinaryArchiveType type, u64 data, u32 size)
+    {
+        if (!object) return;
+
+        u32 index = values.Size();
+        values.EmplaceBack(Value{name, type, size, data, InvalidIndex});
+
+        Node& node = nodes[ToIndex(object)];
+        if (node.last != InvalidIndex)
+        {
+            values[node.last].next = index;
+        }
+        else
+        {
+            node.first = index;
+        }
+        node.last = index;
+        node.count++;
+    }
+
+    void BinaryAssetWriter::PushFloat(ArchiveObject object, u32 name, f64 value)
+    {
+        f32 single = static_cast<f32>(value);
+        if (static_cast<f64>(single) == value)
+        {
+            u32 bits = 0;
+            MemCopy(&bits, &single, sizeof(u32));
+            Push(object, name, BinaryArchiveType::Float32, bits);
+        }
+        else
+        {
+            u64 bits = 0;
+            MemCopy(&bits, &value, sizeof(u64));
+            Push(object, name, BinaryArchiveType::Float64, bits);
+        }
+    }
+
+    void BinaryAssetWriter::PushString(ArchiveObject object, u32 name, const StringView& value)
+    {
+        u64 offset = strings.Size();
+        strings.Insert(strings.end(), value.begin(), value.end());
+        Push(object, name, BinaryArchiveType::String, offset, value.Size());
+    }
+
+    void BinaryAssetWriter::WriteBool(ArchiveObject object, const StringView& name, bool value)
+    {
+        Push(object, InternName(name), value ? BinaryArchiveType::True : BinaryArchiveType::False, 0);
+    }
+
+    void BinaryAssetWriter::WriteInt(ArchiveObject object, const StringView& name, i64 value)
+    {
+        Push(object, InternName(name), BinaryArchiveType::Int, ZigZagEncode(value));
+    }
+
+    void BinaryAssetWriter::WriteUInt(ArchiveObject object, const StringView& name, u64 value)
+    {
+        Push(object, InternName(name), BinaryArchiveType::UInt, value);
+    }
+
+    void BinaryAssetWriter::WriteFloat(ArchiveObject object, const StringView& name, f64 value)
+    {
+        PushFloat(object, InternName(name), value);
+    }
+
+    void BinaryAssetWriter::WriteString(ArchiveObject object, const StringView& name, const StringView& value)
+    {
+        PushString(object, InternName(name), value);
+    }
+
+    void BinaryAssetWriter::WriteValue(ArchiveObject object, const StringView& name, ArchiveObject value)
+    {
+        if (!value) return;
+        Push(object, InternName(name), nodes[ToIndex(value)].type, ToIndex(value));
+    }
+
+    void BinaryAssetWriter::AddBool(ArchiveObject array, bool value)
+    {
+        Push(array, InvalidIndex, value ? BinaryArchiveType::True : BinaryArchiveType::False, 0);
+    }
+
+    void BinaryAssetWriter::AddInt(ArchiveObject array, i64 value)
+    {
+        Push(array, InvalidIndex, BinaryArchiveType::Int, ZigZagEncode(value));
+    }
+
+    void BinaryAssetWriter::AddUInt(ArchiveObject array, u64 value)
+    {
+        Push(array, InvalidIndex, BinaryArchiveType::UInt, value);
+    }
+
+    void BinaryAssetWriter::AddFloat(ArchiveObject array, f64 value)
+    {
+        PushFloat(array, InvalidIndex, value);
+    }
+
+    void BinaryAssetWriter::AddString(ArchiveObject array, const StringView& value)
+    {
+        PushString(array, InvalidIndex, value);
+    }
+
+    void BinaryAssetWriter::AddValue(ArchiveObject array, ArchiveObject value)
+    {
+        if (!value) return;
+        Push(array, InvalidIndex, nodes[ToIndex(value)].type, ToIndex(value));
+    }
+
+    bool BinaryAssetWriter::HasOpt(SerializationOptions option)
+    {
+        return serializationOptions && option;
+    }
+
+    void BinaryAssetWriter::EncodeValue(Array<u8>& out, const Value& value) const
+    {
+        switch (value.type)
+        {
+            case BinaryArchiveType::Int:
+            case BinaryArchiveType::UInt:
+                out.EmplaceBack(static_cast<u8>(value.type));
+                WriteVarInt(out, value.data);
+                break;
+            case BinaryArchiveType::Float32:
+                out.EmplaceBack(static_cast<u8>(value.type));
+                WriteFixed(out, value.data, 4);
+                break;
+            case BinaryArchiveType::Float64:
+                out.EmplaceBack(static_cast<u8>(value.type));
+                WriteFixed(out, value.data, 8);
+                break;
+            case BinaryArchiveType::String:
+                out.EmplaceBack(static_cast<u8>(value.type));
+                WriteBytes(out, StringView{strings.Data() + value.data, value.size});
+                break;
+            case BinaryArchiveType::Object:
+            case BinaryArchiveType::Array:
+                EncodeNode(out, static_cast<u32>(value.data));
+                break;
+            default:
+                out.EmplaceBack(static_cast<u8>(value.type));
+                break;
+        }
+    }
+
+    void BinaryAssetWriter::EncodeNode(Array<u8>& out, u32 node) const
+    {
+        const Node& current = nodes[node];
+        out.EmplaceBack(static_cast<u8>(current.type));
+        WriteVarInt(out, current.count);
+
+        for (u32 index = current.first; index != InvalidIndex; index = values[index].next)
+        {
+            const Value& value = values[index];
+            if (current.type == BinaryArchiveType::Object)
+            {
+                WriteVarInt(out, value.name);
+            }
+            EncodeValue(out, value);
+        }
+    }
+
+    Array<u8> BinaryAssetWriter::Encode(ArchiveObject object) const
+    {
+        if (!object) return {};
+
+        Array<u8> out{};
+        out.Reserve(values.Size() * 4 + strings.Size() + 64);
+
+        WriteFixed(out, BinaryArchiveMagic, 4);
+        WriteVarInt(out, BinaryArchiveVersion);
+        WriteVarInt(out, names.Size());
+        for (const String& name : names)
+        {
+            WriteBytes(out, name);
+        }
+
+        EncodeNode(out, ToIndex(object));
+        return out;
+    }
+
+    BinaryAssetReader::BinaryAssetReader(Array<u8> data) : bytes(Traits::Move(data))
+    {
+        valid = Decode();
+        if (!valid)
+        {
+            logger.Error("invalid binary archive");
+            entries.Clear();
+        }
+    }
+
+    BinaryAssetReader::BinaryAssetReader(Span<const u8> data) : BinaryAssetReader(Array<u8>{data.begin(), data.end()}) {}
+
+    bool BinaryAssetReader::Decode()
+    {
+        const u8* it = bytes.begin();
+        const u8* end = bytes.end();
+
+        u64 magic = 0;
+        u64 version = 0;
+        u64 nameCount = 0;
+
+        if (!ReadFixed(it, end, 4, magic) || magic != BinaryArchiveMagic) return false;
+        if (!ReadVarInt(it, end, version) || version != BinaryArchiveVersion) return false;
+        if (!ReadVarInt(it, end, nameCount) || nameCount > static_cast<u64>(end - it)) return false;
+
+        names.Reserve(nameCount);
+        for (u64 i = 0; i < nameCount; ++i)
+        {
+            u64 size = 0;
+            if (!ReadBytes(it, end, size)) return false;
+            names.EmplaceBack(reinterpret_cast<const char*>(it - size - 1), size);
+        }
+
+        entries.EmplaceBack(Entry{InvalidIndex, BinaryArchiveType::Null, 0, 0, 0});
+        return DecodeValue(it, end, 0, 0) && entries[0].type == BinaryArchiveType::Object;
+    }
+
+    bool BinaryAssetReader::DecodeValue(const u8*& it, const u8* end, u32 index, u32 depth)
+    {
+        if (it == end || depth > MaxDepth) return false;
+
+        BinaryArchiveType type = static_cast<BinaryArchiveType>(*it++);
+        entries[index].type = type;
+
+        switch (type)
+        {
+            case BinaryArchiveType::Null:
+            case BinaryArchiveType::False:
+            case BinaryArchiveType::True:
+                return true;
+            case BinaryArchiveType::Int:
+            case BinaryArchiveType::UInt:
+                return ReadVarInt(it, end, entries[index].data);
+            case BinaryArchiveType::Float32:
+                return ReadFixed(it, end, 4, entries[index].data);
+            case BinaryArchiveType::Float64:
+                return ReadFixed(it, end, 8, entries[index].data);
+            case BinaryArchiveType::String:
+            {
+                u64 size = 0;
+                if (!ReadBytes(it, end, size)) return false;
+                entries[index].data = (it - size - 1) - bytes.begin();
+                entries[index].size = static_cast<u32>(size);
+                return true;
+            }
+            case BinaryArchiveType::Object:
+            case BinaryArchiveType::Array:
+            {
+                u64 count = 0;
+                if (!ReadVarInt(it, end, count) || count > static_cast<u64>(end - it)) return false;
+
+                //children are stored contiguously so Next is just the following entry.
+                u32 first = entries.Size();
+                entries[index].data = first;
+                entries[index].size = static_cast<u32>(count);
+                if (first + count > entries.Capacity())
+                {
+                    entries.Reserve((first + count) * 3 / 2);
+                }
+                entries.Resize(first + count, Entry{InvalidIndex, BinaryArchiveType::Null, 0, 0, 0});
+
+                for (u32 i = 0; i < count; ++i)
+                {
+                    if (type == BinaryArchiveType::Object)
+                    {
+                        u64 name = 0;
+                        if (!ReadVarInt(it, end, name) || name >= names.Size()) return false;
+                        entries[first + i].name = static_cast<u32>(name);
+                    }
+
+                    if (!DecodeValue(it, end, first + i, depth + 1)) return false;
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool BinaryAssetReader::IsValid() const
+    {
+        return valid;
+    }
+
+    const BinaryAssetReader::Entry* BinaryAssetReader::GetEntry(ArchiveObject object) const
+    {
+        if (!object) return nullptr;
+        return &entries[ToIndex(object)];
+    }
+
+    const BinaryAssetReader::Entry* BinaryAssetReader::FindField(ArchiveObject object, const StringView& name)
+    {
+        if (!object) return nullptr;
+
+        Entry& entry = entries[ToIndex(object)];
+        if (entry.type != BinaryArchiveType::Object || entry.size == 0) return nullptr;
+
+        //fields are usually read in the same order they were written, start from the field after the last match.
+        for (u32 i = 0; i < entry.size; ++i)
+        {
+            u32 field = (entry.cursor + i) % entry.size;
+            const Entry& candidate = entries[static_cast<u32>(entry.data) + field];
+            if (names[candidate.name] == name)
+            {
+                entry.cursor = field + 1;
+                return &candidate;
+            }
+        }
+        return nullptr;
+    }
+
+    ArchiveObject BinaryAssetReader::ReadObject()
+    {
+        if (!valid) return {};
+        return {ToHandler(0)};
+    }
+
+    bool BinaryAssetReader::ReadBool(ArchiveObject object, const StringView& name)
+    {
+        const Entry* entry = FindField(object, name);
+        return entry && entry->type == BinaryArchiveType::True;
+    }
+
+    i64 BinaryAssetReader::ReadInt(ArchiveObject object, const StringView& name)
+    {
+        if (const Entry* entry = FindField(object, name))
+        {
+            return GetInt({ToHandler(entry - entries.Data())});
+        }
+        return 0;
+    }
+
+    u64 BinaryAssetReader::ReadUInt(ArchiveObject object, const StringView& name)
+    {
+        if (const Entry* entry = FindField(object, name))
+        {
+            return GetUInt({ToHandler(entry - entries.Data())});
+        }
+        return 0;
+    }
+
+    StringView BinaryAssetReader::ReadString(ArchiveObject object, const StringView& name)
+    {
+        if (const Entry* entry = FindField(object, name))
+        {
+            return GetString({ToHandler(entry - entries.Data())});
+        }
+        return {};
+    }
+
+    f64 BinaryAssetReader::ReadFloat(ArchiveObject object, const StringView& name)
+    {
+        if (const Entry* entry = FindField(object, name))
+        {
+            return GetFloat({ToHandler(entry - entries.Data())});
+        }
+        return 0.0;
+    }
+
+    ArchiveObject BinaryAssetReader::ReadObject(ArchiveObject object, const StringView& name)
+    {
+        if (const Entry* entry = FindField(object, name))
+        {
+            if (entry->type == BinaryArchiveType::Object || entry->type == BinaryArchiveType::Array)
+            {
+                return {ToHandler(entry - entries.Data())};
+            }
+        }
+        return {};
+    }
+
+    usize BinaryAssetReader::ArrSize(ArchiveObject object)
+    {
+        const Entry* entry = GetEntry(object);
+        if (entry && entry->type == BinaryArchiveType::Array)
+        {
+            return entry->size;
+        }
+        return 0;
+    }
+
+    ArchiveObject BinaryAssetReader::Next(ArchiveObject object, ArchiveObject item)
+    {
+        const Entry* entry = GetEntry(object);
+        if (entry == nullptr || entry->size == 0) return {};
+
+        u32 first = static_cast<u32>(entry->data);
+        if (!item)
+        {
+            return {ToHandler(first)};
+        }
+
+        u32 next = ToIndex(item) + 1;
+        if (next < first + entry->size)
+        {
+            return {ToHandler(next)};
+        }
+        return {};
+    }
+
+    i64 BinaryAssetReader::GetInt(ArchiveObject object)
+    {
+        if (const Entry* entry = GetEntry(object))
+        {
+            switch (entry->type)
+            {
+                case BinaryArchiveType::Int: return ZigZagDecode(entry->data);
+                case BinaryArchiveType::UInt: return static_cast<i64>(entry->data);
+                default: break;
+            }
+        }
+        return 0;
+    }
+
+    u64 BinaryAssetReader::GetUInt(ArchiveObject object)
+    {
+        if (const Entry* entry = GetEntry(object))
+        {
+            switch (entry->type)
+            {
+                case BinaryArchiveType::Int: return static_cast<u64>(ZigZagDecode(entry->data));
+                case BinaryArchiveType::UInt: return entry->data;
+                default: break;
+            }
+        }
+        return 0;
+    }
+
+    StringView BinaryAssetReader::GetString(ArchiveObject object)
+    {
+        const Entry* entry = GetEntry(object);
+        if (entry && entry->type == BinaryArchiveType::String)
+        {
+            return {reinterpret_cast<const char*>(bytes.Data() + entry->data), entry->size};
+        }
+        return {};
+    }
+
+    f64 BinaryAssetReader::GetFloat(ArchiveObject object)
+    {
+        if (const Entry* entry = GetEntry(object))
+        {
+            if (entry->type == BinaryArchiveType::Float32)
+            {
+                u32 bits = static_cast<u32>(entry->data);
+                f32 value = 0;
+                MemCopy(&value, &bits, sizeof(f32));
+                return value;
+            }
+
+            if (entry->type == BinaryArchiveType::Float64)
+            {
+                f64 value = 0;
+                MemCopy(&value, &entry->data, sizeof(f64));
+                return value;
+            }
+        }
+        return 0.0;
+    }
+
+    bool BinaryAssetReader::GetBool(ArchiveObject object)
+    {
+        const Entry* entry = GetEntry(object);
+        return entry && entry->type == BinaryArchiveType::True;
+    }
 }
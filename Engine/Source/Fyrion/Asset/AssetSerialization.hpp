@@ -1,7 +1,9 @@
 #pragma once
 
+#include "Fyrion/Core/HashMap.hpp"
 #include "Fyrion/Core/Registry.hpp"
 #include "Fyrion/Core/Serialization.hpp"
+#include "Fyrion/Core/Span.hpp"
 #include "Fyrion/Core/String.hpp"
 
 typedef struct yyjson_mut_doc yyjson_mut_doc;
@@ -76,4 +78,135 @@ namespace Fyrion
     private:
         yyjson_doc* doc = nullptr;
     };
+
+
+    //binary layout: magic | version | name table | root value
+    //values are a type tag followed by the payload, integers are varints, floats are raw IEEE and object fields are name table ids.
+    enum class BinaryArchiveType : u8
+    {
+        Null    = 0,
+        False   = 1,
+        True    = 2,
+        Int     = 3,
+        UInt    = 4,
+        Float32 = 5,
+        Float64 = 6,
+        String  = 7,
+        Object  = 8,
+        Array   = 9
+    };
+
+    constexpr u32 BinaryArchiveMagic = 0x41425946; //FYBA
+    constexpr u32 BinaryArchiveVersion = 1;
+
+    class FY_API BinaryAssetWriter : public ArchiveWriter
+    {
+    public:
+        FY_NO_COPY_CONSTRUCTOR(BinaryAssetWriter);
+        FY_BASE_TYPES(ArchiveWriter);
+
+        BinaryAssetWriter(SerializationOptions serializationOptions = SerializationOptions::None);
+
+        ArchiveObject CreateObject() override;
+        ArchiveObject CreateArray() override;
+
+        void WriteBool(ArchiveObject object, const StringView& name, bool value) override;
+        void WriteInt(ArchiveObject object, const StringView& name, i64 value) override;
+        void WriteUInt(ArchiveObject object, const StringView& name, u64 value) override;
+        void WriteFloat(ArchiveObject object, const StringView& name, f64 value) override;
+        void WriteString(ArchiveObject object, const StringView& name, const StringView& value) override;
+        void WriteValue(ArchiveObject object, const StringView& name, ArchiveObject value) override;
+
+        void AddBool(ArchiveObject array, bool value) override;
+        void AddInt(ArchiveObject array, i64 value) override;
+        void AddUInt(ArchiveObject array, u64 value) override;
+        void AddFloat(ArchiveObject array, f64 value) override;
+        void AddString(ArchiveObject array, const StringView& value) override;
+        void AddValue(ArchiveObject array, ArchiveObject value) override;
+
+        bool HasOpt(SerializationOptions option) override;
+
+        Array<u8> Encode(ArchiveObject object) const;
+
+    private:
+        struct Value
+        {
+            u32               name;
+            BinaryArchiveType type;
+            u32               size;
+            u64               data;
+            u32               next;
+        };
+
+        struct Node
+        {
+            BinaryArchiveType type;
+            u32               count;
+            u32               first;
+            u32               last;
+        };
+
+        SerializationOptions serializationOptions = SerializationOptions::None;
+        HashMap<String, u32> nameIds{};
+        Array<String>        names{};
+        Array<Node>          nodes{};
+        Array<Value>         values{};
+        Array<char>          strings{};
+
+        u32  InternName(const StringView& name);
+        void Push(ArchiveObject object, u32 name, BinaryArchiveType type, u64 data, u32 size = 0);
+        void PushFloat(ArchiveObject object, u32 name, f64 value);
+        void PushString(ArchiveObject object, u32 name, const StringView& value);
+        void EncodeValue(Array<u8>& out, const Value& value) const;
+        void EncodeNode(Array<u8>& out, u32 node) const;
+    };
+
+    class FY_API BinaryAssetReader : public ArchiveReader
+    {
+    public:
+        FY_NO_COPY_CONSTRUCTOR(BinaryAssetReader);
+        FY_BASE_TYPES(ArchiveReader);
+
+        explicit BinaryAssetReader(Array<u8> data);
+        explicit BinaryAssetReader(Span<const u8> data);
+
+        bool IsValid() const;
+
+        ArchiveObject ReadObject() override;
+
+        bool          ReadBool(ArchiveObject object, const StringView& name) override;
+        i64           ReadInt(ArchiveObject object, const StringView& name) override;
+        u64           ReadUInt(ArchiveObject object, const StringView& name) override;
+        StringView    ReadString(ArchiveObject object, const StringView& name) override;
+        f64           ReadFloat(ArchiveObject object, const StringView& name) override;
+        ArchiveObject ReadObject(ArchiveObject object, const StringView& name) override;
+
+        usize         ArrSize(ArchiveObject object) override;
+        ArchiveObject Next(ArchiveObject object, ArchiveObject item) override;
+        i64           GetInt(ArchiveObject object) override;
+        u64           GetUInt(ArchiveObject object) override;
+        StringView    GetString(ArchiveObject object) override;
+        f64           GetFloat(ArchiveObject object) override;
+        bool          GetBool(ArchiveObject object) override;
+
+    private:
+        struct Entry
+        {
+            u32               name;
+            BinaryArchiveType type;
+            u32               size;
+            u64               data;
+            u32               cursor;
+        };
+
+        Array<u8>         bytes{};
+        Array<StringView> names{};
+        Array<Entry>      entries{};
+        bool              valid = false;
+
+        bool         Decode();
+        bool         DecodeValue(const u8*& it, const u8* end, u32 index, u32 depth);
+        const Entry* GetEntry(ArchiveObject object) const;
+        const Entry* FindField(ArchiveObject object, const StringView& name);
+    };
 }
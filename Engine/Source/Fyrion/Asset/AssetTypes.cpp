@@ -40,13 +40,32 @@ namespace Fyrion
         return GetTypeID<UIFontAsset>();
     }
 
-    bool UIFontAssetIO::ImportAsset(StringView path, Asset* asset)
+    namespace
     {
-        UIFontAsset* fontAsset = asset->Cast<UIFontAsset>();
+        struct UIFontImport
+        {
+            UIFontAsset* fontAsset;
+            Array<u8>    bytes;
+        };
+
+        void CommitUIFontImport(VoidPtr userData, bool apply)
+        {
+            UIFontImport* import = static_cast<UIFontImport*>(userData);
+            if (apply)
+            {
+                import->fontAsset->SaveBuffer(import->fontAsset->fontBytes, import->bytes.begin(), import->bytes.Size());
+            }
+            MemoryGlobals::GetDefaultAllocator().DestroyAndFree(import);
+        }
+    }
 
-        Array<u8> bytes = FileSystem::ReadFileAsByteArray(path);
-        fontAsset->SaveBuffer(fontAsset->fontBytes, bytes.begin(), bytes.Size());
+    bool UIFontAssetIO::ImportAsset(StringView path, Asset* asset)
+    {
+        UIFontImport* import = MemoryGlobals::GetDefaultAllocator().Alloc<UIFontImport>();
+        import->fontAsset = asset->Cast<UIFontAsset>();
+        import->bytes = FileSystem::ReadFileAsByteArray(path);
 
+        AssetManager::AddImportCommit(import, CommitUIFontImport);
         return true;
     }
 
@@ -24,6 +24,10 @@ namespace Fyrion
         FnImportAsset         importAsset = nullptr;
         FnRenameAsset         renameAsset = nullptr;
 
+        //imports are executed on the job system, IOs that depend on main thread resources can disable it.
+        //importAsset must not change live assets, the imported data is applied by AssetManager::AddImportCommit.
+        bool asyncImport = true;
+
         static void RegisterType(NativeTypeHandler<AssetIO>& type);
     };
 
@@ -0,0 +1,130 @@
+#include "ObjectDelta.hpp"
+
+#include "AssetSerialization.hpp"
+
+namespace Fyrion
+{
+    namespace
+    {
+        Array<u8> EncodeField(const SerializationField& field, ConstPtr instance)
+        {
+            //each value has its own writer, the name table of a shared writer would make equal values differ
+            BinaryAssetWriter writer(SerializationOptions::IncludeNullOrEmptyValues);
+            ArchiveObject     object = writer.CreateObject();
+            Serialization::SerializeField(field, writer, object, instance);
+            return writer.Encode(object);
+        }
+    }
+
+    ObjectDelta::ObjectDelta(const TypeHandler* typeHandler, ConstPtr oldValue, ConstPtr newValue) : typeHandler(typeHandler)
+    {
+        if (typeHandler == nullptr || oldValue == nullptr || newValue == nullptr) return;
+
+        const SerializationPlan& plan = typeHandler->GetSerializationPlan();
+        revision = plan.revision;
+
+        for (u32 i = 0; i < plan.fields.Size(); ++i)
+        {
+            const SerializationField& field = plan.fields[i];
+
+            Array<u8> oldData = EncodeField(field, oldValue);
+            Array<u8> newData = EncodeField(field, newValue);
+
+            if (oldData.Size() != newData.Size() || memcmp(oldData.Data(), newData.Data(), oldData.Size()) != 0)
+            {
+                fields.EmplaceBack(FieldDelta{
+                    .field = i,
+                    .name = field.name,
+                    .oldData = Traits::Move(oldData),
+                    .newData = Traits::Move(newData)
+                });
+            }
+        }
+    }
+
+    void ObjectDelta::ApplyNew(VoidPtr instance) const
+    {
+        Apply(instance, true);
+    }
+
+    void ObjectDelta::ApplyOld(VoidPtr instance) const
+    {
+        Apply(instance, false);
+    }
+
+    void ObjectDelta::Apply(VoidPtr instance, bool newValue) const
+    {
+        if (typeHandler == nullptr || instance == nullptr) return;
+
+        const SerializationPlan& plan = typeHandler->GetSerializationPlan();
+
+        for (const FieldDelta& fieldDelta : fields)
+        {
+            const SerializationField* field = nullptr;
+            if (plan.revision == revision)
+            {
+                field = &plan.fields[fieldDelta.field];
+            }
+            else
+            {
+                for (const SerializationField& it : plan.fields)
+                {
+                    if (it.name == fieldDelta.name)
+                    {
+                        field = &it;
+                        break;
+                    }
+                }
+            }
+
+            if (field)
+            {
+                BinaryAssetReader reader(newValue ? fieldDelta.newData : fieldDelta.oldData);
+                Serialization::DeserializeField(*field, reader, reader.ReadObject(), instance);
+            }
+        }
+    }
+
+    bool ObjectDelta::Merge(const ObjectDelta& next)
+    {
+        if (typeHandler != next.typeHandler || revision != next.revision || fields.Size() != next.fields.Size())
+        {
+            return false;
+        }
+
+        for (usize i = 0; i < fields.Size(); ++i)
+        {
+            if (fields[i].field != next.fields[i].field)
+            {
+                return false;
+            }
+        }
+
+        //keeps the oldest value to roll back and the newest one to commit
+        for (usize i = 0; i < fields.Size(); ++i)
+        {
+            fields[i].newData = next.fields[i].newData;
+        }
+        return true;
+    }
+
+    bool ObjectDelta::Empty() const
+    {
+        return fields.Empty();
+    }
+
+    usize ObjectDelta::GetMemorySize() const
+    {
+        usize size = sizeof(ObjectDelta) + fields.Capacity() * sizeof(FieldDelta);
+        for (const FieldDelta& fieldDelta : fields)
+        {
+            size += fieldDelta.oldData.Capacity() + fieldDelta.newData.Capacity() + fieldDelta.name.Capacity();
+        }
+        return size;
+    }
+
+    Span<const FieldDelta> ObjectDelta::GetFields() const
+    {
+        return {fields.Data(), fields.Size()};
+    }
+}
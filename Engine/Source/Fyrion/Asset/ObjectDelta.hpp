@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Fyrion/Core/Array.hpp"
+#include "Fyrion/Core/Registry.hpp"
+#include "Fyrion/Core/String.hpp"
+
+namespace Fyrion
+{
+    struct FieldDelta
+    {
+        u32       field;   //index in the serialization plan
+        String    name;    //used when the plan was rebuilt
+        Array<u8> oldData; //binary archive with only this field
+        Array<u8> newData;
+    };
+
+    //binary values of the fields that differ between two instances of the same type, applied in O(changed fields).
+    class FY_API ObjectDelta
+    {
+    public:
+        ObjectDelta() = default;
+        ObjectDelta(const TypeHandler* typeHandler, ConstPtr oldValue, ConstPtr newValue);
+
+        void  ApplyNew(VoidPtr instance) const;
+        void  ApplyOld(VoidPtr instance) const;
+        bool  Merge(const ObjectDelta& next);
+        bool  Empty() const;
+        usize GetMemorySize() const;
+
+        Span<const FieldDelta> GetFields() const;
+
+    private:
+        const TypeHandler* typeHandler{};
+        u64                revision{};
+        Array<FieldDelta>  fields{};
+
+        void Apply(VoidPtr instance, bool newValue) const;
+    };
+}
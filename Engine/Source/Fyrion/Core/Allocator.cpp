@@ -1,9 +1,9 @@
 #include "Allocator.hpp"
 #include <mimalloc.h>
-#include "mimalloc/types.h"
 
 #include <cpptrace/cpptrace.hpp>
 #include <unordered_map>
+#include <atomic>
 #include <mutex>
 
 namespace Fyrion
@@ -24,6 +24,10 @@ namespace Fyrion
         std::mutex                                      traceMutex{};
         bool                                            init = Init();
 
+        //memory can be allocated on one thread and freed on another, so the stats are process-wide
+        std::atomic<i64> allocatedBytes{};
+        std::atomic<i64> freedBytes{};
+
 
         void OnExit()
         {
@@ -52,6 +56,10 @@ namespace Fyrion
     VoidPtr GeneralPurposeAllocator::MemAlloc(usize bytes, usize alignment)
     {
         VoidPtr ptr = mi_malloc_aligned(bytes, alignment);
+        if (ptr)
+        {
+            allocatedBytes.fetch_add(static_cast<i64>(mi_usable_size(ptr)), std::memory_order_relaxed);
+        }
 
         if (captureTrace)
         {
@@ -73,12 +81,22 @@ namespace Fyrion
             traceMutex.unlock();
         }
 
+        if (ptr)
+        {
+            freedBytes.fetch_add(static_cast<i64>(mi_usable_size(ptr)), std::memory_order_relaxed);
+        }
         mi_free(ptr);
     }
 
     VoidPtr GeneralPurposeAllocator::MemRealloc(VoidPtr ptr, usize newSize)
     {
-        VoidPtr newPtr = mi_realloc(ptr, newSize);
+        const usize oldSize = ptr ? mi_usable_size(ptr) : 0;
+        VoidPtr     newPtr = mi_realloc(ptr, newSize);
+        if (newPtr)
+        {
+            freedBytes.fetch_add(static_cast<i64>(oldSize), std::memory_order_relaxed);
+            allocatedBytes.fetch_add(static_cast<i64>(mi_usable_size(newPtr)), std::memory_order_relaxed);
+        }
         if (captureTrace)
         {
             usize ptrAddress = reinterpret_cast<usize>(newPtr);
@@ -128,10 +146,9 @@ namespace Fyrion
 
     HeapStats MemoryGlobals::GetHeapStats()
     {
-        mi_heap_t* heap = mi_heap_get_default();
         return HeapStats{
-            .totalAllocated = heap->tld->stats.normal.allocated + heap->tld->stats.large.allocated + heap->tld->stats.huge.allocated,
-            .totalFreed = heap->tld->stats.normal.freed + heap->tld->stats.large.freed + heap->tld->stats.huge.freed,
+            .totalAllocated = allocatedBytes.load(std::memory_order_relaxed),
+            .totalFreed = freedBytes.load(std::memory_order_relaxed),
         };
     }
 }
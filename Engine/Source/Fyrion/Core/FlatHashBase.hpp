@@ -0,0 +1,602 @@
+#pragma once
+
+#include <bit>
+#include <cstring>
+
+#include "Fyrion/Common.hpp"
+#include "Algorithm.hpp"
+#include "Allocator.hpp"
+#include "Hash.hpp"
+#include "Pair.hpp"
+#include "Traits.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FY_FLAT_HASH_SSE2 1
+#include <emmintrin.h>
+#endif
+
+//open addressing table based on the swiss table layout (https://abseil.io/about/design/swisstables)
+//each slot has a control byte: empty, deleted or the 7 lower bits of the hash (H2) when full.
+//lookups compare H2 against a whole group of control bytes at once and only touch the matching slots.
+
+namespace Fyrion
+{
+    namespace FlatHash
+    {
+        constexpr i8    Empty = -128;
+        constexpr i8    Deleted = -2;
+        constexpr usize GroupWidth = 16;
+        constexpr usize MinCapacity = 16;
+
+        //the engine hashes are not guaranteed to spread the bits used for H1 and H2, so they are mixed again.
+        FY_FINLINE usize Mix(usize hash)
+        {
+            u64 value = static_cast<u64>(hash) * FY_UINT64_C(0x9E3779B97F4A7C15);
+            return static_cast<usize>(value ^ (value >> 32));
+        }
+
+        FY_FINLINE usize H1(usize hash)
+        {
+            return hash >> 7;
+        }
+
+        FY_FINLINE i8 H2(usize hash)
+        {
+            return static_cast<i8>(hash & 0x7F);
+        }
+
+        FY_FINLINE bool IsFull(i8 ctrl)
+        {
+            return ctrl >= 0;
+        }
+
+        FY_FINLINE usize MaxLoad(usize capacity)
+        {
+            return capacity - capacity / 8;
+        }
+
+        struct Group
+        {
+#if FY_FLAT_HASH_SSE2
+            __m128i ctrl;
+
+            explicit Group(const i8* pos) : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos))) {}
+
+            u32 Match(i8 h2) const
+            {
+                return static_cast<u32>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl)));
+            }
+
+            u32 MatchEmptyOrDeleted() const
+            {
+                return static_cast<u32>(_mm_movemask_epi8(ctrl));
+            }
+#else
+            const i8* ctrl;
+
+            explicit Group(const i8* pos) : ctrl(pos) {}
+
+            u32 Match(i8 h2) const
+            {
+                u32 mask = 0;
+                for (u32 i = 0; i < GroupWidth; ++i)
+                {
+                    mask |= static_cast<u32>(ctrl[i] == h2) << i;
+                }
+                return mask;
+            }
+
+            u32 MatchEmptyOrDeleted() const
+            {
+                u32 mask = 0;
+                for (u32 i = 0; i < GroupWidth; ++i)
+                {
+                    mask |= static_cast<u32>(ctrl[i] < 0) << i;
+                }
+                return mask;
+            }
+#endif
+            u32 MatchEmpty() const
+            {
+                return Match(Empty);
+            }
+        };
+    }
+
+    template<typename Key>
+    struct FlatHashSetEntry
+    {
+        Key first;
+    };
+
+    template<typename T>
+    struct FlatHashIterator
+    {
+        const i8* ctrl{};
+        const i8* ctrlEnd{};
+        T*        slot{};
+
+        FlatHashIterator() = default;
+
+        FlatHashIterator(const i8* ctrl, const i8* ctrlEnd, T* slot) : ctrl(ctrl), ctrlEnd(ctrlEnd), slot(slot) {}
+
+        operator FlatHashIterator<const T>() const
+        {
+            return {ctrl, ctrlEnd, slot};
+        }
+
+        T* operator->() const
+        {
+            return slot;
+        }
+
+        T& operator*() const
+        {
+            return *slot;
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return slot != nullptr;
+        }
+
+        FlatHashIterator& operator++()
+        {
+            ++ctrl;
+            ++slot;
+            SkipEmpty();
+            return *this;
+        }
+
+        void SkipEmpty()
+        {
+            while (ctrl != ctrlEnd && !FlatHash::IsFull(*ctrl))
+            {
+                ++ctrl;
+                ++slot;
+            }
+
+            if (ctrl == ctrlEnd)
+            {
+                slot = nullptr;
+            }
+        }
+
+        bool operator==(const FlatHashIterator& other) const
+        {
+            return slot == other.slot;
+        }
+
+        bool operator!=(const FlatHashIterator& other) const
+        {
+            return slot != other.slot;
+        }
+    };
+
+    template<typename Key, typename Entry>
+    class FlatHashTable
+    {
+    public:
+        typedef Entry                         ValueType;
+        typedef Entry                         Node;
+        typedef FlatHashIterator<Entry>       Iterator;
+        typedef FlatHashIterator<const Entry> ConstIterator;
+
+        FlatHashTable() = default;
+        FlatHashTable(const FlatHashTable& other);
+        FlatHashTable(FlatHashTable&& other) noexcept;
+        FlatHashTable& operator=(const FlatHashTable& other);
+        FlatHashTable& operator=(FlatHashTable&& other) noexcept;
+
+        Iterator      begin();
+        Iterator      end();
+        ConstIterator begin() const;
+        ConstIterator end() const;
+
+        void  Clear();
+        bool  Empty() const;
+        usize Size() const;
+        usize Capacity() const;
+        void  Reserve(usize size);
+
+        template<typename ParamKey>
+        Iterator Find(const ParamKey& key);
+
+        template<typename ParamKey>
+        ConstIterator Find(const ParamKey& key) const;
+
+        template<typename ParamKey>
+        bool Has(const ParamKey& key) const;
+
+        void Erase(ConstIterator where);
+        void Erase(Iterator where);
+
+        template<typename ParamKey>
+        void Erase(const ParamKey& key);
+
+        void Swap(FlatHashTable& other);
+
+        ~FlatHashTable();
+
+    protected:
+        template<typename ParamKey>
+        usize FindIndex(const ParamKey& key) const;
+
+        //returns the slot index of the key and true if the slot was reserved and must be constructed by the caller
+        Pair<usize, bool> FindOrPrepareInsert(const Key& key);
+
+        Iterator MakeIterator(usize index);
+
+    private:
+        usize FindFirstNonFull(usize hash) const;
+        void  SetCtrl(usize index, i8 value);
+        void  Resize(usize newCapacity);
+        void  Destroy();
+
+        Entry*     m_slots{};
+        i8*        m_ctrl{};
+        usize      m_capacity{};
+        usize      m_size{};
+        usize      m_growthLeft{};
+        Allocator& m_allocator = MemoryGlobals::GetDefaultAllocator();
+    };
+
+    template<typename Key, typename Entry>
+    FlatHashTable<Key, Entry>::FlatHashTable(const FlatHashTable& other)
+    {
+        if (other.m_size == 0) return;
+
+        Resize(other.m_capacity);
+
+        //same capacity, so the entries keep their positions
+        MemCopy(m_ctrl, other.m_ctrl, m_capacity + FlatHash::GroupWidth);
+        for (usize i = 0; i < m_capacity; ++i)
+        {
+            if (FlatHash::IsFull(m_ctrl[i]))
+            {
+                new(PlaceHolder(), m_slots + i) Entry(other.m_slots[i]);
+            }
+        }
+        m_size = other.m_size;
+        m_growthLeft = other.m_growthLeft;
+    }
+
+    template<typename Key, typename Entry>
+    FlatHashTable<Key, Entry>::FlatHashTable(FlatHashTable&& other) noexcept
+    {
+        Swap(other);
+    }
+
+    template<typename Key, typename Entry>
+    FlatHashTable<Key, Entry>& FlatHashTable<Key, Entry>::operator=(const FlatHashTable& other)
+    {
+        if (this != &other)
+        {
+            FlatHashTable(other).Swap(*this);
+        }
+        return *this;
+    }
+
+    template<typename Key, typename Entry>
+    FlatHashTable<Key, Entry>& FlatHashTable<Key, Entry>::operator=(FlatHashTable&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Destroy();
+            Swap(other);
+        }
+        return *this;
+    }
+
+    template<typename Key, typename Entry>
+    FY_FINLINE typename FlatHashTable<Key, Entry>::Iterator FlatHashTable<Key, Entry>::begin()
+    {
+        if (m_size == 0) return {};
+        Iterator it{m_ctrl, m_ctrl + m_capacity, m_slots};
+        it.SkipEmpty();
+        return it;
+    }
+
+    template<typename Key, typename Entry>
+    FY_FINLINE typename FlatHashTable<Key, Entry>::Iterator FlatHashTable<Key, Entry>::end()
+    {
+        return {};
+    }
+
+    template<typename Key, typename Entry>
+    FY_FINLINE typename FlatHashTable<Key, Entry>::ConstIterator FlatHashTable<Key, Entry>::begin() const
+    {
+        return const_cast<FlatHashTable*>(this)->begin();
+    }
+
+    template<typename Key, typename Entry>
+    FY_FINLINE typename FlatHashTable<Key, Entry>::ConstIterator FlatHashTable<Key, Entry>::end() const
+    {
+        return {};
+    }
+
+    template<typename Key, typename Entry>
+    void FlatHashTable<Key, Entry>::Clear()
+    {
+        if (m_capacity == 0) return;
+
+        for (usize i = 0; i < m_capacity; ++i)
+        {
+            if (FlatHash::IsFull(m_ctrl[i]))
+            {
+                m_slots[i].~Entry();
+            }
+        }
+
+        //the memory is kept, tables are usually filled again with a similar amount of entries
+        memset(m_ctrl, FlatHash::Empty, m_capacity + FlatHash::GroupWidth);
+        m_size = 0;
+        m_growthLeft = FlatHash::MaxLoad(m_capacity);
+    }
+
+    template<typename Key, typename Entry>
+    FY_FINLINE bool FlatHashTable<Key, Entry>::Empty() const
+    {
+        return m_size == 0;
+    }
+
+    template<typename Key, typename Entry>
+    FY_FINLINE usize FlatHashTable<Key, Entry>::Size() const
+    {
+        return m_size;
+    }
+
+    template<typename Key, typename Entry>
+    FY_FINLINE usize FlatHashTable<Key, Entry>::Capacity() const
+    {
+        return m_capacity;
+    }
+
+    template<typename Key, typename Entry>
+    void FlatHashTable<Key, Entry>::Reserve(usize size)
+    {
+        usize capacity = FlatHash::MinCapacity;
+        while (FlatHash::MaxLoad(capacity) < size)
+        {
+            capacity *= 2;
+        }
+
+        if (capacity > m_capacity)
+        {
+            Resize(capacity);
+        }
+    }
+
+    template<typename Key, typename Entry>
+    template<typename ParamKey>
+    FY_FINLINE typename FlatHashTable<Key, Entry>::Iterator FlatHashTable<Key, Entry>::Find(const ParamKey& key)
+    {
+        usize index = FindIndex(key);
+        return index != nPos ? MakeIterator(index) : Iterator{};
+    }
+
+    template<typename Key, typename Entry>
+    template<typename ParamKey>
+    FY_FINLINE typename FlatHashTable<Key, Entry>::ConstIterator FlatHashTable<Key, Entry>::Find(const ParamKey& key) const
+    {
+        return const_cast<FlatHashTable*>(this)->Find(key);
+    }
+
+    template<typename Key, typename Entry>
+    template<typename ParamKey>
+    FY_FINLINE bool FlatHashTable<Key, Entry>::Has(const ParamKey& key) const
+    {
+        return FindIndex(key) != nPos;
+    }
+
+    template<typename Key, typename Entry>
+    void FlatHashTable<Key, Entry>::Erase(ConstIterator where)
+    {
+        const usize index = where.slot - m_slots;
+        m_slots[index].~Entry();
+        SetCtrl(index, FlatHash::Deleted);
+        --m_size;
+    }
+
+    template<typename Key, typename Entry>
+    FY_FINLINE void FlatHashTable<Key, Entry>::Erase(Iterator where)
+    {
+        Erase(ConstIterator(where));
+    }
+
+    template<typename Key, typename Entry>
+    template<typename ParamKey>
+    void FlatHashTable<Key, Entry>::Erase(const ParamKey& key)
+    {
+        usize index = FindIndex(key);
+        if (index != nPos)
+        {
+            Erase(MakeIterator(index));
+        }
+    }
+
+    template<typename Key, typename Entry>
+    void FlatHashTable<Key, Entry>::Swap(FlatHashTable& other)
+    {
+        Entry* slots = m_slots;
+        m_slots = other.m_slots;
+        other.m_slots = slots;
+
+        i8* ctrl = m_ctrl;
+        m_ctrl = other.m_ctrl;
+        other.m_ctrl = ctrl;
+
+        usize capacity = m_capacity;
+        m_capacity = other.m_capacity;
+        other.m_capacity = capacity;
+
+        usize size = m_size;
+        m_size = other.m_size;
+        other.m_size = size;
+
+        usize growthLeft = m_growthLeft;
+        m_growthLeft = other.m_growthLeft;
+        other.m_growthLeft = growthLeft;
+    }
+
+    template<typename Key, typename Entry>
+    template<typename ParamKey>
+    usize FlatHashTable<Key, Entry>::FindIndex(const ParamKey& key) const
+    {
+        if (m_capacity == 0) return nPos;
+
+        const usize hash = FlatHash::Mix(Hash<Key>::Value(key));
+        const i8    h2 = FlatHash::H2(hash);
+        const usize mask = m_capacity - 1;
+
+        usize pos = FlatHash::H1(hash) & mask;
+        usize step = 0;
+
+        while (true)
+        {
+            FlatHash::Group group(m_ctrl + pos);
+            for (u32 match = group.Match(h2); match != 0; match &= match - 1)
+            {
+                const usize index = (pos + std::countr_zero(match)) & mask;
+                if (m_slots[index].first == key)
+                {
+                    return index;
+                }
+            }
+
+            if (group.MatchEmpty() != 0)
+            {
+                return nPos;
+            }
+
+            step += FlatHash::GroupWidth;
+            pos = (pos + step) & mask;
+        }
+    }
+
+    template<typename Key, typename Entry>
+    Pair<usize, bool> FlatHashTable<Key, Entry>::FindOrPrepareInsert(const Key& key)
+    {
+        usize index = FindIndex(key);
+        if (index != nPos)
+        {
+            return {index, false};
+        }
+
+        if (m_growthLeft == 0)
+        {
+            if (m_capacity == 0)
+            {
+                Resize(FlatHash::MinCapacity);
+            }
+            else if (m_size <= FlatHash::MaxLoad(m_capacity) / 2)
+            {
+                //mostly tombstones, rehash in place
+                Resize(m_capacity);
+            }
+            else
+            {
+                Resize(m_capacity * 2);
+            }
+        }
+
+        const usize hash = FlatHash::Mix(Hash<Key>::Value(key));
+        index = FindFirstNonFull(hash);
+        if (m_ctrl[index] == FlatHash::Empty)
+        {
+            --m_growthLeft;
+        }
+        SetCtrl(index, FlatHash::H2(hash));
+        ++m_size;
+        return {index, true};
+    }
+
+    template<typename Key, typename Entry>
+    FY_FINLINE typename FlatHashTable<Key, Entry>::Iterator FlatHashTable<Key, Entry>::MakeIterator(usize index)
+    {
+        return {m_ctrl + index, m_ctrl + m_capacity, m_slots + index};
+    }
+
+    template<typename Key, typename Entry>
+    usize FlatHashTable<Key, Entry>::FindFirstNonFull(usize hash) const
+    {
+        const usize mask = m_capacity - 1;
+
+        usize pos = FlatHash::H1(hash) & mask;
+        usize step = 0;
+
+        while (true)
+        {
+            if (u32 match = FlatHash::Group(m_ctrl + pos).MatchEmptyOrDeleted())
+            {
+                return (pos + std::countr_zero(match)) & mask;
+            }
+            step += FlatHash::GroupWidth;
+            pos = (pos + step) & mask;
+        }
+    }
+
+    template<typename Key, typename Entry>
+    FY_FINLINE void FlatHashTable<Key, Entry>::SetCtrl(usize index, i8 value)
+    {
+        m_ctrl[index] = value;
+
+        //the first group is mirrored after the last slot, so groups can be loaded from any position
+        if (index < FlatHash::GroupWidth)
+        {
+            m_ctrl[m_capacity + index] = value;
+        }
+    }
+
+    template<typename Key, typename Entry>
+    void FlatHashTable<Key, Entry>::Resize(usize newCapacity)
+    {
+        Entry*      oldSlots = m_slots;
+        i8*         oldCtrl = m_ctrl;
+        const usize oldCapacity = m_capacity;
+
+        m_slots = static_cast<Entry*>(m_allocator.MemAlloc(newCapacity * sizeof(Entry) + newCapacity + FlatHash::GroupWidth, alignof(Entry)));
+        m_ctrl = reinterpret_cast<i8*>(m_slots + newCapacity);
+        m_capacity = newCapacity;
+        memset(m_ctrl, FlatHash::Empty, newCapacity + FlatHash::GroupWidth);
+
+        for (usize i = 0; i < oldCapacity; ++i)
+        {
+            if (FlatHash::IsFull(oldCtrl[i]))
+            {
+                const usize hash = FlatHash::Mix(Hash<Key>::Value(oldSlots[i].first));
+                const usize index = FindFirstNonFull(hash);
+                SetCtrl(index, FlatHash::H2(hash));
+                new(PlaceHolder(), m_slots + index) Entry(Traits::Move(oldSlots[i]));
+                oldSlots[i].~Entry();
+            }
+        }
+
+        m_growthLeft = FlatHash::MaxLoad(m_capacity) - m_size;
+
+        if (oldSlots)
+        {
+            m_allocator.MemFree(oldSlots);
+        }
+    }
+
+    template<typename Key, typename Entry>
+    void FlatHashTable<Key, Entry>::Destroy()
+    {
+        if (m_capacity == 0) return;
+
+        Clear();
+        m_allocator.MemFree(m_slots);
+
+        m_slots = nullptr;
+        m_ctrl = nullptr;
+        m_capacity = 0;
+        m_growthLeft = 0;
+    }
+
+    template<typename Key, typename Entry>
+    FlatHashTable<Key, Entry>::~FlatHashTable()
+    {
+        Destroy();
+    }
+}
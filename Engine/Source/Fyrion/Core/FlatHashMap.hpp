@@ -0,0 +1,72 @@
+#pragma once
+
+#include "FlatHashBase.hpp"
+
+namespace Fyrion
+{
+    //same interface as HashMap, but entries are stored inline in a single allocation.
+    //pointers and iterators are invalidated when the map grows.
+    template<typename Key, typename Value>
+    class FlatHashMap : public FlatHashTable<Key, Pair<Key, Value>>
+    {
+    public:
+        typedef FlatHashTable<Key, Pair<Key, Value>> Base;
+        typedef typename Base::Iterator              Iterator;
+        typedef typename Base::ConstIterator         ConstIterator;
+
+        Value& operator[](const Key& key);
+
+        Pair<Iterator, bool> Insert(const Pair<Key, Value>& p);
+        Pair<Iterator, bool> Insert(const Key& key, const Value& value);
+
+        Pair<Iterator, bool> Emplace(const Key& key, Value&& value);
+    };
+
+    template<typename Key, typename Value>
+    FY_FINLINE Value& FlatHashMap<Key, Value>::operator[](const Key& key)
+    {
+        Pair<usize, bool> result = this->FindOrPrepareInsert(key);
+        Iterator          it = this->MakeIterator(result.first);
+        if (result.second)
+        {
+            new(PlaceHolder(), it.slot) Pair<Key, Value>(key, Value());
+        }
+        return it->second;
+    }
+
+    template<typename Key, typename Value>
+    FY_FINLINE Pair<typename FlatHashMap<Key, Value>::Iterator, bool> FlatHashMap<Key, Value>::Insert(const Pair<Key, Value>& p)
+    {
+        Pair<usize, bool> result = this->FindOrPrepareInsert(p.first);
+        Iterator          it = this->MakeIterator(result.first);
+        if (result.second)
+        {
+            new(PlaceHolder(), it.slot) Pair<Key, Value>(p);
+        }
+        return {it, result.second};
+    }
+
+    template<typename Key, typename Value>
+    FY_FINLINE Pair<typename FlatHashMap<Key, Value>::Iterator, bool> FlatHashMap<Key, Value>::Insert(const Key& key, const Value& value)
+    {
+        Pair<usize, bool> result = this->FindOrPrepareInsert(key);
+        Iterator          it = this->MakeIterator(result.first);
+        if (result.second)
+        {
+            new(PlaceHolder(), it.slot) Pair<Key, Value>(key, value);
+        }
+        return {it, result.second};
+    }
+
+    template<typename Key, typename Value>
+    FY_FINLINE Pair<typename FlatHashMap<Key, Value>::Iterator, bool> FlatHashMap<Key, Value>::Emplace(const Key& key, Value&& value)
+    {
+        Pair<usize, bool> result = this->FindOrPrepareInsert(key);
+        Iterator          it = this->MakeIterator(result.first);
+        if (result.second)
+        {
+            new(PlaceHolder(), it.slot) Pair<Key, Value>(Key(key), Traits::Forward<Value>(value));
+        }
+        return {it, result.second};
+    }
+}
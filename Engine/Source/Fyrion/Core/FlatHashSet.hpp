@@ -0,0 +1,37 @@
+#pragma once
+
+#include "FlatHashBase.hpp"
+
+namespace Fyrion
+{
+    //same interface as HashSet, keys are stored inline in a single allocation.
+    template<typename Key>
+    class FlatHashSet : public FlatHashTable<Key, FlatHashSetEntry<Key>>
+    {
+    public:
+        typedef FlatHashTable<Key, FlatHashSetEntry<Key>> Base;
+        typedef typename Base::Iterator                   Iterator;
+        typedef typename Base::ConstIterator              ConstIterator;
+
+        Pair<Iterator, bool> Insert(const Key& key);
+        Pair<Iterator, bool> Emplace(const Key& key);
+    };
+
+    template<typename Key>
+    FY_FINLINE Pair<typename FlatHashSet<Key>::Iterator, bool> FlatHashSet<Key>::Insert(const Key& key)
+    {
+        Pair<usize, bool> result = this->FindOrPrepareInsert(key);
+        Iterator          it = this->MakeIterator(result.first);
+        if (result.second)
+        {
+            new(PlaceHolder(), it.slot) FlatHashSetEntry<Key>{key};
+        }
+        return {it, result.second};
+    }
+
+    template<typename Key>
+    FY_FINLINE Pair<typename FlatHashSet<Key>::Iterator, bool> FlatHashSet<Key>::Emplace(const Key& key)
+    {
+        return Insert(key);
+    }
+}
@@ -0,0 +1,462 @@
+#include "JobSystem.hpp"
+
+#include <condition_variable>
+#include <thread>
+
+#include "Allocator.hpp"
+#include "Logger.hpp"
+#include "Math.hpp"
+
+namespace Fyrion
+{
+    namespace
+    {
+        Logger& logger = Logger::GetLogger("Fyrion::JobSystem");
+
+        //Chase-Lev work stealing deque, only the owner thread can push and pop, any thread can steal.
+        class JobDeque
+        {
+        public:
+            static constexpr i64 Capacity = 4096;
+            static constexpr i64 Mask = Capacity - 1;
+
+            bool Push(Job* job)
+            {
+                i64 b = bottom.load(std::memory_order_relaxed);
+                i64 t = top.load(std::memory_order_acquire);
+                if (b - t >= Capacity)
+                {
+                    return false;
+                }
+                buffer[b & Mask].store(job, std::memory_order_release);
+                std::atomic_thread_fence(std::memory_order_release);
+                bottom.store(b + 1, std::memory_order_relaxed);
+                return true;
+            }
+
+            Job* Pop()
+            {
+                i64 b = bottom.load(std::memory_order_relaxed) - 1;
+                bottom.store(b, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                i64 t = top.load(std::memory_order_relaxed);
+
+                if (t > b)
+                {
+                    bottom.store(b + 1, std::memory_order_relaxed);
+                    return nullptr;
+                }
+
+                Job* job = buffer[b & Mask].load(std::memory_order_relaxed);
+                if (t == b)
+                {
+                    //last element, race against stealers
+                    if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                    {
+                        job = nullptr;
+                    }
+                    bottom.store(b + 1, std::memory_order_relaxed);
+                }
+                return job;
+            }
+
+            Job* Steal()
+            {
+                i64 t = top.load(std::memory_order_acquire);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                i64 b = bottom.load(std::memory_order_acquire);
+
+                if (t >= b)
+                {
+                    return nullptr;
+                }
+
+                Job* job = buffer[t & Mask].load(std::memory_order_acquire);
+                if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                {
+                    return nullptr;
+                }
+                return job;
+            }
+
+        private:
+            alignas(64) std::atomic<i64> top{0};
+            alignas(64) std::atomic<i64> bottom{0};
+            std::atomic<Job*>            buffer[Capacity]{};
+        };
+
+        struct Worker
+        {
+            JobDeque    deque{};
+            std::thread thread{};
+        };
+
+        Array<Worker*> workers{};
+
+        //jobs pushed from threads that aren't workers
+        std::mutex globalQueueMutex{};
+        Array<Job*> globalQueue{};
+
+        std::mutex              sleepMutex{};
+        std::condition_variable sleepCondition{};
+        std::atomic<u32>        sleepingWorkers{0};
+        std::atomic<u64>        queuedJobs{0};
+        std::atomic<bool>       running{false};
+
+        thread_local i32 currentWorkerIndex = -1;
+        thread_local u32 stealSeed = 0;
+    }
+
+    struct JobSystemInternal
+    {
+        static void Notify()
+        {
+            if (sleepingWorkers.load() > 0)
+            {
+                {
+                    std::lock_guard lock(sleepMutex);
+                }
+                sleepCondition.notify_one();
+            }
+        }
+
+        static void Push(Job* job)
+        {
+            queuedJobs.fetch_add(1);
+
+            if (currentWorkerIndex < 0 || !workers[currentWorkerIndex]->deque.Push(job))
+            {
+                std::lock_guard lock(globalQueueMutex);
+                globalQueue.EmplaceBack(job);
+            }
+
+            Notify();
+        }
+
+        static Job* PopGlobal()
+        {
+            std::lock_guard lock(globalQueueMutex);
+            if (globalQueue.Empty())
+            {
+                return nullptr;
+            }
+            Job* job = globalQueue.Back();
+            globalQueue.PopBack();
+            return job;
+        }
+
+        static Job* FindJob()
+        {
+            if (queuedJobs.load(std::memory_order_relaxed) == 0)
+            {
+                return nullptr;
+            }
+
+            if (currentWorkerIndex >= 0)
+            {
+                if (Job* job = workers[currentWorkerIndex]->deque.Pop())
+                {
+                    return job;
+                }
+            }
+
+            if (Job* job = PopGlobal())
+            {
+                return job;
+            }
+
+            u32 workerCount = workers.Size();
+            stealSeed = stealSeed * 1664525u + 1013904223u;
+            u32 start = stealSeed % workerCount;
+
+            for (u32 i = 0; i < workerCount; ++i)
+            {
+                u32 victim = (start + i) % workerCount;
+                if (static_cast<i32>(victim) == currentWorkerIndex) continue;
+
+                if (Job* job = workers[victim]->deque.Steal())
+                {
+                    return job;
+                }
+            }
+
+            return nullptr;
+        }
+
+        static void Finish(JobCounter* counter)
+        {
+            if (counter == nullptr)
+            {
+                return;
+            }
+
+            Array<Job> continuations{};
+            {
+                //the lock keeps the counter alive until the last decrement releases it.
+                std::lock_guard lock(counter->continuationMutex);
+                if (counter->pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    continuations.Swap(counter->continuations);
+                }
+            }
+
+            for (const Job& job : continuations)
+            {
+                Schedule(job.function, job.userData, job.counter);
+            }
+        }
+
+        static void Execute(Job* job)
+        {
+            queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+
+            JobCounter* counter = job->counter;
+            job->function(job->userData);
+            MemoryGlobals::GetDefaultAllocator().DestroyAndFree(job);
+
+            Finish(counter);
+        }
+
+        static void Schedule(FnJob function, VoidPtr userData, JobCounter* counter)
+        {
+            if (!running)
+            {
+                function(userData);
+                Finish(counter);
+                return;
+            }
+            Push(MemoryGlobals::GetDefaultAllocator().Alloc<Job>(function, userData, counter));
+        }
+
+        //the last Finish call still holds the lock after the counter reaches zero
+        static void WaitRelease(JobCounter& counter)
+        {
+            std::lock_guard lock(counter.continuationMutex);
+        }
+
+        static void Increment(JobCounter* counter, u32 count)
+        {
+            if (counter)
+            {
+                counter->pending.fetch_add(count, std::memory_order_acq_rel);
+            }
+        }
+
+        static void AddContinuations(JobCounter& dependency, Span<JobDecl> jobs, JobCounter* counter)
+        {
+            {
+                std::lock_guard lock(dependency.continuationMutex);
+                if (dependency.pending.load(std::memory_order_acquire) > 0)
+                {
+                    for (const JobDecl& job : jobs)
+                    {
+                        dependency.continuations.EmplaceBack(job.function, job.userData, counter);
+                    }
+                    return;
+                }
+            }
+
+            for (const JobDecl& job : jobs)
+            {
+                Schedule(job.function, job.userData, counter);
+            }
+        }
+
+        static void WorkerLoop(i32 index)
+        {
+            currentWorkerIndex = index;
+            stealSeed = static_cast<u32>(index) * 2654435761u;
+
+            while (true)
+            {
+                if (Job* job = FindJob())
+                {
+                    Execute(job);
+                    continue;
+                }
+
+                if (!running && queuedJobs.load() == 0)
+                {
+                    break;
+                }
+
+                std::unique_lock lock(sleepMutex);
+                sleepingWorkers.fetch_add(1);
+                sleepCondition.wait(lock, []
+                {
+                    return queuedJobs.load() > 0 || !running;
+                });
+                sleepingWorkers.fetch_sub(1);
+            }
+        }
+    };
+
+    void JobSystem::Run(FnJob function, VoidPtr userData, JobCounter* counter)
+    {
+        JobSystemInternal::Increment(counter, 1);
+        JobSystemInternal::Schedule(function, userData, counter);
+    }
+
+    void JobSystem::Run(Span<JobDecl> jobs, JobCounter* counter)
+    {
+        JobSystemInternal::Increment(counter, jobs.Size());
+        for (const JobDecl& job : jobs)
+        {
+            JobSystemInternal::Schedule(job.function, job.userData, counter);
+        }
+    }
+
+    void JobSystem::RunAfter(JobCounter& dependency, Span<JobDecl> jobs, JobCounter* counter)
+    {
+        JobSystemInternal::Increment(counter, jobs.Size());
+        JobSystemInternal::AddContinuations(dependency, jobs, counter);
+    }
+
+    void JobSystem::Wait(JobCounter& counter)
+    {
+        while (!counter.IsDone())
+        {
+            if (Job* job = JobSystemInternal::FindJob())
+            {
+                JobSystemInternal::Execute(job);
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        JobSystemInternal::WaitRelease(counter);
+    }
+
+    bool JobSystem::IsRunning()
+    {
+        return running;
+    }
+
+    u32 JobSystem::GetWorkerCount()
+    {
+        return workers.Size();
+    }
+
+    i32 JobSystem::GetCurrentWorkerIndex()
+    {
+        return currentWorkerIndex;
+    }
+
+    void JobSystem::ParallelFor(usize count, usize batchSize, VoidPtr userData, FnParallelRange function)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        if (batchSize == 0)
+        {
+            usize workerCount = workers.Empty() ? 1 : workers.Size();
+            batchSize = Math::Max((count + workerCount * 4 - 1) / (workerCount * 4), static_cast<usize>(1));
+        }
+
+        if (!running || count <= batchSize)
+        {
+            function(userData, 0, count);
+            return;
+        }
+
+        struct Batch
+        {
+            FnParallelRange function;
+            VoidPtr         userData;
+            usize           begin;
+            usize           end;
+        };
+
+        usize batchCount = (count + batchSize - 1) / batchSize;
+
+        Array<Batch>   batches{};
+        Array<JobDecl> jobs{};
+        batches.Resize(batchCount);
+        jobs.Resize(batchCount);
+
+        for (usize i = 0; i < batchCount; ++i)
+        {
+            batches[i] = Batch{
+                .function = function,
+                .userData = userData,
+                .begin = i * batchSize,
+                .end = Math::Min((i + 1) * batchSize, count)
+            };
+
+            jobs[i] = JobDecl{
+                .function = [](VoidPtr userData)
+                {
+                    Batch* batch = static_cast<Batch*>(userData);
+                    batch->function(batch->userData, batch->begin, batch->end);
+                },
+                .userData = &batches[i]
+            };
+        }
+
+        JobCounter counter{};
+        Run(jobs, &counter);
+        Wait(counter);
+    }
+
+    void JobSystemInit()
+    {
+        u32 workerCount = Math::Max(std::thread::hardware_concurrency(), 2u);
+
+        running = true;
+
+        //worker 0 is the thread that initialized the job system, it executes jobs while waiting on counters.
+        currentWorkerIndex = 0;
+        workers.Reserve(workerCount);
+
+        for (u32 i = 0; i < workerCount; ++i)
+        {
+            workers.EmplaceBack(MemoryGlobals::GetDefaultAllocator().Alloc<Worker>());
+        }
+
+        for (u32 i = 1; i < workerCount; ++i)
+        {
+            workers[i]->thread = std::thread(JobSystemInternal::WorkerLoop, static_cast<i32>(i));
+        }
+
+        logger.Debug("JobSystem started with {} workers", workerCount);
+    }
+
+    void JobSystemShutdown()
+    {
+        if (!running)
+        {
+            return;
+        }
+
+        //drain the main thread queue before stopping the workers
+        while (Job* job = JobSystemInternal::FindJob())
+        {
+            JobSystemInternal::Execute(job);
+        }
+
+        {
+            std::lock_guard lock(sleepMutex);
+            running = false;
+        }
+        sleepCondition.notify_all();
+
+        for (Worker* worker : workers)
+        {
+            if (worker->thread.joinable())
+            {
+                worker->thread.join();
+            }
+            MemoryGlobals::GetDefaultAllocator().DestroyAndFree(worker);
+        }
+
+        workers.Clear();
+        workers.ShrinkToFit();
+        globalQueue.Clear();
+        globalQueue.ShrinkToFit();
+        currentWorkerIndex = -1;
+    }
+}
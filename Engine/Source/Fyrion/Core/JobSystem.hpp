@@ -0,0 +1,106 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+
+#include "Fyrion/Common.hpp"
+#include "Array.hpp"
+#include "Span.hpp"
+#include "Traits.hpp"
+
+namespace Fyrion
+{
+    typedef void (*FnJob)(VoidPtr userData);
+
+    struct JobDecl
+    {
+        FnJob   function{};
+        VoidPtr userData{};
+    };
+
+    struct Job
+    {
+        FnJob              function{};
+        VoidPtr            userData{};
+        struct JobCounter* counter{};
+    };
+
+    struct FY_API JobCounter
+    {
+        FY_NO_COPY_CONSTRUCTOR(JobCounter);
+
+        JobCounter() = default;
+
+        bool IsDone() const
+        {
+            return pending.load(std::memory_order_acquire) == 0;
+        }
+
+        u32 Pending() const
+        {
+            return pending.load(std::memory_order_acquire);
+        }
+
+    private:
+        std::atomic<u32> pending{0};
+        std::mutex       continuationMutex{};
+        Array<Job>       continuations{};
+
+        friend struct JobSystemInternal;
+    };
+
+    namespace JobSystem
+    {
+        //jobs are executed inline if the job system is not running.
+        FY_API void Run(FnJob function, VoidPtr userData, JobCounter* counter = nullptr);
+        FY_API void Run(Span<JobDecl> jobs, JobCounter* counter = nullptr);
+
+        //schedule the jobs only after all jobs tracked by dependency are finished
+        FY_API void RunAfter(JobCounter& dependency, Span<JobDecl> jobs, JobCounter* counter = nullptr);
+
+        //the calling thread executes other jobs while waiting.
+        FY_API void Wait(JobCounter& counter);
+
+        FY_API bool IsRunning();
+        FY_API u32  GetWorkerCount();
+        FY_API i32  GetCurrentWorkerIndex();
+
+        typedef void (*FnParallelRange)(VoidPtr userData, usize begin, usize end);
+
+        FY_API void ParallelFor(usize count, usize batchSize, VoidPtr userData, FnParallelRange function);
+
+        template <typename Func>
+        void ParallelFor(usize count, Func&& func, usize batchSize = 0)
+        {
+            ParallelFor(count, batchSize, &func, [](VoidPtr userData, usize begin, usize end)
+            {
+                auto& func = *static_cast<Traits::RemoveReference<Func>*>(userData);
+                for (usize i = begin; i < end; ++i)
+                {
+                    func(i);
+                }
+            });
+        }
+
+        template <typename T, typename Func>
+        void ParallelFor(Span<T> items, Func&& func, usize batchSize = 0)
+        {
+            struct Data
+            {
+                Span<T>                         items;
+                Traits::RemoveReference<Func>& func;
+            };
+
+            Data data{items, func};
+
+            ParallelFor(items.Size(), batchSize, &data, [](VoidPtr userData, usize begin, usize end)
+            {
+                Data& data = *static_cast<Data*>(userData);
+                for (usize i = begin; i < end; ++i)
+                {
+                    data.func(data.items[i]);
+                }
+            });
+        }
+    }
+}
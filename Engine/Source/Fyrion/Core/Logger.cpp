@@ -5,6 +5,10 @@
 
 #include <chrono>
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 namespace Fyrion
 {
@@ -12,11 +16,43 @@ namespace Fyrion
     {
         const char* levelDesc[] = {"Trace", "Debug", "Info", "Warn", "Error", "Critical", "Off"};
 
+        struct LogRecord
+        {
+            Logger*           logger{};
+            LogLevel          level{};
+            i64               timestamp{};
+            BufferString<256> message{};
+        };
+
+        //single producer, single consumer. only the owner thread writes head, only the log thread writes tail
+        struct LogRing
+        {
+            Array<LogRecord>   records{};
+            usize              mask{};
+            std::atomic<usize> head{};
+            std::atomic<usize> tail{};
+        };
+
         struct LogContext
         {
             HashMap<String, SharedPtr<Logger>>  loggers{};
             Array<LogSink*>                     sinks{};
             LogLevel                            defaultLevel = LogLevel::Info;
+
+            std::mutex              mutex{};
+            std::condition_variable condition{};
+            std::condition_variable flushCondition{};
+            std::thread             thread{};
+            std::thread::id         threadId{};
+            std::atomic_bool        async{false};
+            std::atomic_bool        running{false};
+            std::atomic_bool        sleeping{false};
+            std::atomic<u32>        generation{0};
+            std::atomic<u64>        dropped{0};
+            std::atomic<u64>        droppedToReport{0};
+            AsyncLogOptions         options{};
+            Array<LogRing*>         rings{};
+            Logger*                 logger{};
         };
 
         LogContext& GetContext()
@@ -24,6 +60,145 @@ namespace Fyrion
             static LogContext loggers{};
             return loggers;
         }
+
+        thread_local LogRing* threadRing = nullptr;
+        thread_local u32      threadGeneration = 0;
+
+        i64 GetTimestamp()
+        {
+            return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+        }
+
+        LogRing* GetThreadRing(LogContext& context)
+        {
+            u32 generation = context.generation.load(std::memory_order_acquire);
+            if (threadGeneration != generation)
+            {
+                usize size = 1;
+                while (size < context.options.threadBufferSize)
+                {
+                    size *= 2;
+                }
+
+                threadRing = MemoryGlobals::GetDefaultAllocator().Alloc<LogRing>();
+                threadRing->records.Resize(size);
+                threadRing->mask = size - 1;
+                threadGeneration = generation;
+
+                std::lock_guard lock(context.mutex);
+                context.rings.EmplaceBack(threadRing);
+            }
+            return threadRing;
+        }
+
+        void PushRecord(LogContext& context, Logger* logger, LogLevel level, const StringView& message)
+        {
+            LogRing* ring = GetThreadRing(context);
+            usize    head = ring->head.load(std::memory_order_relaxed);
+
+            while (head - ring->tail.load(std::memory_order_acquire) > ring->mask)
+            {
+                if (context.options.overflow != LogOverflow::Block)
+                {
+                    context.dropped.fetch_add(1, std::memory_order_relaxed);
+                    if (context.options.overflow == LogOverflow::Count)
+                    {
+                        context.droppedToReport.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    return;
+                }
+                context.condition.notify_one();
+                std::this_thread::yield();
+            }
+
+            LogRecord& record = ring->records[head & ring->mask];
+            record.logger = logger;
+            record.level = level;
+            record.timestamp = GetTimestamp();
+            record.message = message;
+            ring->head.store(head + 1, std::memory_order_release);
+
+            if (context.sleeping.load(std::memory_order_relaxed))
+            {
+                context.condition.notify_one();
+            }
+        }
+
+        void LogThread()
+        {
+            LogContext& context = GetContext();
+
+            Array<LogRing*>   rings{};
+            Array<LogRecord*> pending{};
+            Array<usize>      heads{};
+
+            while (true)
+            {
+                //the lock is only held to copy the ring list, records are drained and written without it
+                rings.Clear();
+                {
+                    std::lock_guard lock(context.mutex);
+                    for (LogRing* ring : context.rings)
+                    {
+                        rings.EmplaceBack(ring);
+                    }
+                }
+
+                pending.Clear();
+                heads.Resize(rings.Size());
+
+                for (usize i = 0; i < rings.Size(); ++i)
+                {
+                    LogRing* ring = rings[i];
+                    heads[i] = ring->head.load(std::memory_order_acquire);
+                    for (usize t = ring->tail.load(std::memory_order_relaxed); t < heads[i]; ++t)
+                    {
+                        pending.EmplaceBack(&ring->records[t & ring->mask]);
+                    }
+                }
+
+                //each thread buffer is already in order, the messages of different threads are merged by time
+                std::stable_sort(pending.begin(), pending.end(), [](const LogRecord* a, const LogRecord* b)
+                {
+                    return a->timestamp < b->timestamp;
+                });
+
+                for (LogRecord* record : pending)
+                {
+                    record->logger->WriteLog(record->level, record->message, record->timestamp);
+                }
+
+                for (usize i = 0; i < heads.Size(); ++i)
+                {
+                    rings[i]->tail.store(heads[i], std::memory_order_release);
+                }
+
+                if (u64 dropped = context.droppedToReport.exchange(0, std::memory_order_relaxed); dropped > 0)
+                {
+                    BufferString<64> message{};
+                    message.Append(dropped).Append(" log messages were dropped");
+                    context.logger->WriteLog(LogLevel::Warn, message, GetTimestamp());
+                }
+
+                {
+                    //Flush checks the tails under the lock, taking it here makes sure the notification is not missed
+                    std::lock_guard lock(context.mutex);
+                }
+                context.flushCondition.notify_all();
+
+                if (pending.Empty())
+                {
+                    if (!context.running)
+                    {
+                        break;
+                    }
+                    std::unique_lock lock(context.mutex);
+                    context.sleeping = true;
+                    context.condition.wait_for(lock, std::chrono::milliseconds(100));
+                    context.sleeping = false;
+                }
+            }
+        }
     }
 
 
@@ -59,8 +234,22 @@ namespace Fyrion
 
     void Logger::PrintLog(LogLevel level, const StringView& message)
     {
-        const auto now = std::chrono::system_clock::now();
-        std::time_t t = std::chrono::system_clock::to_time_t(now);
+        LogContext& context = GetContext();
+        if (context.async.load(std::memory_order_acquire) && std::this_thread::get_id() != context.threadId)
+        {
+            PushRecord(context, this, level, message);
+            if (level >= LogLevel::Critical)
+            {
+                Flush();
+            }
+            return;
+        }
+        WriteLog(level, message, GetTimestamp());
+    }
+
+    void Logger::WriteLog(LogLevel level, const StringView& message, i64 timestamp)
+    {
+        std::time_t t = static_cast<std::time_t>(timestamp / 1000000);
         std::tm tm{};
 
 #ifdef FY_WIN
@@ -68,8 +257,7 @@ namespace Fyrion
 #else
         ::localtime_r(&t, &tm);
 #endif
-        auto duration     = now.time_since_epoch();
-        i64 milliseconds = (std::chrono::duration_cast<std::chrono::milliseconds>(duration) - duration_cast<std::chrono::milliseconds>(duration_cast<std::chrono::seconds>(duration))).count();
+        i64 milliseconds = (timestamp / 1000) % 1000;
 
         BufferString<1024> buffer{};
 
@@ -119,6 +307,7 @@ namespace Fyrion
 
     void Logger::AddSink(LogSink& logSink)
     {
+        std::lock_guard lock(GetContext().mutex);
         m_logSinks.EmplaceBack(&logSink);
     }
 
@@ -147,17 +336,103 @@ namespace Fyrion
 
     void Logger::RegisterSink(LogSink& logSink)
     {
+        std::lock_guard lock(GetContext().mutex);
         GetContext().sinks.EmplaceBack(&logSink);
     }
 
     void Logger::UnregisterSink(LogSink& logSink)
     {
+        Flush();
+
+        std::lock_guard lock(GetContext().mutex);
         auto& sinks = GetContext().sinks;
         sinks.Erase(std::find(sinks.begin(), sinks.end(), &logSink), sinks.end());
     }
 
+    void Logger::EnableAsync(const AsyncLogOptions& options)
+    {
+        LogContext& context = GetContext();
+        if (context.async)
+        {
+            return;
+        }
+
+        context.options = options;
+        context.logger = &GetLogger("Fyrion::Logger");
+        context.generation++;
+        context.running = true;
+        context.thread = std::thread(LogThread);
+        context.threadId = context.thread.get_id();
+        context.async = true;
+    }
+
+    void Logger::DisableAsync()
+    {
+        LogContext& context = GetContext();
+        if (!context.async)
+        {
+            return;
+        }
+
+        context.async = false;
+        context.running = false;
+        context.condition.notify_one();
+        context.thread.join();
+        context.threadId = {};
+
+        for (LogRing* ring : context.rings)
+        {
+            MemoryGlobals::GetDefaultAllocator().DestroyAndFree(ring);
+        }
+        context.rings.Clear();
+        context.rings.ShrinkToFit();
+        context.generation++;
+    }
+
+    bool Logger::IsAsync()
+    {
+        return GetContext().async;
+    }
+
+    void Logger::Flush()
+    {
+        LogContext& context = GetContext();
+        if (!context.async || std::this_thread::get_id() == context.threadId)
+        {
+            return;
+        }
+
+        std::unique_lock lock(context.mutex);
+
+        Array<usize> heads{};
+        for (LogRing* ring : context.rings)
+        {
+            heads.EmplaceBack(ring->head.load(std::memory_order_acquire));
+        }
+
+        context.condition.notify_one();
+        context.flushCondition.wait(lock, [&]
+        {
+            for (usize i = 0; i < heads.Size(); ++i)
+            {
+                if (context.rings[i]->tail.load(std::memory_order_acquire) < heads[i])
+                {
+                    return false;
+                }
+            }
+            return true;
+        });
+    }
+
+    u64 Logger::GetDroppedCount()
+    {
+        return GetContext().dropped;
+    }
+
     void Logger::Reset()
     {
+        DisableAsync();
+
         LogContext& logContext = GetContext();
         logContext.sinks.Clear();
         logContext.sinks.ShrinkToFit();
@@ -19,6 +19,19 @@ namespace Fyrion
         Off = 6
     };
 
+    enum class LogOverflow
+    {
+        Block, //waits for the background thread to drain the buffer
+        Drop,  //discards the new message
+        Count  //discards the new message and logs how many were lost once there is space again
+    };
+
+    struct AsyncLogOptions
+    {
+        usize       threadBufferSize = 1024; //messages per thread, rounded up to a power of two
+        LogOverflow overflow = LogOverflow::Block;
+    };
+
     struct LogSink
     {
         virtual ~LogSink() = default;
@@ -34,6 +47,7 @@ namespace Fyrion
     public:
 
         void PrintLog(LogLevel level, const StringView& message);
+        void WriteLog(LogLevel level, const StringView& message, i64 timestamp);
         void SetLevel(LogLevel level);
         void AddSink(LogSink& logSink);
         bool CanLog(LogLevel level);
@@ -92,6 +106,7 @@ namespace Fyrion
         inline void FatalError(const fmt::format_string<Args...>& fmt, Args&& ...args)
         {
             Log(LogLevel::Error, fmt, Traits::Forward<Args>(args)...);
+            Flush();
             FY_ASSERT(false, "error");
         }
 
@@ -102,6 +117,14 @@ namespace Fyrion
         static void     SetDefaultLevel(LogLevel logLevel);
         static void     Reset();
 
+        //messages are pushed to a lock-free buffer of the calling thread and written to the sinks by a background thread.
+        //DisableAsync must be called before the sinks are destroyed, when no other thread is logging.
+        static void     EnableAsync(const AsyncLogOptions& options = {});
+        static void     DisableAsync();
+        static bool     IsAsync();
+        static void     Flush();
+        static u64      GetDroppedCount();
+
     private:
         String           m_name{};
         LogLevel         m_logLevel{};
@@ -274,6 +274,12 @@ namespace Fyrion
         Vec3 max;
     };
 
+    //planes are stored as (normal, distance) pointing inwards: left, right, bottom, top, near, far
+    struct Frustum
+    {
+        Vec4 planes[6];
+    };
+
     struct Ray
     {
         Vec3 origin;
@@ -1754,6 +1760,76 @@ namespace Fyrion
         return true;
     }
 
+    namespace Math
+    {
+        //transforms the center and projects the extents on the world axes (Arvo)
+        inline AABB TransformAABB(const AABB& aabb, const Mat4& matrix)
+        {
+            Vec3 center = (aabb.min + aabb.max) * 0.5f;
+            Vec3 extent = (aabb.max - aabb.min) * 0.5f;
+
+            Vec3 worldCenter{
+                matrix[0].x * center.x + matrix[1].x * center.y + matrix[2].x * center.z + matrix[3].x,
+                matrix[0].y * center.x + matrix[1].y * center.y + matrix[2].y * center.z + matrix[3].y,
+                matrix[0].z * center.x + matrix[1].z * center.y + matrix[2].z * center.z + matrix[3].z
+            };
+
+            Vec3 worldExtent{
+                std::abs(matrix[0].x) * extent.x + std::abs(matrix[1].x) * extent.y + std::abs(matrix[2].x) * extent.z,
+                std::abs(matrix[0].y) * extent.x + std::abs(matrix[1].y) * extent.y + std::abs(matrix[2].y) * extent.z,
+                std::abs(matrix[0].z) * extent.x + std::abs(matrix[1].z) * extent.y + std::abs(matrix[2].z) * extent.z
+            };
+
+            return AABB{worldCenter - worldExtent, worldCenter + worldExtent};
+        }
+
+        //Gribb/Hartmann plane extraction, expects a zero to one depth range.
+        inline Frustum ExtractFrustum(const Mat4& viewProjection)
+        {
+            Vec4 rows[4];
+            for (u32 r = 0; r < 4; ++r)
+            {
+                rows[r] = Vec4{viewProjection[0][r], viewProjection[1][r], viewProjection[2][r], viewProjection[3][r]};
+            }
+
+            Frustum frustum{};
+            frustum.planes[0] = rows[3] + rows[0];
+            frustum.planes[1] = rows[3] - rows[0];
+            frustum.planes[2] = rows[3] + rows[1];
+            frustum.planes[3] = rows[3] - rows[1];
+            frustum.planes[4] = rows[2];
+            frustum.planes[5] = rows[3] - rows[2];
+
+            for (Vec4& plane : frustum.planes)
+            {
+                f32 len = Sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+                if (len > 0.0f)
+                {
+                    plane = plane / len;
+                }
+            }
+            return frustum;
+        }
+
+        //conservative, boxes crossing the corners outside the frustum may pass.
+        inline bool TestFrustumAABB(const Frustum& frustum, const AABB& aabb)
+        {
+            Vec3 center = (aabb.min + aabb.max) * 0.5f;
+            Vec3 extent = (aabb.max - aabb.min) * 0.5f;
+
+            for (const Vec4& plane : frustum.planes)
+            {
+                f32 distance = plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w;
+                f32 radius = std::abs(plane.x) * extent.x + std::abs(plane.y) * extent.y + std::abs(plane.z) * extent.z;
+                if (distance + radius < 0.0f)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+
     //hash impl
 
     template <>
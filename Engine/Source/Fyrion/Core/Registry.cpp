@@ -5,6 +5,8 @@
 #include "HashMap.hpp"
 #include "Logger.hpp"
 
+#include <mutex>
+
 namespace Fyrion
 {
     namespace
@@ -16,6 +18,72 @@ namespace Fyrion
         HashMap<TypeID, Array<FunctionHandler*>>            functionsByAttribute{};
         EventHandler<OnTypeAdded>                           onTypeAddedEvent{};
         Logger&                                             logger = Logger::GetLogger("Fyrion::Registry");
+        std::atomic<u64>                                    revision{1};
+        std::mutex                                          serializationPlanMutex{};
+
+        void BuildSerializationPlan(const TypeHandler& typeHandler, SerializationPlan& plan)
+        {
+            const TypeInfo& typeInfo = typeHandler.GetTypeInfo();
+            if (typeInfo.size == 0)
+            {
+                return;
+            }
+
+            //offsets are resolved against uninitialized memory, field pointers are only computed, never accessed.
+            Allocator& allocator = MemoryGlobals::GetDefaultAllocator();
+            u8* scratch = static_cast<u8*>(allocator.MemAlloc(typeInfo.size, typeInfo.alignment > 0 ? typeInfo.alignment : 1));
+
+            for (FieldHandler* field : typeHandler.GetFields())
+            {
+                u8* fieldPointer = static_cast<u8*>(field->GetFieldPointer(static_cast<VoidPtr>(scratch)));
+                if (fieldPointer == nullptr)
+                {
+                    continue;
+                }
+
+                FieldInfo       fieldInfo = field->GetFieldInfo();
+                const TypeInfo& fieldType = fieldInfo.typeInfo;
+
+                SerializationField planField{
+                    .name = field->GetName(),
+                    .offset = static_cast<usize>(fieldPointer - scratch),
+                    .isPointer = fieldInfo.isPointer
+                };
+
+                if (fieldType.archiveWrite)
+                {
+                    planField.kind = SerializationFieldKind::Archive;
+                    planField.archiveWrite = fieldType.archiveWrite;
+                    planField.archiveRead = fieldType.archiveRead;
+                }
+                else if (fieldType.apiId == GetTypeID<ArrayApi>())
+                {
+                    planField.kind = SerializationFieldKind::Array;
+                    fieldType.extractApi(&planField.arrayApi);
+
+                    TypeInfo itemInfo = planField.arrayApi.getTypeInfo();
+                    planField.archiveAdd = itemInfo.archiveAdd;
+                    planField.archiveGet = itemInfo.archiveGet;
+                    if (planField.archiveAdd == nullptr)
+                    {
+                        planField.typeHandler = Registry::FindTypeById(itemInfo.typeId);
+                    }
+                }
+                else if (TypeHandler* fieldTypeHandler = Registry::FindTypeById(fieldType.typeId))
+                {
+                    planField.kind = SerializationFieldKind::Object;
+                    planField.typeHandler = fieldTypeHandler;
+                }
+                else
+                {
+                    continue;
+                }
+
+                plan.fields.EmplaceBack(planField);
+            }
+
+            allocator.MemFree(scratch);
+        }
     }
 
     ParamHandler::ParamHandler(usize index, const FieldInfo& fieldInfo) : m_fieldInfo(fieldInfo)
@@ -261,6 +329,20 @@ namespace Fyrion
         simpleName = Fyrion::GetSimpleName(name);
     }
 
+    TypeHandler::~TypeHandler()
+    {
+        Allocator& allocator = MemoryGlobals::GetDefaultAllocator();
+        if (SerializationPlan* plan = serializationPlan.load())
+        {
+            allocator.DestroyAndFree(plan);
+        }
+
+        for (SerializationPlan* plan : retiredPlans)
+        {
+            allocator.DestroyAndFree(plan);
+        }
+    }
+
     ConstructorHandler* TypeHandler::FindConstructor(TypeID* ids, usize size) const
     {
         u64 constructorId = size > 0 ? MurmurHash64(ids, size * sizeof(TypeID), HashSeed64) : 0;
@@ -379,6 +461,38 @@ namespace Fyrion
         return simpleName;
     }
 
+    const SerializationPlan& TypeHandler::GetSerializationPlan() const
+    {
+        u64 currentRevision = revision.load(std::memory_order_acquire);
+
+        SerializationPlan* plan = serializationPlan.load(std::memory_order_acquire);
+        if (plan != nullptr && plan->revision == currentRevision)
+        {
+            return *plan;
+        }
+
+        std::lock_guard lock(serializationPlanMutex);
+
+        plan = serializationPlan.load(std::memory_order_acquire);
+        if (plan != nullptr && plan->revision == currentRevision)
+        {
+            return *plan;
+        }
+
+        SerializationPlan* newPlan = MemoryGlobals::GetDefaultAllocator().Alloc<SerializationPlan>();
+        newPlan->revision = currentRevision;
+        BuildSerializationPlan(*this, *newPlan);
+
+        //other threads may still be iterating the old plan, it's released with the type.
+        if (plan != nullptr)
+        {
+            retiredPlans.EmplaceBack(plan);
+        }
+
+        serializationPlan.store(newPlan, std::memory_order_release);
+        return *newPlan;
+    }
+
     const TypeInfo& TypeHandler::GetTypeInfo() const
     {
         return typeInfo;
@@ -690,6 +804,7 @@ namespace Fyrion
         {
             it = typeHandler.fields.Emplace(fieldName, MakeShared<FieldHandler>(fieldName, typeHandler)).first;
             typeHandler.fieldArray.EmplaceBack(it->second.Get());
+            revision.fetch_add(1, std::memory_order_release);
         }
         return FieldBuilder{*it->second};
     }
@@ -734,6 +849,7 @@ namespace Fyrion
             baseType->derivedTypes.EmplaceBack(typeHandler.GetTypeInfo().typeId, fnCast);
             typeHandler.baseTypes.Insert(typeId, fnCast);
             typeHandler.baseTypesArray.EmplaceBack(typeId);
+            revision.fetch_add(1, std::memory_order_release);
 
             for(const auto& it : baseType->functions)
             {
@@ -779,6 +895,7 @@ namespace Fyrion
 
         itByName->second.EmplaceBack(typeHandler);
         itById->second.EmplaceBack(typeHandler);
+        revision.fetch_add(1, std::memory_order_release);
 
         logger.Debug("Type {} Registered ", name, version);
 
@@ -835,6 +952,11 @@ namespace Fyrion
         return nullptr;
     }
 
+    u64 Registry::GetRevision()
+    {
+        return revision.load(std::memory_order_acquire);
+    }
+
     Span<TypeHandler*> Registry::FindTypesByAttribute(TypeID typeId)
     {
         if (auto it = typesByAttribute.Find(typeId))
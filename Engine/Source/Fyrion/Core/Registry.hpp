@@ -2,6 +2,7 @@
 
 #include "Fyrion/Common.hpp"
 #include "Allocator.hpp"
+#include "Array.hpp"
 #include "Event.hpp"
 #include "StringView.hpp"
 #include "TypeInfo.hpp"
@@ -10,6 +11,8 @@
 #include "HashMap.hpp"
 #include "Span.hpp"
 
+#include <atomic>
+
 namespace Fyrion
 {
     class TypeBuilder;
@@ -278,6 +281,34 @@ namespace Fyrion
         FnCast fnCast{};
     };
 
+    enum class SerializationFieldKind : u8
+    {
+        Archive,
+        Array,
+        Object
+    };
+
+    struct SerializationField
+    {
+        StringView             name{};
+        usize                  offset{};
+        SerializationFieldKind kind{};
+        bool                   isPointer{};
+        FnArchiveWrite         archiveWrite{};
+        FnArchiveRead          archiveRead{};
+        TypeHandler*           typeHandler{};
+        ArrayApi               arrayApi{};
+        FnArchiveAdd           archiveAdd{};
+        FnArchiveGet           archiveGet{};
+    };
+
+    //flattened fields resolved once per type, rebuilt when the registry changes.
+    struct SerializationPlan
+    {
+        u64                       revision{};
+        Array<SerializationField> fields{};
+    };
+
 
     class FY_API TypeHandler : public AttributeHandler
     {
@@ -314,8 +345,12 @@ namespace Fyrion
         HashMap<TypeID, FnCast>                       baseTypes{};
         Array<TypeID>                                 baseTypesArray{};
         Array<DerivedType>                            derivedTypes{};
+
+        mutable std::atomic<SerializationPlan*>       serializationPlan{};
+        mutable Array<SerializationPlan*>             retiredPlans{};
     public:
         TypeHandler(const StringView& name, const TypeInfo& typeInfo, u32 version);
+        ~TypeHandler() override;
 
         ConstructorHandler*             FindConstructor(TypeID* ids, usize size) const;
         Span<ConstructorHandler*>       GetConstructors() const;
@@ -335,6 +370,8 @@ namespace Fyrion
         Array<TypeID>                   GetBaseTypes() const;
         bool                            IsDerivedFrom(TypeID typeId) const;
 
+        const SerializationPlan&        GetSerializationPlan() const;
+
 
         StringView          GetName() const;
         StringView          GetSimpleName() const;
@@ -1166,6 +1203,7 @@ namespace Fyrion
         FY_API TypeHandler*       FindTypeByName(const StringView& name);
         FY_API TypeHandler*       FindTypeById(TypeID typeId);
         FY_API Span<TypeHandler*> FindTypesByAttribute(TypeID typeId);
+        FY_API u64                GetRevision();
 
 
         FY_API FunctionBuilder          NewFunction(const FunctionHandlerCreation& functionHandlerCreation);
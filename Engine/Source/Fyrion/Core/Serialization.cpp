@@ -9,42 +9,57 @@ namespace Fyrion
         if (typeHandler == nullptr || instance == nullptr) return {};
 
         const ArchiveObject object = writer.CreateObject();
-        for (FieldHandler* field : typeHandler->GetFields())
+        for (const SerializationField& field : typeHandler->GetSerializationPlan().fields)
         {
-            const TypeInfo& typeInfo = field->GetFieldInfo().typeInfo;
+            SerializeField(field, writer, object, instance);
+        }
+        return object;
+    }
+
+    void Serialization::Deserialize(const TypeHandler* typeHandler, ArchiveReader& reader, ArchiveObject object, VoidPtr instance)
+    {
+        if (typeHandler == nullptr || instance == nullptr) return;
+
+        for (const SerializationField& field : typeHandler->GetSerializationPlan().fields)
+        {
+            DeserializeField(field, reader, object, instance);
+        }
+    }
 
-            if (FnArchiveWrite archiveWrite = typeInfo.archiveWrite)
+    void Serialization::SerializeField(const SerializationField& field, ArchiveWriter& writer, ArchiveObject object, ConstPtr instance)
+    {
+        ConstPtr fieldPointer = static_cast<const u8*>(instance) + field.offset;
+
+        switch (field.kind)
+        {
+            case SerializationFieldKind::Archive:
             {
-                archiveWrite(writer, object, field->GetName(), field->GetFieldPointer(instance));
+                field.archiveWrite(writer, object, field.name, fieldPointer);
+                break;
             }
-            else if (typeInfo.apiId == GetTypeID<ArrayApi>())
+            case SerializationFieldKind::Array:
             {
                 ArchiveObject array = writer.CreateArray();
-
-                ConstPtr arrayPtr = field->GetFieldPointer(instance);
-                ArrayApi arrayApi{};
-                typeInfo.extractApi(&arrayApi);
-                usize    size = arrayApi.size(arrayPtr);
-                TypeInfo itemInfo = arrayApi.getTypeInfo();
+                usize         size = field.arrayApi.size(fieldPointer);
 
                 bool empty = true;
 
-                if (FnArchiveAdd archiveAdd = itemInfo.archiveAdd)
+                if (field.archiveAdd)
                 {
                     for (usize i = 0; i < size; ++i)
                     {
-                        if (ConstPtr value = arrayApi.getConst(arrayPtr, i))
+                        if (ConstPtr value = field.arrayApi.getConst(fieldPointer, i))
                         {
-                            archiveAdd(writer, array, value);
+                            field.archiveAdd(writer, array, value);
                             empty = false;
                         }
                     }
                 }
-                else if (TypeHandler* itemHandler = Registry::FindTypeById(itemInfo.typeId))
+                else if (field.typeHandler)
                 {
                     for (usize i = 0; i < size; ++i)
                     {
-                        if (ArchiveObject value = Serialize(itemHandler, writer, arrayApi.getConst(arrayPtr, i)))
+                        if (ArchiveObject value = Serialize(field.typeHandler, writer, field.arrayApi.getConst(fieldPointer, i)))
                         {
                             writer.AddValue(array, value);
                             empty = false;
@@ -54,66 +69,62 @@ namespace Fyrion
 
                 if (!empty)
                 {
-                    writer.WriteValue(object, field->GetName(), array);
+                    writer.WriteValue(object, field.name, array);
                 }
+                break;
             }
-            else if (const TypeHandler* fieldType = Registry::FindTypeById(typeInfo.typeId))
+            case SerializationFieldKind::Object:
             {
-                writer.WriteValue(object, field->GetName(), Serialize(fieldType, writer, field->GetFieldPointer(instance)));
+                writer.WriteValue(object, field.name, Serialize(field.typeHandler, writer, fieldPointer));
+                break;
             }
         }
-        return object;
     }
 
-    void Serialization::Deserialize(const TypeHandler* typeHandler, ArchiveReader& reader, ArchiveObject object, VoidPtr instance)
+    void Serialization::DeserializeField(const SerializationField& field, ArchiveReader& reader, ArchiveObject object, VoidPtr instance)
     {
-        if (typeHandler == nullptr || instance == nullptr) return;
+        VoidPtr fieldPointer = static_cast<u8*>(instance) + field.offset;
 
-        for (FieldHandler* field : typeHandler->GetFields())
+        switch (field.kind)
         {
-            const TypeInfo& typeInfo = field->GetFieldInfo().typeInfo;
-
-            if (FnArchiveRead archiveRead = typeInfo.archiveRead)
+            case SerializationFieldKind::Archive:
             {
-                archiveRead(reader, object, field->GetName(), field->GetFieldPointer(instance));
+                field.archiveRead(reader, object, field.name, fieldPointer);
+                break;
             }
-            else if (typeInfo.apiId == GetTypeID<ArrayApi>())
+            case SerializationFieldKind::Array:
             {
-                VoidPtr arrPtr = field->GetFieldPointer(instance);
-
-                ArrayApi arrayApi{};
-                typeInfo.extractApi(&arrayApi);
-
-                arrayApi.clear(arrPtr);
+                field.arrayApi.clear(fieldPointer);
 
-                ArchiveObject arr = reader.ReadObject(object, field->GetName());
+                ArchiveObject arr = reader.ReadObject(object, field.name);
                 usize         size = reader.ArrSize(arr);
-                TypeInfo      itemInfo = arrayApi.getTypeInfo();
                 ArchiveObject item{};
 
-                if (FnArchiveGet archiveGet = itemInfo.archiveGet)
+                if (field.archiveGet)
                 {
                     for (usize i = 0; i < size; ++i)
                     {
                         item = reader.Next(arr, item);
-                        archiveGet(reader, item, arrayApi.pushNew(arrPtr));
+                        field.archiveGet(reader, item, field.arrayApi.pushNew(fieldPointer));
                     }
                 }
-                else if (TypeHandler* itemHandler = Registry::FindTypeById(itemInfo.typeId))
+                else if (field.typeHandler)
                 {
                     for (usize i = 0; i < size; ++i)
                     {
                         item = reader.Next(arr, item);
-                        Deserialize(itemHandler, reader, item, arrayApi.pushNew(arrPtr));
+                        Deserialize(field.typeHandler, reader, item, field.arrayApi.pushNew(fieldPointer));
                     }
                 }
+                break;
             }
-            else if (const TypeHandler* fieldType = Registry::FindTypeById(typeInfo.typeId))
+            case SerializationFieldKind::Object:
             {
-                if (!field->GetFieldInfo().isPointer)
+                if (!field.isPointer)
                 {
-                    Deserialize(fieldType, reader, reader.ReadObject(object, field->GetName()), field->GetFieldPointer(instance));
+                    Deserialize(field.typeHandler, reader, reader.ReadObject(object, field.name), fieldPointer);
                 }
+                break;
             }
         }
     }
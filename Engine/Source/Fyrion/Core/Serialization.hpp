@@ -7,6 +7,7 @@
 namespace Fyrion
 {
     FY_HANDLER(ArchiveObject);
+    struct SerializationField;
 
     enum class SerializationOptions : u32
     {
@@ -120,6 +121,8 @@ namespace Fyrion
     {
         FY_API ArchiveObject Serialize(const TypeHandler* typeHandler, ArchiveWriter& writer, ConstPtr instance);
         FY_API void          Deserialize(const TypeHandler* typeHandler, ArchiveReader& reader, ArchiveObject object, VoidPtr instance);
+        FY_API void          SerializeField(const SerializationField& field, ArchiveWriter& writer, ArchiveObject object, ConstPtr instance);
+        FY_API void          DeserializeField(const SerializationField& field, ArchiveReader& reader, ArchiveObject object, VoidPtr instance);
         FY_API void          WriteEnum(TypeID typeId, ArchiveWriter& writer, ArchiveObject object, StringView name, i64 value);
         FY_API bool          ReadEnum(TypeID typeId, ArchiveReader& reader, ArchiveObject object, StringView name, i64& value);
     }
@@ -36,6 +36,8 @@ namespace Fyrion
     void            AssetDatabaseInit();
     void            AssetDatabaseShutdown();
     void            InputInit();
+    void            JobSystemInit();
+    void            JobSystemShutdown();
 
 
     namespace
@@ -69,6 +71,7 @@ namespace Fyrion
     {
         args.Parse(argc, argv);
 
+        JobSystemInit();
         TypeRegister();
         AssetDatabaseInit();
         InputInit();
@@ -79,7 +82,15 @@ namespace Fyrion
 
     void Engine::CreateContext(const EngineContextCreation& contextCreation)
     {
-        AssetManager::LoadFromDirectory("Fyrion", Path::Join(FileSystem::AssetFolder(), "Fyrion"));
+        //cooked builds ship the engine assets as a package
+        if (String pakFile = Path::Join(FileSystem::AssetFolder(), "Fyrion.pak"); FileSystem::GetFileStatus(pakFile).exists)
+        {
+            AssetManager::LoadFromPackage("Fyrion", pakFile, Path::Join(FileSystem::AssetFolder(), "Fyrion.bin"));
+        }
+        else
+        {
+            AssetManager::LoadFromDirectory("Fyrion", Path::Join(FileSystem::AssetFolder(), "Fyrion"));
+        }
 
         PlatformInit();
 
@@ -263,6 +274,7 @@ namespace Fyrion
 
     void Engine::Destroy()
     {
+        JobSystemShutdown();
         DefaultRenderPipelineShutdown();
         SceneManagerShutdown();
         ShaderManagerShutdown();
@@ -1,8 +1,10 @@
+#include <algorithm>
 #include <cgltf.h>
 
 #include "Fyrion/Asset/AssetHandler.hpp"
 #include "Fyrion/Asset/AssetTypes.hpp"
 #include "Fyrion/Core/Image.hpp"
+#include "Fyrion/Core/JobSystem.hpp"
 #include "Fyrion/Core/Logger.hpp"
 #include "Fyrion/Graphics/Assets/DCCAsset.hpp"
 #include "Fyrion/IO/FileSystem.hpp"
@@ -24,6 +26,47 @@ namespace Fyrion
         using ImportedMaterialMap = HashMap<usize, MaterialAsset*>;
         using ImportedMeshMap = HashMap<usize, MeshAsset*>;
 
+        //the import runs as a job graph: buffers -> textures and meshes, the jobs only read the cgltf data and write their own import.
+        //assets are created and changed by CommitImport on the main thread.
+
+        struct BufferImport
+        {
+            cgltf_data*   data;
+            cgltf_buffer* buffer;
+            String        path;
+        };
+
+        struct TextureImport
+        {
+            const cgltf_texture* texture;
+            String               name;
+            TextureAsset*        textureAsset; //null if the texture is created on the commit
+            const TextureAsset*  cooker;       //provides the import settings
+            TextureCookedImage   cooked;
+        };
+
+        struct MeshImport
+        {
+            const cgltf_mesh*      gltfMesh;
+            String                 name;
+            MeshAsset*             meshAsset; //null if the mesh is created on the commit
+            const MeshAsset*       builder;   //provides the import settings
+            usize                  indexCount;
+            Array<cgltf_material*> materials;
+            MeshAssetData          data;
+        };
+
+        struct GLTFImport
+        {
+            DCCAsset*            dccAsset;
+            cgltf_data*          data;
+            Array<String>        relatedFiles;
+            Array<TextureImport> textures;
+            Array<MeshImport>    meshes;
+            TextureAsset         defaultTexture;
+            MeshAsset            defaultMesh;
+        };
+
         FY_BASE_TYPES(AssetIO);
 
         static void MoveAsset(AssetHandler* asset, StringView newName, AssetHandler* newParent)
@@ -56,26 +99,17 @@ namespace Fyrion
             return GetTypeID<DCCAsset>();
         }
 
-        static MeshAsset* LoadGltfMesh(DCCAsset* dccAsset, ImportedMaterialMap& materialMap, cgltf_data* data, cgltf_mesh& gltfMesh, u32 index)
+        static void BuildGltfMesh(VoidPtr userData)
         {
-            String name = gltfMesh.name != nullptr ? gltfMesh.name : String{"Mesh_"}.Append(index);
+            MeshImport&       meshImport = *static_cast<MeshImport*>(userData);
+            const cgltf_mesh& gltfMesh = *meshImport.gltfMesh;
 
-            Array<VertexStride>    vertices;
-            Array<u32>             indices;
-            Array<MeshPrimitive>   primitives;
-            Array<MaterialAsset*>  materials;
-            Array<cgltf_material*> gltfMaterials;
-            bool                   missingNormals = false;
-            bool                   missingTangents = false;
-
-            MeshAsset* meshAsset = dccAsset->FindMeshByName(name);
-            if (meshAsset == nullptr)
-            {
-                meshAsset = AssetManager::Create<MeshAsset>(AssetCreation{
-                    .name = name,
-                    .parent = dccAsset->GetHandler()
-                });
-            }
+            Array<VertexStride>     vertices;
+            Array<u32>              indices;
+            Array<MeshPrimitive>    primitives;
+            Array<cgltf_material*>& gltfMaterials = meshImport.materials;
+            bool                    missingNormals = false;
+            bool                    missingTangents = false;
 
             for (u32 p = 0; p < gltfMesh.primitives_count; ++p)
             {
@@ -231,13 +265,8 @@ namespace Fyrion
 
                     if (!found)
                     {
-                        if (auto it = materialMap.Find(reinterpret_cast<usize>(gltfPrimitive.material)))
-                        {
-                            materialIndex = materials.Size();
-
-                            materials.EmplaceBack(it->second);
-                            gltfMaterials.EmplaceBack(gltfPrimitive.material);
-                        }
+                        materialIndex = gltfMaterials.Size();
+                        gltfMaterials.EmplaceBack(gltfPrimitive.material);
                     }
                 }
 
@@ -248,9 +277,7 @@ namespace Fyrion
                 });
             }
 
-            meshAsset->SetData(vertices, indices, primitives, materials, missingNormals, missingTangents);
-
-            return meshAsset;
+            meshImport.builder->BuildData(vertices, indices, primitives, missingNormals, missingTangents, meshImport.data);
         }
 
         static void LoadGltfNode(const ImportedMeshMap& meshMap, SceneObject* parentObject, cgltf_node* node, u32& meshCount)
@@ -344,110 +371,87 @@ namespace Fyrion
             return nullptr;
         }
 
-        static bool ImportAsset(StringView path, Asset* asset)
+        static void LoadBuffer(VoidPtr userData)
         {
-            DCCAsset* dccAsset = static_cast<DCCAsset*>(asset);
-
-            cgltf_options options = {};
-            cgltf_data*   data = nullptr;
-            cgltf_result  result = cgltf_parse_file(&options, path.CStr(), &data);
-            if (result != cgltf_result_success)
-            {
-                logger.Error("Error on import file {} ", path);
-                return false;
-            }
+            BufferImport& bufferImport = *static_cast<BufferImport*>(userData);
+            cgltf_buffer& buffer = *bufferImport.buffer;
 
-            for (cgltf_size i = 0; i < data->buffers_count; ++i)
+            if (bufferImport.path.Empty())
             {
-                if (data->buffers[i].data)
+                const char* comma = strchr(buffer.uri, ',');
+                if (comma && comma - buffer.uri >= 7 && strncmp(comma - 7, ";base64", 7) == 0)
                 {
-                    continue;
-                }
-
-                const char* uri = data->buffers[i].uri;
-
-                if (uri == nullptr)
-                {
-                    continue;
+                    cgltf_options options = {};
+                    if (cgltf_load_buffer_base64(&options, buffer.size, comma + 1, &buffer.data) == cgltf_result_success)
+                    {
+                        buffer.data_free_method = cgltf_data_free_method_memory_free;
+                    }
                 }
+                return;
+            }
 
-                if (strncmp(uri, "data:", 5) == 0)
+            if (FileHandler file = FileSystem::OpenFile(bufferImport.path, AccessMode::ReadOnly))
+            {
+                if (FileSystem::GetFileSize(file) >= buffer.size)
                 {
-                    continue;
+                    cgltf_memory_options& memory = bufferImport.data->memory;
+                    buffer.data = memory.alloc_func(memory.user_data, buffer.size);
+                    buffer.data_free_method = cgltf_data_free_method_memory_free;
+                    FileSystem::ReadFile(file, buffer.data, buffer.size);
                 }
+                FileSystem::CloseFile(file);
+            }
+        }
 
+        static void CookGltfTexture(VoidPtr userData)
+        {
+            TextureImport&     textureImport = *static_cast<TextureImport*>(userData);
+            const cgltf_image& gltfImage = *textureImport.texture->image;
 
-                String bufferPath = Path::Join(Path::Parent(path), uri);
-
-                if (!FileSystem::GetFileStatus(bufferPath).exists)
-                {
-                    bufferPath = Path::Join(Path::Parent(path), asset->GetHandler()->GetName(), Path::Extension(uri));
-                }
+            Span<const u8> imageBuffer{
+                static_cast<const u8*>(gltfImage.buffer_view->buffer->data) + gltfImage.buffer_view->offset,
+                static_cast<const u8*>(gltfImage.buffer_view->buffer->data) + gltfImage.buffer_view->offset + gltfImage.buffer_view->size
+            };
 
-                if (!FileSystem::GetFileStatus(bufferPath).exists)
-                {
-                    logger.Error("buffer file not found {}", path.CStr());
-                    cgltf_free(data);
-                    return false;
-                }
+            Image image{imageBuffer};
+            textureImport.cooked = textureImport.cooker->CookImage(image);
+        }
 
-                String bufferName = Path::Name(bufferPath) + Path::Extension(bufferPath);
-                if (data->buffers[i].uri)
-                {
-                    data->memory.free_func(data->memory.user_data, data->buffers[i].uri);
-                    data->buffers[i].uri = (char*)data->memory.alloc_func(data->memory.user_data, bufferName.Size() + 1);
-                    MemCopy(data->buffers[i].uri, bufferName.CStr(), bufferName.Size());
-                    data->buffers[i].uri[bufferName.Size()] = 0;
-                }
-                asset->GetHandler()->AddRelatedFile(bufferName);
-            }
+        static void ReleaseImport(GLTFImport* import)
+        {
+            cgltf_free(import->data);
+            MemoryGlobals::GetDefaultAllocator().DestroyAndFree(import);
+        }
 
-            if (cgltf_load_buffers(&options, data, path.CStr()) != cgltf_result_success)
-            {
-                logger.Error("Failed to load buffers {}", path.CStr());
-                cgltf_free(data);
-                return false;
-            }
+        static void ApplyImport(GLTFImport& import)
+        {
+            DCCAsset* dccAsset = import.dccAsset;
 
-            if (cgltf_validate(data) != cgltf_result_success)
+            for (const String& relatedFile : import.relatedFiles)
             {
-                logger.Error("Failed validation for {}", path.CStr());
-                cgltf_free(data);
-                return false;
+                dccAsset->GetHandler()->AddRelatedFile(relatedFile);
             }
 
             ImportedTextureMap  textureMap;
             ImportedMaterialMap materialMap;
             ImportedMeshMap     meshMap;
 
-            for (i32 t = 0; t < data->textures_count; ++t)
+            for (TextureImport& textureImport : import.textures)
             {
-                const cgltf_texture& texture = data->textures[t];
-
-                if (texture.image->buffer_view != nullptr)
+                TextureAsset* textureAsset = textureImport.textureAsset;
+                if (textureAsset == nullptr)
                 {
-                    String        textureName = texture.name != nullptr ? texture.name : String{"Texture_"}.Append(t);
-                    TextureAsset* textureAsset = dccAsset->FindTextureByName(textureName);
-                    if (textureAsset == nullptr)
-                    {
-                        textureAsset = AssetManager::Create<TextureAsset>(AssetCreation{
-                            .name = textureName,
-                            .parent = dccAsset->GetHandler(),
-                        });
-                    }
-
-                    Span<const u8> imageBuffer{
-                        static_cast<const u8*>(texture.image->buffer_view->buffer->data) + texture.image->buffer_view->offset,
-                        static_cast<const u8*>(texture.image->buffer_view->buffer->data) + texture.image->buffer_view->offset + texture.image->buffer_view->size
-                    };
-
-                    Image image{imageBuffer};
-                    textureAsset->SetImage(image);
-
-                    textureMap.Insert(reinterpret_cast<usize>(&texture), textureAsset);
+                    textureAsset = AssetManager::Create<TextureAsset>(AssetCreation{
+                        .name = textureImport.name,
+                        .parent = dccAsset->GetHandler(),
+                    });
                 }
+                textureAsset->SetCookedImage(textureImport.cooked);
+                textureMap.Insert(reinterpret_cast<usize>(textureImport.texture), textureAsset);
             }
 
+            cgltf_data* data = import.data;
+
             for (int m = 0; m < data->materials_count; ++m)
             {
                 const cgltf_material& material = data->materials[m];
@@ -502,10 +506,25 @@ namespace Fyrion
                 materialMap.Insert(reinterpret_cast<usize>(&material), materialAsset);
             }
 
-            for (u32 m = 0; m < data->meshes_count; ++m)
+            for (MeshImport& meshImport : import.meshes)
             {
-                MeshAsset* meshAsset = LoadGltfMesh(dccAsset, materialMap, data, data->meshes[m], m);
-                meshMap.Insert(reinterpret_cast<usize>(&data->meshes[m]), meshAsset);
+                MeshAsset* meshAsset = meshImport.meshAsset;
+                if (meshAsset == nullptr)
+                {
+                    meshAsset = AssetManager::Create<MeshAsset>(AssetCreation{
+                        .name = meshImport.name,
+                        .parent = dccAsset->GetHandler()
+                    });
+                }
+
+                for (cgltf_material* material : meshImport.materials)
+                {
+                    auto it = materialMap.Find(reinterpret_cast<usize>(material));
+                    meshImport.data.materials.EmplaceBack(it ? it->second : nullptr);
+                }
+
+                meshAsset->SaveData(meshImport.data);
+                meshMap.Insert(reinterpret_cast<usize>(meshImport.gltfMesh), meshAsset);
             }
 
             if (data->scenes_count > 0)
@@ -534,8 +553,202 @@ namespace Fyrion
                     }
                 }
             }
+        }
+
+        static void CommitImport(VoidPtr userData, bool apply)
+        {
+            GLTFImport* import = static_cast<GLTFImport*>(userData);
+            if (apply)
+            {
+                ApplyImport(*import);
+            }
+            ReleaseImport(import);
+        }
+
+        static bool ImportAsset(StringView path, Asset* asset)
+        {
+            DCCAsset* dccAsset = static_cast<DCCAsset*>(asset);
+
+            cgltf_options options = {};
+            cgltf_data*   data = nullptr;
+            cgltf_result  result = cgltf_parse_file(&options, path.CStr(), &data);
+            if (result != cgltf_result_success)
+            {
+                logger.Error("Error on import file {} ", path);
+                return false;
+            }
+
+            GLTFImport* import = MemoryGlobals::GetDefaultAllocator().Alloc<GLTFImport>();
+            import->dccAsset = dccAsset;
+            import->data = data;
+
+            for (cgltf_size i = 0; i < data->buffers_count; ++i)
+            {
+                if (data->buffers[i].data)
+                {
+                    continue;
+                }
+
+                const char* uri = data->buffers[i].uri;
+
+                if (uri == nullptr)
+                {
+                    continue;
+                }
+
+                if (strncmp(uri, "data:", 5) == 0)
+                {
+                    continue;
+                }
+
+
+                String bufferPath = Path::Join(Path::Parent(path), uri);
+
+                if (!FileSystem::GetFileStatus(bufferPath).exists)
+                {
+                    bufferPath = Path::Join(Path::Parent(path), asset->GetHandler()->GetName(), Path::Extension(uri));
+                }
+
+                if (!FileSystem::GetFileStatus(bufferPath).exists)
+                {
+                    logger.Error("buffer file not found {}", path.CStr());
+                    ReleaseImport(import);
+                    return false;
+                }
+
+                String bufferName = Path::Name(bufferPath) + Path::Extension(bufferPath);
+                if (data->buffers[i].uri)
+                {
+                    data->memory.free_func(data->memory.user_data, data->buffers[i].uri);
+                    data->buffers[i].uri = (char*)data->memory.alloc_func(data->memory.user_data, bufferName.Size() + 1);
+                    MemCopy(data->buffers[i].uri, bufferName.CStr(), bufferName.Size());
+                    data->buffers[i].uri[bufferName.Size()] = 0;
+                }
+                import->relatedFiles.EmplaceBack(bufferName);
+            }
+
+            Array<BufferImport> bufferImports{};
+            for (cgltf_size i = 0; i < data->buffers_count; ++i)
+            {
+                const char* uri = data->buffers[i].uri;
+                if (data->buffers[i].data == nullptr && uri != nullptr && !strchr(uri, '%') && !strstr(uri, "://"))
+                {
+                    bufferImports.EmplaceBack(BufferImport{
+                        .data = data,
+                        .buffer = &data->buffers[i],
+                        .path = strncmp(uri, "data:", 5) != 0 ? Path::Join(Path::Parent(path), uri) : String{}
+                    });
+                }
+            }
+
+            Array<JobDecl> bufferJobs{};
+            for (BufferImport& bufferImport : bufferImports)
+            {
+                bufferJobs.EmplaceBack(JobDecl{LoadBuffer, &bufferImport});
+            }
+
+            JobCounter bufferCounter{};
+            JobSystem::Run(bufferJobs, &bufferCounter);
+            JobSystem::Wait(bufferCounter);
+
+            //loads the glb chunk and the buffers that failed, reporting the errors
+            if (cgltf_load_buffers(&options, data, path.CStr()) != cgltf_result_success)
+            {
+                logger.Error("Failed to load buffers {}", path.CStr());
+                ReleaseImport(import);
+                return false;
+            }
+
+            if (cgltf_validate(data) != cgltf_result_success)
+            {
+                logger.Error("Failed validation for {}", path.CStr());
+                ReleaseImport(import);
+                return false;
+            }
+
+            AssetManager::SetImportProgress(0.1f);
+
+            //existing assets are only read here, to reuse their import settings
+            Array<TextureImport>& textureImports = import->textures;
+            for (i32 t = 0; t < data->textures_count; ++t)
+            {
+                const cgltf_texture& texture = data->textures[t];
+
+                if (texture.image->buffer_view != nullptr)
+                {
+                    String        textureName = texture.name != nullptr ? texture.name : String{"Texture_"}.Append(t);
+                    TextureAsset* textureAsset = dccAsset->FindTextureByName(textureName);
+
+                    textureImports.EmplaceBack(TextureImport{
+                        .texture = &texture,
+                        .name = textureName,
+                        .textureAsset = textureAsset,
+                        .cooker = textureAsset != nullptr ? textureAsset : &import->defaultTexture
+                    });
+                }
+            }
+
+            Array<MeshImport>& meshImports = import->meshes;
+            for (u32 m = 0; m < data->meshes_count; ++m)
+            {
+                const cgltf_mesh& gltfMesh = data->meshes[m];
+                String            name = gltfMesh.name != nullptr ? gltfMesh.name : String{"Mesh_"}.Append(m);
+                MeshAsset*        meshAsset = dccAsset->FindMeshByName(name);
+
+                usize indexCount = 0;
+                for (u32 p = 0; p < gltfMesh.primitives_count; ++p)
+                {
+                    indexCount += gltfMesh.primitives[p].indices != nullptr ? gltfMesh.primitives[p].indices->count : 0;
+                }
+
+                meshImports.EmplaceBack(MeshImport{
+                    .gltfMesh = &gltfMesh,
+                    .name = name,
+                    .meshAsset = meshAsset,
+                    .builder = meshAsset != nullptr ? meshAsset : &import->defaultMesh,
+                    .indexCount = indexCount
+                });
+            }
+
+            if (AssetManager::IsImportCancelled())
+            {
+                ReleaseImport(import);
+                return false;
+            }
+
+            //textures and meshes don't depend on each other, the biggest meshes start first to balance the workers
+            Array<MeshImport*> sortedMeshes{};
+            for (MeshImport& meshImport : meshImports)
+            {
+                sortedMeshes.EmplaceBack(&meshImport);
+            }
+            std::sort(sortedMeshes.begin(), sortedMeshes.end(), [](const MeshImport* a, const MeshImport* b)
+            {
+                return a->indexCount > b->indexCount;
+            });
+
+            Array<JobDecl> jobs{};
+            for (MeshImport* meshImport : sortedMeshes)
+            {
+                jobs.EmplaceBack(JobDecl{BuildGltfMesh, meshImport});
+            }
+            for (TextureImport& textureImport : textureImports)
+            {
+                jobs.EmplaceBack(JobDecl{CookGltfTexture, &textureImport});
+            }
+
+            JobCounter counter{};
+            JobSystem::Run(jobs, &counter);
+            JobSystem::Wait(counter);
+
+            if (AssetManager::IsImportCancelled())
+            {
+                ReleaseImport(import);
+                return false;
+            }
 
-            cgltf_free(data);
+            AssetManager::SetImportProgress(0.9f);
+            AssetManager::AddImportCommit(import, CommitImport);
             return true;
         }
     };
@@ -16,6 +16,9 @@ namespace Fyrion
             getImportExtensions = GetImportExtensions;
             getAssetTypeId = GetAssetTypeID;
             importAsset = ImportAsset;
+
+            //shader compilation creates GPU pipelines
+            asyncImport = false;
         }
 
         static Span<StringView> GetImportExtensions()
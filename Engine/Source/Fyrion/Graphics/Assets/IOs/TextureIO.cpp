@@ -1,3 +1,4 @@
+#include "Fyrion/Asset/AssetManager.hpp"
 #include "Fyrion/Asset/AssetTypes.hpp"
 #include "Fyrion/Graphics/Assets/TextureAsset.hpp"
 #include "Fyrion/IO/Path.hpp"
@@ -27,19 +28,48 @@ namespace Fyrion
             return GetTypeID<TextureAsset>();
         }
 
+        struct TextureImport
+        {
+            TextureAsset*      textureAsset;
+            bool               hdr;
+            HDRImage           hdrImage;
+            TextureCookedImage cooked;
+        };
+
+        static void CommitImport(VoidPtr userData, bool apply)
+        {
+            TextureImport* import = static_cast<TextureImport*>(userData);
+            if (apply)
+            {
+                if (import->hdr)
+                {
+                    import->textureAsset->SetHDRImage(import->hdrImage);
+                }
+                else
+                {
+                    import->textureAsset->SetCookedImage(import->cooked);
+                }
+            }
+            MemoryGlobals::GetDefaultAllocator().DestroyAndFree(import);
+        }
+
         static bool ImportAsset(StringView path, Asset* asset)
         {
-            TextureAsset* textureAsset = asset->Cast<TextureAsset>();
+            TextureImport* import = MemoryGlobals::GetDefaultAllocator().Alloc<TextureImport>();
+            import->textureAsset = asset->Cast<TextureAsset>();
+            import->hdr = Path::Extension(path) == ".hdr";
 
-            if (Path::Extension(path) == ".hdr")
+            //the image is loaded and cooked here, the asset is only changed on the commit
+            if (import->hdr)
             {
-                textureAsset->SetHDRImage(path);
+                import->hdrImage = HDRImage{path};
             }
             else
             {
-                textureAsset->SetImagePath(path);
+                import->cooked = import->textureAsset->CookImage(Image{path});
             }
 
+            AssetManager::AddImportCommit(import, CommitImport);
             return true;
         }
     };
@@ -1,16 +1,55 @@
 #include "MeshAsset.hpp"
 
+#include "Fyrion/Asset/AssetHandler.hpp"
+#include "Fyrion/Core/Attributes.hpp"
+#include "Fyrion/Core/Logger.hpp"
+#include "Fyrion/Core/Registry.hpp"
 #include "Fyrion/Graphics/Graphics.hpp"
+#include "Fyrion/Graphics/MeshOptimizer.hpp"
 #include "Fyrion/Graphics/RenderUtils.hpp"
 
 namespace Fyrion
 {
+    namespace
+    {
+        Logger& logger = Logger::GetLogger("Fyrion::MeshAsset");
+    }
+
+    TypeHandler* MeshImportSettings::GetTypeHandler()
+    {
+        return Registry::FindType<MeshImportSettings>();
+    }
+
+    void MeshImportSettings::RegisterType(NativeTypeHandler<MeshImportSettings>& type)
+    {
+        type.Field<&MeshImportSettings::optimizeMesh>("optimizeMesh").Attribute<UIProperty>();
+        type.Field<&MeshImportSettings::overdrawThreshold>("overdrawThreshold").Attribute<UIProperty>();
+        type.Field<&MeshImportSettings::vertexFormat>("vertexFormat").Attribute<UIProperty>();
+        type.Field<&MeshImportSettings::lodCount>("lodCount").Attribute<UIProperty>();
+        type.Field<&MeshImportSettings::lodReduction>("lodReduction").Attribute<UIProperty>().Attribute<UIFloatProperty>(0.0f, 1.0f);
+        type.Field<&MeshImportSettings::lodMaxError>("lodMaxError").Attribute<UIProperty>().Attribute<UIFloatProperty>(0.0f, 1.0f);
+        type.Field<&MeshImportSettings::generateMeshlets>("generateMeshlets").Attribute<UIProperty>();
+    }
+
     void MeshAsset::SetData(Array<VertexStride>&         p_vertices,
                             Array<u32>&                  p_indices,
                             Array<MeshPrimitive>&        p_primitives,
                             const Array<MaterialAsset*>& p_materials,
                             bool                         missingNormals,
                             bool                         missingTangents)
+    {
+        MeshAssetData data{};
+        BuildData(p_vertices, p_indices, p_primitives, missingNormals, missingTangents, data);
+        data.materials = p_materials;
+        SaveData(data);
+    }
+
+    void MeshAsset::BuildData(Array<VertexStride>&  p_vertices,
+                              Array<u32>&           p_indices,
+                              Array<MeshPrimitive>& p_primitives,
+                              bool                  missingNormals,
+                              bool                  missingTangents,
+                              MeshAssetData&        data) const
     {
         if (missingNormals)
         {
@@ -22,16 +61,193 @@ namespace Fyrion
             RenderUtils::CalcTangents(p_vertices, p_indices, true);
         }
 
-        indicesCount = p_indices.Size();
-        verticesCount = p_vertices.Size();
+        data.sourceVertexCount = p_vertices.Size();
+        data.sourceACMR = MeshOptimizer::CalculateACMR(p_indices, data.sourceVertexCount);
+
+        if (meshImportSettings.optimizeMesh)
+        {
+            Array<u32> remap{};
+            u32 uniqueCount = MeshOptimizer::GenerateVertexRemap(p_vertices, p_indices, remap);
+            MeshOptimizer::RemapIndices(p_indices, remap);
+            MeshOptimizer::RemapVertices(p_vertices, remap, uniqueCount);
+
+            //triangles are only reordered inside of each primitive, the primitive ranges don't change
+            for (const MeshPrimitive& primitive : p_primitives)
+            {
+                Span<u32> primitiveIndices(p_indices.Data() + primitive.firstIndex, primitive.indexCount);
+                MeshOptimizer::OptimizeVertexCache(primitiveIndices);
+                MeshOptimizer::OptimizeOverdraw(primitiveIndices, p_vertices, meshImportSettings.overdrawThreshold);
+            }
+
+            MeshOptimizer::OptimizeVertexFetch(p_vertices, p_indices);
+        }
+
+        const usize lod0IndexCount = p_indices.Size();
+
+        data.verticesCount = p_vertices.Size();
+        data.vertexFormat = meshImportSettings.vertexFormat;
+        data.boundingBox = RenderUtils::CalculateMeshAABB(p_vertices);
+        data.primitives = p_primitives;
+
+        GenerateLODs(p_vertices, p_indices, data);
+        data.indicesCount = p_indices.Size();
+
+        GenerateMeshlets(p_vertices, p_indices, data);
+        data.acmr = MeshOptimizer::CalculateACMR(Span<u32>(p_indices.Data(), lod0IndexCount), data.verticesCount);
+
+        if (data.vertexFormat == MeshVertexFormat::Quantized)
+        {
+            MeshOptimizer::Quantize(p_vertices, data.quantizedVertices);
+        }
+        else
+        {
+            data.vertices = Traits::Move(p_vertices);
+        }
+        data.indices = Traits::Move(p_indices);
+    }
+
+    void MeshAsset::SaveData(const MeshAssetData& data)
+    {
+        boundingBox = data.boundingBox;
+        indicesCount = data.indicesCount;
+        verticesCount = data.verticesCount;
+        vertexFormat = data.vertexFormat;
+        materials = data.materials;
+        primitives = data.primitives;
+        lodPrimitives = data.lodPrimitives;
+        lodErrors = data.lodErrors;
+        meshletCount = data.meshletCount;
+        meshletCache.Clear();
+        meshletBoundsCache.Clear();
+
+        if (vertexFormat == MeshVertexFormat::Quantized)
+        {
+            SaveBuffer(vertices, data.quantizedVertices.Data(), data.quantizedVertices.Size() * sizeof(VertexStrideQuantized));
+        }
+        else
+        {
+            SaveBuffer(vertices, data.vertices.Data(), data.vertices.Size() * sizeof(VertexStride));
+        }
+        SaveBuffer(indices, data.indices.Data(), data.indices.Size() * sizeof(u32));
+        SaveBuffer(meshlets, data.meshlets.Data(), data.meshlets.Size() * sizeof(Meshlet));
+        SaveBuffer(meshletBounds, data.meshletBounds.Data(), data.meshletBounds.Size() * sizeof(MeshletBounds));
+
+        logger.Info("mesh {} imported: ACMR {:.3f} -> {:.3f}, vertices {} -> {}, vertex data {} -> {} bytes, {} LODs, {} meshlets",
+                     GetHandler() != nullptr ? GetHandler()->GetName() : StringView{},
+                     data.sourceACMR,
+                     data.acmr,
+                     data.sourceVertexCount,
+                     verticesCount,
+                     data.sourceVertexCount * sizeof(VertexStride),
+                     verticesCount * MeshOptimizer::GetVertexSize(vertexFormat),
+                     GetLODCount(),
+                     meshletCount);
+    }
+
+    void MeshAsset::GenerateMeshlets(const Array<VertexStride>& p_vertices, Array<u32>& p_indices, MeshAssetData& data) const
+    {
+        data.meshletCount = 0;
+        if (!meshImportSettings.generateMeshlets)
+        {
+            return;
+        }
+
+        Array<Meshlet>&       meshletData = data.meshlets;
+        Array<MeshletBounds>& boundsData = data.meshletBounds;
+
+        //the triangles are reordered inside of each primitive, the LOD primitives get their own meshlets
+        auto build = [&](MeshPrimitive& primitive)
+        {
+            const usize firstMeshlet = meshletData.Size();
+            MeshOptimizer::BuildMeshlets(Span<u32>(p_indices.Data() + primitive.firstIndex, primitive.indexCount), p_vertices, meshletData, boundsData);
+
+            for (usize m = firstMeshlet; m < meshletData.Size(); ++m)
+            {
+                meshletData[m].firstIndex += primitive.firstIndex;
+            }
+
+            primitive.firstMeshlet = static_cast<u32>(firstMeshlet);
+            primitive.meshletCount = static_cast<u32>(meshletData.Size() - firstMeshlet);
+        };
+
+        for (MeshPrimitive& primitive : data.primitives)
+        {
+            build(primitive);
+        }
+
+        for (MeshPrimitive& primitive : data.lodPrimitives)
+        {
+            build(primitive);
+        }
+
+        data.meshletCount = static_cast<u32>(meshletData.Size());
+    }
+
+    void MeshAsset::GenerateLODs(const Array<VertexStride>& p_vertices, Array<u32>& p_indices, MeshAssetData& data) const
+    {
+        Array<MeshPrimitive>& lodPrimitives = data.lodPrimitives;
+        Array<f32>&           lodErrors = data.lodErrors;
+        lodPrimitives.Clear();
+        lodErrors.Clear();
+
+        if (meshImportSettings.lodCount <= 1 || p_indices.Empty())
+        {
+            return;
+        }
+
+        const f32 maxError = Math::Len(data.boundingBox.max - data.boundingBox.min) * meshImportSettings.lodMaxError;
+
+        lodErrors.EmplaceBack(0.0f);
+
+        Array<u32> simplified{};
+        usize      previousFirst = 0; //first primitive of the previous LOD, primitives are read from lodPrimitives after LOD 0
+
+        for (u32 lod = 1; lod < meshImportSettings.lodCount; ++lod)
+        {
+            const usize indexStart = p_indices.Size();
+            const usize primitiveStart = lodPrimitives.Size();
+            f32         lodError = 0.0f;
+            usize       previousIndexCount = 0;
 
-        boundingBox = RenderUtils::CalculateMeshAABB(p_vertices);
+            for (usize p = 0; p < data.primitives.Size(); ++p)
+            {
+                const MeshPrimitive previous = lod == 1 ? data.primitives[p] : lodPrimitives[previousFirst + p];
+                const usize         targetIndexCount = static_cast<usize>(static_cast<f32>(previous.indexCount / 3) * meshImportSettings.lodReduction) * 3;
 
-        materials = p_materials;
-        primitives = p_primitives;
+                //each LOD simplifies the previous one, so the errors add up
+                Span<u32> source(p_indices.Data() + previous.firstIndex, previous.indexCount);
+                lodError = Math::Max(lodError, MeshOptimizer::Simplify(source, p_vertices, targetIndexCount, maxError, simplified));
+                MeshOptimizer::OptimizeVertexCache(simplified);
 
-        SaveBuffer(vertices, p_vertices.Data(), p_vertices.Size() * sizeof(VertexStride));
-        SaveBuffer(indices, p_indices.Data(), p_indices.Size() * sizeof(u32));
+                lodPrimitives.EmplaceBack(MeshPrimitive{
+                    .firstIndex = static_cast<u32>(p_indices.Size()),
+                    .indexCount = static_cast<u32>(simplified.Size()),
+                    .materialIndex = previous.materialIndex
+                });
+
+                for (u32 index : simplified)
+                {
+                    p_indices.EmplaceBack(index);
+                }
+                previousIndexCount += previous.indexCount;
+            }
+
+            //stop when the simplification can't remove enough triangles within the max error
+            if (static_cast<f32>(p_indices.Size() - indexStart) > static_cast<f32>(previousIndexCount) * 0.95f)
+            {
+                p_indices.Resize(indexStart);
+                lodPrimitives.Resize(primitiveStart);
+                break;
+            }
+
+            lodErrors.EmplaceBack(lodErrors.Back() + lodError);
+            previousFirst = primitiveStart;
+        }
+
+        if (lodErrors.Size() == 1)
+        {
+            lodErrors.Clear();
+        }
     }
 
     Span<MeshPrimitive> MeshAsset::GetPrimitives() const
@@ -39,11 +255,58 @@ namespace Fyrion
         return primitives;
     }
 
+    Span<MeshPrimitive> MeshAsset::GetPrimitives(u32 lod) const
+    {
+        if (lod == 0)
+        {
+            return primitives;
+        }
+        Span<MeshPrimitive> lodSpan = lodPrimitives;
+        return Span<MeshPrimitive>(lodSpan.begin() + (lod - 1) * primitives.Size(), primitives.Size());
+    }
+
+    u32 MeshAsset::GetLODCount() const
+    {
+        return lodErrors.Empty() ? 1 : static_cast<u32>(lodErrors.Size());
+    }
+
+    f32 MeshAsset::GetLODError(u32 lod) const
+    {
+        return lod < lodErrors.Size() ? lodErrors[lod] : 0.0f;
+    }
+
+    u32 MeshAsset::GetMeshletCount() const
+    {
+        return meshletCount;
+    }
+
+    Span<Meshlet> MeshAsset::GetMeshlets()
+    {
+        if (meshletCache.Size() != meshletCount)
+        {
+            meshletCache.Resize(meshletCount);
+            AssetBufferView data = MapBuffer(meshlets);
+            MemCopy(meshletCache.Data(), data.Data(), meshletCount * sizeof(Meshlet));
+        }
+        return meshletCache;
+    }
+
+    Span<MeshletBounds> MeshAsset::GetMeshletBounds()
+    {
+        if (meshletBoundsCache.Size() != meshletCount)
+        {
+            meshletBoundsCache.Resize(meshletCount);
+            AssetBufferView data = MapBuffer(meshletBounds);
+            MemCopy(meshletBoundsCache.Data(), data.Data(), meshletCount * sizeof(MeshletBounds));
+        }
+        return meshletBoundsCache;
+    }
+
     Buffer MeshAsset::GetVertexBuffer()
     {
         if (!vertexBuffer)
         {
-            Array<u8> data = LoadBuffer(vertices);
+            AssetBufferView data = MapBuffer(vertices);
 
             BufferCreation creation{
                 .usage = BufferUsage::VertexBuffer,
@@ -66,7 +329,7 @@ namespace Fyrion
     {
         if (!indexBuffer)
         {
-            Array<u8> data = LoadBuffer(indices);
+            AssetBufferView data = MapBuffer(indices);
 
             BufferCreation creation{
                 .usage = BufferUsage::IndexBuffer,
@@ -91,6 +354,16 @@ namespace Fyrion
         return materials;
     }
 
+    const AABB& MeshAsset::GetBoundingBox() const
+    {
+        return boundingBox;
+    }
+
+    MeshVertexFormat MeshAsset::GetVertexFormat() const
+    {
+        return vertexFormat;
+    }
+
     MeshAsset::~MeshAsset()
     {
         if (vertexBuffer)
@@ -106,12 +379,19 @@ namespace Fyrion
 
     void MeshAsset::RegisterType(NativeTypeHandler<MeshAsset>& type)
     {
-        type.Attribute<AssetMeta>(AssetMeta{.displayName = "Mesh"});
+        type.Attribute<AssetMeta>(AssetMeta{.displayName = "Mesh", .importSettings = GetTypeID<MeshImportSettings>()});
+        type.Field<&MeshAsset::meshImportSettings>("importSettings").Attribute<UIProperty>();
         type.Field<&MeshAsset::boundingBox>("boundingBox");
         type.Field<&MeshAsset::indicesCount>("indicesCount");
         type.Field<&MeshAsset::verticesCount>("verticesCount");
+        type.Field<&MeshAsset::vertexFormat>("vertexFormat");
         type.Field<&MeshAsset::materials>("materials");
         type.Field<&MeshAsset::primitives>("primitives");
+        type.Field<&MeshAsset::lodPrimitives>("lodPrimitives");
+        type.Field<&MeshAsset::lodErrors>("lodErrors");
+        type.Field<&MeshAsset::meshletCount>("meshletCount");
+        type.Field<&MeshAsset::meshlets>("meshlets");
+        type.Field<&MeshAsset::meshletBounds>("meshletBounds");
         type.Field<&MeshAsset::vertices>("vertices");
         type.Field<&MeshAsset::indices>("indices");
     }
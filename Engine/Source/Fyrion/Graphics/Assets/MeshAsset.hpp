@@ -1,9 +1,47 @@
 #pragma once
 #include "MaterialAsset.hpp"
 #include "Fyrion/Asset/Asset.hpp"
+#include "Fyrion/Asset/AssetTypes.hpp"
 
 namespace Fyrion
 {
+    struct FY_API MeshImportSettings : ImportSettings
+    {
+        TypeHandler* GetTypeHandler() override;
+
+        bool             optimizeMesh = true;
+        f32              overdrawThreshold = 1.05f;
+        MeshVertexFormat vertexFormat = MeshVertexFormat::Full;
+        u32              lodCount = 4;
+        f32              lodReduction = 0.5f; //index count of each LOD relative to the previous one
+        f32              lodMaxError = 0.05f; //relative to the mesh size
+        bool             generateMeshlets = true;
+
+        static void RegisterType(NativeTypeHandler<MeshImportSettings>& type);
+    };
+
+    //output of MeshAsset::BuildData, applied to the asset and written to the asset buffers by SaveData
+    struct MeshAssetData
+    {
+        AABB                         boundingBox{};
+        u32                          indicesCount = 0;
+        usize                        verticesCount = 0;
+        MeshVertexFormat             vertexFormat = MeshVertexFormat::Full;
+        Array<MaterialAsset*>        materials{};
+        Array<MeshPrimitive>         primitives{};
+        Array<MeshPrimitive>         lodPrimitives{};
+        Array<f32>                   lodErrors{};
+        u32                          meshletCount = 0;
+        Array<VertexStride>          vertices{};
+        Array<VertexStrideQuantized> quantizedVertices{};
+        Array<u32>                   indices{};
+        Array<Meshlet>               meshlets{};
+        Array<MeshletBounds>         meshletBounds{};
+        usize                        sourceVertexCount = 0;
+        f32                          sourceACMR = 0.0f;
+        f32                          acmr = 0.0f;
+    };
+
     class FY_API MeshAsset : public Asset
     {
     public:
@@ -20,23 +58,53 @@ namespace Fyrion
                      bool                         missingNormals,
                      bool                         missingTangents);
 
+        //BuildData doesn't change the asset, meshes can be built concurrently. SaveData applies the data and writes the asset buffers.
+        void BuildData(Array<VertexStride>&  p_vertices,
+                       Array<u32>&           p_indices,
+                       Array<MeshPrimitive>& p_primitives,
+                       bool                  missingNormals,
+                       bool                  missingTangents,
+                       MeshAssetData&        data) const;
+        void SaveData(const MeshAssetData& data);
+
         Span<MeshPrimitive>  GetPrimitives() const;
+        Span<MeshPrimitive>  GetPrimitives(u32 lod) const;
+        u32                  GetLODCount() const;
+        f32                  GetLODError(u32 lod) const;
         Span<MaterialAsset*> GetMaterials() const;
+        const AABB&          GetBoundingBox() const;
+        MeshVertexFormat     GetVertexFormat() const;
+        u32                  GetMeshletCount() const;
+        Span<Meshlet>        GetMeshlets();
+        Span<MeshletBounds>  GetMeshletBounds();
 
         Buffer GetVertexBuffer();
         Buffer GetIndexBuffeer();
 
     private:
+        MeshImportSettings    meshImportSettings{};
         AABB                  boundingBox;
         u32                   indicesCount = 0;
         usize                 verticesCount = 0;
+        MeshVertexFormat      vertexFormat = MeshVertexFormat::Full;
         Array<MaterialAsset*> materials;
         Array<MeshPrimitive>  primitives{};
+        Array<MeshPrimitive>  lodPrimitives{}; //primitives of the LODs after the first one, in LOD order
+        Array<f32>            lodErrors{};     //object space error of each LOD
+        u32                   meshletCount = 0;
         AssetBuffer                  vertices{};
         AssetBuffer                  indices{};
+        AssetBuffer                  meshlets{};
+        AssetBuffer                  meshletBounds{};
 
 
         Buffer vertexBuffer{};
         Buffer indexBuffer{};
+
+        Array<Meshlet>       meshletCache{};
+        Array<MeshletBounds> meshletBoundsCache{};
+
+        void GenerateLODs(const Array<VertexStride>& p_vertices, Array<u32>& p_indices, MeshAssetData& data) const;
+        void GenerateMeshlets(const Array<VertexStride>& p_vertices, Array<u32>& p_indices, MeshAssetData& data) const;
     };
 }
@@ -1,6 +1,7 @@
 #include "ShaderAsset.hpp"
 
 #include "Fyrion/Asset/AssetTypes.hpp"
+#include "Fyrion/Core/JobSystem.hpp"
 #include "Fyrion/Core/Logger.hpp"
 #include "Fyrion/Graphics/Graphics.hpp"
 #include "Fyrion/Graphics/ShaderManager.hpp"
@@ -11,123 +12,168 @@ namespace Fyrion
     namespace
     {
         Logger& logger = Logger::GetLogger("Fyrion::ShaderAsset");
-    }
 
-    void ShaderAsset::Compile()
-    {
-        Array<u8>              bytes{};
-        Array<ShaderStageInfo> tempStages{};
+        struct ShaderCompilation
+        {
+            ShaderAsset*           shader{};
+            String                 source{};
+            RenderApiType          renderApi{};
+            u64                    cacheKey{};
+            Array<ShaderStageInfo> stages{};
+            Array<u8>              bytes{};
+            ShaderInfo             shaderInfo{};
+            bool                   compiled = false;
+            JobCounter             counter{};
+        };
+
+        void CompileStages(VoidPtr userData)
+        {
+            ShaderCompilation& compilation = *static_cast<ShaderCompilation*>(userData);
 
-        RenderApiType renderApi = Graphics::GetRenderApi();
-        String source = FileSystem::ReadFileAsString(GetHandler()->GetAbsolutePath());
+            Array<ShaderCreation> shaderCreations{};
+            Array<Array<u8>>      stageBytes(compilation.stages.Size());
+            for (const ShaderStageInfo& stage : compilation.stages)
+            {
+                shaderCreations.EmplaceBack(ShaderCreation{
+                    .asset = compilation.shader,
+                    .source = compilation.source,
+                    .entryPoint = stage.entryPoint,
+                    .shaderStage = stage.stage,
+                    .renderApi = compilation.renderApi
+                });
+            }
 
-        if (shaderType == ShaderAssetType::Graphics)
-        {
-            if (!ShaderManager::CompileShader(ShaderCreation{.asset = this, .source = source, .entryPoint = "MainVS", .shaderStage = ShaderStage::Vertex, .renderApi = renderApi}, bytes))
+            if (!ShaderManager::CompileShaders(shaderCreations, stageBytes))
             {
                 return;
             }
 
-            tempStages.EmplaceBack(ShaderStageInfo{
-                .stage = ShaderStage::Vertex,
-                .entryPoint = "MainVS",
-                .offset = 0,
-                .size = (u32)bytes.Size()
-            });
-
-            u32 offset = (u32)bytes.Size();
-
-            if (!ShaderManager::CompileShader(ShaderCreation{.asset = this, .source = source, .entryPoint = "MainPS", .shaderStage = ShaderStage::Pixel, .renderApi = renderApi}, bytes))
+            for (usize i = 0; i < compilation.stages.Size(); ++i)
             {
-                return;
+                compilation.stages[i].offset = (u32)compilation.bytes.Size();
+                compilation.stages[i].size = (u32)stageBytes[i].Size();
+                compilation.bytes.Insert(compilation.bytes.end(), stageBytes[i].begin(), stageBytes[i].end());
             }
 
-            tempStages.EmplaceBack(ShaderStageInfo{
-                .stage = ShaderStage::Pixel,
-                .entryPoint = "MainPS",
-                .offset = offset,
-                .size = (u32)bytes.Size() - offset
-            });
+            compilation.shaderInfo = ShaderManager::ExtractShaderInfo(compilation.bytes, compilation.stages, compilation.renderApi);
+            ShaderManager::SaveToCache(compilation.cacheKey, compilation.bytes, compilation.stages, compilation.shaderInfo);
+            compilation.compiled = true;
+        }
+    }
 
-            offset = (u32)bytes.Size();
+    void ShaderAsset::Compile()
+    {
+        ShaderAsset* shader = this;
+        CompileShaders({&shader, 1});
+    }
+
+    void ShaderAsset::CompileShaders(Span<ShaderAsset*> shaders)
+    {
+        RenderApiType renderApi = Graphics::GetRenderApi();
+
+        Array<ShaderCompilation*> compilations{};
+        compilations.Reserve(shaders.Size());
 
+        //sources, includes and the cache are resolved here, only the stages missing in the cache are compiled on the job system
+        for (ShaderAsset* shader : shaders)
+        {
+            ShaderCompilation* compilation = MemoryGlobals::GetDefaultAllocator().Alloc<ShaderCompilation>();
+            compilation->shader = shader;
+            compilation->renderApi = renderApi;
+            compilation->source = FileSystem::ReadFileAsString(shader->GetHandler()->GetAbsolutePath());
+            compilations.EmplaceBack(compilation);
 
-            std::string_view str = {source.CStr(), source.Size()};
-            if (str.find("MainGS") != std::string_view::npos)
+            if (shader->shaderType == ShaderAssetType::Graphics)
             {
-                if (!ShaderManager::CompileShader(ShaderCreation{.asset = this, .source = source, .entryPoint = "MainGS", .shaderStage = ShaderStage::Geometry, .renderApi = renderApi}, bytes))
+                compilation->stages.EmplaceBack(ShaderStageInfo{.stage = ShaderStage::Vertex, .entryPoint = "MainVS"});
+                compilation->stages.EmplaceBack(ShaderStageInfo{.stage = ShaderStage::Pixel, .entryPoint = "MainPS"});
+
+                std::string_view str = {compilation->source.CStr(), compilation->source.Size()};
+                if (str.find("MainGS") != std::string_view::npos)
                 {
-                    return;
+                    compilation->stages.EmplaceBack(ShaderStageInfo{.stage = ShaderStage::Geometry, .entryPoint = "MainGS"});
                 }
-
-                tempStages.EmplaceBack(ShaderStageInfo{
-                    .stage = ShaderStage::Geometry,
-                    .entryPoint = "MainGS",
-                    .offset = offset,
-                    .size = (u32)bytes.Size() - offset
-                });
-
-                offset = (u32)bytes.Size();
+            }
+            else if (shader->shaderType == ShaderAssetType::Compute)
+            {
+                compilation->stages.EmplaceBack(ShaderStageInfo{.stage = ShaderStage::Compute, .entryPoint = "MainCS"});
             }
 
-        }
-        else if (shaderType == ShaderAssetType::Compute)
-        {
-            if (!ShaderManager::CompileShader(ShaderCreation{
-                                                 .asset = this,
-                                                 .source = source,
-                                                 .entryPoint = "MainCS",
-                                                 .shaderStage = ShaderStage::Compute,
-                                                 .renderApi = renderApi
-                                             }, bytes))
+            if (compilation->stages.Empty())
             {
-                return;
+                compilation->shaderInfo = ShaderManager::ExtractShaderInfo(compilation->bytes, compilation->stages, renderApi);
+                compilation->compiled = true;
+                continue;
             }
 
-            tempStages.EmplaceBack(ShaderStageInfo{
-                .stage = ShaderStage::Compute,
-                .entryPoint = "MainCS",
-                .size = (u32)bytes.Size()
-            });
+            compilation->cacheKey = ShaderManager::GetCacheKey(shader, compilation->source, compilation->stages, renderApi);
+            if (ShaderManager::LoadFromCache(compilation->cacheKey, compilation->bytes, compilation->stages, compilation->shaderInfo))
+            {
+                compilation->compiled = true;
+                continue;
+            }
 
+            JobSystem::Run(CompileStages, compilation, &compilation->counter);
         }
 
-        stages = Traits::Move(tempStages);
-
-        shaderInfo = ShaderManager::ExtractShaderInfo(bytes, stages, renderApi);
-
-        SaveBuffer(spriv, bytes.Data(), bytes.Size());
-        GetHandler()->Save();
+        HashSet<ShaderAsset*> dependencies{};
 
-        for (PipelineState pipelineState : pipelineDependencies)
+        //each shader recreates its pipelines as soon as its own stages are done
+        for (ShaderCompilation* compilation : compilations)
         {
-            if (shaderType == ShaderAssetType::Graphics)
-            {
-                Graphics::CreateGraphicsPipelineState({
-                    .shader = this,
-                    .pipelineState = pipelineState
-                });
-            }
-            else if (shaderType == ShaderAssetType::Compute)
+            JobSystem::Wait(compilation->counter);
+
+            ShaderAsset* shader = compilation->shader;
+            if (compilation->compiled)
             {
-                Graphics::CreateComputePipelineState({
-                    .shader = this,
-                    .pipelineState = pipelineState
-                });
-            }
-        }
+                shader->stages = Traits::Move(compilation->stages);
+                shader->shaderInfo = Traits::Move(compilation->shaderInfo);
 
-        for (const auto it : shaderDependencies)
-        {
-            it.first->Compile();
+                shader->SaveBuffer(shader->spriv, compilation->bytes.Data(), compilation->bytes.Size());
+                shader->GetHandler()->Save();
+
+                for (PipelineState pipelineState : shader->pipelineDependencies)
+                {
+                    if (shader->shaderType == ShaderAssetType::Graphics)
+                    {
+                        Graphics::CreateGraphicsPipelineState({
+                            .shader = shader,
+                            .pipelineState = pipelineState
+                        });
+                    }
+                    else if (shader->shaderType == ShaderAssetType::Compute)
+                    {
+                        Graphics::CreateComputePipelineState({
+                            .shader = shader,
+                            .pipelineState = pipelineState
+                        });
+                    }
+                }
+
+                for (const auto it : shader->shaderDependencies)
+                {
+                    dependencies.Insert(it.first);
+                }
+
+                for (const auto it : shader->bindingSetDependencies)
+                {
+                    it.first->Reload();
+                }
+            }
+            MemoryGlobals::GetDefaultAllocator().DestroyAndFree(compilation);
         }
 
-        for(const auto it: bindingSetDependencies)
+        //shaders that include the compiled ones are recompiled together
+        if (!dependencies.Empty())
         {
-            it.first->Reload();
+            Array<ShaderAsset*> dependentShaders{};
+            dependentShaders.Reserve(dependencies.Size());
+            for (const auto it : dependencies)
+            {
+                dependentShaders.EmplaceBack(it.first);
+            }
+            CompileShaders(dependentShaders);
         }
-
-       // logger.Debug("Shader {} compiled sucessfully", GetPath());
     }
 
     void ShaderAsset::AddPipelineDependency(PipelineState pipelineState)
@@ -179,9 +225,9 @@ namespace Fyrion
         return stages;
     }
 
-    Array<u8> ShaderAsset::GetBytes() const
+    AssetBufferView ShaderAsset::GetBytes() const
     {
-        return LoadBuffer(spriv);
+        return MapBuffer(spriv);
     }
 
     bool ShaderAsset::IsCompiled() const
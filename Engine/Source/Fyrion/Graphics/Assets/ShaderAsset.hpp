@@ -36,11 +36,14 @@ namespace Fyrion
         }
 
         Span<ShaderStageInfo> GetStages() const;
-        Array<u8>             GetBytes() const;
+        AssetBufferView       GetBytes() const;
 
         bool IsCompiled() const;
         void Compile();
 
+        //compiles the shaders in parallel, pipelines of each shader are recreated as soon as it finishes.
+        static void CompileShaders(Span<ShaderAsset*> shaders);
+
         void AddPipelineDependency(PipelineState pipelineState);
         void AddShaderDependency(ShaderAsset* shaderAsset);
         void AddBindingSetDependency(BindingSet* bindingSet);
@@ -1,9 +1,8 @@
 #include "TextureAsset.hpp"
 
-#include <stb_image_resize.h>
-
 #include "Fyrion/Core/Attributes.hpp"
 #include "Fyrion/Core/Image.hpp"
+#include "Fyrion/Core/Logger.hpp"
 #include "Fyrion/Graphics/Graphics.hpp"
 #include "Fyrion/Graphics/Assets/ShaderAsset.hpp"
 
@@ -17,6 +16,116 @@ namespace Fyrion
         ConstPtr      bytes;
     };
 
+    namespace
+    {
+        Logger& logger = Logger::GetLogger("Fyrion::TextureAsset");
+
+        template<typename T>
+        struct CookedTexture
+        {
+            Array<TextureAssetImage> images{};
+            Array<T>                 mips{};
+            Array<u8>                blocks{};
+        };
+
+        Format GetCompressedFormat(TextureCompression compression)
+        {
+            switch (compression)
+            {
+                case TextureCompression::BC1: return Format::BC1;
+                case TextureCompression::BC3: return Format::BC3;
+                case TextureCompression::BC4: return Format::BC4;
+                case TextureCompression::BC5: return Format::BC5;
+                case TextureCompression::BC6H: return Format::BC6H;
+                case TextureCompression::BC7: return Format::BC7;
+                case TextureCompression::None:
+                    break;
+            }
+            return Format::Undefined;
+        }
+
+        //builds the mip chain as RGBA, each mip is filtered from the previous one.
+        //if compressedFormat is not Undefined, the chain is also encoded to blocks.
+        template<typename T>
+        CookedTexture<T> CookTexture(const TImage<T>& image, const TextureImportSettings& settings, Format compressedFormat)
+        {
+            const Extent extent{image.GetWidth(), image.GetHeight()};
+            const u32    mipLevels = settings.generateMipmaps ? TextureCooker::GetMipLevels(extent) : 1;
+            const u32    channels = image.GetChannels();
+
+            CookedTexture<T> cooked{};
+
+            usize pixelCount = 0;
+            for (u32 mip = 0; mip < mipLevels; ++mip)
+            {
+                Extent mipExtent = TextureCooker::GetMipExtent(extent, mip);
+                pixelCount += mipExtent.width * mipExtent.height;
+            }
+            cooked.mips.Resize(pixelCount * 4);
+
+            Span<T> pixels = image.GetData();
+            if (channels == 4)
+            {
+                MemCopy(cooked.mips.Data(), pixels.Data(), pixels.Size() * sizeof(T));
+            }
+            else
+            {
+                //grayscale images are expanded to RGBA
+                for (usize i = 0; i < extent.width * extent.height; ++i)
+                {
+                    const T* source = pixels.Data() + i * channels;
+                    T*       pixel = cooked.mips.Data() + i * 4;
+                    pixel[0] = source[0];
+                    pixel[1] = channels >= 3 ? source[1] : source[0];
+                    pixel[2] = channels >= 3 ? source[2] : source[0];
+                    pixel[3] = channels == 2 ? source[1] : static_cast<T>(sizeof(T) == 1 ? 255 : 1);
+                }
+            }
+
+            usize offset = 0;
+            for (u32 mip = 0; mip < mipLevels; ++mip)
+            {
+                const Extent mipExtent = TextureCooker::GetMipExtent(extent, mip);
+                const usize  size = mipExtent.width * mipExtent.height * 4;
+                if (mip + 1 < mipLevels)
+                {
+                    TextureCooker::GenerateMip(settings.mipFilter, cooked.mips.Data() + offset, mipExtent, cooked.mips.Data() + offset + size);
+                }
+
+                cooked.images.EmplaceBack(TextureAssetImage{
+                    .byteOffset = static_cast<u32>(offset * sizeof(T)),
+                    .mip = mip,
+                    .arrayLayer = 0,
+                    .extent = mipExtent,
+                    .size = size * sizeof(T)
+                });
+                offset += size;
+            }
+
+            if (compressedFormat != Format::Undefined)
+            {
+                usize blocksSize = 0;
+                for (TextureAssetImage& textureImage : cooked.images)
+                {
+                    blocksSize += TextureCooker::GetImageSize(compressedFormat, textureImage.extent);
+                }
+                cooked.blocks.Resize(blocksSize);
+
+                usize blockOffset = 0;
+                for (TextureAssetImage& textureImage : cooked.images)
+                {
+                    TextureCooker::Compress(compressedFormat, cooked.mips.Data() + textureImage.byteOffset / sizeof(T), textureImage.extent, cooked.blocks.Data() + blockOffset);
+
+                    textureImage.byteOffset = static_cast<u32>(blockOffset);
+                    textureImage.size = TextureCooker::GetImageSize(compressedFormat, textureImage.extent);
+                    blockOffset += textureImage.size;
+                }
+            }
+
+            return cooked;
+        }
+    }
+
 
     TypeHandler* TextureImportSettings::GetTypeHandler()
     {
@@ -26,7 +135,9 @@ namespace Fyrion
     void TextureImportSettings::RegisterType(NativeTypeHandler<TextureImportSettings>& type)
     {
         type.Field<&TextureImportSettings::generateMipmaps>("generateMipmaps");
+        type.Field<&TextureImportSettings::mipFilter>("mipFilter");
         type.Field<&TextureImportSettings::textureType>("textureType");
+        type.Field<&TextureImportSettings::compression>("compression");
     }
 
     void TextureAssetImage::RegisterType(NativeTypeHandler<TextureAssetImage>& type)
@@ -65,57 +176,34 @@ namespace Fyrion
 
     void TextureAsset::SetImage(const Image& image)
     {
-        mipLevels = textureImportSettings.generateMipmaps ? static_cast<u32>(std::floor(std::log2(std::max(image.GetWidth(), image.GetHeight())))) + 1 : 1;
-
-        format = Format::RGBA;
-        images.Clear();
-
-        arrayLayers = 1;
+        SetCookedImage(CookImage(image));
+    }
 
-        usize bytesSize{};
-        //calc bytes
+    TextureCookedImage TextureAsset::CookImage(const Image& image) const
+    {
+        Format compressedFormat = GetCompressedFormat(textureImportSettings.compression);
+        if (compressedFormat == Format::BC6H)
         {
-            u32 mipWidth = image.GetWidth();
-            u32 mipHeight = image.GetHeight();
-            for (u32 i = 0; i < mipLevels; i++)
-            {
-                bytesSize += mipWidth * mipHeight * image.GetChannels();
-                if (mipWidth > 1) mipWidth /= 2;
-                if (mipHeight > 1) mipHeight /= 2;
-            }
+            logger.Warn("BC6H compression requires a HDR image, texture will not be compressed");
+            compressedFormat = Format::Undefined;
         }
 
-        Array<u8> byteImages{};
-        byteImages.Resize(bytesSize);
-
-        i32 mipWidth = image.GetWidth();
-        i32 mipHeight = image.GetHeight();
-        u32 offset{};
+        CookedTexture<u8> cooked = CookTexture(image, textureImportSettings, compressedFormat);
 
-        for (u32 i = 0; i < mipLevels; i++)
-        {
-            images.EmplaceBack(TextureAssetImage{
-                .byteOffset = offset,
-                .mip = i,
-                .arrayLayer = 0,
-                .extent = Extent{static_cast<u32>(mipWidth), static_cast<u32>(mipHeight)},
-                .size = static_cast<usize>(mipWidth * mipHeight * image.GetChannels())
-            });
-
-            memcpy(byteImages.Data() + offset, image.GetData().begin(), mipWidth * mipHeight * image.GetChannels());
-
-            if (mipWidth > 1 && mipHeight > 1)
-            {
-                stbir_resize_uint8(byteImages.Data() + offset, mipWidth, mipHeight, 0, image.GetData().begin(), mipWidth / 2, mipHeight / 2, 0, image.GetChannels());
-            }
-
-            offset += mipWidth * mipHeight * image.GetChannels();
-
-            if (mipWidth > 1) mipWidth /= 2;
-            if (mipHeight > 1) mipHeight /= 2;
-        }
+        return TextureCookedImage{
+            .format = compressedFormat != Format::Undefined ? compressedFormat : Format::RGBA,
+            .images = Traits::Move(cooked.images),
+            .data = !cooked.blocks.Empty() ? Traits::Move(cooked.blocks) : Traits::Move(cooked.mips)
+        };
+    }
 
-        SaveBuffer(textureData, byteImages.Data(), byteImages.Size());
+    void TextureAsset::SetCookedImage(const TextureCookedImage& cooked)
+    {
+        format = cooked.format;
+        mipLevels = cooked.images.Size();
+        arrayLayers = 1;
+        images = cooked.images;
+        SaveBuffer(textureData, cooked.data.Data(), cooked.data.Size());
     }
 
     void TextureAsset::SetHDRImage(const HDRImage& image)
@@ -127,18 +215,28 @@ namespace Fyrion
         {
             case TextureType::Texture2D:
             {
-                arrayLayers = 1;
+                Format compressedFormat = GetCompressedFormat(textureImportSettings.compression);
+                if (compressedFormat != Format::Undefined && compressedFormat != Format::BC6H)
+                {
+                    logger.Warn("HDR images can only be compressed to BC6H, texture will not be compressed");
+                    compressedFormat = Format::Undefined;
+                }
 
-                images.EmplaceBack(TextureAssetImage{
-                    .byteOffset = 0,
-                    .mip = 0,
-                    .arrayLayer = 0,
-                    .extent = Extent{image.GetWidth(), image.GetHeight()},
-                    .size = static_cast<usize>(image.GetWidth() * image.GetHeight() * image.GetChannels())
-                });
+                CookedTexture<f32> cooked = CookTexture(image, textureImportSettings, compressedFormat);
 
-                SaveBuffer(textureData, image.GetData().Data(), image.GetData().Size() * sizeof(f32));
+                format = compressedFormat != Format::Undefined ? compressedFormat : Format::RGBA32F;
+                mipLevels = cooked.images.Size();
+                arrayLayers = 1;
+                images = Traits::Move(cooked.images);
 
+                if (!cooked.blocks.Empty())
+                {
+                    SaveBuffer(textureData, cooked.blocks.Data(), cooked.blocks.Size());
+                }
+                else
+                {
+                    SaveBuffer(textureData, cooked.mips.Data(), cooked.mips.Size() * sizeof(f32));
+                }
                 break;
             }
             case TextureType::Texture3D:
@@ -197,7 +295,13 @@ namespace Fyrion
 
     Texture TextureAsset::CreateTexture() const
     {
-        Array<u8> textureBytes = LoadBuffer(textureData);
+        if (TextureCooker::IsCompressed(format) && !Graphics::GetDeviceFeatures().textureCompressionBCSupported)
+        {
+            logger.Error("BC texture compression is not supported by the device");
+            return {};
+        }
+
+        AssetBufferView textureBytes = MapBuffer(textureData);
         if (textureBytes.Size() == 0)
         {
             return {};
@@ -260,6 +364,12 @@ namespace Fyrion
 
     Image TextureAsset::GetImage() const
     {
+        if (TextureCooker::IsCompressed(format))
+        {
+            logger.Error("GetImage is not supported for compressed textures");
+            return {};
+        }
+
         Image image{images[0].extent.width, images[0].extent.height, 4};
         image.data = Traits::Move(LoadBuffer(textureData));
         return image;
@@ -3,6 +3,7 @@
 #include "Fyrion/Asset/AssetTypes.hpp"
 #include "Fyrion/Core/Image.hpp"
 #include "Fyrion/Graphics/GraphicsTypes.hpp"
+#include "Fyrion/Graphics/TextureCooker.hpp"
 
 namespace Fyrion
 {
@@ -15,12 +16,25 @@ namespace Fyrion
         Cubemap
     };
 
+    enum class TextureCompression
+    {
+        None,
+        BC1,  //RGB
+        BC3,  //RGBA
+        BC4,  //R
+        BC5,  //RG, normal maps
+        BC6H, //RGB HDR
+        BC7   //RGBA, higher quality than BC1 and BC3
+    };
+
     struct FY_API TextureImportSettings : ImportSettings
     {
         TypeHandler* GetTypeHandler() override;
 
-        bool        generateMipmaps = true;
-        TextureType textureType = TextureType::Texture2D;
+        bool               generateMipmaps = true;
+        MipFilter          mipFilter = MipFilter::Kaiser;
+        TextureType        textureType = TextureType::Texture2D;
+        TextureCompression compression = TextureCompression::None;
 
         static void RegisterType(NativeTypeHandler<TextureImportSettings>& type);
     };
@@ -36,6 +50,14 @@ namespace Fyrion
         static void RegisterType(NativeTypeHandler<TextureAssetImage>& type);
     };
 
+    //output of TextureAsset::CookImage, data has the mips or the compressed blocks
+    struct TextureCookedImage
+    {
+        Format                   format{Format::RGBA};
+        Array<TextureAssetImage> images{};
+        Array<u8>                data{};
+    };
+
     class FY_API TextureAsset : public Asset
     {
     public:
@@ -46,6 +68,7 @@ namespace Fyrion
         void       SetImagePath(StringView path);
         void       SetHDRImagePath(StringView path);
         void       SetImage(const Image& image);
+        void       SetCookedImage(const TextureCookedImage& cooked);
         void       SetHDRImage(const HDRImage& image);
         Texture    CreateTexture() const;
         Texture    GetTexture();
@@ -53,6 +76,9 @@ namespace Fyrion
         Image      GetImage() const;
         Format     GetFormat() const;
 
+        //doesn't change the asset, textures can be cooked concurrently and set later with SetCookedImage
+        TextureCookedImage CookImage(const Image& image) const;
+
         void SetTextureType(TextureType textureType);
 
         static void RegisterType(NativeTypeHandler<TextureAsset>& type);
@@ -1,6 +1,7 @@
 namespace Fyrion
 {
 
+    void RegisterMeshletCullingPass();
     void RegisterSceneRenderPass();
     void RegisterSkyboxGenRenderPass();
     void RegisterShadowMapRenderPass();
@@ -11,6 +12,7 @@ namespace Fyrion
 
     void DefaultRenderPipelineInit()
     {
+        RegisterMeshletCullingPass();
         RegisterSceneRenderPass();
         RegisterSkyboxGenRenderPass();
         RegisterShadowMapRenderPass();
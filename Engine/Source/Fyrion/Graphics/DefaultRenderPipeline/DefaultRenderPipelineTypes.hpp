@@ -1,5 +1,6 @@
 #pragma once
 #include "Fyrion/Core/Math.hpp"
+#include "Fyrion/Graphics/DrawList.hpp"
 
 #define FY_SHADOW_MAP_CASCADE_COUNT 4
 #define FY_SHADOW_MAP_DIM 4096
@@ -11,4 +12,21 @@ namespace Fyrion
         f32  cascadeSplit[FY_SHADOW_MAP_CASCADE_COUNT];
         Mat4 cascadeViewProjMat[FY_SHADOW_MAP_CASCADE_COUNT];
     };
+
+    struct MeshletDrawBatch
+    {
+        MeshAsset*     mesh;
+        MaterialAsset* material;
+        u32            firstCommand;
+        u32            commandCount;
+    };
+
+    //draws of the frame written by the MeshletCullingPass
+    struct MeshletDrawData
+    {
+        Buffer                  transforms{}; //instance transforms, indexed by the draw firstInstance
+        Buffer                  commands{};   //DrawIndexedIndirectCommand, culled meshlets have instanceCount 0
+        Array<MeshletDrawBatch> batches{};
+        Array<DrawCommand>      directDraws{}; //meshes without meshlets or devices without multi draw indirect
+    };
 }
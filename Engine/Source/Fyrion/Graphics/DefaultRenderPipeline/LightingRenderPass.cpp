@@ -1,5 +1,6 @@
 #include "DefaultRenderPipelineTypes.hpp"
 #include "Fyrion/Graphics/Graphics.hpp"
+#include "Fyrion/Graphics/LightCulling.hpp"
 #include "Fyrion/Graphics/RenderGraph.hpp"
 #include "Fyrion/Graphics/RenderStorage.hpp"
 #include "Fyrion/Graphics/RenderUtils.hpp"
@@ -8,6 +9,14 @@
 
 namespace Fyrion
 {
+    namespace
+    {
+        constexpr usize MinBufferSize = 4096;
+
+        //small light counts are binned on the CPU jobs, it avoids the dispatch and the barrier
+        constexpr usize GPULightCullingThreshold = 256;
+    }
+
     struct DirectionalLightData
     {
         Vec4             direction;
@@ -23,6 +32,29 @@ namespace Fyrion
         Mat4                 view{};
         DirectionalLightData directionalLight[4];
         u32                  lightCount[4] = {};
+        Mat4                 projection{};
+        Vec4                 clusterClip{}; //x near, y far
+    };
+
+    struct LightCullingData
+    {
+        Mat4 view;
+        Mat4 projectionInverse;
+        Vec4 clip;
+        u32  lightCount[4];
+    };
+
+    struct LightingBuffer
+    {
+        Buffer buffer{};
+        usize  size{};
+    };
+
+    struct LightingFrame
+    {
+        LightingBuffer lights{};
+        LightingBuffer clusters{};
+        LightingBuffer lightIndices{};
     };
 
     class LightingRenderPass : public RenderGraphPass
@@ -34,6 +66,14 @@ namespace Fyrion
         BindingSet*   bindingSet{};
         VoidPtr       skyboxReference{};
 
+        PipelineState lightCullingPSO{};
+        BindingSet*   lightCullingBindingSet{};
+        u32           frame = 0;
+
+        LightingFrame                  frames[FY_FRAMES_IN_FLIGHT]{};
+        Array<LightCulling::LightData> lights{};
+        LightCulling::LightClusterList clusterList{};
+
         DiffuseIrradianceGenerator diffuseIrradianceGenerator;
         BRDFLUTGenerator           brdflutGenerator;
         SpecularMapGenerator       specularMapGenerator;
@@ -49,6 +89,12 @@ namespace Fyrion
             lightingPSO = Graphics::CreateComputePipelineState(creation);
             bindingSet = Graphics::CreateBindingSet(creation.shader);
 
+            ShaderAsset* lightCullingShader = AssetManager::LoadByPath<ShaderAsset>("Fyrion://Shaders/Passes/LightCulling.comp");
+            lightCullingPSO = Graphics::CreateComputePipelineState({
+                .shader = lightCullingShader
+            });
+            lightCullingBindingSet = Graphics::CreateBindingSet(lightCullingShader);
+
             diffuseIrradianceGenerator.Init({64, 64});
             brdflutGenerator.Init({512, 512});
             specularMapGenerator.Init({128, 128}, 6);
@@ -60,6 +106,85 @@ namespace Fyrion
             });
         }
 
+        static void UpdateBuffer(LightingBuffer& buffer, const void* data, usize size)
+        {
+            if (!buffer.buffer || buffer.size < size)
+            {
+                if (buffer.buffer)
+                {
+                    Graphics::WaitQueue();
+                    Graphics::DestroyBuffer(buffer.buffer);
+                }
+
+                buffer.size = Math::Max(Math::Max(size, buffer.size * 2), MinBufferSize);
+                buffer.buffer = Graphics::CreateBuffer(BufferCreation{
+                    .usage = BufferUsage::StorageBuffer,
+                    .size = buffer.size,
+                    .allocation = BufferAllocation::TransferToGPU
+                });
+            }
+
+            if (data != nullptr && size > 0)
+            {
+                Graphics::UpdateBufferData(BufferDataInfo{
+                    .buffer = buffer.buffer,
+                    .data = data,
+                    .size = size
+                });
+            }
+        }
+
+        //point and spot lights binned in the froxel grid, the lighting shader only loops the lights of the pixel cluster
+        void CullLights(RenderCommands& cmd, const CameraData& cameraData)
+        {
+            LightCulling::PackLights(RenderStorage::GetPointLights(), RenderStorage::GetSpotLights(), lights);
+
+            LightingFrame& current = frames[frame];
+            frame = (frame + 1) % FY_FRAMES_IN_FLIGHT;
+
+            UpdateBuffer(current.lights, lights.Data(), lights.Size() * sizeof(LightCulling::LightData));
+
+            if (lights.Size() > GPULightCullingThreshold)
+            {
+                UpdateBuffer(current.clusters, nullptr, LightCulling::ClusterCount * sizeof(LightCulling::LightCluster));
+                UpdateBuffer(current.lightIndices, nullptr, LightCulling::ClusterCount * LightCulling::MaxLightsPerCluster * sizeof(u32));
+
+                LightCullingData cullingData{
+                    .view = cameraData.view,
+                    .projectionInverse = cameraData.projectionInverse,
+                    .clip = Vec4{cameraData.nearClip, cameraData.farClip, 0.0f, 0.0f},
+                    .lightCount = {static_cast<u32>(lights.Size())}
+                };
+
+                lightCullingBindingSet->GetVar("lights")->SetBuffer(current.lights.buffer);
+                lightCullingBindingSet->GetVar("lightClusters")->SetBuffer(current.clusters.buffer);
+                lightCullingBindingSet->GetVar("lightIndices")->SetBuffer(current.lightIndices.buffer);
+                lightCullingBindingSet->GetVar("culling")->SetValue(&cullingData, sizeof(LightCullingData));
+
+                cmd.BindPipelineState(lightCullingPSO);
+                cmd.BindBindingSet(lightCullingPSO, lightCullingBindingSet);
+                cmd.Dispatch(1, 1, LightCulling::ClusterCountZ);
+
+                cmd.ResourceBarrier(ResourceBarrierInfo{
+                    .buffer = current.clusters.buffer
+                });
+
+                cmd.ResourceBarrier(ResourceBarrierInfo{
+                    .buffer = current.lightIndices.buffer
+                });
+            }
+            else
+            {
+                LightCulling::BuildClusters(cameraData, lights, clusterList);
+                UpdateBuffer(current.clusters, clusterList.clusters.Data(), clusterList.clusters.Size() * sizeof(LightCulling::LightCluster));
+                UpdateBuffer(current.lightIndices, clusterList.lightIndices.Data(), clusterList.lightIndices.Size() * sizeof(u32));
+            }
+
+            bindingSet->GetVar("lights")->SetBuffer(current.lights.buffer);
+            bindingSet->GetVar("lightClusters")->SetBuffer(current.clusters.buffer);
+            bindingSet->GetVar("lightIndices")->SetBuffer(current.lightIndices.buffer);
+        }
+
         void Render(f64 deltaTime, RenderCommands& cmd) override
         {
             const CameraData& cameraData = graph->GetCameraData();
@@ -67,6 +192,8 @@ namespace Fyrion
             LightingData data{
                 .viewPos = Math::MakeVec4(cameraData.viewPos, 0.0),
                 .view = cameraData.view,
+                .projection = cameraData.projection,
+                .clusterClip = Vec4{cameraData.nearClip, cameraData.farClip, 0.0f, 0.0f}
             };
 
             if (DirectionalLight* directionalLight = RenderStorage::GetDirectionalLight())
@@ -119,6 +246,8 @@ namespace Fyrion
 
             bindingSet->GetVar("data")->SetValue(&data, sizeof(LightingData));
 
+            CullLights(cmd, cameraData);
+
             cmd.BindPipelineState(lightingPSO);
             cmd.BindBindingSet(lightingPSO, bindingSet);
 
@@ -129,6 +258,20 @@ namespace Fyrion
 
         void Destroy() override
         {
+            Graphics::WaitQueue();
+            for (LightingFrame& frameBuffers : frames)
+            {
+                for (LightingBuffer* buffer : {&frameBuffers.lights, &frameBuffers.clusters, &frameBuffers.lightIndices})
+                {
+                    if (buffer->buffer)
+                    {
+                        Graphics::DestroyBuffer(buffer->buffer);
+                    }
+                }
+            }
+            Graphics::DestroyBindingSet(lightCullingBindingSet);
+            Graphics::DestroyComputePipelineState(lightCullingPSO);
+
             Graphics::DestroySampler(shadowMapSampler);
             Graphics::DestroyBindingSet(bindingSet);
             Graphics::DestroyComputePipelineState(lightingPSO);
@@ -0,0 +1,246 @@
+#include <bit>
+
+#include "DefaultRenderPipelineTypes.hpp"
+#include "Fyrion/Core/FlatHashMap.hpp"
+#include "Fyrion/Core/Registry.hpp"
+#include "Fyrion/Graphics/DrawList.hpp"
+#include "Fyrion/Graphics/Graphics.hpp"
+#include "Fyrion/Graphics/RenderGraph.hpp"
+#include "Fyrion/Graphics/RenderStorage.hpp"
+#include "Fyrion/Graphics/Assets/MeshAsset.hpp"
+#include "Fyrion/Graphics/Assets/ShaderAsset.hpp"
+
+namespace Fyrion
+{
+    namespace
+    {
+        constexpr usize MinBufferSize = 4096;
+    }
+
+    struct MeshletCullingData
+    {
+        Vec4 frustum[6];
+        Vec4 viewPosCommandCount;
+        u32  batchCount[4];
+    };
+
+    struct MeshletCullingBuffer
+    {
+        Buffer buffer{};
+        usize  size{};
+    };
+
+    struct MeshletCullingFrame
+    {
+        MeshletCullingBuffer transforms{};
+        MeshletCullingBuffer meshlets{};
+        MeshletCullingBuffer bounds{};
+        MeshletCullingBuffer batches{};
+        MeshletCullingBuffer batchInstances{};
+        MeshletCullingBuffer commands{};
+    };
+
+    //culls the meshlets of the visible instances in a compute shader and writes the indirect draws of the SceneRenderPass
+    class MeshletCullingPass : public RenderGraphPass
+    {
+    public:
+        FY_BASE_TYPES(RenderGraphPass);
+
+        PipelineState pipelineState{};
+        BindingSet*   bindingSet{};
+        bool          gpuCulling = false;
+        u32           frame = 0;
+
+        DrawList        drawList{};
+        MeshletDrawData drawData{};
+
+        MeshletCullingFrame frames[FY_FRAMES_IN_FLIGHT]{};
+
+        FlatHashMap<MeshAsset*, u32> meshletOffsets{};
+        Array<Meshlet>               meshlets{};
+        Array<MeshletBounds>         bounds{};
+        Array<MeshletBatch>          batches{};
+        Array<u32>                   batchInstances{};
+
+        void Init() override
+        {
+            ShaderAsset* shader = AssetManager::LoadByPath<ShaderAsset>("Fyrion://Shaders/Passes/MeshletCulling.comp");
+
+            pipelineState = Graphics::CreateComputePipelineState({
+                .shader = shader
+            });
+            bindingSet = Graphics::CreateBindingSet(shader);
+            gpuCulling = Graphics::GetDeviceFeatures().multiDrawIndirectSupported;
+
+            node->GetOutputResource("MeshletDrawData")->reference = &drawData;
+        }
+
+        static void UpdateBuffer(MeshletCullingBuffer& buffer, BufferUsage usage, BufferAllocation allocation, const void* data, usize size)
+        {
+            if (!buffer.buffer || buffer.size < size)
+            {
+                if (buffer.buffer)
+                {
+                    Graphics::WaitQueue();
+                    Graphics::DestroyBuffer(buffer.buffer);
+                }
+
+                buffer.size = Math::Max(Math::Max(size, buffer.size * 2), MinBufferSize);
+                buffer.buffer = Graphics::CreateBuffer(BufferCreation{
+                    .usage = usage,
+                    .size = buffer.size,
+                    .allocation = allocation
+                });
+            }
+
+            if (data != nullptr && size > 0)
+            {
+                Graphics::UpdateBufferData(BufferDataInfo{
+                    .buffer = buffer.buffer,
+                    .data = data,
+                    .size = size
+                });
+            }
+        }
+
+        void Render(f64 deltaTime, RenderCommands& cmd) override
+        {
+            const CameraData& cameraData = graph->GetCameraData();
+            const Frustum     frustum = Math::ExtractFrustum(cameraData.projection * cameraData.view);
+
+            MeshRenderList meshRenderList = RenderStorage::GetMeshesToRender();
+            drawList.Build(meshRenderList, frustum, LODSelection::FromCamera(cameraData, graph->GetViewportExtent()));
+
+            drawData.batches.Clear();
+            drawData.directDraws.Clear();
+            meshletOffsets.Clear();
+            meshlets.Clear();
+            bounds.Clear();
+            batches.Clear();
+            batchInstances.Clear();
+
+            //draw commands are sorted by material, mesh and primitive, each run of the same primitive is a batch
+            u32               commandCount = 0;
+            Span<DrawCommand> commands = drawList.GetCommands();
+            for (usize i = 0; i < commands.Size();)
+            {
+                const DrawCommand& draw = commands[i];
+                if (!gpuCulling || draw.meshletCount == 0)
+                {
+                    drawData.directDraws.EmplaceBack(draw);
+                    i++;
+                    continue;
+                }
+
+                auto it = meshletOffsets.Find(draw.mesh);
+                if (it == meshletOffsets.end())
+                {
+                    it = meshletOffsets.Insert(draw.mesh, static_cast<u32>(meshlets.Size())).first;
+                    for (const Meshlet& meshlet : draw.mesh->GetMeshlets())
+                    {
+                        meshlets.EmplaceBack(meshlet);
+                    }
+                    for (const MeshletBounds& meshletBounds : draw.mesh->GetMeshletBounds())
+                    {
+                        bounds.EmplaceBack(meshletBounds);
+                    }
+                }
+
+                MeshletBatch& batch = batches.EmplaceBack(MeshletBatch{
+                    .firstCommand = commandCount,
+                    .firstMeshlet = it->second + draw.firstMeshlet,
+                    .meshletCount = draw.meshletCount,
+                    .firstInstance = static_cast<u32>(batchInstances.Size())
+                });
+
+                for (; i < commands.Size() && commands[i].mesh == draw.mesh && commands[i].material == draw.material && commands[i].firstIndex == draw.firstIndex; ++i)
+                {
+                    batchInstances.EmplaceBack(commands[i].instance);
+                }
+
+                const u32 batchCommandCount = batch.meshletCount * (static_cast<u32>(batchInstances.Size()) - batch.firstInstance);
+
+                drawData.batches.EmplaceBack(MeshletDrawBatch{
+                    .mesh = draw.mesh,
+                    .material = draw.material,
+                    .firstCommand = commandCount,
+                    .commandCount = batchCommandCount
+                });
+                commandCount += batchCommandCount;
+            }
+
+            MeshletCullingFrame& current = frames[frame];
+            frame = (frame + 1) % FY_FRAMES_IN_FLIGHT;
+
+            UpdateBuffer(current.transforms, BufferUsage::StorageBuffer, BufferAllocation::TransferToGPU, meshRenderList.transforms.Data(), meshRenderList.transforms.Size() * sizeof(Mat4));
+            drawData.transforms = current.transforms.buffer;
+
+            if (commandCount == 0)
+            {
+                return;
+            }
+
+            UpdateBuffer(current.meshlets, BufferUsage::StorageBuffer, BufferAllocation::TransferToGPU, meshlets.Data(), meshlets.Size() * sizeof(Meshlet));
+            UpdateBuffer(current.bounds, BufferUsage::StorageBuffer, BufferAllocation::TransferToGPU, bounds.Data(), bounds.Size() * sizeof(MeshletBounds));
+            UpdateBuffer(current.batches, BufferUsage::StorageBuffer, BufferAllocation::TransferToGPU, batches.Data(), batches.Size() * sizeof(MeshletBatch));
+            UpdateBuffer(current.batchInstances, BufferUsage::StorageBuffer, BufferAllocation::TransferToGPU, batchInstances.Data(), batchInstances.Size() * sizeof(u32));
+            UpdateBuffer(current.commands, BufferUsage::StorageBuffer | BufferUsage::IndirectBuffer, BufferAllocation::GPUOnly, nullptr, commandCount * sizeof(DrawIndexedIndirectCommand));
+            drawData.commands = current.commands.buffer;
+
+            MeshletCullingData cullingData{};
+            for (u32 i = 0; i < 6; ++i)
+            {
+                cullingData.frustum[i] = frustum.planes[i];
+            }
+            cullingData.viewPosCommandCount = Vec4{cameraData.viewPos.x, cameraData.viewPos.y, cameraData.viewPos.z, std::bit_cast<f32>(commandCount)};
+            cullingData.batchCount[0] = static_cast<u32>(batches.Size());
+
+            bindingSet->GetVar("transforms")->SetBuffer(current.transforms.buffer);
+            bindingSet->GetVar("meshlets")->SetBuffer(current.meshlets.buffer);
+            bindingSet->GetVar("meshletBounds")->SetBuffer(current.bounds.buffer);
+            bindingSet->GetVar("batches")->SetBuffer(current.batches.buffer);
+            bindingSet->GetVar("batchInstances")->SetBuffer(current.batchInstances.buffer);
+            bindingSet->GetVar("commands")->SetBuffer(current.commands.buffer);
+            bindingSet->GetVar("culling")->SetValue(&cullingData, sizeof(MeshletCullingData));
+
+            cmd.BindPipelineState(pipelineState);
+            cmd.BindBindingSet(pipelineState, bindingSet);
+            cmd.Dispatch((commandCount + 63) / 64, 1, 1);
+
+            cmd.ResourceBarrier(ResourceBarrierInfo{
+                .buffer = current.commands.buffer
+            });
+        }
+
+        void Destroy() override
+        {
+            Graphics::WaitQueue();
+            for (MeshletCullingFrame& frameBuffers : frames)
+            {
+                for (MeshletCullingBuffer* buffer : {&frameBuffers.transforms, &frameBuffers.meshlets, &frameBuffers.bounds, &frameBuffers.batches, &frameBuffers.batchInstances, &frameBuffers.commands})
+                {
+                    if (buffer->buffer)
+                    {
+                        Graphics::DestroyBuffer(buffer->buffer);
+                    }
+                }
+            }
+            Graphics::DestroyComputePipelineState(pipelineState);
+            Graphics::DestroyBindingSet(bindingSet);
+        }
+
+        static void RegisterType(NativeTypeHandler<MeshletCullingPass>& type)
+        {
+            RenderGraphPassBuilder<MeshletCullingPass>::Builder(RenderGraphPassType::Compute)
+                .Output(RenderGraphResourceCreation{
+                    .name = "MeshletDrawData",
+                    .type = RenderGraphResourceType::Reference
+                });
+        }
+    };
+
+    void RegisterMeshletCullingPass()
+    {
+        Registry::Type<MeshletCullingPass>();
+    }
+}
@@ -1,7 +1,9 @@
 #include <Fyrion/Core/Color.hpp>
 
+#include "DefaultRenderPipelineTypes.hpp"
 #include "Fyrion/Core/Registry.hpp"
 #include "Fyrion/Graphics/Graphics.hpp"
+#include "Fyrion/Graphics/MeshOptimizer.hpp"
 #include "Fyrion/Graphics/RenderGraph.hpp"
 #include "Fyrion/Graphics/RenderStorage.hpp"
 #include "Fyrion/Graphics/Assets/DCCAsset.hpp"
@@ -22,21 +24,30 @@ namespace Fyrion
     public:
         FY_BASE_TYPES(RenderGraphPass);
 
-        PipelineState pipelineState{};
+        PipelineState pipelineStates[2]{}; //one for each MeshVertexFormat
         BindingSet*   bindingSet{};
 
         void Init() override
         {
-            GraphicsPipelineCreation graphicsPipelineCreation{
-                .shader = AssetManager::LoadByPath<ShaderAsset>("Fyrion://Shaders/Passes/GBufferRender.raster"),
-                .renderPass = node->GetRenderPass(),
-                .depthWrite = true,
-                .cullMode = CullMode::Back,
-                .compareOperator = CompareOp::Less,
-            };
+            ShaderAsset* shader = AssetManager::LoadByPath<ShaderAsset>("Fyrion://Shaders/Passes/GBufferRender.raster");
 
-            pipelineState = Graphics::CreateGraphicsPipelineState(graphicsPipelineCreation);
-            bindingSet = Graphics::CreateBindingSet(graphicsPipelineCreation.shader);
+            for (u32 i = 0; i < 2; ++i)
+            {
+                MeshVertexFormat vertexFormat = static_cast<MeshVertexFormat>(i);
+
+                GraphicsPipelineCreation graphicsPipelineCreation{
+                    .shader = shader,
+                    .renderPass = node->GetRenderPass(),
+                    .depthWrite = true,
+                    .cullMode = CullMode::Back,
+                    .compareOperator = CompareOp::Less,
+                    .inputs = MeshOptimizer::GetVertexInputs(vertexFormat),
+                    .stride = MeshOptimizer::GetVertexSize(vertexFormat)
+                };
+
+                pipelineStates[i] = Graphics::CreateGraphicsPipelineState(graphicsPipelineCreation);
+            }
+            bindingSet = Graphics::CreateBindingSet(shader);
         }
 
 
@@ -47,42 +58,74 @@ namespace Fyrion
             SceneData data{.viewProjection = cameraData.projection * cameraData.view};
             bindingSet->GetVar("scene")->SetValue(&data, sizeof(SceneData));
 
-            cmd.BindPipelineState(pipelineState);
-            cmd.BindBindingSet(pipelineState, bindingSet);
             //cmd.BindBindingSet(pipelineState, RenderStorage::GetBindlessTextures());
 
-            for (MeshRenderData& meshRenderData : RenderStorage::GetMeshesToRender())
+            const MeshletDrawData* drawData = static_cast<const MeshletDrawData*>(node->GetInputResource("MeshletDrawData")->reference);
+            if (!drawData->transforms)
+            {
+                return;
+            }
+            bindingSet->GetVar("transforms")->SetBuffer(drawData->transforms);
+
+            MeshAsset*     boundMesh = nullptr;
+            MaterialAsset* boundMaterial = nullptr;
+            PipelineState  pipelineState{};
+
+            auto bind = [&](MeshAsset* mesh, MaterialAsset* material)
             {
-                if (MeshAsset* mesh = meshRenderData.mesh)
+                if (mesh != boundMesh)
                 {
-                    Span<MeshPrimitive> primitives = mesh->GetPrimitives();
+                    PipelineState meshPipelineState = pipelineStates[static_cast<u32>(mesh->GetVertexFormat())];
+                    if (meshPipelineState != pipelineState)
+                    {
+                        pipelineState = meshPipelineState;
+                        cmd.BindPipelineState(pipelineState);
+                        cmd.BindBindingSet(pipelineState, bindingSet);
+                        boundMaterial = nullptr;
+                    }
 
                     cmd.BindVertexBuffer(mesh->GetVertexBuffer());
                     cmd.BindIndexBuffer(mesh->GetIndexBuffeer());
+                    boundMesh = mesh;
+                }
 
-                    cmd.PushConstants(pipelineState, ShaderStage::Vertex, &meshRenderData.model, sizeof(Mat4));
-
-                    for (MeshPrimitive& primitive : primitives)
-                    {
-                        if (MaterialAsset* material = meshRenderData.materials[primitive.materialIndex])
-                        {
-                            cmd.BindBindingSet(pipelineState, material->GetBindingSet());
-                            cmd.DrawIndexed(primitive.indexCount, 1, primitive.firstIndex, 0, 0);
-                        }
-                    }
+                if (material != boundMaterial)
+                {
+                    cmd.BindBindingSet(pipelineState, material->GetBindingSet());
+                    boundMaterial = material;
                 }
+            };
+
+            //firstInstance of each draw is the transform index, read by the vertex shader from SV_InstanceID
+            for (const MeshletDrawBatch& batch : drawData->batches)
+            {
+                bind(batch.mesh, batch.material);
+                cmd.DrawIndexedIndirect(drawData->commands, batch.firstCommand * sizeof(DrawIndexedIndirectCommand), batch.commandCount, sizeof(DrawIndexedIndirectCommand));
+            }
+
+            for (const DrawCommand& draw : drawData->directDraws)
+            {
+                bind(draw.mesh, draw.material);
+                cmd.DrawIndexed(draw.indexCount, 1, draw.firstIndex, 0, draw.instance);
             }
         }
 
         void Destroy() override
         {
-            Graphics::DestroyGraphicsPipelineState(pipelineState);
+            for (PipelineState pipelineState : pipelineStates)
+            {
+                Graphics::DestroyGraphicsPipelineState(pipelineState);
+            }
             Graphics::DestroyBindingSet(bindingSet);
         }
 
         static void RegisterType(NativeTypeHandler<SceneRenderPass>& type)
         {
             RenderGraphPassBuilder<SceneRenderPass>::Builder(RenderGraphPassType::Graphics)
+                .Input(RenderGraphResourceCreation{
+                    .name = "MeshletDrawData",
+                    .type = RenderGraphResourceType::Reference
+                })
                 .Output(RenderGraphResourceCreation{
                     .name = "GBufferColorMetallic",
                     .type = RenderGraphResourceType::Attachment,
@@ -1,5 +1,7 @@
 #include "DefaultRenderPipelineTypes.hpp"
+#include "Fyrion/Graphics/DrawList.hpp"
 #include "Fyrion/Graphics/Graphics.hpp"
+#include "Fyrion/Graphics/MeshOptimizer.hpp"
 #include "Fyrion/Graphics/RenderGraph.hpp"
 #include "Fyrion/Graphics/RenderStorage.hpp"
 #include "Fyrion/Graphics/Assets/ShaderAsset.hpp"
@@ -15,12 +17,13 @@ namespace Fyrion
         float cascadeSplitLambda = 0.75f;
 
         Texture       shadowMapTexture{};
-        PipelineState pipelineState{};
+        PipelineState pipelineStates[2]{}; //one for each MeshVertexFormat
 
         TextureView shadowMapTextureViews[FY_SHADOW_MAP_CASCADE_COUNT];
         RenderPass  shadowMapPass[FY_SHADOW_MAP_CASCADE_COUNT];
 
         ShadowMapDataInfo shadowMapDataInfo{};
+        DrawList          drawList{};
 
         struct PushConsts
         {
@@ -55,16 +58,24 @@ namespace Fyrion
                 });
             }
 
-            GraphicsPipelineCreation graphicsPipelineCreation{
-                .shader = AssetManager::LoadByPath<ShaderAsset>("Fyrion://Shaders/Passes/ShadowMap.raster"),
-                .renderPass = shadowMapPass[0],
-                .depthWrite = true,
-                .cullMode = CullMode::Front,
-                .compareOperator = CompareOp::LessOrEqual,
-                .stride = sizeof(VertexStride)
-            };
+            ShaderAsset* shader = AssetManager::LoadByPath<ShaderAsset>("Fyrion://Shaders/Passes/ShadowMap.raster");
 
-            pipelineState = Graphics::CreateGraphicsPipelineState(graphicsPipelineCreation);
+            for (u32 i = 0; i < 2; ++i)
+            {
+                MeshVertexFormat vertexFormat = static_cast<MeshVertexFormat>(i);
+
+                GraphicsPipelineCreation graphicsPipelineCreation{
+                    .shader = shader,
+                    .renderPass = shadowMapPass[0],
+                    .depthWrite = true,
+                    .cullMode = CullMode::Front,
+                    .compareOperator = CompareOp::LessOrEqual,
+                    .inputs = MeshOptimizer::GetVertexInputs(vertexFormat),
+                    .stride = MeshOptimizer::GetVertexSize(vertexFormat)
+                };
+
+                pipelineStates[i] = Graphics::CreateGraphicsPipelineState(graphicsPipelineCreation);
+            }
         }
 
         void Render(f64 deltaTime, RenderCommands& cmd) override
@@ -180,32 +191,41 @@ namespace Fyrion
                     });
 
                     cmd.SetScissor(Rect{0, 0, FY_SHADOW_MAP_DIM, FY_SHADOW_MAP_DIM});
-                    cmd.BindPipelineState(pipelineState);
-
-                    for (MeshRenderData& meshRenderData : RenderStorage::GetMeshesToRender())
-                    {
-                        if (MeshAsset* mesh = meshRenderData.mesh)
-                        {
-                            Span<MeshPrimitive> primitives = mesh->GetPrimitives();
 
-                            cmd.BindVertexBuffer(mesh->GetVertexBuffer());
-                            cmd.BindIndexBuffer(mesh->GetIndexBuffeer());
+                    MeshRenderList meshRenderList = RenderStorage::GetMeshesToRender();
 
-                            PushConsts pushConsts{
-                                .model = meshRenderData.model,
-                                .viewProjection = shadowMapDataInfo.cascadeViewProjMat[i],
-                            };
+                    //casters between the light and the cascade still need to be rendered, so the near plane is not tested
+                    Frustum cascadeFrustum = Math::ExtractFrustum(shadowMapDataInfo.cascadeViewProjMat[i]);
+                    cascadeFrustum.planes[4] = Vec4{0.0f, 0.0f, 0.0f, 1.0f};
+                    //LODs are selected from the main camera, so the shadows match the rendered meshes
+                    drawList.Build(meshRenderList, cascadeFrustum, LODSelection::FromCamera(cameraData, graph->GetViewportExtent()));
 
-                            cmd.PushConstants(pipelineState, ShaderStage::Vertex, &pushConsts, sizeof(PushConsts));
+                    MeshAsset*    boundMesh = nullptr;
+                    PipelineState pipelineState{};
 
-                            for (MeshPrimitive& primitive : primitives)
+                    for (const DrawCommand& draw : drawList.GetCommands())
+                    {
+                        if (draw.mesh != boundMesh)
+                        {
+                            PipelineState meshPipelineState = pipelineStates[static_cast<u32>(draw.mesh->GetVertexFormat())];
+                            if (meshPipelineState != pipelineState)
                             {
-                                if (MaterialAsset* material = meshRenderData.materials[primitive.materialIndex])
-                                {
-                                    cmd.DrawIndexed(primitive.indexCount, 1, primitive.firstIndex, 0, 0);
-                                }
+                                pipelineState = meshPipelineState;
+                                cmd.BindPipelineState(pipelineState);
                             }
+
+                            cmd.BindVertexBuffer(draw.mesh->GetVertexBuffer());
+                            cmd.BindIndexBuffer(draw.mesh->GetIndexBuffeer());
+                            boundMesh = draw.mesh;
                         }
+
+                        PushConsts pushConsts{
+                            .model = meshRenderList.transforms[draw.instance],
+                            .viewProjection = shadowMapDataInfo.cascadeViewProjMat[i],
+                        };
+
+                        cmd.PushConstants(pipelineState, ShaderStage::Vertex, &pushConsts, sizeof(PushConsts));
+                        cmd.DrawIndexed(draw.indexCount, 1, draw.firstIndex, 0, 0);
                     }
                     cmd.EndRenderPass();
 
@@ -229,7 +249,10 @@ namespace Fyrion
             }
 
             Graphics::DestroyTexture(shadowMapTexture);
-            Graphics::DestroyGraphicsPipelineState(pipelineState);
+            for (PipelineState pipelineState : pipelineStates)
+            {
+                Graphics::DestroyGraphicsPipelineState(pipelineState);
+            }
         }
 
         static void RegisterType(NativeTypeHandler<ShadowMapRenderPass>& type)
@@ -33,9 +33,14 @@ namespace Fyrion
         virtual void            WaitQueue() = 0;
         virtual GPUQueue        GetMainQueue() = 0;
         virtual RenderCommands& GetTempCmd() = 0;
-        virtual void            UpdateBufferData(const BufferDataInfo& bufferDataInfo) = 0;
+        virtual UploadToken     UpdateBufferData(const BufferDataInfo& bufferDataInfo) = 0;
+        virtual UploadToken     UpdateTextureData(const TextureDataInfo& textureDataInfo) = 0;
+        virtual bool            IsUploadComplete(UploadToken token) = 0;
+        virtual void            WaitUpload(UploadToken token) = 0;
         virtual VoidPtr         GetBufferMappedMemory(const Buffer& buffer) = 0;
         virtual TextureCreation GetTextureCreationInfo(Texture texture) = 0;
+        virtual DeviceFeatures  GetDeviceFeatures() = 0;
+        virtual bool            IsPipelineStateReady(const PipelineState& pipelineState) = 0;
 
         virtual void    ImGuiInit(Swapchain renderSwapchain) = 0;
         virtual void    ImGuiNewFrame() = 0;
@@ -25,6 +25,7 @@ namespace Fyrion
     {
         VkCommandBufferBeginInfo beginInfo{VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
         vkBeginCommandBuffer(commandBuffer, &beginInfo);
+        pipelineReady = true;
     }
 
     void VulkanCommands::End()
@@ -117,28 +118,33 @@ namespace Fyrion
 
     void VulkanCommands::DrawIndexed(u32 indexCount, u32 instanceCount, u32 firstIndex, i32 vertexOffset, u32 firstInstance)
     {
+        if (!pipelineReady) return;
         vkCmdDrawIndexed(commandBuffer, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
     }
 
     void VulkanCommands::Draw(u32 vertexCount, u32 instanceCount, u32 firstVertex, u32 firstInstance)
     {
+        if (!pipelineReady) return;
         vkCmdDraw(commandBuffer, vertexCount, instanceCount, firstVertex, firstInstance);
     }
 
     void VulkanCommands::PushConstants(const PipelineState& pipeline, ShaderStage stages, const void* data, usize size)
     {
+        if (!pipelineReady) return;
         VulkanPipelineState& pipelineState = *static_cast<VulkanPipelineState*>(pipeline.handler);
         vkCmdPushConstants(commandBuffer, pipelineState.layout, Vulkan::CastStage(stages), 0, size, data);
     }
 
     void VulkanCommands::BindBindingSet(const PipelineState& pipeline, BindingSet* bindingSet)
     {
+        if (!pipelineReady) return;
         VulkanBindingSet* vulkanBindingSet = static_cast<VulkanBindingSet*>(bindingSet);
         vulkanBindingSet->Bind(*this,pipeline);
     }
 
     void VulkanCommands::DrawIndexedIndirect(const Buffer& buffer, usize offset, u32 drawCount, u32 stride)
     {
+        if (!pipelineReady) return;
         const VulkanBuffer& vulkanBuffer = *static_cast<const VulkanBuffer*>(buffer.handler);
         vkCmdDrawIndexedIndirect(commandBuffer, vulkanBuffer.buffer, offset, drawCount, stride);
     }
@@ -146,11 +152,14 @@ namespace Fyrion
     void VulkanCommands::BindPipelineState(const PipelineState& pipeline)
     {
         auto& pipelineState = *static_cast<VulkanPipelineState*>(pipeline.handler);
+        pipelineReady = vulkanDevice.ResolvePipelineState(&pipelineState);
+        if (!pipelineReady) return;
         vkCmdBindPipeline(commandBuffer, pipelineState.bindingPoint, pipelineState.pipeline);
     }
 
     void VulkanCommands::Dispatch(u32 x, u32 y, u32 z)
     {
+        if (!pipelineReady) return;
         vkCmdDispatch(commandBuffer, Math::Max(x, 1u), Math::Max(y, 1u), Math::Max(z, 1u));
     }
 
@@ -183,6 +192,27 @@ namespace Fyrion
 
     void VulkanCommands::ResourceBarrier(const ResourceBarrierInfo& resourceBarrierInfo)
     {
+        if (resourceBarrierInfo.buffer)
+        {
+            VkBufferMemoryBarrier bufferBarrier{VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER};
+            bufferBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+            bufferBarrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+            bufferBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            bufferBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            bufferBarrier.buffer = static_cast<VulkanBuffer*>(resourceBarrierInfo.buffer.handler)->buffer;
+            bufferBarrier.offset = 0;
+            bufferBarrier.size = VK_WHOLE_SIZE;
+
+            vkCmdPipelineBarrier(commandBuffer,
+                                 VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                                 VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                                 0,
+                                 0, nullptr,
+                                 1, &bufferBarrier,
+                                 0, nullptr);
+            return;
+        }
+
         VkImageSubresourceRange subresourceRange = {};
         if (resourceBarrierInfo.isDepth)
         {
@@ -258,7 +288,7 @@ namespace Fyrion
                 break;
 
             case VK_IMAGE_LAYOUT_GENERAL:
-                barrier.srcAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+                barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
                 break;
 
             case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL:
@@ -14,6 +14,9 @@ namespace Fyrion
         VkCommandPool commandPool{};
         VkCommandBuffer commandBuffer{};
 
+        //false while the bound pipeline is still being created asynchronously, the commands using it are skipped
+        bool pipelineReady = true;
+
         VulkanCommands(VulkanDevice& vulkanDevice);
 
         void Begin() override;
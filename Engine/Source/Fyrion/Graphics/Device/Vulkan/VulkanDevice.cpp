@@ -7,17 +7,31 @@
 #include "VulkanBindingSet.hpp"
 #include "VulkanPlatform.hpp"
 #include "VulkanUtils.hpp"
+#include "Fyrion/Asset/AssetManager.hpp"
+#include "Fyrion/Core/JobSystem.hpp"
 #include "Fyrion/Graphics/Assets/ShaderAsset.hpp"
+#include "Fyrion/IO/FileSystem.hpp"
+#include "Fyrion/IO/Path.hpp"
 #include "Fyrion/Platform/Platform.hpp"
 #include "Fyrion/ImGui/Lib/imgui_impl_vulkan.h"
 
 namespace Fyrion
 {
+    namespace
+    {
+        constexpr usize UploadRingSize = 64 * 1024 * 1024;
+    }
+
     VulkanDevice::~VulkanDevice()
     {
         ImGui_ImplVulkan_Shutdown();
 
         DestroySampler(defaultSampler);
+        DestroyUploadResources();
+
+        DestroyRetiredPipelines(true);
+        SavePipelineCache();
+        vkDestroyPipelineCache(device, pipelineCache, nullptr);
 
         for (size_t i = 0; i < FY_FRAMES_IN_FLIGHT; i++)
         {
@@ -165,7 +179,9 @@ namespace Fyrion
         vkGetPhysicalDeviceFeatures(physicalDevice, &vulkanDeviceFeatures);
         vkGetPhysicalDeviceProperties(physicalDevice, &vulkanDeviceProperties);
 
-        deviceFeatures.multiDrawIndirectSupported = vulkanDeviceFeatures.multiDrawIndirect;
+        //indirect draws use firstInstance to find the instance transform
+        deviceFeatures.multiDrawIndirectSupported = vulkanDeviceFeatures.multiDrawIndirect && vulkanDeviceFeatures.drawIndirectFirstInstance;
+        deviceFeatures.textureCompressionBCSupported = vulkanDeviceFeatures.textureCompressionBC;
 
         {
             VkPhysicalDeviceDescriptorIndexingFeatures indexingFeatures{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES, nullptr};
@@ -323,6 +339,12 @@ namespace Fyrion
         if (deviceFeatures.multiDrawIndirectSupported)
         {
             deviceFeatures2.features.multiDrawIndirect = VK_TRUE;
+            deviceFeatures2.features.drawIndirectFirstInstance = VK_TRUE;
+        }
+
+        if (deviceFeatures.textureCompressionBCSupported)
+        {
+            deviceFeatures2.features.textureCompressionBC = VK_TRUE;
         }
 
         if (vulkanDeviceFeatures.shaderInt64)
@@ -412,6 +434,8 @@ namespace Fyrion
         allocatorInfo.pVulkanFunctions = &vmaVulkanFunctions;
         vmaCreateAllocator(&allocatorInfo, &vmaAllocator);
 
+        LoadPipelineCache();
+
         temporaryCmd = MakeShared<VulkanCommands>(*this);
 
         for (int j = 0; j < FY_FRAMES_IN_FLIGHT; ++j)
@@ -477,6 +501,8 @@ namespace Fyrion
 
         defaultSampler = CreateSampler(SamplerCreation{});
 
+        CreateUploadResources();
+
         logger.Info("Vulkan API {}.{}.{} Device: {} ",
                     VK_VERSION_MAJOR(vulkanDeviceProperties.apiVersion),
                     VK_VERSION_MINOR(vulkanDeviceProperties.apiVersion),
@@ -856,7 +882,36 @@ namespace Fyrion
             textureViewCreation.viewType = ViewType::Type2DArray;
         }
 
-        vmaCreateImage(vmaAllocator, &imageCreateInfo, &allocInfo, &vulkanTexture->image, &vulkanTexture->allocation, nullptr);
+        if (VulkanTexture* aliasTexture = static_cast<VulkanTexture*>(textureCreation.aliasTexture.handler);
+            aliasTexture && aliasTexture->allocation && vkCreateImage(device, &imageCreateInfo, nullptr, &vulkanTexture->image) == VK_SUCCESS)
+        {
+            VkMemoryRequirements memoryRequirements{};
+            vkGetImageMemoryRequirements(device, vulkanTexture->image, &memoryRequirements);
+
+            VmaAllocationInfo aliasAllocationInfo{};
+            vmaGetAllocationInfo(vmaAllocator, aliasTexture->allocation, &aliasAllocationInfo);
+
+            //the image gets its own memory if it doesn't fit in the aliased allocation
+            vulkanTexture->aliased = memoryRequirements.size <= aliasAllocationInfo.size &&
+                (memoryRequirements.memoryTypeBits & (1u << aliasAllocationInfo.memoryType)) != 0 &&
+                aliasAllocationInfo.offset % memoryRequirements.alignment == 0 &&
+                vmaBindImageMemory(vmaAllocator, aliasTexture->allocation, vulkanTexture->image) == VK_SUCCESS;
+
+            if (!vulkanTexture->aliased)
+            {
+                vkDestroyImage(device, vulkanTexture->image, nullptr);
+                vulkanTexture->image = VK_NULL_HANDLE;
+            }
+        }
+
+        if (!vulkanTexture->aliased)
+        {
+            if (usage && (TextureUsage::RenderPass | TextureUsage::DepthStencil | TextureUsage::Storage))
+            {
+                allocInfo.flags |= VMA_ALLOCATION_CREATE_CAN_ALIAS_BIT;
+            }
+            vmaCreateImage(vmaAllocator, &imageCreateInfo, &allocInfo, &vulkanTexture->image, &vulkanTexture->allocation, nullptr);
+        }
 
         textureViewCreation.texture = {vulkanTexture};
         vulkanTexture->textureView = CreateTextureView(textureViewCreation);
@@ -924,62 +979,40 @@ namespace Fyrion
         return {vulkanSampler};
     }
 
-    PipelineState VulkanDevice::CreateGraphicsPipelineState(const GraphicsPipelineCreation& creation)
+    struct VulkanGraphicsPipelineJob
     {
-        ShaderAsset* shader = creation.shader;
-        FY_ASSERT(shader, "shader is null");
-        bool invalidPass = creation.attachments.Empty() && !creation.renderPass && !creation.pipelineState && creation.depthFormat == Format::Undefined;
-        FY_ASSERT(!invalidPass, "creation needs attachments or renderpass or pipelineState");
-
-        //shader not valid.
-        if(!shader->IsCompiled())
-        {
-            return {};
-        }
-
-        Array<u8>              bytes = shader->GetBytes();
-        Span<ShaderStageInfo> stages = shader->GetStages();
-        ShaderInfo            shaderInfo = shader->GetShaderInfo();
-
-
-        VulkanPipelineState* vulkanPipelineState;
-        if (!creation.pipelineState)
-        {
-            vulkanPipelineState = allocator.Alloc<VulkanPipelineState>();
-            vulkanPipelineState->graphicsPipelineCreation = creation;
-
-            shader->AddPipelineDependency({vulkanPipelineState});
-        }
-        else
-        {
-            vulkanPipelineState = static_cast<VulkanPipelineState*>(creation.pipelineState.handler);
-
-            vkDeviceWaitIdle(device);
-            vkDestroyPipelineLayout(device, vulkanPipelineState->layout, nullptr);
-            vkDestroyPipeline(device, vulkanPipelineState->pipeline, nullptr);
-        }
+        VulkanDevice*                            vulkanDevice{};
+        VulkanPipelineState*                     vulkanPipelineState{};
+        Array<u8>                                bytes{};
+        Array<ShaderStageInfo>                   stages{};
+        ShaderInfo                               shaderInfo{};
+        Array<VkVertexInputAttributeDescription> attributeDescriptions{};
+        u32                                      stride{};
+    };
+
+    //only touches the job data and thread-safe vulkan calls, it runs on a worker for async creations
+    void CreateGraphicsPipeline(VoidPtr userData)
+    {
+        VulkanGraphicsPipelineJob& job = *static_cast<VulkanGraphicsPipelineJob*>(userData);
+        VulkanDevice&              vulkanDevice = *job.vulkanDevice;
+        VulkanPipelineState*       vulkanPipelineState = job.vulkanPipelineState;
+        VkDevice                   device = vulkanDevice.device;
+        ShaderInfo&                shaderInfo = job.shaderInfo;
 
-        Array<VkPushConstantRange>                 pushConstants{};
         Array<VkPipelineColorBlendAttachmentState> attachments{};
-        Array<VkVertexInputAttributeDescription>   attributeDescriptions{};
 
         Array<VkShaderModule> shaderModules{};
-        shaderModules.Resize(stages.Size());
+        shaderModules.Resize(job.stages.Size());
         Array<VkPipelineShaderStageCreateInfo> shaderStages{};
-        shaderStages.Resize(stages.Size());
+        shaderStages.Resize(job.stages.Size());
 
-        for (u32 i = 0; i < stages.Size(); ++i)
+        for (u32 i = 0; i < job.stages.Size(); ++i)
         {
-            const ShaderStageInfo& shaderStageAsset = stages[i];
-
-            Span<u8> data = Span<u8>{
-                bytes.begin() + shaderStageAsset.offset,
-                bytes.begin() + shaderStageAsset.offset + shaderStageAsset.size
-            };
+            const ShaderStageInfo& shaderStageAsset = job.stages[i];
 
             VkShaderModuleCreateInfo createInfo{VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO};
-            createInfo.codeSize = data.Size();
-            createInfo.pCode = reinterpret_cast<const u32*>(data.Data());
+            createInfo.codeSize = shaderStageAsset.size;
+            createInfo.pCode = reinterpret_cast<const u32*>(job.bytes.Data() + shaderStageAsset.offset);
             vkCreateShaderModule(device, &createInfo, nullptr, &shaderModules[i]);
 
             shaderStages[i].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
@@ -988,47 +1021,6 @@ namespace Fyrion
             shaderStages[i].stage = static_cast<VkShaderStageFlagBits>(Vulkan::CastStage(shaderStageAsset.stage));
         }
 
-        for (ShaderPushConstant pushConstant : shaderInfo.pushConstants)
-        {
-            pushConstants.EmplaceBack(VkPushConstantRange{
-                .stageFlags = Vulkan::CastStage(pushConstant.stage),
-                .offset = pushConstant.offset,
-                .size = pushConstant.size
-            });
-        }
-
-        u32 stride = shaderInfo.stride;
-        if (creation.stride > 0)
-        {
-            stride = creation.stride;
-        }
-
-        if (!creation.inputs.Empty())
-        {
-            for (const auto& input : creation.inputs)
-            {
-                attributeDescriptions.EmplaceBack(VkVertexInputAttributeDescription{
-                    .location = input.location,
-                    .binding = 0,
-                    .format = Vulkan::CastFormat(input.format),
-                    .offset = input.offset
-                });
-            }
-        }
-        else
-        {
-            for (const auto& input : shaderInfo.inputVariables)
-            {
-                attributeDescriptions.EmplaceBack(VkVertexInputAttributeDescription{
-                    .location = input.location,
-                    .binding = 0,
-                    .format = Vulkan::CastFormat(input.format),
-                    .offset = input.offset
-                });
-            }
-        }
-
-
         for (const auto& output : shaderInfo.outputVariables)
         {
             VkPipelineColorBlendAttachmentState attachmentState{};
@@ -1050,11 +1042,12 @@ namespace Fyrion
             attachments.EmplaceBack(attachmentState);
         }
 
-        Vulkan::CreatePipelineLayout(device, shaderInfo.descriptors, shaderInfo.pushConstants, &vulkanPipelineState->layout);
+        VkPipelineLayout layout{};
+        Vulkan::CreatePipelineLayout(device, shaderInfo.descriptors, shaderInfo.pushConstants, &layout);
 
         VkVertexInputBindingDescription bindingDescription{};
         bindingDescription.binding = 0;
-        bindingDescription.stride = stride;
+        bindingDescription.stride = job.stride;
         bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
 
         VkPipelineVertexInputStateCreateInfo vertexInputInfo{VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO};
@@ -1069,10 +1062,10 @@ namespace Fyrion
             vertexInputInfo.vertexBindingDescriptionCount = 0;
         }
 
-        if (!attributeDescriptions.Empty())
+        if (!job.attributeDescriptions.Empty())
         {
-            vertexInputInfo.vertexAttributeDescriptionCount = attributeDescriptions.Size();
-            vertexInputInfo.pVertexAttributeDescriptions = attributeDescriptions.Data();
+            vertexInputInfo.vertexAttributeDescriptionCount = job.attributeDescriptions.Size();
+            vertexInputInfo.pVertexAttributeDescriptions = job.attributeDescriptions.Data();
         } else
         {
             vertexInputInfo.vertexAttributeDescriptionCount = 0;
@@ -1127,36 +1120,10 @@ namespace Fyrion
         pipelineInfo.pRasterizationState = &rasterizer;
         pipelineInfo.pMultisampleState = &multisampling;
         pipelineInfo.pColorBlendState = &colorBlending;
-        pipelineInfo.layout = vulkanPipelineState->layout;
+        pipelineInfo.layout = layout;
         pipelineInfo.subpass = 0;
         pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
 
-        if (creation.renderPass && vulkanPipelineState->attachments.Empty())
-        {
-            VulkanRenderPass* renderPass = static_cast<VulkanRenderPass*>(vulkanPipelineState->graphicsPipelineCreation.renderPass.handler);
-
-            for (VkFormat format : renderPass->formats)
-            {
-                if (!Vulkan::IsDepthFormat(format))
-                {
-                    vulkanPipelineState->attachments.EmplaceBack(format);
-                }
-            }
-
-            if (renderPass->hasDepth)
-            {
-                vulkanPipelineState->graphicsPipelineCreation.depthFormat = Format::Depth;
-            }
-        }
-
-        if (!creation.attachments.Empty() && vulkanPipelineState->attachments.Empty())
-        {
-            for(Format format: creation.attachments)
-            {
-                vulkanPipelineState->attachments.EmplaceBack(Vulkan::CastFormat(format));
-            }
-        }
-
         Array<VkAttachmentDescription> attachmentDescriptions{};
         Array<VkAttachmentReference>   colorAttachmentReference{};
         VkAttachmentReference          depthReference{};
@@ -1230,7 +1197,16 @@ namespace Fyrion
             pipelineInfo.pDepthStencilState = &depthStencilStateCreateInfo;
         }
 
-        vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &vulkanPipelineState->pipeline);
+        VkPipeline pipeline{};
+        if (vkCreateGraphicsPipelines(device, vulkanDevice.pipelineCache, 1, &pipelineInfo, nullptr, &pipeline) == VK_SUCCESS)
+        {
+            vulkanPipelineState->pendingPipeline = pipeline;
+            vulkanPipelineState->pendingLayout = layout;
+        }
+        else
+        {
+            vkDestroyPipelineLayout(device, layout, nullptr);
+        }
 
         for (const auto shaderModule : shaderModules)
         {
@@ -1239,6 +1215,118 @@ namespace Fyrion
 
         vkDestroyRenderPass(device, pipelineInfo.renderPass, nullptr);
 
+        vulkanDevice.allocator.DestroyAndFree(&job);
+    }
+
+    PipelineState VulkanDevice::CreateGraphicsPipelineState(const GraphicsPipelineCreation& creation)
+    {
+        ShaderAsset* shader = creation.shader;
+        FY_ASSERT(shader, "shader is null");
+        bool invalidPass = creation.attachments.Empty() && !creation.renderPass && !creation.pipelineState && creation.depthFormat == Format::Undefined;
+        FY_ASSERT(!invalidPass, "creation needs attachments or renderpass or pipelineState");
+
+        //shader not valid.
+        if(!shader->IsCompiled())
+        {
+            return {};
+        }
+
+        VulkanPipelineState* vulkanPipelineState;
+        if (!creation.pipelineState)
+        {
+            vulkanPipelineState = allocator.Alloc<VulkanPipelineState>();
+            vulkanPipelineState->graphicsPipelineCreation = creation;
+
+            shader->AddPipelineDependency({vulkanPipelineState});
+        }
+        else
+        {
+            vulkanPipelineState = static_cast<VulkanPipelineState*>(creation.pipelineState.handler);
+
+            //the current pipeline keeps being used until the new one is swapped in
+            JobSystem::Wait(vulkanPipelineState->creationCounter);
+            ResolvePipelineState(vulkanPipelineState);
+        }
+
+        //shader data and creation spans are copied, the shader can be recompiled while an async job is running
+        VulkanGraphicsPipelineJob* job = allocator.Alloc<VulkanGraphicsPipelineJob>();
+        job->vulkanDevice = this;
+        job->vulkanPipelineState = vulkanPipelineState;
+        job->shaderInfo = shader->GetShaderInfo();
+
+        AssetBufferView       bytes = shader->GetBytes();
+        Span<ShaderStageInfo> stages = shader->GetStages();
+        job->bytes.Assign(bytes.Data(), bytes.Data() + bytes.Size());
+        job->stages.Assign(stages.begin(), stages.end());
+
+        job->stride = job->shaderInfo.stride;
+        if (creation.stride > 0)
+        {
+            job->stride = creation.stride;
+        }
+
+        if (!creation.inputs.Empty())
+        {
+            for (const auto& input : creation.inputs)
+            {
+                job->attributeDescriptions.EmplaceBack(VkVertexInputAttributeDescription{
+                    .location = input.location,
+                    .binding = 0,
+                    .format = Vulkan::CastFormat(input.format),
+                    .offset = input.offset
+                });
+            }
+        }
+        else
+        {
+            for (const auto& input : job->shaderInfo.inputVariables)
+            {
+                job->attributeDescriptions.EmplaceBack(VkVertexInputAttributeDescription{
+                    .location = input.location,
+                    .binding = 0,
+                    .format = Vulkan::CastFormat(input.format),
+                    .offset = input.offset
+                });
+            }
+        }
+
+        if (creation.renderPass && vulkanPipelineState->attachments.Empty())
+        {
+            VulkanRenderPass* renderPass = static_cast<VulkanRenderPass*>(vulkanPipelineState->graphicsPipelineCreation.renderPass.handler);
+
+            for (VkFormat format : renderPass->formats)
+            {
+                if (!Vulkan::IsDepthFormat(format))
+                {
+                    vulkanPipelineState->attachments.EmplaceBack(format);
+                }
+            }
+
+            if (renderPass->hasDepth)
+            {
+                vulkanPipelineState->graphicsPipelineCreation.depthFormat = Format::Depth;
+            }
+        }
+
+        if (!creation.attachments.Empty() && vulkanPipelineState->attachments.Empty())
+        {
+            for(Format format: creation.attachments)
+            {
+                vulkanPipelineState->attachments.EmplaceBack(Vulkan::CastFormat(format));
+            }
+        }
+
+        //recreations from shader reloads are always async, the previous pipeline keeps drawing until the new one is ready
+        if (vulkanPipelineState->graphicsPipelineCreation.async || creation.pipelineState)
+        {
+            JobSystem::Run(CreateGraphicsPipeline, job, &vulkanPipelineState->creationCounter);
+        }
+        else
+        {
+            CreateGraphicsPipeline(job);
+            ResolvePipelineState(vulkanPipelineState);
+        }
+
         return {vulkanPipelineState};
     }
 
@@ -1253,7 +1341,7 @@ namespace Fyrion
             return {};
         }
 
-        Array<u8>        bytes = shader->GetBytes();
+        AssetBufferView  bytes = shader->GetBytes();
         ShaderStageInfo& stage = shader->GetStages()[0];
         ShaderInfo       shaderInfo = shader->GetShaderInfo();
 
@@ -1293,7 +1381,7 @@ namespace Fyrion
         computePipelineCreateInfo.layout = vulkanPipelineState->layout;
         computePipelineCreateInfo.stage = shaderStage;
 
-        vkCreateComputePipelines(device, 0, 1, &computePipelineCreateInfo, nullptr, &vulkanPipelineState->pipeline);
+        vkCreateComputePipelines(device, pipelineCache, 1, &computePipelineCreateInfo, nullptr, &vulkanPipelineState->pipeline);
         vkDestroyShaderModule(device, shaderModule, nullptr);
 
         return {vulkanPipelineState};
@@ -1326,6 +1414,9 @@ namespace Fyrion
 
     void VulkanDevice::DestroyBuffer(const Buffer& buffer)
     {
+        //pending uploads may still copy to it
+        WaitUpload({lastUploadToken});
+
         VulkanBuffer* vulkanBuffer = static_cast<VulkanBuffer*>(buffer.handler);
         if (vulkanBuffer->buffer && vulkanBuffer->allocation)
         {
@@ -1336,6 +1427,8 @@ namespace Fyrion
 
     void VulkanDevice::DestroyTexture(const Texture& texture)
     {
+        WaitUpload({lastUploadToken});
+
         VulkanTexture* vulkanTexture = static_cast<VulkanTexture*>(texture.handler);
 
         if (vulkanTexture->imguiDescriptorSet)
@@ -1353,6 +1446,10 @@ namespace Fyrion
             vmaDestroyImage(vmaAllocator, vulkanTexture->image, vulkanTexture->allocation);
             vulkanTexture->allocation = nullptr;
         }
+        else if (vulkanTexture->aliased)
+        {
+            vkDestroyImage(device, vulkanTexture->image, nullptr);
+        }
         allocator.DestroyAndFree(vulkanTexture);
     }
 
@@ -1373,6 +1470,12 @@ namespace Fyrion
     void VulkanDevice::DestroyGraphicsPipelineState(const PipelineState& pipelineState)
     {
         VulkanPipelineState* vulkanPipelineState = static_cast<VulkanPipelineState*>(pipelineState.handler);
+        JobSystem::Wait(vulkanPipelineState->creationCounter);
+        if (vulkanPipelineState->pendingPipeline)
+        {
+            vkDestroyPipeline(device, vulkanPipelineState->pendingPipeline, nullptr);
+            vkDestroyPipelineLayout(device, vulkanPipelineState->pendingLayout, nullptr);
+        }
         if (vulkanPipelineState->pipeline)
         {
             vkDestroyPipeline(device, vulkanPipelineState->pipeline, nullptr);
@@ -1441,6 +1544,8 @@ namespace Fyrion
         vkWaitForFences(device, 1, &inFlightFences[currentFrame], VK_TRUE, UINT64_MAX);
         vkResetFences(device, 1, &inFlightFences[currentFrame]);
 
+        DestroyRetiredPipelines(false);
+
         return *defaultCommands[currentFrame];
     }
 
@@ -1448,6 +1553,11 @@ namespace Fyrion
     {
         VulkanSwapchain* vulkanSwapchain = static_cast<VulkanSwapchain*>(swapchain.handler);
 
+        {
+            std::lock_guard lock(uploadMutex);
+            FlushUploads();
+        }
+
         VkPipelineStageFlags waitStages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
 
         VkSubmitInfo submitInfo{VK_STRUCTURE_TYPE_SUBMIT_INFO};
@@ -1478,12 +1588,120 @@ namespace Fyrion
         }
 
         currentFrame = (currentFrame + 1) % FY_FRAMES_IN_FLIGHT;
+        frameCount++;
+    }
+
+    bool VulkanDevice::IsPipelineStateReady(const PipelineState& pipelineState)
+    {
+        return pipelineState && ResolvePipelineState(static_cast<VulkanPipelineState*>(pipelineState.handler));
+    }
+
+    bool VulkanDevice::ResolvePipelineState(VulkanPipelineState* vulkanPipelineState)
+    {
+        if (vulkanPipelineState->creationCounter.IsDone() && vulkanPipelineState->pendingPipeline)
+        {
+            if (vulkanPipelineState->pipeline)
+            {
+                retiredPipelines.EmplaceBack(VulkanRetiredPipeline{
+                    .pipeline = vulkanPipelineState->pipeline,
+                    .layout = vulkanPipelineState->layout,
+                    .frame = frameCount
+                });
+            }
+
+            vulkanPipelineState->pipeline = vulkanPipelineState->pendingPipeline;
+            vulkanPipelineState->layout = vulkanPipelineState->pendingLayout;
+            vulkanPipelineState->pendingPipeline = VK_NULL_HANDLE;
+            vulkanPipelineState->pendingLayout = VK_NULL_HANDLE;
+        }
+        return vulkanPipelineState->pipeline != VK_NULL_HANDLE;
+    }
+
+    void VulkanDevice::DestroyRetiredPipelines(bool all)
+    {
+        for (usize i = 0; i < retiredPipelines.Size();)
+        {
+            const VulkanRetiredPipeline& retired = retiredPipelines[i];
+            if (all || retired.frame + FY_FRAMES_IN_FLIGHT <= frameCount)
+            {
+                vkDestroyPipeline(device, retired.pipeline, nullptr);
+                vkDestroyPipelineLayout(device, retired.layout, nullptr);
+                retiredPipelines.Erase(retiredPipelines.begin() + i);
+                continue;
+            }
+            i++;
+        }
+    }
+
+    void VulkanDevice::LoadPipelineCache()
+    {
+        Array<u8> file{};
+        if (StringView dataDirectory = AssetManager::GetDataDirectory(); !dataDirectory.Empty())
+        {
+            pipelineCachePath = Path::Join(dataDirectory, "PipelineCache.bin");
+            file = FileSystem::ReadFileAsByteArray(pipelineCachePath);
+        }
+
+        //data saved by another device or driver version is discarded
+        Span<const u8> cacheData = Vulkan::ReadPipelineCacheFile(vulkanDeviceProperties, Span<const u8>{file.Data(), file.Size()});
+        if (!file.Empty() && cacheData.Empty())
+        {
+            logger.Debug("pipeline cache {} is not compatible with the current device", pipelineCachePath);
+        }
+
+        VkPipelineCacheCreateInfo createInfo{VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO};
+        createInfo.initialDataSize = cacheData.Size();
+        createInfo.pInitialData = cacheData.Data();
+
+        if (vkCreatePipelineCache(device, &createInfo, nullptr, &pipelineCache) != VK_SUCCESS && createInfo.initialDataSize > 0)
+        {
+            createInfo.initialDataSize = 0;
+            createInfo.pInitialData = nullptr;
+            vkCreatePipelineCache(device, &createInfo, nullptr, &pipelineCache);
+        }
+    }
+
+    void VulkanDevice::SavePipelineCache()
+    {
+        if (!pipelineCache || pipelineCachePath.Empty())
+        {
+            return;
+        }
+
+        usize size = 0;
+        vkGetPipelineCacheData(device, pipelineCache, &size, nullptr);
+
+        Array<u8> cacheData(size);
+        if (size == 0 || vkGetPipelineCacheData(device, pipelineCache, &size, cacheData.Data()) != VK_SUCCESS)
+        {
+            return;
+        }
+
+        FileSystem::CreateDirectory(Path::Parent(pipelineCachePath));
+
+        Array<u8>   file = Vulkan::WritePipelineCacheFile(vulkanDeviceProperties, Span<const u8>{cacheData.Data(), size});
+        String      tempPath = String(pipelineCachePath).Append(".tmp");
+        FileHandler fileHandler = FileSystem::OpenFile(tempPath, AccessMode::WriteOnly);
+        if (!fileHandler)
+        {
+            return;
+        }
+        FileSystem::WriteFile(fileHandler, file.Data(), file.Size());
+        FileSystem::CloseFile(fileHandler);
+
+        FileSystem::Remove(pipelineCachePath);
+        FileSystem::Rename(tempPath, pipelineCachePath);
     }
 
     void VulkanDevice::WaitQueue()
     {
+        std::lock_guard lock(uploadMutex);
+        FlushUploads();
+
         vkQueueWaitIdle(graphicsQueue);
         vkDeviceWaitIdle(device);
+
+        ReclaimUploads();
     }
 
     GPUQueue VulkanDevice::GetMainQueue()
@@ -1493,10 +1711,13 @@ namespace Fyrion
 
     RenderCommands& VulkanDevice::GetTempCmd()
     {
+        //temp commands wait for the queue, the pending uploads must be submitted before them
+        std::lock_guard lock(uploadMutex);
+        FlushUploads();
         return *temporaryCmd;
     }
 
-    void VulkanDevice::UpdateBufferData(const BufferDataInfo& bufferDataInfo)
+    UploadToken VulkanDevice::UpdateBufferData(const BufferDataInfo& bufferDataInfo)
     {
         FY_ASSERT(bufferDataInfo.data, "data cannot be null");
         FY_ASSERT(bufferDataInfo.size > 0, "size should be higher then zero");
@@ -1508,13 +1729,185 @@ namespace Fyrion
             {
                 memcpy((i8*)vulkanBuffer.allocInfo.pMappedData + bufferDataInfo.offset, bufferDataInfo.data, bufferDataInfo.size);
             }
+            return {};
         }
-        else
+
+        std::lock_guard lock(uploadMutex);
+
+        usize         offset = 0;
+        VulkanBuffer* stagingBuffer = WriteUploadData(bufferDataInfo.data, bufferDataInfo.size, offset);
+
+        BufferCopyInfo copy{};
+        copy.srcOffset = offset;
+        copy.dstOffset = bufferDataInfo.offset;
+        copy.size = bufferDataInfo.size;
+
+        VulkanUploadBatch& batch = uploadBatches[uploadBatchIndex];
+        batch.commands->CopyBuffer({stagingBuffer}, bufferDataInfo.buffer, {&copy, 1});
+        return {batch.token};
+    }
+
+    UploadToken VulkanDevice::UpdateTextureData(const TextureDataInfo& textureDataInfo)
+    {
+        std::lock_guard lock(uploadMutex);
+
+        usize         offset = 0;
+        VulkanBuffer* stagingBuffer = WriteUploadData(textureDataInfo.data, textureDataInfo.size, offset);
+
+        VulkanUploadBatch& batch = uploadBatches[uploadBatchIndex];
+        VulkanCommands&    commands = *batch.commands;
+
+        for (const TextureDataRegion& textureRegion : textureDataInfo.regions)
         {
-            VulkanBuffer stagingBuffer = {};
+            commands.ResourceBarrier(ResourceBarrierInfo{
+                .texture = textureDataInfo.texture,
+                .oldLayout = ResourceLayout::Undefined,
+                .newLayout = ResourceLayout::CopyDest,
+                .mipLevel = textureRegion.mipLevel,
+                .levelCount = Math::Max(textureRegion.levelCount, 1u),
+                .baseArrayLayer = textureRegion.arrayLayer,
+                .layerCount = Math::Max(textureRegion.layerCount, 1u)
+            });
+
+            BufferImageCopy region{
+                .bufferOffset = offset + textureRegion.dataOffset,
+                .textureMipLevel = textureRegion.mipLevel,
+                .textureArrayLayer = textureRegion.arrayLayer,
+                .layerCount = Math::Max(textureRegion.layerCount, 1u),
+                .imageOffset = {},
+                .imageExtent = {textureRegion.extent.width, textureRegion.extent.height, Math::Max(textureRegion.extent.depth, 1u)},
+            };
+
+            commands.CopyBufferToTexture({stagingBuffer}, textureDataInfo.texture, {&region, 1});
+
+            commands.ResourceBarrier(ResourceBarrierInfo{
+                .texture = textureDataInfo.texture,
+                .oldLayout = ResourceLayout::CopyDest,
+                .newLayout = ResourceLayout::ShaderReadOnly,
+                .mipLevel = textureRegion.mipLevel,
+                .levelCount = Math::Max(textureRegion.levelCount, 1u),
+                .baseArrayLayer = textureRegion.arrayLayer,
+                .layerCount = Math::Max(textureRegion.layerCount, 1u)
+            });
+        }
+
+        return {batch.token};
+    }
+
+    bool VulkanDevice::IsUploadComplete(UploadToken token)
+    {
+        std::lock_guard lock(uploadMutex);
+        ReclaimUploads();
+        return token.id <= completedUploadToken;
+    }
+
+    void VulkanDevice::WaitUpload(UploadToken token)
+    {
+        std::lock_guard lock(uploadMutex);
+        if (token.id <= completedUploadToken)
+        {
+            return;
+        }
+
+        if (uploadBatches[uploadBatchIndex].recording && uploadBatches[uploadBatchIndex].token <= token.id)
+        {
+            FlushUploads();
+        }
+
+        for (VulkanUploadBatch& batch : uploadBatches)
+        {
+            if (batch.submitted && batch.token <= token.id)
+            {
+                vkWaitForFences(device, 1, &batch.fence, VK_TRUE, UINT64_MAX);
+            }
+        }
+
+        ReclaimUploads();
+    }
+
+    void VulkanDevice::CreateUploadResources()
+    {
+        VkBufferCreateInfo bufferInfo = {VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+        bufferInfo.size = UploadRingSize;
+        bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+        bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        VmaAllocationCreateInfo vmaAllocInfo = {};
+        vmaAllocInfo.usage = VMA_MEMORY_USAGE_AUTO;
+        vmaAllocInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+        vmaCreateBuffer(vmaAllocator, &bufferInfo, &vmaAllocInfo, &uploadBuffer.buffer, &uploadBuffer.allocation, &uploadBuffer.allocInfo);
+
+        uploadRing.Init(UploadRingSize);
+
+        VkFenceCreateInfo fenceInfo{VK_STRUCTURE_TYPE_FENCE_CREATE_INFO};
+        for (VulkanUploadBatch& batch : uploadBatches)
+        {
+            batch.commands = MakeShared<VulkanCommands>(*this);
+            vkCreateFence(device, &fenceInfo, nullptr, &batch.fence);
+        }
+    }
+
+    void VulkanDevice::DestroyUploadResources()
+    {
+        {
+            std::lock_guard lock(uploadMutex);
+            FlushUploads();
+        }
+
+        for (VulkanUploadBatch& batch : uploadBatches)
+        {
+            if (batch.submitted)
+            {
+                vkWaitForFences(device, 1, &batch.fence, VK_TRUE, UINT64_MAX);
+            }
+        }
+        ReclaimUploads();
+
+        for (VulkanUploadBatch& batch : uploadBatches)
+        {
+            vkDestroyFence(device, batch.fence, nullptr);
+            vkDestroyCommandPool(device, batch.commands->commandPool, nullptr);
+            batch.commands = {};
+        }
+
+        vmaDestroyBuffer(vmaAllocator, uploadBuffer.buffer, uploadBuffer.allocation);
+    }
+
+    //the functions below expect uploadMutex to be locked
+
+    VulkanUploadBatch& VulkanDevice::BeginUploadBatch()
+    {
+        VulkanUploadBatch& batch = uploadBatches[uploadBatchIndex];
+        if (batch.recording)
+        {
+            return batch;
+        }
+
+        //batches are used in order, the one being reused is the oldest submitted
+        if (batch.submitted)
+        {
+            vkWaitForFences(device, 1, &batch.fence, VK_TRUE, UINT64_MAX);
+            ReclaimUploads();
+        }
+
+        vkResetFences(device, 1, &batch.fence);
+        batch.commands->Begin();
+        batch.token = ++lastUploadToken;
+        batch.recording = true;
+        return batch;
+    }
+
+    VulkanBuffer* VulkanDevice::WriteUploadData(const void* data, usize size, usize& offset)
+    {
+        ReclaimUploads();
+
+        if (size > uploadRing.GetCapacity())
+        {
+            VulkanUploadBatch& batch = BeginUploadBatch();
+            VulkanBuffer&      stagingBuffer = batch.dedicatedBuffers.EmplaceBack();
 
             VkBufferCreateInfo bufferInfo = {VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
-            bufferInfo.size = bufferDataInfo.size;
+            bufferInfo.size = size;
             bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
             bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 
@@ -1523,20 +1916,86 @@ namespace Fyrion
             vmaAllocInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
             vmaCreateBuffer(vmaAllocator, &bufferInfo, &vmaAllocInfo, &stagingBuffer.buffer, &stagingBuffer.allocation, &stagingBuffer.allocInfo);
 
-            memcpy(stagingBuffer.allocInfo.pMappedData, bufferDataInfo.data, bufferDataInfo.size);
+            memcpy(stagingBuffer.allocInfo.pMappedData, data, size);
+            offset = 0;
+            return &stagingBuffer;
+        }
 
-            temporaryCmd->Begin();
+        //offsets aligned for any texel block size
+        const usize alignment = Math::Max(static_cast<usize>(vulkanDeviceProperties.limits.optimalBufferCopyOffsetAlignment), static_cast<usize>(16));
+        while (!uploadRing.Allocate(size, alignment, offset))
+        {
+            //the ring is full, submit the current batch and wait for the oldest one
+            FlushUploads();
+            for (VulkanUploadBatch& batch : uploadBatches)
+            {
+                if (batch.submitted && batch.token == completedUploadToken + 1)
+                {
+                    vkWaitForFences(device, 1, &batch.fence, VK_TRUE, UINT64_MAX);
+                }
+            }
+            ReclaimUploads();
+        }
 
-            BufferCopyInfo copy{};
-            copy.dstOffset = 0;
-            copy.srcOffset = bufferDataInfo.offset;
-            copy.size = bufferDataInfo.size;
+        BeginUploadBatch();
+        memcpy(static_cast<u8*>(uploadBuffer.allocInfo.pMappedData) + offset, data, size);
+        return &uploadBuffer;
+    }
 
-            temporaryCmd->CopyBuffer({&stagingBuffer}, bufferDataInfo.buffer, &copy);
-            temporaryCmd->SubmitAndWait({graphicsQueue});
+    void VulkanDevice::FlushUploads()
+    {
+        VulkanUploadBatch& batch = uploadBatches[uploadBatchIndex];
+        if (!batch.recording)
+        {
+            return;
+        }
+
+        //the copies are visible to everything submitted to the queue after the batch
+        VkMemoryBarrier barrier{VK_STRUCTURE_TYPE_MEMORY_BARRIER};
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+        vkCmdPipelineBarrier(batch.commands->commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+        batch.commands->End();
+
+        VkSubmitInfo submitInfo{VK_STRUCTURE_TYPE_SUBMIT_INFO};
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers = &batch.commands->commandBuffer;
 
-            vmaDestroyBuffer(vmaAllocator, stagingBuffer.buffer, stagingBuffer.allocation);
+        if (vkQueueSubmit(graphicsQueue, 1, &submitInfo, batch.fence) != VK_SUCCESS)
+        {
+            FY_ASSERT(false, "failed to execute vkQueueSubmit");
         }
+
+        uploadRing.Submit(batch.token);
+        batch.recording = false;
+        batch.submitted = true;
+        uploadBatchIndex = (uploadBatchIndex + 1) % FY_FRAMES_IN_FLIGHT;
+    }
+
+    void VulkanDevice::ReclaimUploads()
+    {
+        //batches complete in submission order, stops at the first one still running
+        bool reclaimed = true;
+        while (reclaimed)
+        {
+            reclaimed = false;
+            for (VulkanUploadBatch& batch : uploadBatches)
+            {
+                if (batch.submitted && batch.token == completedUploadToken + 1 && vkGetFenceStatus(device, batch.fence) == VK_SUCCESS)
+                {
+                    for (VulkanBuffer& stagingBuffer : batch.dedicatedBuffers)
+                    {
+                        vmaDestroyBuffer(vmaAllocator, stagingBuffer.buffer, stagingBuffer.allocation);
+                    }
+                    batch.dedicatedBuffers.Clear();
+                    batch.submitted = false;
+                    completedUploadToken = batch.token;
+                    reclaimed = true;
+                }
+            }
+        }
+        uploadRing.Release(completedUploadToken);
     }
 
     VoidPtr VulkanDevice::GetBufferMappedMemory(const Buffer& buffer)
@@ -1551,6 +2010,11 @@ namespace Fyrion
         return vulkanTexture->creation;
     }
 
+    DeviceFeatures VulkanDevice::GetDeviceFeatures()
+    {
+        return deviceFeatures;
+    }
+
     static void CheckVkResult(VkResult err)
     {
         if (err == 0)
@@ -1575,7 +2039,7 @@ namespace Fyrion
         Info.Device = device;
         Info.QueueFamily = graphicsFamily;
         Info.Queue = graphicsQueue;
-        Info.PipelineCache = VK_NULL_HANDLE;
+        Info.PipelineCache = pipelineCache;
         Info.DescriptorPool = descriptorPool;
         Info.UseDynamicRendering = false;
         Info.Subpass = 0;
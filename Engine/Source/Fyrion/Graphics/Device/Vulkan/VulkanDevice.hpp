@@ -8,10 +8,23 @@
 #include "volk.h"
 #include "vk_mem_alloc.h"
 #include "Fyrion/Core/FixedArray.hpp"
+#include "Fyrion/Graphics/StagingRing.hpp"
 #include "VulkanTypes.hpp"
 
+#include <mutex>
+
 namespace Fyrion
 {
+    struct VulkanUploadBatch
+    {
+        SharedPtr<VulkanCommands> commands{};
+        VkFence                   fence{};
+        u64                       token{};
+        bool                      recording = false;
+        bool                      submitted = false;
+        Array<VulkanBuffer>       dedicatedBuffers{}; //uploads bigger than the staging ring
+    };
+
     class VulkanDevice final : public RenderDevice
     {
     public:
@@ -57,6 +70,20 @@ namespace Fyrion
         Sampler defaultSampler;
 
         u32 currentFrame = 0;
+        u64 frameCount = 0;
+
+        VkPipelineCache              pipelineCache{};
+        String                       pipelineCachePath{};
+        Array<VulkanRetiredPipeline> retiredPipelines{};
+
+        //uploads to gpu only resources are recorded in batches and submitted before the next frame or temp command
+        std::mutex                                         uploadMutex{};
+        VulkanBuffer                                       uploadBuffer{};
+        StagingRing                                        uploadRing{};
+        FixedArray<VulkanUploadBatch, FY_FRAMES_IN_FLIGHT> uploadBatches{};
+        u32                                                uploadBatchIndex = 0;
+        u64                                                lastUploadToken = 0;
+        u64                                                completedUploadToken = 0;
 
         VulkanDevice();
         ~VulkanDevice() override;
@@ -88,10 +115,26 @@ namespace Fyrion
         void            WaitQueue() override;
         GPUQueue        GetMainQueue() override;
         RenderCommands& GetTempCmd() override;
-        void            UpdateBufferData(const BufferDataInfo& bufferDataInfo) override;
+        UploadToken     UpdateBufferData(const BufferDataInfo& bufferDataInfo) override;
+        UploadToken     UpdateTextureData(const TextureDataInfo& textureDataInfo) override;
+        bool            IsUploadComplete(UploadToken token) override;
+        void            WaitUpload(UploadToken token) override;
         VoidPtr         GetBufferMappedMemory(const Buffer& buffer) override;
         TextureCreation GetTextureCreationInfo(Texture texture) override;
-
+        DeviceFeatures  GetDeviceFeatures() override;
+        bool            IsPipelineStateReady(const PipelineState& pipelineState) override;
+
+        void LoadPipelineCache();
+        void SavePipelineCache();
+        bool ResolvePipelineState(VulkanPipelineState* vulkanPipelineState);
+        void DestroyRetiredPipelines(bool all);
+
+        void               CreateUploadResources();
+        void               DestroyUploadResources();
+        VulkanUploadBatch& BeginUploadBatch();
+        VulkanBuffer*      WriteUploadData(const void* data, usize size, usize& offset);
+        void               FlushUploads();
+        void               ReclaimUploads();
 
         bool CreateSwapchain(VulkanSwapchain* vulkanSwapchain);
         void DestroySwapchain(VulkanSwapchain* vulkanSwapchain);
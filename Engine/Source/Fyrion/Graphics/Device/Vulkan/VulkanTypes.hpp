@@ -4,6 +4,7 @@
 #include "vk_mem_alloc.h"
 #include "Fyrion/Core/Array.hpp"
 #include "Fyrion/Core/FixedArray.hpp"
+#include "Fyrion/Core/JobSystem.hpp"
 #include "Fyrion/Graphics/GraphicsTypes.hpp"
 #include "Fyrion/Platform/PlatformTypes.hpp"
 
@@ -71,6 +72,7 @@ namespace Fyrion
         TextureCreation creation{};
         VkImage         image{};
         VmaAllocation   allocation{};
+        bool            aliased{};
         TextureView     textureView{};
         VkDescriptorSet imguiDescriptorSet{};
         String          name{};
@@ -91,5 +93,18 @@ namespace Fyrion
         VkPipeline               pipeline{};
         VkPipelineLayout         layout{};
         VkPipelineCache          cache{};
+
+        //written by the creation job, swapped in by the device once the counter is done
+        JobCounter       creationCounter{};
+        VkPipeline       pendingPipeline{};
+        VkPipelineLayout pendingLayout{};
+    };
+
+    //replaced pipelines are kept alive until the frames in flight that may use them are finished
+    struct VulkanRetiredPipeline
+    {
+        VkPipeline       pipeline{};
+        VkPipelineLayout layout{};
+        u64              frame{};
     };
 }
@@ -231,6 +231,13 @@ namespace Fyrion::Vulkan
 		case Format::RGB: return VK_FORMAT_R8G8B8_UNORM;
 		case Format::RGB16F: return VK_FORMAT_R16G16B16_SFLOAT;
 		case Format::RGB32F: return VK_FORMAT_R32G32B32_SFLOAT;
+		case Format::BC1: return VK_FORMAT_BC1_RGB_UNORM_BLOCK;
+		case Format::BC3: return VK_FORMAT_BC3_UNORM_BLOCK;
+		case Format::BC4: return VK_FORMAT_BC4_UNORM_BLOCK;
+		case Format::BC5: return VK_FORMAT_BC5_UNORM_BLOCK;
+		case Format::BC6H: return VK_FORMAT_BC6H_UFLOAT_BLOCK;
+		case Format::BC7: return VK_FORMAT_BC7_UNORM_BLOCK;
+		case Format::RGBASNorm: return VK_FORMAT_R8G8B8A8_SNORM;
 		case Format::Undefined:
 			break;
 		default:
@@ -623,5 +630,63 @@ namespace Fyrion::Vulkan
 		nameInfo.pObjectName = name.CStr();
 		vkSetDebugUtilsObjectNameEXT(device.device, &nameInfo);
 	}
-}
 
+	namespace
+	{
+		constexpr u32 PipelineCacheMagic = 0x43505946;
+
+		//the driver validates its own header too, but some drivers crash on data from other versions
+		struct PipelineCacheFileHeader
+		{
+			u32 magic;
+			u32 vendorID;
+			u32 deviceID;
+			u32 driverVersion;
+			u8  pipelineCacheUUID[VK_UUID_SIZE];
+			u64 dataSize;
+		};
+	}
+
+	Array<u8> WritePipelineCacheFile(const VkPhysicalDeviceProperties& properties, Span<const u8> cacheData)
+	{
+		PipelineCacheFileHeader header{
+			.magic = PipelineCacheMagic,
+			.vendorID = properties.vendorID,
+			.deviceID = properties.deviceID,
+			.driverVersion = properties.driverVersion,
+			.dataSize = cacheData.Size()
+		};
+		MemCopy(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE);
+
+		Array<u8> file(sizeof(PipelineCacheFileHeader) + cacheData.Size());
+		MemCopy(file.Data(), &header, sizeof(PipelineCacheFileHeader));
+		if (!cacheData.Empty())
+		{
+			MemCopy(file.Data() + sizeof(PipelineCacheFileHeader), cacheData.Data(), cacheData.Size());
+		}
+		return file;
+	}
+
+	Span<const u8> ReadPipelineCacheFile(const VkPhysicalDeviceProperties& properties, Span<const u8> file)
+	{
+		if (file.Size() < sizeof(PipelineCacheFileHeader))
+		{
+			return {};
+		}
+
+		PipelineCacheFileHeader header{};
+		MemCopy(&header, file.Data(), sizeof(PipelineCacheFileHeader));
+
+		if (header.magic != PipelineCacheMagic ||
+			header.vendorID != properties.vendorID ||
+			header.deviceID != properties.deviceID ||
+			header.driverVersion != properties.driverVersion ||
+			memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) != 0 ||
+			header.dataSize != file.Size() - sizeof(PipelineCacheFileHeader))
+		{
+			return {};
+		}
+
+		return Span<const u8>{file.Data() + sizeof(PipelineCacheFileHeader), header.dataSize};
+	}
+}
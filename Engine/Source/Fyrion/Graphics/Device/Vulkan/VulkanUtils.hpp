@@ -40,6 +40,8 @@ namespace Fyrion::Vulkan
     VkSamplerMipmapMode           CastSamplerMipmapMode(SamplerMipmapMode samplerMipmapMode);
     void                          SetObjectName(VulkanDevice& device, VkObjectType type, u64 handle, StringView name);
     VkImageAspectFlags            CastTextureAspect(TextureAspect textureAspect);
+    Array<u8>                     WritePipelineCacheFile(const VkPhysicalDeviceProperties& properties, Span<const u8> cacheData);
+    Span<const u8>                ReadPipelineCacheFile(const VkPhysicalDeviceProperties& properties, Span<const u8> file);
 
     inline bool QueryInstanceExtension(const char* extension)
     {
@@ -0,0 +1,130 @@
+#include "DrawList.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Assets/MeshAsset.hpp"
+#include "Fyrion/Core/JobSystem.hpp"
+
+namespace Fyrion
+{
+    namespace
+    {
+        constexpr usize CullingBatchSize = 1024;
+    }
+
+    u32 LODSelection::Select(const MeshAsset* mesh, const Mat4& transform, const AABB& bounds) const
+    {
+        const u32 lodCount = mesh->GetLODCount();
+        if (errorScale <= 0.0f || lodCount == 1)
+        {
+            return 0;
+        }
+
+        const Vec3 center = (bounds.min + bounds.max) * 0.5f;
+        const f32  radius = static_cast<f32>(Math::Len(bounds.max - center));
+        const f32  distance = Math::Max(static_cast<f32>(Math::Len(center - viewPos)) - radius, 0.0001f);
+
+        f32 scale = 0.0f;
+        for (u32 axis = 0; axis < 3; ++axis)
+        {
+            scale = Math::Max(scale, static_cast<f32>(Math::Len(Math::MakeVec3(transform[axis]))));
+        }
+        const f32 pixelsPerUnit = errorScale * scale / distance;
+
+        for (u32 lod = lodCount - 1; lod > 0; --lod)
+        {
+            if (mesh->GetLODError(lod) * pixelsPerUnit <= maxPixelError)
+            {
+                return lod;
+            }
+        }
+        return 0;
+    }
+
+    LODSelection LODSelection::FromCamera(const CameraData& cameraData, Extent viewportExtent, f32 maxPixelError)
+    {
+        //projection[1][1] is 1 / tan(fov / 2), the vertical distance in NDC of an error of 1 at distance 1
+        return LODSelection{
+            .viewPos = cameraData.viewPos,
+            .errorScale = std::abs(cameraData.projection[1][1]) * static_cast<f32>(viewportExtent.height) * 0.5f,
+            .maxPixelError = maxPixelError
+        };
+    }
+
+    void DrawList::Build(const MeshRenderList& meshRenderList, const Frustum& frustum, const LODSelection& lodSelection)
+    {
+        const usize count = meshRenderList.Size();
+
+        visibility.Resize(count);
+        JobSystem::ParallelFor(count, [&](usize i)
+        {
+            MeshAsset* mesh = meshRenderList.meshes[i];
+            if (mesh != nullptr && Math::TestFrustumAABB(frustum, meshRenderList.bounds[i]))
+            {
+                visibility[i] = static_cast<u8>(lodSelection.Select(mesh, meshRenderList.transforms[i], meshRenderList.bounds[i]) + 1);
+            }
+            else
+            {
+                visibility[i] = 0;
+            }
+        }, CullingBatchSize);
+
+        commands.Clear();
+        visibleCount = 0;
+
+        for (usize i = 0; i < count; ++i)
+        {
+            if (!visibility[i])
+            {
+                continue;
+            }
+
+            visibleCount++;
+
+            MeshAsset* mesh = meshRenderList.meshes[i];
+            for (const MeshPrimitive& primitive : mesh->GetPrimitives(visibility[i] - 1))
+            {
+                if (MaterialAsset* material = meshRenderList.GetMaterial(i, primitive.materialIndex))
+                {
+                    commands.EmplaceBack(DrawCommand{
+                        .mesh = mesh,
+                        .material = material,
+                        .instance = static_cast<u32>(i),
+                        .firstIndex = primitive.firstIndex,
+                        .indexCount = primitive.indexCount,
+                        .firstMeshlet = primitive.firstMeshlet,
+                        .meshletCount = primitive.meshletCount
+                    });
+                }
+            }
+        }
+
+        std::sort(commands.begin(), commands.end(), [](const DrawCommand& a, const DrawCommand& b)
+        {
+            if (a.material != b.material)
+            {
+                return a.material < b.material;
+            }
+            if (a.mesh != b.mesh)
+            {
+                return a.mesh < b.mesh;
+            }
+            if (a.firstIndex != b.firstIndex)
+            {
+                return a.firstIndex < b.firstIndex;
+            }
+            return a.instance < b.instance;
+        });
+    }
+
+    Span<DrawCommand> DrawList::GetCommands() const
+    {
+        return commands;
+    }
+
+    usize DrawList::GetVisibleCount() const
+    {
+        return visibleCount;
+    }
+}
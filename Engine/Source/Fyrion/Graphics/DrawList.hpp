@@ -0,0 +1,44 @@
+#pragma once
+
+#include "GraphicsTypes.hpp"
+#include "Fyrion/Common.hpp"
+
+namespace Fyrion
+{
+    struct DrawCommand
+    {
+        MeshAsset*     mesh;
+        MaterialAsset* material;
+        u32            instance; //index in the MeshRenderList
+        u32            firstIndex;
+        u32            indexCount;
+        u32            firstMeshlet;
+        u32            meshletCount;
+    };
+
+    //picks the mesh LOD of each instance by its projected error in pixels. disabled when errorScale is 0.
+    struct FY_API LODSelection
+    {
+        Vec3 viewPos{};
+        f32  errorScale = 0.0f; //pixels of an object space error of 1 at distance 1
+        f32  maxPixelError = 1.0f;
+
+        u32 Select(const MeshAsset* mesh, const Mat4& transform, const AABB& bounds) const;
+
+        static LODSelection FromCamera(const CameraData& cameraData, Extent viewportExtent, f32 maxPixelError = 1.0f);
+    };
+
+    //visible primitives of a MeshRenderList, sorted by material and mesh to minimize state changes.
+    class FY_API DrawList
+    {
+    public:
+        void              Build(const MeshRenderList& meshRenderList, const Frustum& frustum, const LODSelection& lodSelection = {});
+        Span<DrawCommand> GetCommands() const;
+        usize             GetVisibleCount() const;
+
+    private:
+        Array<u8>          visibility{}; //selected LOD + 1, 0 when culled
+        Array<DrawCommand> commands{};
+        usize              visibleCount = 0;
+    };
+}
@@ -191,53 +191,27 @@ namespace Fyrion
 
     void Graphics::UpdateTextureData(const TextureDataInfo& textureDataInfo)
     {
-        Buffer buffer = CreateBuffer(BufferCreation{
-            .size = textureDataInfo.size,
-            .allocation = BufferAllocation::TransferToGPU
-        });
-
-        MemCopy(GetBufferMappedMemory(buffer), textureDataInfo.data, textureDataInfo.size);
+        renderDevice->UpdateTextureData(textureDataInfo);
+    }
 
-        RenderCommands& tempCmd = renderDevice->GetTempCmd();
-        tempCmd.Begin();
+    UploadToken Graphics::UpdateBufferDataAsync(const BufferDataInfo& bufferDataInfo)
+    {
+        return renderDevice->UpdateBufferData(bufferDataInfo);
+    }
 
-        for (const TextureDataRegion& textureRegion : textureDataInfo.regions)
-        {
-            tempCmd.ResourceBarrier(ResourceBarrierInfo{
-                .texture = textureDataInfo.texture,
-                .oldLayout = ResourceLayout::Undefined,
-                .newLayout = ResourceLayout::CopyDest,
-                .mipLevel = textureRegion.mipLevel,
-                .levelCount = Math::Max(textureRegion.levelCount, 1u),
-                .baseArrayLayer = textureRegion.arrayLayer,
-                .layerCount = Math::Max(textureRegion.layerCount, 1u)
-            });
-
-            BufferImageCopy region{
-                .bufferOffset = textureRegion.dataOffset,
-                .textureMipLevel = textureRegion.mipLevel,
-                .textureArrayLayer = textureRegion.arrayLayer,
-                .layerCount = Math::Max(textureRegion.layerCount, 1u),
-                .imageOffset = {},
-                .imageExtent = {textureRegion.extent.width, textureRegion.extent.height, Math::Max(textureRegion.extent.depth, 1u)},
-            };
-
-            tempCmd.CopyBufferToTexture(buffer, textureDataInfo.texture, {&region, 1});
-
-            tempCmd.ResourceBarrier(ResourceBarrierInfo{
-                .texture = textureDataInfo.texture,
-                .oldLayout = ResourceLayout::CopyDest,
-                .newLayout = ResourceLayout::ShaderReadOnly,
-                .mipLevel = textureRegion.mipLevel,
-                .levelCount = Math::Max(textureRegion.levelCount, 1u),
-                .baseArrayLayer = textureRegion.arrayLayer,
-                .layerCount = Math::Max(textureRegion.layerCount, 1u)
-            });
-        }
+    UploadToken Graphics::UpdateTextureDataAsync(const TextureDataInfo& textureDataInfo)
+    {
+        return renderDevice->UpdateTextureData(textureDataInfo);
+    }
 
-        tempCmd.SubmitAndWait(renderDevice->GetMainQueue());
+    bool Graphics::IsUploadComplete(UploadToken token)
+    {
+        return renderDevice->IsUploadComplete(token);
+    }
 
-        DestroyBuffer(buffer);
+    void Graphics::WaitUpload(UploadToken token)
+    {
+        renderDevice->WaitUpload(token);
     }
 
     void Graphics::UpdateTextureLayout(Texture texture, ResourceLayout oldLayout, ResourceLayout newLayout, bool isDepth)
@@ -301,6 +275,16 @@ namespace Fyrion
         return renderDevice->GetTextureCreationInfo(texture);
     }
 
+    DeviceFeatures Graphics::GetDeviceFeatures()
+    {
+        return renderDevice->GetDeviceFeatures();
+    }
+
+    bool Graphics::IsPipelineStateReady(const PipelineState& pipelineState)
+    {
+        return renderDevice->IsPipelineStateReady(pipelineState);
+    }
+
     RenderApiType Graphics::GetRenderApi()
     {
         return RenderApiType::Vulkan;
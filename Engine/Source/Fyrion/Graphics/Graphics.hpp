@@ -28,10 +28,16 @@ namespace Fyrion::Graphics
     FY_API void            WaitQueue();
     FY_API void            UpdateBufferData(const BufferDataInfo& bufferDataInfo);
     FY_API void            UpdateTextureData(const TextureDataInfo& textureDataInfo);
+    FY_API UploadToken     UpdateBufferDataAsync(const BufferDataInfo& bufferDataInfo);
+    FY_API UploadToken     UpdateTextureDataAsync(const TextureDataInfo& textureDataInfo);
+    FY_API bool            IsUploadComplete(UploadToken token);
+    FY_API void            WaitUpload(UploadToken token);
     FY_API void            UpdateTextureLayout(Texture texture, ResourceLayout oldLayout, ResourceLayout newLayout, bool isDepth = false);
     FY_API VoidPtr         GetBufferMappedMemory(const Buffer& buffer);
     FY_API void            GetTextureData(const TextureGetDataInfo& info, Array<u8>& data);
     FY_API TextureCreation GetTextureCreationInfo(Texture texture);
+    FY_API DeviceFeatures  GetDeviceFeatures();
+    FY_API bool            IsPipelineStateReady(const PipelineState& pipelineState);
     FY_API RenderCommands& GetCmd();
     FY_API GPUQueue        GetMainQueue();
     FY_API RenderApiType   GetRenderApi();
@@ -51,6 +51,7 @@ namespace Fyrion
         Registry::Type<DCCAsset>();
         Registry::Type<DCCAssetImportSettings>();
         Registry::Type<MeshAsset>();
+        Registry::Type<MeshImportSettings>();
         Registry::Type<MaterialAsset>();
         Registry::Type<MeshPrimitive>();
         Registry::Type<TextureAssetImage>();
@@ -87,6 +88,23 @@ namespace Fyrion
         textureType.Value<TextureType::Texture3D>("Texture3D");
         textureType.Value<TextureType::Cubemap>("Cubemap");
 
+        auto textureCompression = Registry::Type<TextureCompression>();
+        textureCompression.Value<TextureCompression::None>("None");
+        textureCompression.Value<TextureCompression::BC1>("BC1");
+        textureCompression.Value<TextureCompression::BC3>("BC3");
+        textureCompression.Value<TextureCompression::BC4>("BC4");
+        textureCompression.Value<TextureCompression::BC5>("BC5");
+        textureCompression.Value<TextureCompression::BC6H>("BC6H");
+        textureCompression.Value<TextureCompression::BC7>("BC7");
+
+        auto mipFilter = Registry::Type<MipFilter>();
+        mipFilter.Value<MipFilter::Box>("Box");
+        mipFilter.Value<MipFilter::Kaiser>("Kaiser");
+
+        auto meshVertexFormat = Registry::Type<MeshVertexFormat>();
+        meshVertexFormat.Value<MeshVertexFormat::Full>("Full");
+        meshVertexFormat.Value<MeshVertexFormat::Quantized>("Quantized");
+
         auto format = Registry::Type<Format>();
         format.Value<Format::R>("R");
         format.Value<Format::R16F>("R16F");
@@ -103,6 +121,13 @@ namespace Fyrion
         format.Value<Format::BGRA>("BGRA");
         format.Value<Format::Depth>("Depth");
         format.Value<Format::Undefined>("Undefined");
+        format.Value<Format::BC1>("BC1");
+        format.Value<Format::BC3>("BC3");
+        format.Value<Format::BC4>("BC4");
+        format.Value<Format::BC5>("BC5");
+        format.Value<Format::BC6H>("BC6H");
+        format.Value<Format::BC7>("BC7");
+        format.Value<Format::RGBASNorm>("RGBASNorm");
 
         auto lightType = Registry::Type<LightType>();
         lightType.Value<LightType::Directional>("Directional");
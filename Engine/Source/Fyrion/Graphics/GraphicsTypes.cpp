@@ -8,6 +8,8 @@ namespace Fyrion
         type.Field<&MeshPrimitive::firstIndex>("firstIndex");
         type.Field<&MeshPrimitive::indexCount>("indexCount");
         type.Field<&MeshPrimitive::materialIndex>("materialIndex");
+        type.Field<&MeshPrimitive::firstMeshlet>("firstMeshlet");
+        type.Field<&MeshPrimitive::meshletCount>("meshletCount");
     }
 
     void RenderGraphEdge::RegisterType(NativeTypeHandler<RenderGraphEdge>& type)
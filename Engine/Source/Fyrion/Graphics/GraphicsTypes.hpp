@@ -41,6 +41,13 @@ namespace Fyrion
         BGRA,
         Depth,
         Undefined,
+        BC1,
+        BC3,
+        BC4,
+        BC5,
+        BC6H,
+        BC7,
+        RGBASNorm,
         //TODO : add ohter formats
     };
 
@@ -308,6 +315,25 @@ namespace Fyrion
         bool  castShadows;
     };
 
+    struct PointLight
+    {
+        Vec3  position;
+        Color color;
+        f32   intensity;
+        f32   range;
+    };
+
+    struct SpotLight
+    {
+        Vec3  position;
+        Vec3  direction;  //where the light points to
+        Color color;
+        f32   intensity;
+        f32   range;
+        f32   innerAngle; //half angle in radians, full intensity inside
+        f32   outerAngle; //half angle in radians, no light outside
+    };
+
     struct SwapchainCreation
     {
         Window window{};
@@ -345,6 +371,7 @@ namespace Fyrion
         u32          arrayLayers{1};
         ViewType     defaultView{ViewType::Type2D};
         StringView   name{};
+        Texture      aliasTexture{}; //shares the memory of this texture if it fits, their contents are not valid at the same time
     };
 
     struct TextureViewCreation
@@ -413,6 +440,8 @@ namespace Fyrion
         Span<VertexInputAttribute> inputs{};
         u32                        stride{};
         PipelineState              pipelineState{};
+        //created on a worker thread, Graphics::IsPipelineStateReady tells when it can be used
+        bool                       async{false};
     };
 
     struct ComputePipelineCreation
@@ -447,6 +476,7 @@ namespace Fyrion
 
     struct ResourceBarrierInfo
     {
+        Buffer buffer{}; //compute shader writes to be read by indirect draws, graphics and compute shaders, the texture fields are ignored
         Texture texture{};
         ResourceLayout oldLayout{};
         ResourceLayout newLayout{};
@@ -533,6 +563,12 @@ namespace Fyrion
         static void RegisterType(NativeTypeHandler<ShaderInfo>& type);
     };
 
+    //identifies the upload batch of an async update, ids grow in submission order
+    struct UploadToken
+    {
+        u64 id{};
+    };
+
     struct BufferDataInfo
     {
         Buffer      buffer{};
@@ -598,6 +634,22 @@ namespace Fyrion
         Vec4 tangent{};
     };
 
+    //compact layout written by the mesh optimizer, the shaders read the same inputs as VertexStride.
+    struct VertexStrideQuantized final
+    {
+        Vec3 position{};
+        u16  uv[2]{};      //half
+        i8   normal[4]{};  //snorm
+        i8   tangent[4]{}; //snorm, w is the bitangent sign
+        u8   color[4]{};   //unorm
+    };
+
+    enum class MeshVertexFormat
+    {
+        Full,
+        Quantized
+    };
+
     inline bool operator==(const VertexStride& r, const VertexStride& l)
     {
         return r.position == l.position && r.normal == l.normal && r.uv == l.uv && r.color == l.color && r.tangent == l.tangent;
@@ -618,10 +670,49 @@ namespace Fyrion
         u32 firstIndex{};
         u32 indexCount{};
         u32 materialIndex{};
+        u32 firstMeshlet{};
+        u32 meshletCount{}; //0 for meshes imported without meshlets
 
         static void RegisterType(NativeTypeHandler<MeshPrimitive>& type);
     };
 
+    //cluster of triangles of a primitive, the triangles are a range of the mesh index buffer.
+    struct Meshlet final
+    {
+        u32 firstIndex{};
+        u32 indexCount{};
+        u32 vertexCount{};
+    };
+
+    //object space bounds of a meshlet. the meshlet is backfacing when all the triangle normals are
+    //inside the cone, coneCutoff is 1 when the normals are too spread to be culled.
+    struct MeshletBounds final
+    {
+        Vec3 center{};
+        f32  radius{};
+        Vec3 coneAxis{};
+        f32  coneCutoff{1.0f};
+    };
+
+    //meshlets of a primitive drawn by a list of instances, the culling writes one draw per meshlet and instance.
+    struct MeshletBatch final
+    {
+        u32 firstCommand{};
+        u32 firstMeshlet{};
+        u32 meshletCount{};
+        u32 firstInstance{}; //in the batch instances, the instance count comes from the next batch
+    };
+
+    //same layout as VkDrawIndexedIndirectCommand
+    struct DrawIndexedIndirectCommand final
+    {
+        u32 indexCount{};
+        u32 instanceCount{};
+        u32 firstIndex{};
+        i32 vertexOffset{};
+        u32 firstInstance{};
+    };
+
 
     struct BufferCopyInfo
     {
@@ -642,12 +733,43 @@ namespace Fyrion
         f32 farClip{};
     };
 
-    struct MeshRenderData
+    struct MeshRenderHandle
     {
-        usize                 address{};
-        Mat4                  model;
-        MeshAsset*            mesh = nullptr;
-        Array<MaterialAsset*> materials{};
+        u32 index = U32_MAX;
+        u32 generation = 0;
+
+        explicit operator bool() const
+        {
+            return index != U32_MAX;
+        }
+    };
+
+    struct MeshRenderMaterials
+    {
+        u32 offset;
+        u32 count;
+        u32 capacity;
+    };
+
+    //packed renderables, all spans share the same index.
+    struct MeshRenderList
+    {
+        Span<Mat4>                transforms;
+        Span<AABB>                bounds;
+        Span<MeshAsset*>          meshes;
+        Span<MeshRenderMaterials> materialRanges;
+        Span<MaterialAsset*>      materials;
+
+        usize Size() const
+        {
+            return meshes.Size();
+        }
+
+        MaterialAsset* GetMaterial(usize index, u32 materialIndex) const
+        {
+            const MeshRenderMaterials& range = materialRanges[index];
+            return materialIndex < range.count ? materials[range.offset + materialIndex] : nullptr;
+        }
     };
 
     struct TextureArrayElement
@@ -747,6 +869,7 @@ namespace Fyrion
         bool raytraceSupported{};
         bool bindlessSupported{};
         bool multiDrawIndirectSupported{};
+        bool textureCompressionBCSupported{};
     };
 
 
@@ -767,8 +890,15 @@ namespace Fyrion
         case Format::RGBA16F: return sizeof(Vec4) / 2;
         case Format::RGBA32F: return sizeof(Vec4);
         case Format::BGRA: return 8 * 4;
+        case Format::RGBASNorm: return 8 * 4;
         case Format::Depth:
         case Format::Undefined:
+        case Format::BC1:
+        case Format::BC3:
+        case Format::BC4:
+        case Format::BC5:
+        case Format::BC6H:
+        case Format::BC7:
             break;
         }
         return 0;
@@ -0,0 +1,224 @@
+#include "LightCulling.hpp"
+
+#include <cmath>
+
+#include "Fyrion/Core/JobSystem.hpp"
+
+namespace Fyrion
+{
+    namespace
+    {
+        bool TestSphereAABB(const Vec3& center, f32 radius, const AABB& bounds)
+        {
+            f32 distance = 0.0f;
+            for (i32 axis = 0; axis < 3; ++axis)
+            {
+                if (center[axis] < bounds.min[axis])
+                {
+                    const f32 delta = bounds.min[axis] - center[axis];
+                    distance += delta * delta;
+                }
+                else if (center[axis] > bounds.max[axis])
+                {
+                    const f32 delta = center[axis] - bounds.max[axis];
+                    distance += delta * delta;
+                }
+            }
+            return distance <= radius * radius;
+        }
+
+        //light position, direction and range in view space
+        bool TestViewLight(const Vec4& positionRange, const Vec4& direction, const Vec4& spotAngles, const AABB& bounds)
+        {
+            const Vec3 position = Math::MakeVec3(positionRange);
+            if (!TestSphereAABB(position, positionRange.w, bounds))
+            {
+                return false;
+            }
+
+            if (direction.w == 0.0f)
+            {
+                return true;
+            }
+
+            const Vec3 center = (bounds.min + bounds.max) * 0.5f;
+            const f32  radius = static_cast<f32>(Math::Len(bounds.max - center));
+
+            const Vec3 toCenter = center - position;
+            const f32  axisDistance = Math::Dot(toCenter, Math::MakeVec3(direction));
+            const f32  lineDistance = Math::Sqrt(Math::Max(Math::Dot(toCenter, toCenter) - axisDistance * axisDistance, 0.0f));
+            const f32  coneDistance = spotAngles.x * lineDistance - axisDistance * spotAngles.y;
+
+            return coneDistance <= radius && axisDistance <= radius + positionRange.w && axisDistance >= -radius;
+        }
+
+        void BinSlice(const CameraData& cameraData, Span<LightCulling::LightData> lights, LightCulling::LightClusterList& list, u32 z)
+        {
+            Array<u32>& indices = list.sliceIndices[z];
+            indices.Clear();
+
+            const f32 nearDepth = LightCulling::GetSliceDepth(z, cameraData.nearClip, cameraData.farClip);
+            const f32 farDepth = LightCulling::GetSliceDepth(z + 1, cameraData.nearClip, cameraData.farClip);
+
+            //lights that can touch the depth range of the slice, the loop only reads contiguous vec4s
+            Array<u32> candidates{};
+            for (u32 i = 0; i < list.viewPositions.Size(); ++i)
+            {
+                const Vec4& positionRange = list.viewPositions[i];
+                if (-positionRange.z + positionRange.w >= nearDepth && -positionRange.z - positionRange.w <= farDepth)
+                {
+                    candidates.EmplaceBack(i);
+                }
+            }
+
+            for (u32 y = 0; y < LightCulling::ClusterCountY; ++y)
+            {
+                for (u32 x = 0; x < LightCulling::ClusterCountX; ++x)
+                {
+                    const AABB bounds = LightCulling::GetClusterBounds(cameraData, x, y, z);
+                    const u32  offset = static_cast<u32>(indices.Size());
+
+                    for (u32 light : candidates)
+                    {
+                        if (indices.Size() - offset == LightCulling::MaxLightsPerCluster)
+                        {
+                            break;
+                        }
+
+                        if (TestViewLight(list.viewPositions[light], list.viewDirections[light], lights[light].spotAngles, bounds))
+                        {
+                            indices.EmplaceBack(light);
+                        }
+                    }
+
+                    list.clusters[LightCulling::GetClusterIndex(x, y, z)] = LightCulling::LightCluster{
+                        .offset = offset,
+                        .count = static_cast<u32>(indices.Size()) - offset
+                    };
+                }
+            }
+        }
+    }
+
+    void LightCulling::PackLights(Span<PointLight> pointLights, Span<SpotLight> spotLights, Array<LightData>& lights)
+    {
+        lights.Clear();
+
+        for (const PointLight& pointLight : pointLights)
+        {
+            lights.EmplaceBack(LightData{
+                .positionRange = Math::MakeVec4(pointLight.position, pointLight.range),
+                .colorIntensity = Math::MakeVec4(pointLight.color.ToVec3(), pointLight.intensity)
+            });
+        }
+
+        for (const SpotLight& spotLight : spotLights)
+        {
+            const f32 cosOuter = std::cos(spotLight.outerAngle);
+            const f32 cosInner = std::cos(spotLight.innerAngle);
+
+            lights.EmplaceBack(LightData{
+                .positionRange = Math::MakeVec4(spotLight.position, spotLight.range),
+                .colorIntensity = Math::MakeVec4(spotLight.color.ToVec3(), spotLight.intensity),
+                .direction = Math::MakeVec4(Math::Normalize(spotLight.direction), 1.0f),
+                .spotAngles = Vec4{cosOuter, std::sin(spotLight.outerAngle), 1.0f / Math::Max(cosInner - cosOuter, 0.001f), 0.0f}
+            });
+        }
+    }
+
+    u32 LightCulling::GetClusterIndex(u32 x, u32 y, u32 z)
+    {
+        return x + y * ClusterCountX + z * ClusterCountX * ClusterCountY;
+    }
+
+    u32 LightCulling::GetSlice(f32 viewDepth, f32 nearClip, f32 farClip)
+    {
+        if (viewDepth <= nearClip)
+        {
+            return 0;
+        }
+        const u32 slice = static_cast<u32>(std::log(viewDepth / nearClip) / std::log(farClip / nearClip) * ClusterCountZ);
+        return Math::Min(slice, ClusterCountZ - 1);
+    }
+
+    f32 LightCulling::GetSliceDepth(u32 slice, f32 nearClip, f32 farClip)
+    {
+        return nearClip * std::pow(farClip / nearClip, static_cast<f32>(slice) / ClusterCountZ);
+    }
+
+    AABB LightCulling::GetClusterBounds(const CameraData& cameraData, u32 x, u32 y, u32 z)
+    {
+        const f32 nearDepth = GetSliceDepth(z, cameraData.nearClip, cameraData.farClip);
+        const f32 farDepth = GetSliceDepth(z + 1, cameraData.nearClip, cameraData.farClip);
+
+        AABB bounds{Vec3{F32_MAX, F32_MAX, F32_MAX}, Vec3{-F32_MAX, -F32_MAX, -F32_MAX}};
+
+        for (u32 corner = 0; corner < 4; ++corner)
+        {
+            const f32 ndcX = -1.0f + 2.0f * static_cast<f32>(x + (corner & 1)) / ClusterCountX;
+            const f32 ndcY = -1.0f + 2.0f * static_cast<f32>(y + (corner >> 1)) / ClusterCountY;
+
+            //any point of the projection works, only the ray from the camera is used
+            const Vec4 point = cameraData.projectionInverse * Vec4{ndcX, ndcY, 1.0f, 1.0f};
+            const Vec3 ray = Math::MakeVec3(point) / point.w;
+
+            for (f32 depth : {nearDepth, farDepth})
+            {
+                const Vec3 position = ray * (depth / -ray.z);
+                bounds.min = Math::Min(bounds.min, position);
+                bounds.max = Math::Max(bounds.max, position);
+            }
+        }
+
+        return bounds;
+    }
+
+    bool LightCulling::TestLight(const LightData& light, const Mat4& view, const AABB& bounds)
+    {
+        const Vec4 position = view * Vec4{light.positionRange.x, light.positionRange.y, light.positionRange.z, 1.0f};
+        const Vec4 direction = view * Vec4{light.direction.x, light.direction.y, light.direction.z, 0.0f};
+
+        return TestViewLight(Vec4{position.x, position.y, position.z, light.positionRange.w},
+                             Vec4{direction.x, direction.y, direction.z, light.direction.w},
+                             light.spotAngles,
+                             bounds);
+    }
+
+    void LightCulling::BuildClusters(const CameraData& cameraData, Span<LightData> lights, LightClusterList& list)
+    {
+        list.clusters.Resize(ClusterCount);
+        list.lightIndices.Clear();
+        list.viewPositions.Resize(lights.Size());
+        list.viewDirections.Resize(lights.Size());
+
+        for (usize i = 0; i < lights.Size(); ++i)
+        {
+            const LightData& light = lights[i];
+            const Vec4       position = cameraData.view * Vec4{light.positionRange.x, light.positionRange.y, light.positionRange.z, 1.0f};
+            const Vec4       direction = cameraData.view * Vec4{light.direction.x, light.direction.y, light.direction.z, 0.0f};
+
+            list.viewPositions[i] = Vec4{position.x, position.y, position.z, light.positionRange.w};
+            list.viewDirections[i] = Vec4{direction.x, direction.y, direction.z, light.direction.w};
+        }
+
+        JobSystem::ParallelFor(ClusterCountZ, [&](usize z)
+        {
+            BinSlice(cameraData, lights, list, static_cast<u32>(z));
+        }, 1);
+
+        //slices are written to their own lists, merge them and move the offsets
+        for (u32 z = 0; z < ClusterCountZ; ++z)
+        {
+            const u32 base = static_cast<u32>(list.lightIndices.Size());
+            for (u32 i = 0; i < ClusterCountX * ClusterCountY; ++i)
+            {
+                list.clusters[z * ClusterCountX * ClusterCountY + i].offset += base;
+            }
+
+            for (u32 light : list.sliceIndices[z])
+            {
+                list.lightIndices.EmplaceBack(light);
+            }
+        }
+    }
+}
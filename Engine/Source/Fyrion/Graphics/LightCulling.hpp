@@ -0,0 +1,56 @@
+#pragma once
+
+#include "GraphicsTypes.hpp"
+
+//CPU reference of the LightCulling compute shader, both must give the same clusters.
+//lights are binned in a froxel grid: screen tiles on xy and exponential view depth slices on z.
+namespace Fyrion::LightCulling
+{
+    constexpr u32 ClusterCountX = 16;
+    constexpr u32 ClusterCountY = 9;
+    constexpr u32 ClusterCountZ = 24;
+    constexpr u32 ClusterCount = ClusterCountX * ClusterCountY * ClusterCountZ;
+    constexpr u32 MaxLightsPerCluster = 128;
+
+    //GPU layout of point and spot lights
+    struct LightData
+    {
+        Vec4 positionRange;  //xyz world position, w range
+        Vec4 colorIntensity; //rgb color, w intensity
+        Vec4 direction;      //xyz spot direction, w is 1 for spot lights and 0 for point lights
+        Vec4 spotAngles;     //x cos outer, y sin outer, z 1 / (cos inner - cos outer)
+    };
+
+    struct LightCluster
+    {
+        u32 offset; //first light in the light index list
+        u32 count;
+    };
+
+    struct LightClusterList
+    {
+        Array<LightCluster> clusters{};     //indexed by GetClusterIndex
+        Array<u32>          lightIndices{}; //lights of each cluster in ascending order
+
+        //reused between frames by BuildClusters
+        Array<Vec4> viewPositions{};
+        Array<Vec4> viewDirections{};
+        Array<u32>  sliceIndices[ClusterCountZ]{};
+    };
+
+    //point lights come first, spot light indices are offset by the point light count.
+    FY_API void PackLights(Span<PointLight> pointLights, Span<SpotLight> spotLights, Array<LightData>& lights);
+
+    FY_API u32  GetClusterIndex(u32 x, u32 y, u32 z);
+    FY_API u32  GetSlice(f32 viewDepth, f32 nearClip, f32 farClip);
+    FY_API f32  GetSliceDepth(u32 slice, f32 nearClip, f32 farClip);
+
+    //view space bounds, the camera looks to -z.
+    FY_API AABB GetClusterBounds(const CameraData& cameraData, u32 x, u32 y, u32 z);
+
+    //sphere of the range against the bounds, spot lights are also tested with the cone against the bounding sphere of the bounds.
+    FY_API bool TestLight(const LightData& light, const Mat4& view, const AABB& bounds);
+
+    //slices are binned in parallel jobs, each cluster keeps up to MaxLightsPerCluster lights.
+    FY_API void BuildClusters(const CameraData& cameraData, Span<LightData> lights, LightClusterList& list);
+}
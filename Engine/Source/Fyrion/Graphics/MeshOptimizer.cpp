@@ -0,0 +1,1109 @@
+#include "MeshOptimizer.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+#include "Fyrion/Core/FlatHashMap.hpp"
+#include "Fyrion/Core/FlatHashSet.hpp"
+
+namespace Fyrion
+{
+    namespace
+    {
+        //----- forsyth vertex cache optimization
+
+        constexpr u32 VertexCacheSize = 32;
+        constexpr f32 CacheDecayPower = 1.5f;
+        constexpr f32 LastTriangleScore = 0.75f;
+        constexpr f32 ValenceBoostScale = 2.0f;
+        constexpr f32 ValenceBoostPower = 0.5f;
+
+        f32 VertexScore(i32 cachePosition, u32 remainingValence)
+        {
+            if (remainingValence == 0)
+            {
+                return -1.0f;
+            }
+
+            f32 score = 0.0f;
+            if (cachePosition >= 0)
+            {
+                if (cachePosition < 3)
+                {
+                    //the vertices of the last triangle get a fixed score, so the next triangle doesn't prefer a strip direction
+                    score = LastTriangleScore;
+                }
+                else
+                {
+                    const f32 scaler = 1.0f / static_cast<f32>(VertexCacheSize - 3);
+                    score = std::pow(1.0f - static_cast<f32>(cachePosition - 3) * scaler, CacheDecayPower);
+                }
+            }
+
+            //vertices with few triangles left are preferred to avoid leaving isolated triangles behind
+            return score + ValenceBoostScale * std::pow(static_cast<f32>(remainingValence), -ValenceBoostPower);
+        }
+
+        //maps the indices to [0, unique count) so the per vertex data of a primitive doesn't depend on the mesh vertex count.
+        //unique[local] is the original index.
+        u32 CompactIndices(Span<u32> indices, Array<u32>& local, Array<u32>& unique)
+        {
+            unique.Resize(indices.Size());
+            MemCopy(unique.Data(), indices.Data(), indices.Size() * sizeof(u32));
+            std::sort(unique.begin(), unique.end());
+            const usize uniqueCount = std::unique(unique.begin(), unique.end()) - unique.begin();
+
+            local.Resize(indices.Size());
+            for (usize i = 0; i < indices.Size(); ++i)
+            {
+                local[i] = static_cast<u32>(std::lower_bound(unique.begin(), unique.begin() + uniqueCount, indices[i]) - unique.begin());
+            }
+            unique.Resize(uniqueCount);
+            return static_cast<u32>(uniqueCount);
+        }
+
+        u32 CompactIndices(Span<u32> indices, Array<u32>& local)
+        {
+            Array<u32> unique{};
+            return CompactIndices(indices, local, unique);
+        }
+
+        //----- FIFO cache simulation used by the overdraw optimization and the stats
+
+        struct FIFOCache
+        {
+            Array<u32> timestamps{};
+            u32        timestamp = 0;
+            u32        size = 0;
+
+            FIFOCache(usize vertexCount, u32 cacheSize) : timestamp(cacheSize + 1), size(cacheSize)
+            {
+                timestamps.Resize(vertexCount, 0);
+            }
+
+            void Flush()
+            {
+                timestamp += size + 1;
+            }
+
+            u32 Triangle(u32 a, u32 b, u32 c)
+            {
+                return Vertex(a) + Vertex(b) + Vertex(c);
+            }
+
+            u32 Vertex(u32 vertex)
+            {
+                if (timestamp - timestamps[vertex] > size)
+                {
+                    timestamps[vertex] = timestamp++;
+                    return 1;
+                }
+                return 0;
+            }
+        };
+
+        //----- quadric error simplification
+
+        constexpr f32 BorderWeight = 10.0f;
+        constexpr f32 AttributeWeight = 0.01f;
+        constexpr f32 MaxFlipCos = 0.25f;
+
+        constexpr f32 MinConeDot = 0.1f;
+
+        struct Quadric
+        {
+            f32 a00 = 0, a11 = 0, a22 = 0;
+            f32 a01 = 0, a02 = 0, a12 = 0;
+            f32 b0 = 0, b1 = 0, b2 = 0;
+            f32 c = 0;
+            f32 weight = 0;
+
+            void AddPlane(const Vec3& normal, f32 distance, f32 planeWeight)
+            {
+                a00 += normal.x * normal.x * planeWeight;
+                a11 += normal.y * normal.y * planeWeight;
+                a22 += normal.z * normal.z * planeWeight;
+                a01 += normal.x * normal.y * planeWeight;
+                a02 += normal.x * normal.z * planeWeight;
+                a12 += normal.y * normal.z * planeWeight;
+                b0 += normal.x * distance * planeWeight;
+                b1 += normal.y * distance * planeWeight;
+                b2 += normal.z * distance * planeWeight;
+                c += distance * distance * planeWeight;
+                weight += planeWeight;
+            }
+
+            void Add(const Quadric& other)
+            {
+                a00 += other.a00;
+                a11 += other.a11;
+                a22 += other.a22;
+                a01 += other.a01;
+                a02 += other.a02;
+                a12 += other.a12;
+                b0 += other.b0;
+                b1 += other.b1;
+                b2 += other.b2;
+                c += other.c;
+                weight += other.weight;
+            }
+
+            //squared distance to the planes, weighted by their area
+            f32 Error(const Vec3& p) const
+            {
+                const f32 rx = a00 * p.x + a01 * p.y + a02 * p.z + b0;
+                const f32 ry = a01 * p.x + a11 * p.y + a12 * p.z + b1;
+                const f32 rz = a02 * p.x + a12 * p.y + a22 * p.z + b2;
+                const f32 error = rx * p.x + ry * p.y + rz * p.z + b0 * p.x + b1 * p.y + b2 * p.z + c;
+                return std::abs(error) / (weight > 0.0f ? weight : 1.0f);
+            }
+        };
+
+        enum class VertexKind : u8
+        {
+            Manifold, //can collapse to any neighbor
+            Border,   //can only collapse along the border
+            Locked    //attribute seams and non-manifold vertices
+        };
+
+        struct Collapse
+        {
+            u32 from;
+            u32 to;
+            f32 error;
+        };
+
+        FY_FINLINE u64 EdgeKey(u32 a, u32 b)
+        {
+            return static_cast<u64>(a) << 32 | b;
+        }
+
+        FY_FINLINE Vec3 TriangleNormal(const Vec3& p0, const Vec3& p1, const Vec3& p2)
+        {
+            return Math::Cross(p1 - p0, p2 - p0);
+        }
+
+        //----- meshlets
+
+        //sphere around the box of the meshlet and the cone of its triangle normals
+        MeshletBounds ComputeMeshletBounds(const u32* triangles, usize indexCount, const Array<VertexStride>& vertices)
+        {
+            Vec3 minPosition{F32_MAX, F32_MAX, F32_MAX};
+            Vec3 maxPosition{-F32_MAX, -F32_MAX, -F32_MAX};
+            Vec3 normalSum{};
+
+            for (usize i = 0; i < indexCount; i += 3)
+            {
+                const Vec3& p0 = vertices[triangles[i]].position;
+                const Vec3& p1 = vertices[triangles[i + 1]].position;
+                const Vec3& p2 = vertices[triangles[i + 2]].position;
+
+                for (const Vec3* p : {&p0, &p1, &p2})
+                {
+                    minPosition = Vec3{Math::Min(minPosition.x, p->x), Math::Min(minPosition.y, p->y), Math::Min(minPosition.z, p->z)};
+                    maxPosition = Vec3{Math::Max(maxPosition.x, p->x), Math::Max(maxPosition.y, p->y), Math::Max(maxPosition.z, p->z)};
+                }
+
+                const Vec3 normal = TriangleNormal(p0, p1, p2);
+                const f32  length = static_cast<f32>(Math::Len(normal));
+                if (length > 0.0f)
+                {
+                    normalSum = normalSum + normal / length;
+                }
+            }
+
+            MeshletBounds bounds{};
+            bounds.center = (minPosition + maxPosition) * 0.5f;
+            for (usize i = 0; i < indexCount; ++i)
+            {
+                bounds.radius = Math::Max(bounds.radius, static_cast<f32>(Math::Len(vertices[triangles[i]].position - bounds.center)));
+            }
+
+            const f32 axisLength = static_cast<f32>(Math::Len(normalSum));
+            if (axisLength == 0.0f)
+            {
+                return bounds;
+            }
+            bounds.coneAxis = normalSum / axisLength;
+
+            f32 minDot = 1.0f;
+            for (usize i = 0; i < indexCount; i += 3)
+            {
+                const Vec3 normal = TriangleNormal(vertices[triangles[i]].position, vertices[triangles[i + 1]].position, vertices[triangles[i + 2]].position);
+                const f32  length = static_cast<f32>(Math::Len(normal));
+                if (length > 0.0f)
+                {
+                    minDot = Math::Min(minDot, Math::Dot(bounds.coneAxis, normal) / length);
+                }
+            }
+
+            //the cone is only useful when all the normals are less than 90 degrees apart from the axis.
+            //the meshlet is backfacing when the view direction is within 90 - angle degrees of the axis, so sin(angle) is stored.
+            if (minDot > MinConeDot)
+            {
+                bounds.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+            }
+            return bounds;
+        }
+
+        //----- quantization
+
+        u16 ToHalf(f32 value)
+        {
+            const u16 sign = static_cast<u16>((std::bit_cast<u32>(value) >> 16) & 0x8000);
+            const f32 absolute = Math::Min(std::abs(value), 65504.0f);
+            if (absolute < 6.103515625e-05f)
+            {
+                return sign | static_cast<u16>(absolute * 16777216.0f + 0.5f);
+            }
+            const u32 bits = std::bit_cast<u32>(absolute);
+            return sign | static_cast<u16>(Math::Min((bits - ((127u - 15u) << 23) + 0x1000u) >> 13, 0x7BFFu));
+        }
+
+        i8 ToSNorm(f32 value)
+        {
+            return static_cast<i8>(std::round(Math::Clamp(value, -1.0f, 1.0f) * 127.0f));
+        }
+
+        u8 ToUNorm(f32 value)
+        {
+            return static_cast<u8>(std::round(Math::Clamp(value, 0.0f, 1.0f) * 255.0f));
+        }
+
+        VertexInputAttribute fullInputs[] = {
+            {.location = 0, .binding = 0, .format = Format::RGB32F, .offset = offsetof(VertexStride, position)},
+            {.location = 1, .binding = 0, .format = Format::RGB32F, .offset = offsetof(VertexStride, normal)},
+            {.location = 2, .binding = 0, .format = Format::RGB32F, .offset = offsetof(VertexStride, color)},
+            {.location = 3, .binding = 0, .format = Format::RG32F, .offset = offsetof(VertexStride, uv)},
+            {.location = 4, .binding = 0, .format = Format::RGBA32F, .offset = offsetof(VertexStride, tangent)},
+        };
+
+        VertexInputAttribute quantizedInputs[] = {
+            {.location = 0, .binding = 0, .format = Format::RGB32F, .offset = offsetof(VertexStrideQuantized, position)},
+            {.location = 1, .binding = 0, .format = Format::RGBASNorm, .offset = offsetof(VertexStrideQuantized, normal)},
+            {.location = 2, .binding = 0, .format = Format::RGBA, .offset = offsetof(VertexStrideQuantized, color)},
+            {.location = 3, .binding = 0, .format = Format::RG16F, .offset = offsetof(VertexStrideQuantized, uv)},
+            {.location = 4, .binding = 0, .format = Format::RGBASNorm, .offset = offsetof(VertexStrideQuantized, tangent)},
+        };
+    }
+
+    u32 MeshOptimizer::GenerateVertexRemap(const Array<VertexStride>& vertices, const Array<u32>& indices, Array<u32>& remap)
+    {
+        remap.Clear();
+        remap.Resize(vertices.Size(), U32_MAX);
+
+        FlatHashMap<VertexStride, u32> uniqueVertices{};
+        uniqueVertices.Reserve(vertices.Size());
+
+        u32 vertexCount = 0;
+        for (u32 index : indices)
+        {
+            if (remap[index] == U32_MAX)
+            {
+                auto result = uniqueVertices.Insert(vertices[index], vertexCount);
+                if (result.second)
+                {
+                    vertexCount++;
+                }
+                remap[index] = result.first->second;
+            }
+        }
+        return vertexCount;
+    }
+
+    void MeshOptimizer::RemapVertices(Array<VertexStride>& vertices, const Array<u32>& remap, u32 vertexCount)
+    {
+        Array<VertexStride> result{};
+        result.Resize(vertexCount);
+        for (usize i = 0; i < vertices.Size(); ++i)
+        {
+            if (remap[i] != U32_MAX)
+            {
+                result[remap[i]] = vertices[i];
+            }
+        }
+        vertices.Swap(result);
+    }
+
+    void MeshOptimizer::RemapIndices(Span<u32> indices, const Array<u32>& remap)
+    {
+        for (u32& index : indices)
+        {
+            index = remap[index];
+        }
+    }
+
+    void MeshOptimizer::OptimizeVertexCache(Span<u32> indices)
+    {
+        const usize triangleCount = indices.Size() / 3;
+        if (triangleCount == 0)
+        {
+            return;
+        }
+
+        Array<u32> local{};
+        const u32  vertexCount = CompactIndices(indices, local);
+
+        //triangles of each vertex, the live ones are in [offsets[v], offsets[v] + valences[v])
+        Array<u32> valences(vertexCount, 0);
+        for (u32 vertex : local)
+        {
+            valences[vertex]++;
+        }
+
+        Array<u32> offsets(vertexCount + 1, 0);
+        for (u32 v = 0; v < vertexCount; ++v)
+        {
+            offsets[v + 1] = offsets[v] + valences[v];
+        }
+
+        Array<u32> adjacency(local.Size());
+        {
+            Array<u32> cursor(offsets);
+            for (usize i = 0; i < local.Size(); ++i)
+            {
+                adjacency[cursor[local[i]]++] = static_cast<u32>(i / 3);
+            }
+        }
+
+        Array<i32> cachePositions(vertexCount, -1);
+        Array<f32> vertexScores(vertexCount);
+        for (u32 v = 0; v < vertexCount; ++v)
+        {
+            vertexScores[v] = VertexScore(-1, valences[v]);
+        }
+
+        Array<f32> triangleScores(triangleCount);
+        Array<u8>  emitted(triangleCount, 0);
+        u32        bestTriangle = 0;
+        for (usize t = 0; t < triangleCount; ++t)
+        {
+            triangleScores[t] = vertexScores[local[t * 3]] + vertexScores[local[t * 3 + 1]] + vertexScores[local[t * 3 + 2]];
+            if (triangleScores[t] > triangleScores[bestTriangle])
+            {
+                bestTriangle = static_cast<u32>(t);
+            }
+        }
+
+        u32        cache[VertexCacheSize + 3];
+        u32        cacheCount = 0;
+        usize      nextTriangle = 0;
+        Array<u32> result(indices.Size());
+
+        for (usize output = 0; output < triangleCount; ++output)
+        {
+            if (bestTriangle == U32_MAX)
+            {
+                //no triangle touches the cache, continue with the next one in the original order
+                while (emitted[nextTriangle])
+                {
+                    nextTriangle++;
+                }
+                bestTriangle = static_cast<u32>(nextTriangle);
+            }
+
+            const u32* triangle = local.Data() + bestTriangle * 3;
+            emitted[bestTriangle] = 1;
+
+            u32 newCache[VertexCacheSize + 3];
+            u32 newCacheCount = 0;
+
+            for (u32 k = 0; k < 3; ++k)
+            {
+                const u32 vertex = triangle[k];
+                result[output * 3 + k] = indices[bestTriangle * 3 + k];
+
+                u32* first = adjacency.Data() + offsets[vertex];
+                u32* last = first + valences[vertex] - 1;
+                for (u32* it = first; it <= last; ++it)
+                {
+                    if (*it == bestTriangle)
+                    {
+                        *it = *last;
+                        break;
+                    }
+                }
+                valences[vertex]--;
+                newCache[newCacheCount++] = vertex;
+            }
+
+            for (u32 i = 0; i < cacheCount; ++i)
+            {
+                const u32 vertex = cache[i];
+                if (vertex != triangle[0] && vertex != triangle[1] && vertex != triangle[2])
+                {
+                    newCache[newCacheCount++] = vertex;
+                }
+            }
+
+            for (u32 i = 0; i < newCacheCount; ++i)
+            {
+                const u32 vertex = newCache[i];
+                cachePositions[vertex] = i < VertexCacheSize ? static_cast<i32>(i) : -1;
+                vertexScores[vertex] = VertexScore(cachePositions[vertex], valences[vertex]);
+            }
+
+            //only the triangles of the vertices that moved in the cache can change their score
+            bestTriangle = U32_MAX;
+            f32 bestScore = -1.0f;
+            for (u32 i = 0; i < newCacheCount; ++i)
+            {
+                const u32 vertex = newCache[i];
+                for (u32 a = offsets[vertex]; a < offsets[vertex] + valences[vertex]; ++a)
+                {
+                    const u32 t = adjacency[a];
+                    triangleScores[t] = vertexScores[local[t * 3]] + vertexScores[local[t * 3 + 1]] + vertexScores[local[t * 3 + 2]];
+                    if (i < VertexCacheSize && triangleScores[t] > bestScore)
+                    {
+                        bestScore = triangleScores[t];
+                        bestTriangle = t;
+                    }
+                }
+            }
+
+            cacheCount = Math::Min(newCacheCount, VertexCacheSize);
+            MemCopy(cache, newCache, cacheCount * sizeof(u32));
+        }
+
+        MemCopy(indices.begin(), result.Data(), result.Size() * sizeof(u32));
+    }
+
+    void MeshOptimizer::OptimizeOverdraw(Span<u32> indices, const Array<VertexStride>& vertices, f32 threshold)
+    {
+        const usize triangleCount = indices.Size() / 3;
+        if (triangleCount == 0)
+        {
+            return;
+        }
+
+        Array<u32> local{};
+        FIFOCache  cache(CompactIndices(indices, local), DefaultCacheSize);
+
+        //hard boundaries are the triangles where the cache starts over, reordering them doesn't add cache misses
+        Array<u32> hardBoundaries{};
+        for (usize t = 0; t < triangleCount; ++t)
+        {
+            if (cache.Triangle(local[t * 3], local[t * 3 + 1], local[t * 3 + 2]) == 3)
+            {
+                hardBoundaries.EmplaceBack(static_cast<u32>(t));
+            }
+        }
+        hardBoundaries.EmplaceBack(static_cast<u32>(triangleCount));
+
+        //soft boundaries split a hard cluster where the ACMR until that point is still within the threshold
+        Array<u32> clusters{};
+        for (usize h = 0; h + 1 < hardBoundaries.Size(); ++h)
+        {
+            const u32 start = hardBoundaries[h];
+            const u32 end = hardBoundaries[h + 1];
+
+            cache.Flush();
+            u32 clusterMisses = 0;
+            for (u32 t = start; t < end; ++t)
+            {
+                clusterMisses += cache.Triangle(local[t * 3], local[t * 3 + 1], local[t * 3 + 2]);
+            }
+
+            const f32 clusterThreshold = threshold * static_cast<f32>(clusterMisses) / static_cast<f32>(end - start);
+
+            cache.Flush();
+            clusters.EmplaceBack(start);
+
+            u32 runningMisses = 0;
+            u32 runningTriangles = 0;
+            for (u32 t = start; t < end; ++t)
+            {
+                runningMisses += cache.Triangle(local[t * 3], local[t * 3 + 1], local[t * 3 + 2]);
+                runningTriangles++;
+
+                if (t + 1 < end && static_cast<f32>(runningMisses) / static_cast<f32>(runningTriangles) <= clusterThreshold)
+                {
+                    clusters.EmplaceBack(t + 1);
+                    runningMisses = 0;
+                    runningTriangles = 0;
+                    cache.Flush();
+                }
+            }
+        }
+        clusters.EmplaceBack(static_cast<u32>(triangleCount));
+
+        //clusters facing away from the mesh center are drawn first, they are more likely to occlude the rest of the mesh
+        Vec3 meshCentroid{};
+        for (u32 index : indices)
+        {
+            meshCentroid = meshCentroid + vertices[index].position;
+        }
+        meshCentroid = meshCentroid / static_cast<f32>(indices.Size());
+
+        const usize clusterCount = clusters.Size() - 1;
+        Array<f32>  sortKeys(clusterCount);
+        Array<u32>  order(clusterCount);
+
+        for (usize c = 0; c < clusterCount; ++c)
+        {
+            Vec3 centroid{};
+            Vec3 normal{};
+            f32  area = 0.0f;
+
+            for (u32 t = clusters[c]; t < clusters[c + 1]; ++t)
+            {
+                const Vec3& p0 = vertices[indices[t * 3]].position;
+                const Vec3& p1 = vertices[indices[t * 3 + 1]].position;
+                const Vec3& p2 = vertices[indices[t * 3 + 2]].position;
+
+                const Vec3 cross = Math::Cross(p1 - p0, p2 - p0);
+                const f32  triangleArea = Math::Len(cross);
+
+                centroid = centroid + (p0 + p1 + p2) * (triangleArea / 3.0f);
+                normal = normal + cross;
+                area += triangleArea;
+            }
+
+            const f32 normalLength = Math::Len(normal);
+            sortKeys[c] = area > 0.0f && normalLength > 0.0f ? Math::Dot(centroid / area - meshCentroid, normal / normalLength) : 0.0f;
+            order[c] = static_cast<u32>(c);
+        }
+
+        std::stable_sort(order.begin(), order.end(), [&](u32 a, u32 b)
+        {
+            return sortKeys[a] > sortKeys[b];
+        });
+
+        Array<u32> result{};
+        result.Reserve(indices.Size());
+        for (u32 c : order)
+        {
+            for (u32 i = clusters[c] * 3; i < clusters[c + 1] * 3; ++i)
+            {
+                result.EmplaceBack(indices[i]);
+            }
+        }
+
+        MemCopy(indices.begin(), result.Data(), result.Size() * sizeof(u32));
+    }
+
+    f32 MeshOptimizer::Simplify(Span<u32> indices, const Array<VertexStride>& vertices, usize targetIndexCount, f32 targetError, Array<u32>& result)
+    {
+        result.Resize(indices.Size());
+        MemCopy(result.Data(), indices.Data(), indices.Size() * sizeof(u32));
+
+        if (indices.Size() <= targetIndexCount || indices.Empty())
+        {
+            return 0.0f;
+        }
+
+        Array<u32> local{};
+        Array<u32> unique{};
+        const u32  vertexCount = CompactIndices(indices, local, unique);
+
+        auto position = [&](u32 vertex) -> const Vec3&
+        {
+            return vertices[unique[vertex]].position;
+        };
+
+        //vertices sharing a position are attribute seams, they are locked to keep the seams closed
+        Array<u32> positionIds(vertexCount);
+        Array<u32> positionUses{};
+        {
+            FlatHashMap<Vec3, u32> positions{};
+            positions.Reserve(vertexCount);
+            for (u32 v = 0; v < vertexCount; ++v)
+            {
+                auto it = positions.Insert(position(v), static_cast<u32>(positionUses.Size()));
+                if (it.second)
+                {
+                    positionUses.EmplaceBack(0);
+                }
+                positionIds[v] = it.first->second;
+                positionUses[positionIds[v]]++;
+            }
+        }
+
+        //border edges are the ones without the opposite edge, they are found by position to not take seams as borders
+        FlatHashSet<u64> edges{};
+        edges.Reserve(local.Size());
+        for (usize t = 0; t < local.Size(); t += 3)
+        {
+            for (u32 k = 0; k < 3; ++k)
+            {
+                edges.Insert(EdgeKey(positionIds[local[t + k]], positionIds[local[t + (k + 1) % 3]]));
+            }
+        }
+
+        Array<u32>     borderNext(vertexCount, U32_MAX);
+        Array<u32>     borderPrev(vertexCount, U32_MAX);
+        Array<u8>      borderOut(vertexCount, 0);
+        Array<u8>      borderIn(vertexCount, 0);
+        Array<Quadric> quadrics(vertexCount);
+
+        Vec3 minPosition{F32_MAX, F32_MAX, F32_MAX};
+        Vec3 maxPosition{-F32_MAX, -F32_MAX, -F32_MAX};
+
+        for (usize t = 0; t < local.Size(); t += 3)
+        {
+            const Vec3 normal = TriangleNormal(position(local[t]), position(local[t + 1]), position(local[t + 2]));
+            const f32  length = Math::Len(normal);
+            if (length == 0.0f)
+            {
+                continue;
+            }
+            const Vec3 unitNormal = normal / length;
+
+            for (u32 k = 0; k < 3; ++k)
+            {
+                const u32   a = local[t + k];
+                const u32   b = local[t + (k + 1) % 3];
+                const Vec3& pa = position(a);
+
+                quadrics[a].AddPlane(unitNormal, -Math::Dot(unitNormal, pa), length * 0.5f);
+
+                minPosition = Vec3{Math::Min(minPosition.x, pa.x), Math::Min(minPosition.y, pa.y), Math::Min(minPosition.z, pa.z)};
+                maxPosition = Vec3{Math::Max(maxPosition.x, pa.x), Math::Max(maxPosition.y, pa.y), Math::Max(maxPosition.z, pa.z)};
+
+                if (!edges.Has(EdgeKey(positionIds[b], positionIds[a])))
+                {
+                    borderNext[a] = b;
+                    borderPrev[b] = a;
+                    borderOut[a] = Math::Min(borderOut[a] + 1, 255);
+                    borderIn[b] = Math::Min(borderIn[b] + 1, 255);
+
+                    //plane perpendicular to the triangle along the edge, keeps the border in place
+                    const Vec3 edge = position(b) - pa;
+                    const f32  edgeLength = Math::Len(edge);
+                    if (edgeLength > 0.0f)
+                    {
+                        const Vec3 borderNormal = Math::Normalize(Math::Cross(edge, unitNormal));
+                        const f32  distance = -Math::Dot(borderNormal, pa);
+                        quadrics[a].AddPlane(borderNormal, distance, edgeLength * edgeLength * BorderWeight);
+                        quadrics[b].AddPlane(borderNormal, distance, edgeLength * edgeLength * BorderWeight);
+                    }
+                }
+            }
+        }
+
+        Array<VertexKind> kinds(vertexCount);
+        for (u32 v = 0; v < vertexCount; ++v)
+        {
+            if (positionUses[positionIds[v]] > 1 || borderOut[v] > 1 || borderIn[v] != borderOut[v])
+            {
+                kinds[v] = VertexKind::Locked;
+            }
+            else
+            {
+                kinds[v] = borderOut[v] == 1 ? VertexKind::Border : VertexKind::Manifold;
+            }
+        }
+
+        //attribute differences are scaled by the mesh size to be comparable with the position error
+        const f32 attributeScale = Math::Len(maxPosition - minPosition) * AttributeWeight;
+        const f32 attributeScaleSq = attributeScale * attributeScale;
+        const f32 maxErrorSq = targetError * targetError;
+
+        auto collapseError = [&](u32 from, u32 to)
+        {
+            const VertexStride& a = vertices[unique[from]];
+            const VertexStride& b = vertices[unique[to]];
+            const Vec3          normal = a.normal - b.normal;
+            const Vec2          uv = a.uv - b.uv;
+            return quadrics[from].Error(b.position) + attributeScaleSq * (Math::Dot(normal, normal) + uv.x * uv.x + uv.y * uv.y);
+        };
+
+        f32             resultErrorSq = 0.0f;
+        usize           indexCount = local.Size();
+        Array<u32>      offsets(vertexCount + 1);
+        Array<u32>      adjacency{};
+        Array<Collapse> collapses{};
+        Array<u8>       touched(vertexCount);
+        Array<u32>      remap(vertexCount);
+
+        while (indexCount > targetIndexCount)
+        {
+            //vertex to triangles adjacency of the current triangles
+            MemSet(offsets.Data(), 0, offsets.Size() * sizeof(u32));
+            for (usize i = 0; i < indexCount; ++i)
+            {
+                offsets[local[i] + 1]++;
+            }
+            for (u32 v = 0; v < vertexCount; ++v)
+            {
+                offsets[v + 1] += offsets[v];
+            }
+
+            adjacency.Resize(indexCount);
+            {
+                Array<u32> cursor(offsets);
+                for (usize i = 0; i < indexCount; ++i)
+                {
+                    adjacency[cursor[local[i]]++] = static_cast<u32>(i / 3);
+                }
+            }
+
+            collapses.Clear();
+            for (usize t = 0; t < indexCount; t += 3)
+            {
+                for (u32 k = 0; k < 3; ++k)
+                {
+                    const u32 a = local[t + k];
+                    const u32 b = local[t + (k + 1) % 3];
+
+                    for (u32 direction = 0; direction < 2; ++direction)
+                    {
+                        const u32 from = direction == 0 ? a : b;
+                        const u32 to = direction == 0 ? b : a;
+
+                        const bool canCollapse = kinds[from] == VertexKind::Manifold ||
+                            (kinds[from] == VertexKind::Border && kinds[to] != VertexKind::Manifold && (borderNext[from] == to || borderPrev[from] == to));
+
+                        if (canCollapse && positionIds[from] != positionIds[to])
+                        {
+                            collapses.EmplaceBack(Collapse{from, to, collapseError(from, to)});
+                        }
+                    }
+                }
+            }
+
+            if (collapses.Empty())
+            {
+                break;
+            }
+
+            std::sort(collapses.begin(), collapses.end(), [](const Collapse& l, const Collapse& r)
+            {
+                return l.error < r.error;
+            });
+
+            for (u32 v = 0; v < vertexCount; ++v)
+            {
+                remap[v] = v;
+            }
+            MemSet(touched.Data(), 0, touched.Size());
+
+            //a collapse removes about two triangles, the pass stops a bit after the cheapest collapses needed to reach the target.
+            //going further would take expensive collapses only because the cheap ones were touched in this pass.
+            const usize collapseGoal = Math::Min((indexCount - targetIndexCount) / 6, collapses.Size() - 1);
+            const f32   passErrorLimit = collapses[collapseGoal].error * 1.5f;
+
+            usize remainingIndices = indexCount;
+            bool  collapsed = false;
+
+            for (const Collapse& collapse : collapses)
+            {
+                if (remainingIndices <= targetIndexCount || collapse.error > maxErrorSq || collapse.error > passErrorLimit)
+                {
+                    break;
+                }
+
+                if (touched[collapse.from] || touched[collapse.to])
+                {
+                    continue;
+                }
+
+                //reject collapses that flip or degenerate the triangles that are kept
+                bool  valid = true;
+                usize removedIndices = 0;
+                for (u32 a = offsets[collapse.from]; a < offsets[collapse.from + 1] && valid; ++a)
+                {
+                    const u32* triangle = local.Data() + adjacency[a] * 3;
+                    if (triangle[0] == collapse.to || triangle[1] == collapse.to || triangle[2] == collapse.to)
+                    {
+                        removedIndices += 3;
+                        continue;
+                    }
+
+                    const Vec3 before = TriangleNormal(position(triangle[0]), position(triangle[1]), position(triangle[2]));
+                    const Vec3 after = TriangleNormal(
+                        position(triangle[0] == collapse.from ? collapse.to : triangle[0]),
+                        position(triangle[1] == collapse.from ? collapse.to : triangle[1]),
+                        position(triangle[2] == collapse.from ? collapse.to : triangle[2]));
+
+                    valid = Math::Dot(before, after) > MaxFlipCos * Math::Len(before) * Math::Len(after);
+                }
+
+                if (!valid)
+                {
+                    continue;
+                }
+
+                //the one ring is locked for this pass, so the flip test above stays correct
+                for (u32 a = offsets[collapse.from]; a < offsets[collapse.from + 1]; ++a)
+                {
+                    const u32* triangle = local.Data() + adjacency[a] * 3;
+                    touched[triangle[0]] = 1;
+                    touched[triangle[1]] = 1;
+                    touched[triangle[2]] = 1;
+                }
+
+                if (kinds[collapse.from] == VertexKind::Border)
+                {
+                    //the border skips the removed vertex
+                    if (borderNext[collapse.from] == collapse.to)
+                    {
+                        borderNext[borderPrev[collapse.from]] = collapse.to;
+                        borderPrev[collapse.to] = borderPrev[collapse.from];
+                    }
+                    else
+                    {
+                        borderPrev[borderNext[collapse.from]] = collapse.to;
+                        borderNext[collapse.to] = borderNext[collapse.from];
+                    }
+                }
+
+                remap[collapse.from] = collapse.to;
+                quadrics[collapse.to].Add(quadrics[collapse.from]);
+                resultErrorSq = Math::Max(resultErrorSq, collapse.error);
+                remainingIndices -= removedIndices;
+                collapsed = true;
+            }
+
+            if (!collapsed)
+            {
+                break;
+            }
+
+            usize write = 0;
+            for (usize t = 0; t < indexCount; t += 3)
+            {
+                const u32 a = remap[local[t]];
+                const u32 b = remap[local[t + 1]];
+                const u32 c = remap[local[t + 2]];
+                if (a != b && b != c && a != c)
+                {
+                    local[write++] = a;
+                    local[write++] = b;
+                    local[write++] = c;
+                }
+            }
+            indexCount = write;
+        }
+
+        result.Resize(indexCount);
+        for (usize i = 0; i < indexCount; ++i)
+        {
+            result[i] = unique[local[i]];
+        }
+        return std::sqrt(resultErrorSq);
+    }
+
+    void MeshOptimizer::BuildMeshlets(Span<u32> indices, const Array<VertexStride>& vertices, Array<Meshlet>& meshlets, Array<MeshletBounds>& bounds)
+    {
+        const usize triangleCount = indices.Size() / 3;
+        if (triangleCount == 0)
+        {
+            return;
+        }
+
+        Array<u32> local{};
+        Array<u32> unique{};
+        const u32  vertexCount = CompactIndices(indices, local, unique);
+
+        Array<u32> offsets(vertexCount + 1);
+        for (u32 index : local)
+        {
+            offsets[index + 1]++;
+        }
+        for (u32 v = 0; v < vertexCount; ++v)
+        {
+            offsets[v + 1] += offsets[v];
+        }
+
+        Array<u32> adjacency(local.Size());
+        Array<u32> liveTriangles(vertexCount);
+        for (usize i = 0; i < local.Size(); ++i)
+        {
+            adjacency[offsets[local[i]] + liveTriangles[local[i]]++] = static_cast<u32>(i / 3);
+        }
+
+        Array<u8>  emitted(triangleCount);
+        Array<u8>  used(vertexCount);
+        Array<u32> meshletVertices{};
+        Array<u32> meshletIndices{};
+        Array<u32> result{};
+        usize      scan = 0;
+
+        result.Reserve(local.Size());
+
+        auto newVertices = [&](u32 triangle)
+        {
+            const u32* triangleIndices = local.Data() + triangle * 3;
+            return static_cast<u32>(!used[triangleIndices[0]]) + !used[triangleIndices[1]] + !used[triangleIndices[2]];
+        };
+
+        auto finish = [&]()
+        {
+            //bounds are computed from the original indices
+            const usize firstIndex = result.Size();
+            for (u32 index : meshletIndices)
+            {
+                result.EmplaceBack(unique[index]);
+            }
+
+            meshlets.EmplaceBack(Meshlet{
+                .firstIndex = static_cast<u32>(firstIndex),
+                .indexCount = static_cast<u32>(meshletIndices.Size()),
+                .vertexCount = static_cast<u32>(meshletVertices.Size())
+            });
+            bounds.EmplaceBack(ComputeMeshletBounds(result.Data() + firstIndex, meshletIndices.Size(), vertices));
+
+            for (u32 vertex : meshletVertices)
+            {
+                used[vertex] = 0;
+            }
+            meshletVertices.Clear();
+            meshletIndices.Clear();
+        };
+
+        for (usize emittedCount = 0; emittedCount < triangleCount;)
+        {
+            //prefers the triangles that add fewer vertices, then the ones with fewer triangles left around them
+            //to avoid leaving isolated triangles behind
+            u32 best = U32_MAX;
+            u32 bestNewVertices = 4;
+            u32 bestLiveTriangles = U32_MAX;
+
+            for (u32 vertex : meshletVertices)
+            {
+                for (u32 a = offsets[vertex]; a < offsets[vertex + 1]; ++a)
+                {
+                    const u32 triangle = adjacency[a];
+                    if (emitted[triangle])
+                    {
+                        continue;
+                    }
+
+                    const u32* triangleIndices = local.Data() + triangle * 3;
+                    const u32  triangleNewVertices = newVertices(triangle);
+                    const u32  triangleLive = liveTriangles[triangleIndices[0]] + liveTriangles[triangleIndices[1]] + liveTriangles[triangleIndices[2]];
+
+                    if (triangleNewVertices < bestNewVertices || (triangleNewVertices == bestNewVertices && triangleLive < bestLiveTriangles))
+                    {
+                        best = triangle;
+                        bestNewVertices = triangleNewVertices;
+                        bestLiveTriangles = triangleLive;
+                    }
+                }
+            }
+
+            //no connected triangle left, continues with the next one in the index buffer order
+            if (best == U32_MAX)
+            {
+                while (emitted[scan])
+                {
+                    scan++;
+                }
+                best = static_cast<u32>(scan);
+                bestNewVertices = newVertices(best);
+            }
+
+            if (meshletVertices.Size() + bestNewVertices > MaxMeshletVertices)
+            {
+                finish();
+                continue;
+            }
+
+            const u32* triangleIndices = local.Data() + best * 3;
+            for (u32 k = 0; k < 3; ++k)
+            {
+                const u32 vertex = triangleIndices[k];
+                if (!used[vertex])
+                {
+                    used[vertex] = 1;
+                    meshletVertices.EmplaceBack(vertex);
+                }
+                liveTriangles[vertex]--;
+                meshletIndices.EmplaceBack(vertex);
+            }
+            emitted[best] = 1;
+            emittedCount++;
+
+            if (meshletIndices.Size() == MaxMeshletTriangles * 3)
+            {
+                finish();
+            }
+        }
+
+        if (!meshletIndices.Empty())
+        {
+            finish();
+        }
+
+        std::copy(result.begin(), result.end(), indices.begin());
+    }
+
+    void MeshOptimizer::OptimizeVertexFetch(Array<VertexStride>& vertices, Span<u32> indices)
+    {
+        Array<u32> remap(vertices.Size(), U32_MAX);
+        u32        vertexCount = 0;
+
+        for (u32& index : indices)
+        {
+            if (remap[index] == U32_MAX)
+            {
+                remap[index] = vertexCount++;
+            }
+            index = remap[index];
+        }
+
+        RemapVertices(vertices, remap, vertexCount);
+    }
+
+    f32 MeshOptimizer::CalculateACMR(Span<u32> indices, usize vertexCount, u32 cacheSize)
+    {
+        const usize triangleCount = indices.Size() / 3;
+        if (triangleCount == 0)
+        {
+            return 0.0f;
+        }
+
+        FIFOCache cache(vertexCount, cacheSize);
+        usize     misses = 0;
+        for (usize t = 0; t < triangleCount; ++t)
+        {
+            misses += cache.Triangle(indices[t * 3], indices[t * 3 + 1], indices[t * 3 + 2]);
+        }
+        return static_cast<f32>(misses) / static_cast<f32>(triangleCount);
+    }
+
+    void MeshOptimizer::Quantize(const Array<VertexStride>& vertices, Array<VertexStrideQuantized>& quantized)
+    {
+        quantized.Resize(vertices.Size());
+        for (usize i = 0; i < vertices.Size(); ++i)
+        {
+            const VertexStride&    vertex = vertices[i];
+            VertexStrideQuantized& result = quantized[i];
+
+            result.position = vertex.position;
+            result.uv[0] = ToHalf(vertex.uv.x);
+            result.uv[1] = ToHalf(vertex.uv.y);
+
+            result.normal[0] = ToSNorm(vertex.normal.x);
+            result.normal[1] = ToSNorm(vertex.normal.y);
+            result.normal[2] = ToSNorm(vertex.normal.z);
+            result.normal[3] = 0;
+
+            result.tangent[0] = ToSNorm(vertex.tangent.x);
+            result.tangent[1] = ToSNorm(vertex.tangent.y);
+            result.tangent[2] = ToSNorm(vertex.tangent.z);
+            result.tangent[3] = vertex.tangent.w < 0.0f ? -127 : 127;
+
+            result.color[0] = ToUNorm(vertex.color.x);
+            result.color[1] = ToUNorm(vertex.color.y);
+            result.color[2] = ToUNorm(vertex.color.z);
+            result.color[3] = 255;
+        }
+    }
+
+    u32 MeshOptimizer::GetVertexSize(MeshVertexFormat vertexFormat)
+    {
+        return vertexFormat == MeshVertexFormat::Quantized ? sizeof(VertexStrideQuantized) : sizeof(VertexStride);
+    }
+
+    Span<VertexInputAttribute> MeshOptimizer::GetVertexInputs(MeshVertexFormat vertexFormat)
+    {
+        if (vertexFormat == MeshVertexFormat::Quantized)
+        {
+            return {quantizedInputs, std::size(quantizedInputs)};
+        }
+        return {fullInputs, std::size(fullInputs)};
+    }
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "GraphicsTypes.hpp"
+
+//import time mesh processing, the index buffer functions work on triangle lists.
+namespace Fyrion::MeshOptimizer
+{
+    constexpr u32 DefaultCacheSize = 16;
+    constexpr u32 MaxMeshletVertices = 64;
+    constexpr u32 MaxMeshletTriangles = 124;
+
+    //finds identical vertices, remap[i] is the new index of vertex i or U32_MAX if it's not referenced.
+    //new indices follow the first use in the index buffer. returns the unique vertex count.
+    FY_API u32 GenerateVertexRemap(const Array<VertexStride>& vertices, const Array<u32>& indices, Array<u32>& remap);
+    FY_API void RemapVertices(Array<VertexStride>& vertices, const Array<u32>& remap, u32 vertexCount);
+    FY_API void RemapIndices(Span<u32> indices, const Array<u32>& remap);
+
+    //reorders triangles to improve the post-transform vertex cache hit rate (Forsyth).
+    FY_API void OptimizeVertexCache(Span<u32> indices);
+
+    //splits the triangles in clusters without losing much cache efficiency and sorts them front to back from the outside,
+    //must run after OptimizeVertexCache. threshold is the ACMR increase allowed, 1.05 allows 5% worse.
+    FY_API void OptimizeOverdraw(Span<u32> indices, const Array<VertexStride>& vertices, f32 threshold);
+
+    //quadric error edge collapse, the result only uses vertices of the input. stops at targetIndexCount or
+    //when the next collapse would be above targetError, and returns the error of the result in object space.
+    //collapses are weighted by normal and uv differences, attribute seams and non-manifold vertices are kept.
+    FY_API f32 Simplify(Span<u32> indices, const Array<VertexStride>& vertices, usize targetIndexCount, f32 targetError, Array<u32>& result);
+
+    //groups connected triangles in meshlets of up to MaxMeshletVertices and MaxMeshletTriangles, the triangles are
+    //reordered so each meshlet is a range of indices. Meshlet::firstIndex is relative to the start of indices.
+    FY_API void BuildMeshlets(Span<u32> indices, const Array<VertexStride>& vertices, Array<Meshlet>& meshlets, Array<MeshletBounds>& bounds);
+
+    //reorders the vertices by first use so the vertex fetch reads memory in order.
+    FY_API void OptimizeVertexFetch(Array<VertexStride>& vertices, Span<u32> indices);
+
+    //average cache miss per triangle of a FIFO cache, 0.5 is the best possible and 3 the worst.
+    FY_API f32 CalculateACMR(Span<u32> indices, usize vertexCount, u32 cacheSize = DefaultCacheSize);
+
+    FY_API void Quantize(const Array<VertexStride>& vertices, Array<VertexStrideQuantized>& quantized);
+    FY_API u32  GetVertexSize(MeshVertexFormat vertexFormat);
+    FY_API Span<VertexInputAttribute> GetVertexInputs(MeshVertexFormat vertexFormat);
+}
@@ -0,0 +1,71 @@
+#include "MeshletCulling.hpp"
+
+#include <algorithm>
+
+namespace Fyrion
+{
+    namespace
+    {
+        constexpr f32 UniformScaleTolerance = 0.01f;
+    }
+
+    bool MeshletCulling::TestMeshlet(const MeshletBounds& bounds, const Mat4& transform, const Frustum& frustum, const Vec3& viewPos)
+    {
+        const Vec3 center = Math::MakeVec3(transform * Vec4{bounds.center.x, bounds.center.y, bounds.center.z, 1.0f});
+
+        f32 minScale = F32_MAX;
+        f32 maxScale = 0.0f;
+        for (u32 axis = 0; axis < 3; ++axis)
+        {
+            const f32 scale = static_cast<f32>(Math::Len(Math::MakeVec3(transform[axis])));
+            minScale = Math::Min(minScale, scale);
+            maxScale = Math::Max(maxScale, scale);
+        }
+        const f32 radius = bounds.radius * maxScale;
+
+        for (const Vec4& plane : frustum.planes)
+        {
+            if (plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w < -radius)
+            {
+                return false;
+            }
+        }
+
+        const bool uniformScale = maxScale - minScale <= maxScale * UniformScaleTolerance;
+        const bool mirrored = Math::Dot(Math::Cross(Math::MakeVec3(transform[0]), Math::MakeVec3(transform[1])), Math::MakeVec3(transform[2])) < 0.0f;
+        if (bounds.coneCutoff >= 1.0f || !uniformScale || mirrored)
+        {
+            return true;
+        }
+
+        const Vec3 axis = Math::MakeVec3(transform * Vec4{bounds.coneAxis.x, bounds.coneAxis.y, bounds.coneAxis.z, 0.0f}) / maxScale;
+        const Vec3 view = center - viewPos;
+        return Math::Dot(view, axis) < bounds.coneCutoff * static_cast<f32>(Math::Len(view)) + radius;
+    }
+
+    void MeshletCulling::BuildDrawCommands(const Input& input, Array<DrawIndexedIndirectCommand>& commands)
+    {
+        commands.Resize(input.commandCount);
+
+        for (u32 command = 0; command < input.commandCount; ++command)
+        {
+            const MeshletBatch& batch = *(std::upper_bound(input.batches.begin(), input.batches.end(), command, [](u32 value, const MeshletBatch& batch)
+            {
+                return value < batch.firstCommand;
+            }) - 1);
+
+            const u32 local = command - batch.firstCommand;
+            const u32 meshletIndex = batch.firstMeshlet + local % batch.meshletCount;
+            const u32 instance = input.batchInstances[batch.firstInstance + local / batch.meshletCount];
+
+            const Meshlet& meshlet = input.meshlets[meshletIndex];
+            commands[command] = DrawIndexedIndirectCommand{
+                .indexCount = meshlet.indexCount,
+                .instanceCount = TestMeshlet(input.bounds[meshletIndex], input.transforms[instance], input.frustum, input.viewPos) ? 1u : 0u,
+                .firstIndex = meshlet.firstIndex,
+                .vertexOffset = 0,
+                .firstInstance = instance
+            };
+        }
+    }
+}
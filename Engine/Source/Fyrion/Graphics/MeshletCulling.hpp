@@ -0,0 +1,26 @@
+#pragma once
+
+#include "GraphicsTypes.hpp"
+
+//CPU reference of the MeshletCulling compute shader, both must give the same results.
+namespace Fyrion::MeshletCulling
+{
+    struct Input
+    {
+        Span<Mat4>          transforms;     //indexed by the batch instances
+        Span<Meshlet>       meshlets;       //absolute first index in the mesh index buffer
+        Span<MeshletBounds> bounds;         //same index as meshlets
+        Span<MeshletBatch>  batches;        //sorted by firstCommand
+        Span<u32>           batchInstances;
+        Frustum             frustum;
+        Vec3                viewPos;
+        u32                 commandCount;
+    };
+
+    //tests the meshlet against the frustum and the backface cone in world space.
+    //the cone is skipped for transforms with non uniform scale or mirroring, the normals can't be moved with the matrix.
+    FY_API bool TestMeshlet(const MeshletBounds& bounds, const Mat4& transform, const Frustum& frustum, const Vec3& viewPos);
+
+    //writes one command per meshlet and instance, culled meshlets get instanceCount 0 and firstInstance is the transform index.
+    FY_API void BuildDrawCommands(const Input& input, Array<DrawIndexedIndirectCommand>& commands);
+}
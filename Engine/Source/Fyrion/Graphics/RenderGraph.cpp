@@ -2,7 +2,6 @@
 
 #include "Graphics.hpp"
 #include "Fyrion/Engine.hpp"
-#include "Fyrion/Core/Graph.hpp"
 #include "Fyrion/Core/Logger.hpp"
 #include "Fyrion/Core/Registry.hpp"
 
@@ -142,22 +141,9 @@ namespace Fyrion
                             .loadOp = output.loadOp
                         };
 
-                        switch (output.loadOp)
-                        {
-                            case LoadOp::Load:
-                            {
-                                attachmentCreation.initialLayout = it->second->creation.format != Format::Depth ? ResourceLayout::ColorAttachment : ResourceLayout::DepthStencilAttachment;
-                                attachmentCreation.finalLayout = it->second->creation.format != Format::Depth ? ResourceLayout::ColorAttachment : ResourceLayout::DepthStencilAttachment;
-                                break;
-                            }
-                            case LoadOp::DontCare:
-                            case LoadOp::Clear:
-                            {
-                                attachmentCreation.initialLayout = ResourceLayout::Undefined;
-                                attachmentCreation.finalLayout = it->second->creation.format != Format::Depth ? ResourceLayout::ColorAttachment : ResourceLayout::DepthStencilAttachment;
-                                break;
-                            }
-                        }
+                        //the compiled barriers move the attachment to its layout before the pass
+                        attachmentCreation.initialLayout = it->second->creation.format != Format::Depth ? ResourceLayout::ColorAttachment : ResourceLayout::DepthStencilAttachment;
+                        attachmentCreation.finalLayout = attachmentCreation.initialLayout;
 
                         attachments.EmplaceBack(attachmentCreation);
                         extent = it->second->textureCreation.extent;
@@ -216,66 +202,57 @@ namespace Fyrion
     {
         if (!asset) return;
 
-        Graph<String, SharedPtr<RenderGraphNode>> graph{};
-
         for (const String& pass : asset->GetPasses())
         {
             if (const auto it = passDatabase.Find(pass))
             {
-                graph.AddNode(pass, MakeShared<RenderGraphNode>(it->first, it->second));
+                passCreations.EmplaceBack(it->second);
                 continue;
             }
             logger.Error("pass {} not found", pass);
         }
 
-        for (const auto& edge: asset->GetEdges())
-        {
-            graph.AddEdge(edge.nodeInput, edge.nodeOutput);
-        }
+        Compile();
 
-        nodes = graph.Sort();
+        for (const RenderGraphCompiledResource& compiledResource : compiledGraph.resources)
+        {
+            SharedPtr<RenderGraphResource> resource = MakeShared<RenderGraphResource>(compiledResource.fullName, compiledResource.creation);
 
+            if (compiledResource.creation.type == RenderGraphResourceType::Buffer && compiledResource.creation.bufferInitialSize > 0)
+            {
+                resource->buffer = Graphics::CreateBuffer(BufferCreation{
+                    .usage = compiledResource.creation.bufferUsage,
+                    .size = compiledResource.creation.bufferInitialSize,
+                    .allocation = compiledResource.creation.bufferAllocation
+                });
+            }
 
-        for(auto& node: nodes)
-        {
-            logger.Debug("node {} created ", node->name);
+            resources.EmplaceBack(resource);
+            logger.Debug("Created resource {} ", compiledResource.fullName);
         }
 
-        for (SharedPtr<RenderGraphNode>& node : nodes)
+        CreateTextures();
+
+        for (const RenderGraphCompiledPass& compiledPass : compiledGraph.passes)
         {
-            for (auto& input : node->creation.inputs)
+            const RenderGraphPassCreation& creation = passCreations[compiledPass.pass];
+            SharedPtr<RenderGraphNode>&    node = nodes.EmplaceBack(MakeShared<RenderGraphNode>(creation.name, creation));
+
+            for (const RenderGraphResourceBinding& binding : compiledPass.inputs)
             {
-                for (const auto& edge: asset->GetEdges())
+                for (const RenderGraphResourceCreation& input : creation.inputs)
                 {
-                    if (edge.nodeInput == node->name && edge.input == input.name)
+                    if (input.name == binding.name)
                     {
-                        String outputName = edge.nodeOutput + "#" + edge.output;
-                        if (auto itResource = resources.Find(outputName))
-                        {
-                            String inputName = node->name + "#" + input.name;
-                            node->inputs.Insert(input.name, MakeShared<RenderGraphInput>(
-                                inputName,
-                                input,
-                                itResource->second));
-                        }
+                        node->inputs.Insert(input.name, MakeShared<RenderGraphInput>(node->name + "#" + input.name, input, resources[binding.resource]));
+                        break;
                     }
                 }
             }
 
-            for(const auto& output: node->creation.outputs)
+            for (const RenderGraphResourceBinding& binding : compiledPass.outputs)
             {
-                String resourceName = node->name + "#" + output.name;
-
-                //TODO what if the output has the same name but different configs?
-                if (auto it = node->inputs.Find(output.name))
-                {
-                    node->outputs.Insert(output.name, it->second->resource);
-                    resources.Insert(resourceName, it->second->resource);
-                    continue;
-                }
-
-                SharedPtr<RenderGraphResource> resource = CreateResource(resourceName, output);
-                node->outputs.Insert(output.name, resource);
+                node->outputs.Insert(binding.name, resources[binding.resource]);
             }
 
             node->CreateRenderPass();
@@ -304,14 +281,14 @@ namespace Fyrion
             logger.Debug("node {} created ", node->name);
         }
 
-        if (auto it = resources.Find(asset->GetColorOutput()))
+        if (compiledGraph.colorOutput != U32_MAX)
         {
-            colorOutput = it->second;
+            colorOutput = resources[compiledGraph.colorOutput];
         }
 
-        if (auto it = resources.Find(asset->GetDepthOutput()))
+        if (compiledGraph.depthOutput != U32_MAX)
         {
-            depthOutput = it->second;
+            depthOutput = resources[compiledGraph.depthOutput];
         }
 
         Event::Bind<OnRecordRenderCommands, &RenderGraph::RecordCommands>(this);
@@ -322,45 +299,128 @@ namespace Fyrion
         }
     }
 
-    Extent RenderGraph::GetViewportExtent() const
+    void RenderGraph::Compile()
     {
-        return viewportExtent;
+        Array<RenderGraphEdge> edges = asset->GetEdges();
+
+        compiledGraph = RenderGraphCompiler::Compile(RenderGraphCompileInfo{
+            .passes = {passCreations.Data(), passCreations.Size()},
+            .edges = {edges.Data(), edges.Size()},
+            .colorOutput = asset->GetColorOutput(),
+            .depthOutput = asset->GetDepthOutput(),
+            .viewportExtent = viewportExtent
+        });
+
+        logger.Debug("{} of {} passes used, transient memory {} KB, after aliasing {} KB",
+                     compiledGraph.passes.Size(),
+                     passCreations.Size(),
+                     compiledGraph.transientMemory / 1024,
+                     compiledGraph.aliasedMemory / 1024);
     }
 
-    void RenderGraph::Resize(Extent p_extent)
+    void RenderGraph::CreateTextures()
     {
-        Graphics::WaitQueue();
+        //owners allocate the memory of the alias slots, so they are created first
+        Array<u32> order{};
+        for (const RenderGraphAliasSlot& slot : compiledGraph.aliasSlots)
+        {
+            order.EmplaceBack(slot.owner);
+        }
 
-        viewportExtent = p_extent;
+        for (u32 r = 0; r < compiledGraph.resources.Size(); ++r)
+        {
+            u32 aliasSlot = compiledGraph.resources[r].aliasSlot;
+            if (aliasSlot == U32_MAX || compiledGraph.aliasSlots[aliasSlot].owner != r)
+            {
+                order.EmplaceBack(r);
+            }
+        }
 
-        for (auto& it : resources)
+        //defer destroy to avoid getting the same pointer address for the next texture
+        Array<Texture> oldTextures{};
+
+        for (u32 r : order)
         {
-            auto& resource = it.second;
+            const RenderGraphCompiledResource& compiledResource = compiledGraph.resources[r];
+            const RenderGraphResourceCreation& creation = compiledResource.creation;
+            RenderGraphResource&               resource = *resources[r];
 
-            if ((resource->creation.type == RenderGraphResourceType::Texture || resource->creation.type == RenderGraphResourceType::Attachment)
-                && resource->creation.scale > 0.f)
+            if (creation.type != RenderGraphResourceType::Texture && creation.type != RenderGraphResourceType::Attachment)
             {
-                Texture oldTexture = resource->texture;
+                continue;
+            }
 
-                Extent size = Extent{viewportExtent.width, viewportExtent.height} * resource->creation.scale;
-                resource->textureCreation.extent = {(size.width), (size.height), 1};
-                resource->textureCreation.name = resource->fullName;
-                resource->texture = Graphics::CreateTexture(resource->textureCreation);
+            //a texture that aliased another one stays bound to that memory, it's recreated even if it has no slot now
+            if (resource.texture && creation.scale.x <= 0.f && compiledResource.aliasSlot == U32_MAX && !resource.textureCreation.aliasTexture)
+            {
+                continue;
+            }
 
-                //defer destroy to avoid getting the same pointer address for the next texture
-                if (oldTexture)
+            FY_ASSERT(compiledResource.extent.width > 0 && compiledResource.extent.height > 0, "texture without size");
+
+            resource.textureCreation.extent = compiledResource.extent;
+            resource.textureCreation.format = creation.format;
+
+            if (resource.textureCreation.format != Format::Depth)
+            {
+                if (creation.type == RenderGraphResourceType::Attachment)
                 {
-                    Graphics::DestroyTexture(oldTexture);
+                    resource.textureCreation.usage = TextureUsage::RenderPass | TextureUsage::ShaderResource;
                 }
-
-                if (resource->creation.type == RenderGraphResourceType::Texture)
+                else if (creation.type == RenderGraphResourceType::Texture)
                 {
-                    Graphics::UpdateTextureLayout(resource->texture, ResourceLayout::Undefined, ResourceLayout::ShaderReadOnly);
-                    resource->currentLayout = ResourceLayout::ShaderReadOnly;
+                    resource.textureCreation.usage = TextureUsage::Storage | TextureUsage::ShaderResource;
                 }
             }
+            else
+            {
+                resource.textureCreation.usage = TextureUsage::DepthStencil | TextureUsage::ShaderResource;
+            }
+
+            resource.textureCreation.aliasTexture = {};
+            if (compiledResource.aliasSlot != U32_MAX && compiledGraph.aliasSlots[compiledResource.aliasSlot].owner != r)
+            {
+                resource.textureCreation.aliasTexture = resources[compiledGraph.aliasSlots[compiledResource.aliasSlot].owner]->texture;
+            }
+
+            if (resource.texture)
+            {
+                oldTextures.EmplaceBack(resource.texture);
+            }
+
+            resource.textureCreation.name = resource.fullName;
+            resource.texture = Graphics::CreateTexture(resource.textureCreation);
+            resource.currentLayout = ResourceLayout::Undefined;
+
+            //transient resources are discarded on their first use in the frame
+            if (!compiledResource.transient && compiledResource.initialLayout != ResourceLayout::Undefined)
+            {
+                Graphics::UpdateTextureLayout(resource.texture, ResourceLayout::Undefined, compiledResource.initialLayout, creation.format == Format::Depth);
+                resource.currentLayout = compiledResource.initialLayout;
+            }
         }
 
+        for (Texture texture : oldTextures)
+        {
+            Graphics::DestroyTexture(texture);
+        }
+    }
+
+    Extent RenderGraph::GetViewportExtent() const
+    {
+        return viewportExtent;
+    }
+
+    void RenderGraph::Resize(Extent p_extent)
+    {
+        Graphics::WaitQueue();
+
+        viewportExtent = p_extent;
+
+        //extents changed, the alias slots are assigned again
+        Compile();
+        CreateTextures();
+
         for (auto& node : nodes)
         {
             if (node->creation.type == RenderGraphPassType::Graphics)
@@ -407,123 +467,41 @@ namespace Fyrion
         return {};
     }
 
-    SharedPtr<RenderGraphResource> RenderGraph::CreateResource(const StringView& fullName, const RenderGraphResourceCreation& creation)
+    const CompiledRenderGraph& RenderGraph::GetCompiledGraph() const
     {
-        SharedPtr<RenderGraphResource> resource = MakeShared<RenderGraphResource>(fullName, creation);
-
-        switch (creation.type)
-        {
-            case RenderGraphResourceType::Buffer:
-            {
-                if (creation.bufferInitialSize > 0)
-                {
-                    resource->buffer = Graphics::CreateBuffer(BufferCreation{
-                        .usage = creation.bufferUsage,
-                        .size = creation.bufferInitialSize,
-                        .allocation = creation.bufferAllocation
-                    });
-                }
-                break;
-            }
-            case RenderGraphResourceType::Texture:
-            case RenderGraphResourceType::Attachment:
-            {
-                if (creation.size > 0)
-                {
-                    resource->textureCreation.extent = creation.size;
-                }
-                else if (creation.scale > 0.f)
-                {
-                    Extent size = Extent{viewportExtent.width, viewportExtent.height} * creation.scale;
-                    resource->textureCreation.extent = {size.width, size.height, 1};
-                }
-                else
-                {
-                    FY_ASSERT(false, "texture without size");
-                }
-
-                resource->textureCreation.format = creation.format;
-
-                if (resource->textureCreation.format != Format::Depth)
-                {
-                    if (creation.type == RenderGraphResourceType::Attachment)
-                    {
-                        resource->textureCreation.usage = TextureUsage::RenderPass | TextureUsage::ShaderResource;
-                    }
-                    else if (creation.type == RenderGraphResourceType::Texture)
-                    {
-                        resource->textureCreation.usage = TextureUsage::Storage | TextureUsage::ShaderResource;
-                    }
-                }
-                else
-                {
-                    resource->textureCreation.usage = TextureUsage::DepthStencil | TextureUsage::ShaderResource;
-                }
-
-                resource->textureCreation.name = fullName;
-                resource->texture = Graphics::CreateTexture(resource->textureCreation);
+        return compiledGraph;
+    }
 
-                if (creation.type == RenderGraphResourceType::Texture)
-                {
-                    Graphics::UpdateTextureLayout(resource->texture, ResourceLayout::Undefined, ResourceLayout::ShaderReadOnly);
-                    resource->currentLayout = ResourceLayout::ShaderReadOnly;
-                }
-                break;
-            }
-            case RenderGraphResourceType::Reference:
-            {
-                break;
-            }
-        }
+    void RenderGraph::RecordBarrier(RenderCommands& cmd, const RenderGraphBarrier& barrier)
+    {
+        RenderGraphResource* resource = resources[barrier.resource].Get();
 
-        resources.Insert(fullName, resource);
-        logger.Debug("Created resource {} ", fullName);
+        ResourceBarrierInfo resourceBarrierInfo{};
+        resourceBarrierInfo.texture = resource->texture;
+        resourceBarrierInfo.oldLayout = barrier.oldLayout;
+        resourceBarrierInfo.newLayout = barrier.newLayout;
+        resourceBarrierInfo.isDepth = barrier.isDepth;
+        cmd.ResourceBarrier(resourceBarrierInfo);
 
-        return resource;
+        resource->currentLayout = barrier.newLayout;
     }
 
     void RenderGraph::RecordCommands(RenderCommands& cmd, f64 deltaTime)
     {
-        for(auto& node: nodes)
+        for (usize i = 0; i < nodes.Size(); ++i)
         {
-            node->renderGraphPass->Update(deltaTime);
+            SharedPtr<RenderGraphNode>& node = nodes[i];
 
-            cmd.BeginLabel(node->name, {0, 0, 0, 1});
-            for(const auto& inputIt: node->inputs)
+            if (node->renderGraphPass)
             {
-                if (inputIt.second->inputCreation.type == RenderGraphResourceType::Texture)
-                {
-                    ResourceLayout newLayout = inputIt.second->inputCreation.format != Format::Depth ? ResourceLayout::ShaderReadOnly : ResourceLayout::DepthStencilReadOnly;
-                    if (inputIt.second->resource->currentLayout != newLayout)
-                    {
-                        ResourceBarrierInfo resourceBarrierInfo{};
-                        resourceBarrierInfo.texture = inputIt.second->resource->texture;
-                        resourceBarrierInfo.oldLayout = inputIt.second->resource->currentLayout;
-                        resourceBarrierInfo.newLayout = newLayout;
-                        resourceBarrierInfo.isDepth = inputIt.second->inputCreation.format == Format::Depth;
-                        cmd.ResourceBarrier(resourceBarrierInfo);
-
-                        inputIt.second->resource->currentLayout = newLayout;
-                    }
-                }
+                node->renderGraphPass->Update(deltaTime);
             }
 
-            for (const auto output : node->outputs)
+            cmd.BeginLabel(node->name, {0, 0, 0, 1});
+
+            for (const RenderGraphBarrier& barrier : compiledGraph.passes[i].barriers)
             {
-                if (output.second->creation.type == RenderGraphResourceType::Texture)
-                {
-                    if (output.second->currentLayout != ResourceLayout::General)
-                    {
-                        ResourceBarrierInfo resourceBarrierInfo{};
-                        resourceBarrierInfo.texture = output.second->texture;
-                        resourceBarrierInfo.oldLayout = output.second->currentLayout;
-                        resourceBarrierInfo.newLayout = ResourceLayout::General;
-                        resourceBarrierInfo.isDepth = false;
-                        cmd.ResourceBarrier(resourceBarrierInfo);
-
-                        output.second->currentLayout = ResourceLayout::General;
-                    }
-                }
+                RecordBarrier(cmd, barrier);
             }
 
             if (node->renderPass)
@@ -566,28 +544,14 @@ namespace Fyrion
             if (node->renderPass)
             {
                 cmd.EndRenderPass();
-
-                for (auto output : node->outputs)
-                {
-                    if (output.second->creation.type == RenderGraphResourceType::Attachment)
-                    {
-                        output.second->currentLayout = output.second->textureCreation.format != Format::Depth ? ResourceLayout::ColorAttachment : ResourceLayout::DepthStencilAttachment;
-                    }
-                }
             }
 
             cmd.EndLabel();
         }
 
-        if (colorOutput && colorOutput->currentLayout != ResourceLayout::ShaderReadOnly)
+        for (const RenderGraphBarrier& barrier : compiledGraph.finalBarriers)
         {
-            ResourceBarrierInfo resourceBarrierInfo{};
-            resourceBarrierInfo.texture = colorOutput->texture;
-            resourceBarrierInfo.oldLayout = colorOutput->currentLayout;
-            resourceBarrierInfo.newLayout = ResourceLayout::ShaderReadOnly;
-            cmd.ResourceBarrier(resourceBarrierInfo);
-
-            colorOutput->currentLayout = ResourceLayout::ShaderReadOnly;
+            RecordBarrier(cmd, barrier);
         }
     }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "GraphicsTypes.hpp"
+#include "RenderGraphCompiler.hpp"
 #include "Fyrion/Asset/Asset.hpp"
 #include "Fyrion/Core/HashMap.hpp"
 #include "Fyrion/Core/Optional.hpp"
@@ -123,18 +124,24 @@ namespace Fyrion
         static void RegisterPass(const RenderGraphPassCreation& renderGraphPassCreation);
         static void SetRegisterSwapchainRenderEvent(bool p_registerSwapchainRenderEvent);
 
-    private:
-        RenderGraphAsset*                 asset = nullptr;
-        Extent                            viewportExtent;
-        Array<SharedPtr<RenderGraphNode>> nodes;
-        RenderGraphResMap                 resources;
-        SharedPtr<RenderGraphResource>    colorOutput;
-        SharedPtr<RenderGraphResource>    depthOutput;
-        CameraData                        cameraData;
-
-        void                           Create();
-        SharedPtr<RenderGraphResource> CreateResource(const StringView& fullName, const RenderGraphResourceCreation& creation);
+        const CompiledRenderGraph& GetCompiledGraph() const;
 
+    private:
+        RenderGraphAsset*                     asset = nullptr;
+        Extent                                viewportExtent;
+        Array<RenderGraphPassCreation>        passCreations;
+        CompiledRenderGraph                   compiledGraph;
+        Array<SharedPtr<RenderGraphNode>>     nodes;
+        Array<SharedPtr<RenderGraphResource>> resources;
+        SharedPtr<RenderGraphResource>        colorOutput;
+        SharedPtr<RenderGraphResource>        depthOutput;
+        CameraData                            cameraData;
+
+        void Create();
+        void Compile();
+        void CreateTextures();
+
+        void RecordBarrier(RenderCommands& cmd, const RenderGraphBarrier& barrier);
         void RecordCommands(RenderCommands& cmd, f64 deltaTime);
         void BlitSwapchapin(RenderCommands& cmd);
     };
@@ -0,0 +1,466 @@
+#include "RenderGraphCompiler.hpp"
+
+#include "Fyrion/Core/Graph.hpp"
+
+namespace Fyrion
+{
+    namespace
+    {
+        struct ResourceUse
+        {
+            u32            resource;
+            ResourceLayout layout;
+            bool           discard; //previous content is not needed
+            bool           isDepth;
+        };
+
+        bool IsTexture(RenderGraphResourceType type)
+        {
+            return type == RenderGraphResourceType::Texture || type == RenderGraphResourceType::Attachment;
+        }
+
+        StringView GetPassName(StringView fullName)
+        {
+            usize pos = fullName.FindFirstOf("#");
+            return pos != nPos ? fullName.Substr(0, pos) : fullName;
+        }
+
+        String GetFullName(StringView pass, StringView resource)
+        {
+            return String{pass}.Append("#").Append(resource);
+        }
+
+        Extent3D GetExtent(const RenderGraphResourceCreation& creation, Extent viewportExtent)
+        {
+            if (creation.size.width > 0 && creation.size.height > 0)
+            {
+                return creation.size;
+            }
+
+            if (creation.scale.x > 0.f)
+            {
+                Extent size = viewportExtent * creation.scale;
+                return {size.width, size.height, 1};
+            }
+            return {};
+        }
+
+        u32 GetBytesPerPixel(Format format)
+        {
+            switch (format)
+            {
+                case Format::R: return 1;
+                case Format::R16F: return 2;
+                case Format::R32F: return 4;
+                case Format::RG: return 2;
+                case Format::RG16F: return 4;
+                case Format::RG32F: return 8;
+                case Format::RGB: return 4;
+                case Format::RGB16F: return 8;
+                case Format::RGB32F: return 12;
+                case Format::RGBA: return 4;
+                case Format::RGBA16F: return 8;
+                case Format::RGBA32F: return 16;
+                case Format::BGRA: return 4;
+                case Format::RGBASNorm: return 4;
+                case Format::Depth: return 4;
+                default:
+                    break;
+            }
+            return 4;
+        }
+
+        void AddUse(Array<ResourceUse>& uses, const ResourceUse& use)
+        {
+            for (ResourceUse& it : uses)
+            {
+                if (it.resource == use.resource)
+                {
+                    //read and written by the same pass, the write layout is used and the content is kept
+                    it.layout = use.layout;
+                    it.discard = it.discard && use.discard;
+                    return;
+                }
+            }
+            uses.EmplaceBack(use);
+        }
+
+        void SimulateLayouts(CompiledRenderGraph& graph, const Array<Array<ResourceUse>>& passUses, Array<ResourceLayout>& layouts, bool recordBarriers)
+        {
+            for (usize r = 0; r < graph.resources.Size(); ++r)
+            {
+                const RenderGraphCompiledResource& resource = graph.resources[r];
+                layouts[r] = resource.transient ? ResourceLayout::Undefined : resource.initialLayout;
+            }
+
+            for (usize p = 0; p < graph.passes.Size(); ++p)
+            {
+                for (const ResourceUse& use : passUses[p])
+                {
+                    ResourceLayout oldLayout = layouts[use.resource];
+
+                    //storage writes need a barrier even without a layout change
+                    if (oldLayout != use.layout || use.layout == ResourceLayout::General)
+                    {
+                        if (recordBarriers)
+                        {
+                            graph.passes[p].barriers.EmplaceBack(RenderGraphBarrier{
+                                .resource = use.resource,
+                                .oldLayout = use.discard ? ResourceLayout::Undefined : oldLayout,
+                                .newLayout = use.layout,
+                                .isDepth = use.isDepth
+                            });
+                        }
+                        layouts[use.resource] = use.layout;
+                    }
+                }
+            }
+
+            if (graph.colorOutput != U32_MAX && layouts[graph.colorOutput] != ResourceLayout::ShaderReadOnly)
+            {
+                if (recordBarriers)
+                {
+                    graph.finalBarriers.EmplaceBack(RenderGraphBarrier{
+                        .resource = graph.colorOutput,
+                        .oldLayout = layouts[graph.colorOutput],
+                        .newLayout = ResourceLayout::ShaderReadOnly,
+                        .isDepth = graph.resources[graph.colorOutput].creation.format == Format::Depth
+                    });
+                }
+                layouts[graph.colorOutput] = ResourceLayout::ShaderReadOnly;
+            }
+        }
+
+        void AssignAliasSlots(CompiledRenderGraph& graph)
+        {
+            Array<u32> transients{};
+            for (u32 r = 0; r < graph.resources.Size(); ++r)
+            {
+                if (graph.resources[r].transient)
+                {
+                    transients.EmplaceBack(r);
+                }
+            }
+
+            //resources are already in first use order, each one takes the tightest slot released before it
+            Array<u32> slotLastPass{};
+            for (u32 r : transients)
+            {
+                RenderGraphCompiledResource& resource = graph.resources[r];
+
+                u32 best = U32_MAX;
+                for (u32 s = 0; s < graph.aliasSlots.Size(); ++s)
+                {
+                    if (slotLastPass[s] >= resource.firstPass) continue;
+
+                    if (best == U32_MAX)
+                    {
+                        best = s;
+                        continue;
+                    }
+
+                    usize bestSize = graph.aliasSlots[best].memorySize;
+                    usize size = graph.aliasSlots[s].memorySize;
+                    bool  fits = size >= resource.memorySize;
+                    bool  bestFits = bestSize >= resource.memorySize;
+
+                    if ((fits && (!bestFits || size < bestSize)) || (!fits && !bestFits && size > bestSize))
+                    {
+                        best = s;
+                    }
+                }
+
+                if (best == U32_MAX)
+                {
+                    best = graph.aliasSlots.Size();
+                    graph.aliasSlots.EmplaceBack(RenderGraphAliasSlot{.owner = r, .memorySize = resource.memorySize});
+                    slotLastPass.EmplaceBack(resource.lastPass);
+                }
+                else
+                {
+                    RenderGraphAliasSlot& slot = graph.aliasSlots[best];
+                    if (resource.memorySize > slot.memorySize)
+                    {
+                        slot.owner = r;
+                        slot.memorySize = resource.memorySize;
+                    }
+                    slotLastPass[best] = resource.lastPass;
+                }
+                resource.aliasSlot = best;
+            }
+
+            for (const RenderGraphAliasSlot& slot : graph.aliasSlots)
+            {
+                graph.aliasedMemory += slot.memorySize;
+            }
+
+            //slots used by a single resource don't need aliasing
+            Array<u32> slotCount(graph.aliasSlots.Size(), 0u);
+            for (u32 r : transients)
+            {
+                slotCount[graph.resources[r].aliasSlot]++;
+            }
+
+            Array<RenderGraphAliasSlot> slots{};
+            Array<u32>                  remap(graph.aliasSlots.Size(), U32_MAX);
+            for (u32 s = 0; s < graph.aliasSlots.Size(); ++s)
+            {
+                if (slotCount[s] > 1)
+                {
+                    remap[s] = slots.Size();
+                    slots.EmplaceBack(graph.aliasSlots[s]);
+                }
+            }
+
+            for (u32 r : transients)
+            {
+                graph.resources[r].aliasSlot = remap[graph.resources[r].aliasSlot];
+            }
+            graph.aliasSlots = Traits::Move(slots);
+        }
+    }
+
+    u32 CompiledRenderGraph::FindResource(StringView fullName) const
+    {
+        if (auto it = resourceNames.Find(fullName))
+        {
+            return it->second;
+        }
+        return U32_MAX;
+    }
+
+    usize RenderGraphCompiler::EstimateTextureSize(const Extent3D& extent, Format format)
+    {
+        return static_cast<usize>(extent.width) * extent.height * Math::Max(extent.depth, 1u) * GetBytesPerPixel(format);
+    }
+
+    CompiledRenderGraph RenderGraphCompiler::Compile(const RenderGraphCompileInfo& info)
+    {
+        CompiledRenderGraph graph{};
+
+        HashMap<String, u32> passIndices{};
+        for (u32 i = 0; i < info.passes.Size(); ++i)
+        {
+            passIndices.Insert(info.passes[i].name, i);
+        }
+
+        //only passes that contribute to the outputs are kept, the graph runs as declared if there is no output
+        Array<bool> alive(info.passes.Size(), false);
+        Array<u32>  pending{};
+
+        for (StringView output : {info.colorOutput, info.depthOutput})
+        {
+            if (auto it = passIndices.Find(GetPassName(output)); it && !alive[it->second])
+            {
+                alive[it->second] = true;
+                pending.EmplaceBack(it->second);
+            }
+        }
+
+        if (pending.Empty())
+        {
+            for (usize i = 0; i < alive.Size(); ++i)
+            {
+                alive[i] = true;
+            }
+        }
+
+        while (!pending.Empty())
+        {
+            const String& passName = info.passes[pending.Back()].name;
+            pending.PopBack();
+
+            for (const RenderGraphEdge& edge : info.edges)
+            {
+                if (edge.nodeInput != passName) continue;
+
+                if (auto it = passIndices.Find(edge.nodeOutput); it && !alive[it->second])
+                {
+                    alive[it->second] = true;
+                    pending.EmplaceBack(it->second);
+                }
+            }
+        }
+
+        Graph<String, u32> sortGraph{};
+        for (u32 i = 0; i < info.passes.Size(); ++i)
+        {
+            if (alive[i])
+            {
+                sortGraph.AddNode(info.passes[i].name, i);
+            }
+        }
+
+        for (const RenderGraphEdge& edge : info.edges)
+        {
+            auto input = passIndices.Find(edge.nodeInput);
+            auto output = passIndices.Find(edge.nodeOutput);
+            if (input && output && alive[input->second] && alive[output->second])
+            {
+                sortGraph.AddEdge(edge.nodeInput, edge.nodeOutput);
+            }
+        }
+
+        Array<Array<ResourceUse>> passUses{};
+
+        for (u32 passIndex : sortGraph.Sort())
+        {
+            const RenderGraphPassCreation& creation = info.passes[passIndex];
+            u32                            position = graph.passes.Size();
+
+            RenderGraphCompiledPass& compiledPass = graph.passes.EmplaceBack();
+            compiledPass.pass = passIndex;
+            Array<ResourceUse>& uses = passUses.EmplaceBack();
+
+            for (const RenderGraphResourceCreation& input : creation.inputs)
+            {
+                for (const RenderGraphEdge& edge : info.edges)
+                {
+                    if (edge.nodeInput != creation.name || edge.input != input.name) continue;
+
+                    u32 resourceIndex = graph.FindResource(GetFullName(edge.nodeOutput, edge.output));
+                    if (resourceIndex == U32_MAX) continue;
+
+                    RenderGraphCompiledResource& resource = graph.resources[resourceIndex];
+                    resource.lastPass = position;
+                    compiledPass.inputs.EmplaceBack(RenderGraphResourceBinding{input.name, resourceIndex});
+
+                    if (IsTexture(input.type) && IsTexture(resource.creation.type))
+                    {
+                        bool isDepth = resource.creation.format == Format::Depth;
+                        AddUse(uses, ResourceUse{
+                            .resource = resourceIndex,
+                            .layout = isDepth ? ResourceLayout::DepthStencilReadOnly : ResourceLayout::ShaderReadOnly,
+                            .discard = false,
+                            .isDepth = isDepth
+                        });
+                    }
+                }
+            }
+
+            for (const RenderGraphResourceCreation& output : creation.outputs)
+            {
+                String fullName = GetFullName(creation.name, output.name);
+
+                u32 resourceIndex = U32_MAX;
+                for (const RenderGraphResourceBinding& input : compiledPass.inputs)
+                {
+                    if (input.name == output.name)
+                    {
+                        resourceIndex = input.resource;
+                        break;
+                    }
+                }
+
+                if (resourceIndex == U32_MAX)
+                {
+                    resourceIndex = graph.resources.Size();
+
+                    RenderGraphCompiledResource& resource = graph.resources.EmplaceBack();
+                    resource.fullName = fullName;
+                    resource.creation = output;
+                    resource.firstPass = position;
+                    resource.lastPass = position;
+
+                    if (IsTexture(output.type))
+                    {
+                        resource.extent = GetExtent(output, info.viewportExtent);
+                        resource.memorySize = EstimateTextureSize(resource.extent, output.format);
+                        resource.transient = !(output.type == RenderGraphResourceType::Attachment && output.loadOp == LoadOp::Load);
+                    }
+                }
+                else
+                {
+                    graph.resources[resourceIndex].lastPass = position;
+                }
+
+                graph.resourceNames.Insert(fullName, resourceIndex);
+                compiledPass.outputs.EmplaceBack(RenderGraphResourceBinding{output.name, resourceIndex});
+
+                const RenderGraphCompiledResource& resource = graph.resources[resourceIndex];
+                bool isDepth = resource.creation.format == Format::Depth;
+
+                if (output.type == RenderGraphResourceType::Attachment)
+                {
+                    AddUse(uses, ResourceUse{
+                        .resource = resourceIndex,
+                        .layout = isDepth ? ResourceLayout::DepthStencilAttachment : ResourceLayout::ColorAttachment,
+                        .discard = output.loadOp != LoadOp::Load,
+                        .isDepth = isDepth
+                    });
+                }
+                else if (output.type == RenderGraphResourceType::Texture)
+                {
+                    AddUse(uses, ResourceUse{
+                        .resource = resourceIndex,
+                        .layout = ResourceLayout::General,
+                        .discard = false,
+                        .isDepth = isDepth
+                    });
+                }
+            }
+        }
+
+        //outputs are read after the graph, they can't share memory
+        graph.colorOutput = graph.FindResource(info.colorOutput);
+        graph.depthOutput = graph.FindResource(info.depthOutput);
+
+        for (u32 output : {graph.colorOutput, graph.depthOutput})
+        {
+            if (output != U32_MAX)
+            {
+                graph.resources[output].transient = false;
+            }
+        }
+
+        for (const RenderGraphCompiledResource& resource : graph.resources)
+        {
+            if (resource.transient)
+            {
+                graph.aliasedMemory += resource.memorySize;
+            }
+        }
+        graph.transientMemory = graph.aliasedMemory;
+
+        //outputs of culled passes were allocated too
+        for (u32 i = 0; i < info.passes.Size(); ++i)
+        {
+            if (alive[i]) continue;
+
+            for (const RenderGraphResourceCreation& output : info.passes[i].outputs)
+            {
+                bool inPlace = false;
+                for (const RenderGraphResourceCreation& input : info.passes[i].inputs)
+                {
+                    inPlace = inPlace || input.name == output.name;
+                }
+
+                if (!inPlace && IsTexture(output.type) && !(output.type == RenderGraphResourceType::Attachment && output.loadOp == LoadOp::Load))
+                {
+                    graph.transientMemory += EstimateTextureSize(GetExtent(output, info.viewportExtent), output.format);
+                }
+            }
+        }
+
+        //persistent resources start the frame in the layout the previous frame left them
+        Array<ResourceLayout> layouts(graph.resources.Size(), ResourceLayout::Undefined);
+        SimulateLayouts(graph, passUses, layouts, false);
+
+        for (usize r = 0; r < graph.resources.Size(); ++r)
+        {
+            if (!graph.resources[r].transient && IsTexture(graph.resources[r].creation.type))
+            {
+                graph.resources[r].initialLayout = layouts[r];
+            }
+        }
+        SimulateLayouts(graph, passUses, layouts, true);
+
+        if (info.aliasing)
+        {
+            graph.aliasedMemory = 0;
+            AssignAliasSlots(graph);
+        }
+
+        return graph;
+    }
+}
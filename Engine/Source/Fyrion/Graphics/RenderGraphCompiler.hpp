@@ -0,0 +1,79 @@
+#pragma once
+
+#include "GraphicsTypes.hpp"
+#include "Fyrion/Core/HashMap.hpp"
+
+namespace Fyrion
+{
+    struct RenderGraphBarrier
+    {
+        u32            resource{};
+        ResourceLayout oldLayout{};
+        ResourceLayout newLayout{};
+        bool           isDepth{};
+    };
+
+    struct RenderGraphResourceBinding
+    {
+        String name{};
+        u32    resource{};
+    };
+
+    struct RenderGraphCompiledPass
+    {
+        u32                               pass{}; //index in RenderGraphCompileInfo::passes
+        Array<RenderGraphResourceBinding> inputs{};
+        Array<RenderGraphResourceBinding> outputs{};
+        Array<RenderGraphBarrier>         barriers{}; //recorded before the pass
+    };
+
+    struct RenderGraphCompiledResource
+    {
+        String                      fullName{};
+        RenderGraphResourceCreation creation{};
+        Extent3D                    extent{};
+        usize                       memorySize{};
+        u32                         firstPass{};
+        u32                         lastPass{};
+        bool                        transient{}; //content is not used between frames, the memory can be shared
+        u32                         aliasSlot{U32_MAX};
+        ResourceLayout              initialLayout{}; //expected layout at the beginning of the frame
+    };
+
+    struct RenderGraphAliasSlot
+    {
+        u32   owner{}; //the largest resource of the slot, it allocates the memory
+        usize memorySize{};
+    };
+
+    struct RenderGraphCompileInfo
+    {
+        Span<const RenderGraphPassCreation> passes{};
+        Span<const RenderGraphEdge>         edges{};
+        StringView                          colorOutput{};
+        StringView                          depthOutput{};
+        Extent                              viewportExtent{};
+        bool                                aliasing = true;
+    };
+
+    struct FY_API CompiledRenderGraph
+    {
+        Array<RenderGraphCompiledPass>     passes{};
+        Array<RenderGraphCompiledResource> resources{};
+        Array<RenderGraphAliasSlot>        aliasSlots{};
+        Array<RenderGraphBarrier>          finalBarriers{};
+        HashMap<String, u32>               resourceNames{};
+        u32                                colorOutput{U32_MAX};
+        u32                                depthOutput{U32_MAX};
+        usize                              transientMemory{}; //all transient textures of the declared passes allocated at the same time
+        usize                              aliasedMemory{};   //memory used by the passes that were not culled, after aliasing
+
+        u32 FindResource(StringView fullName) const;
+    };
+
+    namespace RenderGraphCompiler
+    {
+        FY_API CompiledRenderGraph Compile(const RenderGraphCompileInfo& info);
+        FY_API usize               EstimateTextureSize(const Extent3D& extent, Format format);
+    }
+}
@@ -5,6 +5,7 @@
 #include "Graphics.hpp"
 #include "GraphicsTypes.hpp"
 #include "Assets/MaterialAsset.hpp"
+#include "Assets/MeshAsset.hpp"
 #include "Fyrion/Engine.hpp"
 #include "Fyrion/Core/HashMap.hpp"
 
@@ -44,13 +45,80 @@ namespace Fyrion
 
     namespace
     {
-        HashMap<usize, usize> meshRenderDataIndices{};
-        Array<MeshRenderData> meshRenderDataArray{};
+        constexpr usize MeshMaterialCompactThreshold = 1024;
+
+        struct MeshRenderSlot
+        {
+            u32 index;      //packed index when alive, next free slot otherwise
+            u32 generation;
+        };
+
+        Array<MeshRenderSlot> meshRenderSlots{};
+        u32                   meshRenderFreeSlot = U32_MAX;
+
+        //packed arrays, removing swaps the last element in so iteration stays dense.
+        Array<u32>                 meshSlots{};
+        Array<Mat4>                meshTransforms{};
+        Array<AABB>                meshBounds{};
+        Array<MeshAsset*>          meshes{};
+        Array<MeshRenderMaterials> meshMaterialRanges{};
+
+        //materials of all renderables, each one owns a range that is reused while it fits.
+        Array<MaterialAsset*> meshMaterials{};
+        usize                 meshMaterialGarbage = 0;
 
         TextureAsset* skyboxAsset = nullptr;
 
         std::optional<DirectionalLight> directionalLight;
 
+        //packed by the address of the owner, removing swaps the last light in.
+        template <typename T>
+        struct PackedLights
+        {
+            HashMap<usize, u32> indices{};
+            Array<usize>        addresses{};
+            Array<T>            lights{};
+
+            void Add(usize address, const T& light)
+            {
+                if (auto it = indices.Find(address))
+                {
+                    lights[it->second] = light;
+                    return;
+                }
+
+                indices.Insert(address, static_cast<u32>(lights.Size()));
+                addresses.EmplaceBack(address);
+                lights.EmplaceBack(light);
+            }
+
+            void Remove(usize address)
+            {
+                auto it = indices.Find(address);
+                if (!it)
+                {
+                    return;
+                }
+
+                const u32 index = it->second;
+                const u32 last = static_cast<u32>(lights.Size() - 1);
+                indices.Erase(it);
+
+                if (index != last)
+                {
+                    lights[index] = lights[last];
+                    addresses[index] = addresses[last];
+                    indices.Find(addresses[index])->second = index;
+                }
+
+                lights.PopBack();
+                addresses.PopBack();
+            }
+        };
+
+        PackedLights<PointLight> pointLights;
+        PackedLights<SpotLight>  spotLights;
+
         Array<TextureAsset*>  pendingLoadingTextures;
         Array<MaterialAsset*> pendingLoadingMaterials;
 
@@ -87,6 +155,72 @@ namespace Fyrion
 
         void UploadMaterialData() {}
 
+        u32 FindMeshIndex(MeshRenderHandle handle)
+        {
+            if (handle.index < meshRenderSlots.Size() && meshRenderSlots[handle.index].generation == handle.generation)
+            {
+                return meshRenderSlots[handle.index].index;
+            }
+            return U32_MAX;
+        }
+
+        void CompactMeshMaterials()
+        {
+            if (meshMaterialGarbage < MeshMaterialCompactThreshold || meshMaterialGarbage < meshMaterials.Size() / 2)
+            {
+                return;
+            }
+
+            Array<MaterialAsset*> compacted{};
+            compacted.Reserve(meshMaterials.Size() - meshMaterialGarbage);
+
+            for (MeshRenderMaterials& range : meshMaterialRanges)
+            {
+                const u32 offset = static_cast<u32>(compacted.Size());
+                for (u32 i = 0; i < range.capacity; ++i)
+                {
+                    compacted.EmplaceBack(meshMaterials[range.offset + i]);
+                }
+                range.offset = offset;
+            }
+
+            meshMaterials.Swap(compacted);
+            meshMaterialGarbage = 0;
+        }
+
+        void SetMeshMaterials(u32 index, Span<MaterialAsset*> materials)
+        {
+            MeshRenderMaterials& range = meshMaterialRanges[index];
+            if (materials.Size() > range.capacity)
+            {
+                meshMaterialGarbage += range.capacity;
+                range.offset = static_cast<u32>(meshMaterials.Size());
+                range.capacity = static_cast<u32>(materials.Size());
+
+                for (usize i = 0; i < materials.Size(); ++i)
+                {
+                    meshMaterials.EmplaceBack(nullptr);
+                }
+            }
+
+            range.count = static_cast<u32>(materials.Size());
+            for (usize i = 0; i < materials.Size(); ++i)
+            {
+                meshMaterials[range.offset + i] = materials[i];
+            }
+
+            // for (MaterialAsset* material : materials)
+            // {
+            //     RequestMaterialLoad(material);
+            // }
+        }
+
+        void SetMeshTransform(u32 index, const Mat4& model)
+        {
+            meshTransforms[index] = model;
+            meshBounds[index] = meshes[index] ? Math::TransformAABB(meshes[index]->GetBoundingBox(), model) : AABB{};
+        }
+
         void RequestMaterialLoad(MaterialAsset* material)
         {
             if (material)
@@ -107,53 +241,115 @@ namespace Fyrion
         }
     }
 
-    void RenderStorage::AddOrUpdateMeshToRender(usize address, const Mat4& model, MeshAsset* mesh, Span<MaterialAsset*> materials)
+    MeshRenderHandle RenderStorage::AddMeshToRender(const Mat4& model, MeshAsset* mesh, Span<MaterialAsset*> materials)
     {
-        auto it = meshRenderDataIndices.Find(address);
-        if (it == meshRenderDataIndices.end())
+        u32 slot = meshRenderFreeSlot;
+        if (slot != U32_MAX)
+        {
+            meshRenderFreeSlot = meshRenderSlots[slot].index;
+        }
+        else
         {
-            it = meshRenderDataIndices.Emplace(address, meshRenderDataArray.Size()).first;
-            meshRenderDataArray.EmplaceBack();
+            slot = static_cast<u32>(meshRenderSlots.Size());
+            meshRenderSlots.EmplaceBack(MeshRenderSlot{});
         }
 
-        MeshRenderData& data = meshRenderDataArray[it->second];
-        data.address = address;
-        data.model = model;
-        data.mesh = mesh;
-        data.materials = materials;
+        const u32 index = static_cast<u32>(meshes.Size());
+        meshRenderSlots[slot].index = index;
 
-        // for (MaterialAsset* material : materials)
-        // {
-        //     RequestMaterialLoad(material);
-        // }
-    }
+        meshSlots.EmplaceBack(slot);
+        meshTransforms.EmplaceBack();
+        meshBounds.EmplaceBack();
+        meshes.EmplaceBack(mesh);
+        meshMaterialRanges.EmplaceBack(MeshRenderMaterials{});
 
-    Span<MeshRenderData> RenderStorage::GetMeshesToRender()
-    {
-        return meshRenderDataArray;
+        SetMeshTransform(index, model);
+        SetMeshMaterials(index, materials);
+
+        return MeshRenderHandle{.index = slot, .generation = meshRenderSlots[slot].generation};
     }
 
-    TextureAsset* RenderStorage::GetSkybox()
+    bool RenderStorage::UpdateMeshToRender(MeshRenderHandle handle, const Mat4& model, MeshAsset* mesh, Span<MaterialAsset*> materials)
     {
-        return skyboxAsset;
+        const u32 index = FindMeshIndex(handle);
+        if (index == U32_MAX)
+        {
+            return false;
+        }
+
+        meshes[index] = mesh;
+        SetMeshTransform(index, model);
+        SetMeshMaterials(index, materials);
+        CompactMeshMaterials();
+        return true;
     }
 
-    void RenderStorage::AddSkybox(TextureAsset* skybox)
+    bool RenderStorage::UpdateMeshTransform(MeshRenderHandle handle, const Mat4& model)
     {
-        skyboxAsset = skybox;
+        const u32 index = FindMeshIndex(handle);
+        if (index == U32_MAX)
+        {
+            return false;
+        }
+
+        SetMeshTransform(index, model);
+        return true;
     }
 
-    void RenderStorage::RemoveMeshFromRender(usize address)
+    void RenderStorage::RemoveMeshFromRender(MeshRenderHandle handle)
     {
-        if (auto it = meshRenderDataIndices.Find(address))
+        const u32 index = FindMeshIndex(handle);
+        if (index == U32_MAX)
         {
-            MeshRenderData& last = meshRenderDataArray.Back();
-            meshRenderDataIndices[last.address] = it->second;
-            meshRenderDataArray[it->second] = Traits::Move(last);
+            return;
+        }
+
+        meshMaterialGarbage += meshMaterialRanges[index].capacity;
 
-            meshRenderDataArray.PopBack();
-            meshRenderDataIndices.Erase(it);
+        const u32 last = static_cast<u32>(meshes.Size() - 1);
+        if (index != last)
+        {
+            meshSlots[index] = meshSlots[last];
+            meshTransforms[index] = meshTransforms[last];
+            meshBounds[index] = meshBounds[last];
+            meshes[index] = meshes[last];
+            meshMaterialRanges[index] = meshMaterialRanges[last];
+            meshRenderSlots[meshSlots[index]].index = index;
         }
+
+        meshSlots.PopBack();
+        meshTransforms.PopBack();
+        meshBounds.PopBack();
+        meshes.PopBack();
+        meshMaterialRanges.PopBack();
+
+        MeshRenderSlot& slot = meshRenderSlots[handle.index];
+        slot.generation++;
+        slot.index = meshRenderFreeSlot;
+        meshRenderFreeSlot = handle.index;
+
+        CompactMeshMaterials();
+    }
+
+    MeshRenderList RenderStorage::GetMeshesToRender()
+    {
+        return MeshRenderList{
+            .transforms = meshTransforms,
+            .bounds = meshBounds,
+            .meshes = meshes,
+            .materialRanges = meshMaterialRanges,
+            .materials = meshMaterials
+        };
+    }
+
+    TextureAsset* RenderStorage::GetSkybox()
+    {
+        return skyboxAsset;
+    }
+
+    void RenderStorage::AddSkybox(TextureAsset* skybox)
+    {
+        skyboxAsset = skybox;
     }
 
     void RenderStorage::AddDirectionalLight(usize address, const DirectionalLight& dirLight)
@@ -175,6 +371,36 @@ namespace Fyrion
         return nullptr;
     }
 
+    void RenderStorage::AddPointLight(usize address, const PointLight& pointLight)
+    {
+        pointLights.Add(address, pointLight);
+    }
+
+    void RenderStorage::RemovePointLight(usize address)
+    {
+        pointLights.Remove(address);
+    }
+
+    Span<PointLight> RenderStorage::GetPointLights()
+    {
+        return pointLights.lights;
+    }
+
+    void RenderStorage::AddSpotLight(usize address, const SpotLight& spotLight)
+    {
+        spotLights.Add(address, spotLight);
+    }
+
+    void RenderStorage::RemoveSpotLight(usize address)
+    {
+        spotLights.Remove(address);
+    }
+
+    Span<SpotLight> RenderStorage::GetSpotLights()
+    {
+        return spotLights.lights;
+    }
+
     BindingSet* RenderStorage::GetBindlessTextures()
     {
         return bindlessTextures;
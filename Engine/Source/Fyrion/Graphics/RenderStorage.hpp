@@ -9,14 +9,22 @@ namespace Fyrion
 
 namespace Fyrion::RenderStorage
 {
-    FY_API void                 AddOrUpdateMeshToRender(usize address, const Mat4& model, MeshAsset* mesh, Span<MaterialAsset*> materials);
-    FY_API void                 RemoveMeshFromRender(usize address);
-    FY_API Span<MeshRenderData> GetMeshesToRender();
+    FY_API MeshRenderHandle     AddMeshToRender(const Mat4& model, MeshAsset* mesh, Span<MaterialAsset*> materials);
+    FY_API bool                 UpdateMeshToRender(MeshRenderHandle handle, const Mat4& model, MeshAsset* mesh, Span<MaterialAsset*> materials);
+    FY_API bool                 UpdateMeshTransform(MeshRenderHandle handle, const Mat4& model);
+    FY_API void                 RemoveMeshFromRender(MeshRenderHandle handle);
+    FY_API MeshRenderList       GetMeshesToRender();
     FY_API void                 AddSkybox(TextureAsset* skybox);
     FY_API TextureAsset*        GetSkybox();
     FY_API void                 AddDirectionalLight(usize address, const DirectionalLight& directionalLight);
     FY_API void                 RemoveDirectionalLight(usize address);
     FY_API DirectionalLight*    GetDirectionalLight();
+    FY_API void                 AddPointLight(usize address, const PointLight& pointLight);
+    FY_API void                 RemovePointLight(usize address);
+    FY_API Span<PointLight>     GetPointLights();
+    FY_API void                 AddSpotLight(usize address, const SpotLight& spotLight);
+    FY_API void                 RemoveSpotLight(usize address);
+    FY_API Span<SpotLight>      GetSpotLights();
     FY_API BindingSet*          GetBindlessTextures();
     FY_API void                 Init();
     FY_API void                 UpdateResources();
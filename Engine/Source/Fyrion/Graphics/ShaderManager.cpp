@@ -8,7 +8,11 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
 #include <iostream>
+#include <mutex>
+#include <string_view>
+#include <thread>
 
 #include "spirv_reflect.h"
 #include "Assets/ShaderAsset.hpp"
@@ -17,8 +21,14 @@
 #include "Fyrion/Asset/AssetManager.hpp"
 #include "Fyrion/Asset/AssetTypes.hpp"
 #include "Fyrion/Asset/AssetHandler.hpp"
+#include "Fyrion/Asset/AssetSerialization.hpp"
+#include "Fyrion/Core/Hash.hpp"
 #include "Fyrion/Core/HashMap.hpp"
+#include "Fyrion/Core/HashSet.hpp"
+#include "Fyrion/Core/JobSystem.hpp"
+#include "Fyrion/Core/Registry.hpp"
 #include "Fyrion/IO/FileSystem.hpp"
+#include "Fyrion/IO/Path.hpp"
 
 #define SHADER_MODEL "6_7"
 
@@ -38,17 +48,99 @@ namespace Fyrion
     {
         Logger& logger = Logger::GetLogger("Fyrion::ShaderManager", LogLevel::Debug);
 
-        IDxcUtils*            utils{};
-        IDxcCompiler3*        compiler{};
-        DxcCreateInstanceProc dxcCreateInstance;
+        struct DxcInstance
+        {
+            IDxcUtils*     utils{};
+            IDxcCompiler3* compiler{};
+            u64            generation{};
+        };
+
+        //DXC compilers aren't thread-safe, each thread that compiles shaders gets its own instances
+        DxcCreateInstanceProc     dxcCreateInstance;
+        std::mutex                dxcInstancesMutex{};
+        Array<DxcInstance>        dxcInstances{};
+        std::atomic<u64>          dxcGeneration{1};
+        thread_local DxcInstance  threadDxcInstance{};
+
+        //include assets and their dependencies are shared by the compilations running in parallel
+        std::mutex                includeMutex{};
+
+        //bump when the layout of the cache files or the compilation changes
+        constexpr u32 ShaderCacheMagic = 0x43485346;
+        constexpr u32 ShaderCacheVersion = 1;
+
+        //hash of the loaded dxcompiler version, shaders built by another compiler are not reused
+        u64 dxcVersion = 0;
+
+        struct ShaderCacheHeader
+        {
+            u32 magic;
+            u32 version;
+            u64 key;
+            u64 bytesSize;
+        };
+
+        String           cacheDirectory{};
+        bool             cacheDirectorySet = false;
+        std::atomic<u64> cacheHits{};
+        std::atomic<u64> cacheMisses{};
+    }
+
+    String NormalizeIncludePath(std::string fileName)
+    {
+        if (const auto c = fileName.find("./"); c != std::string::npos)
+        {
+            fileName.replace(c, sizeof("./") - 1, "");
+        }
+
+        if (const auto c = fileName.find(".\\"); c != std::string::npos)
+        {
+            fileName.replace(c, sizeof(".\\") - 1, "");
+        }
+
+        auto c = fileName.find('\\');
+        while (c != std::string::npos)
+        {
+            fileName.replace(c, sizeof("\\") - 1, "/");
+            c = fileName.find('\\');
+        }
+
+        if (c = fileName.find(":/"); c != std::string::npos)
+        {
+            fileName.replace(c, sizeof(":/") - 1, "://");
+        }
+
+        return {fileName.c_str(), fileName.size()};
+    }
+
+    ShaderAsset* LoadShaderInclude(ShaderAsset* shader, String includePath)
+    {
+        //check if that's a path
+        if (StringView(includePath).FindFirstOf("://") == nPos)
+        {
+            if (shader && shader->GetHandler()->GetParent() != nullptr)
+            {
+                includePath = String(shader->GetHandler()->GetParent()->GetPath()).Append("/").Append(includePath);
+            }
+        }
+
+        std::lock_guard lock(includeMutex);
+
+        ShaderAsset* shaderInclude = AssetManager::LoadByPath<ShaderAsset>(includePath);
+        if (shaderInclude && shader)
+        {
+            shaderInclude->AddShaderDependency(shader);
+        }
+        return shaderInclude;
     }
 
     struct IncludeHandler : IDxcIncludeHandler
     {
-        ShaderAsset*  shader{};
+        ShaderAsset*      shader{};
+        IDxcUtils*        utils{};
         IDxcBlobEncoding* blobEncoding{};
 
-        IncludeHandler(ShaderAsset*  asset) : shader(asset) {}
+        IncludeHandler(ShaderAsset* asset, IDxcUtils* utils) : shader(asset), utils(utils) {}
 
         static String FormatFilePath(LPCWSTR pFilename)
         {
@@ -58,46 +150,13 @@ namespace Fyrion
             {
                 return (char)c;
             });
-
-            if (const auto c = fileName.find("./"); c != std::string::npos)
-            {
-                fileName.replace(c, sizeof("./") - 1, "");
-            }
-
-            if (const auto c = fileName.find(".\\"); c != std::string::npos)
-            {
-                fileName.replace(c, sizeof(".\\") - 1, "");
-            }
-
-            auto c = fileName.find('\\');
-            while (c != std::string::npos)
-            {
-                fileName.replace(c, sizeof("\\") - 1, "/");
-                c = fileName.find('\\');
-            }
-
-            if (c = fileName.find(":/"); c != std::string::npos)
-            {
-                fileName.replace(c, sizeof(":/") - 1, "://");
-            }
-
-            return {fileName.c_str(), fileName.size()};
+            return NormalizeIncludePath(Traits::Move(fileName));
         }
 
 
         HRESULT STDMETHODCALLTYPE LoadSource(LPCWSTR pFilename, IDxcBlob** ppIncludeSource) override
         {
-            String includePath = FormatFilePath(pFilename);
-            //check if that's a path
-            if (StringView(includePath).FindFirstOf("://") == nPos)
-            {
-                if (shader && shader->GetHandler()->GetParent() != nullptr)
-                {
-                    includePath = String(shader->GetHandler()->GetParent()->GetPath()).Append("/").Append(includePath);
-                }
-            }
-
-            ShaderAsset* shaderInclude = AssetManager::LoadByPath<ShaderAsset>(includePath);
+            ShaderAsset* shaderInclude = LoadShaderInclude(shader, FormatFilePath(pFilename));
             if (!shaderInclude)
             {
                 return S_FALSE;
@@ -107,8 +166,6 @@ namespace Fyrion
             utils->CreateBlob(source.CStr(), source.Size(), CP_UTF8, &blobEncoding);
             *ppIncludeSource = blobEncoding;
 
-            shaderInclude->AddShaderDependency(shader);
-
             return S_OK;
         }
 
@@ -155,6 +212,97 @@ namespace Fyrion
         return L"";
     }
 
+    void AddCompilerArgs(Array<LPCWSTR>& args, LPCWSTR entryPoint, ShaderStage shaderStage, RenderApiType renderApi)
+    {
+        args.EmplaceBack(L"-E");
+        args.EmplaceBack(entryPoint);
+        args.EmplaceBack(L"-Wno-ignored-attributes");
+
+        args.EmplaceBack(L"-T");
+        args.EmplaceBack(GetShaderStage(shaderStage));
+
+        if (renderApi != RenderApiType::D3D12)
+        {
+            args.EmplaceBack(L"-spirv");
+            args.EmplaceBack(L"-fspv-target-env=vulkan1.2");
+            args.EmplaceBack(L"-fvk-use-dx-layout");
+            args.EmplaceBack(L"-fvk-use-dx-position-w");
+        }
+    }
+
+    //hashes the source and, recursively, the includes it references, the same ones the IncludeHandler loads
+    void HashShaderSource(ShaderAsset* shader, StringView source, HashSet<String>& visited, u64& hash)
+    {
+        hash = MurmurHash64(source.Data(), static_cast<int>(source.Size()), hash);
+
+        std::string_view str = {source.Data(), source.Size()};
+        usize            pos = str.find("#include");
+        while (pos != std::string_view::npos)
+        {
+            pos += sizeof("#include") - 1;
+            while (pos < str.size() && (str[pos] == ' ' || str[pos] == '\t'))
+            {
+                pos++;
+            }
+
+            if (pos < str.size() && (str[pos] == '"' || str[pos] == '<'))
+            {
+                const char close = str[pos] == '"' ? '"' : '>';
+                const usize end = str.find(close, pos + 1);
+                if (end != std::string_view::npos)
+                {
+                    String includePath = NormalizeIncludePath(std::string{str.substr(pos + 1, end - pos - 1)});
+                    if (visited.Find(includePath) == visited.end())
+                    {
+                        visited.Insert(includePath);
+                        hash = MurmurHash64(includePath.CStr(), static_cast<int>(includePath.Size()), hash);
+                        if (ShaderAsset* shaderInclude = LoadShaderInclude(shader, includePath))
+                        {
+                            String includeSource = FileSystem::ReadFileAsString(shaderInclude->GetHandler()->GetAbsolutePath());
+                            HashShaderSource(shaderInclude, includeSource, visited, hash);
+                        }
+                    }
+                }
+            }
+            pos = str.find("#include", pos);
+        }
+    }
+
+    DxcInstance* GetDxcInstance()
+    {
+        if (dxcCreateInstance == nullptr)
+        {
+            return nullptr;
+        }
+
+        if (threadDxcInstance.generation != dxcGeneration.load())
+        {
+            threadDxcInstance = DxcInstance{.generation = dxcGeneration.load()};
+            dxcCreateInstance(CLSID_DxcUtils, IID_PPV_ARGS(&threadDxcInstance.utils));
+            dxcCreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&threadDxcInstance.compiler));
+
+            std::lock_guard lock(dxcInstancesMutex);
+            dxcInstances.EmplaceBack(threadDxcInstance);
+        }
+
+        if (!threadDxcInstance.utils || !threadDxcInstance.compiler)
+        {
+            return nullptr;
+        }
+        return &threadDxcInstance;
+    }
+
+    String GetCacheFilePath(u64 key)
+    {
+        char name[17]{};
+        for (i32 i = 15; i >= 0; --i)
+        {
+            name[i] = "0123456789abcdef"[key & 0xF];
+            key >>= 4;
+        }
+        return Path::Join(cacheDirectory, StringView{name, 16});
+    }
+
 
     void ShaderManagerInit()
     {
@@ -162,22 +310,187 @@ namespace Fyrion
         if (instance)
         {
             dxcCreateInstance = reinterpret_cast<DxcCreateInstanceProc>(Platform::GetFunctionAddress(instance, "DxcCreateInstance"));
-            dxcCreateInstance(CLSID_DxcUtils, IID_PPV_ARGS(&utils));
-            dxcCreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&compiler));
         }
+
+        IDxcCompiler3* compiler{};
+        if (dxcCreateInstance && SUCCEEDED(dxcCreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&compiler))))
+        {
+            IDxcVersionInfo* versionInfo{};
+            if (SUCCEEDED(compiler->QueryInterface(IID_PPV_ARGS(&versionInfo))))
+            {
+                UINT32 version[2]{};
+                versionInfo->GetVersion(&version[0], &version[1]);
+                dxcVersion = MurmurHash64(version, sizeof(version), 0);
+                versionInfo->Release();
+            }
+
+            IDxcVersionInfo2* versionInfo2{};
+            if (SUCCEEDED(compiler->QueryInterface(IID_PPV_ARGS(&versionInfo2))))
+            {
+                UINT32 commitCount{};
+                char*  commitHash{};
+                if (SUCCEEDED(versionInfo2->GetCommitInfo(&commitCount, &commitHash)))
+                {
+                    dxcVersion = MurmurHash64(&commitCount, sizeof(commitCount), dxcVersion);
+                    if (commitHash)
+                    {
+                        std::string_view commit{commitHash};
+                        dxcVersion = MurmurHash64(commit.data(), static_cast<int>(commit.size()), dxcVersion);
+                        CoTaskMemFree(commitHash);
+                    }
+                }
+                versionInfo2->Release();
+            }
+            compiler->Release();
+        }
+
+        if (!cacheDirectorySet)
+        {
+            cacheDirectory = Path::Join(FileSystem::AppFolder(), "Fyrion", "ShaderCache");
+        }
+    }
+
+    void ShaderManager::SetCacheDirectory(StringView directory)
+    {
+        cacheDirectory = directory;
+        cacheDirectorySet = true;
+    }
+
+    u64 ShaderManager::GetCacheKey(ShaderAsset* shaderAsset, StringView source, Span<ShaderStageInfo> stages, RenderApiType renderApi)
+    {
+        u64 hash = MurmurHash64(&ShaderCacheVersion, sizeof(ShaderCacheVersion), 0);
+        hash = MurmurHash64(&dxcVersion, sizeof(dxcVersion), hash);
+
+        HashSet<String> visited{};
+        HashShaderSource(shaderAsset, source, visited, hash);
+
+        for (const ShaderStageInfo& stage : stages)
+        {
+            std::wstring entryPoint = std::wstring{stage.entryPoint.begin(), stage.entryPoint.end()};
+
+            Array<LPCWSTR> args;
+            AddCompilerArgs(args, entryPoint.c_str(), stage.stage, renderApi);
+            for (LPCWSTR arg : args)
+            {
+                hash = MurmurHash64(arg, static_cast<int>(wcslen(arg) * sizeof(wchar_t)), hash);
+            }
+        }
+        return hash;
+    }
+
+    bool ShaderManager::LoadFromCache(u64 key, Array<u8>& bytes, Array<ShaderStageInfo>& stages, ShaderInfo& shaderInfo)
+    {
+        if (cacheDirectory.Empty())
+        {
+            return false;
+        }
+
+        Array<u8> data = FileSystem::ReadFileAsByteArray(GetCacheFilePath(key));
+
+        ShaderCacheHeader header{};
+        if (data.Size() >= sizeof(ShaderCacheHeader))
+        {
+            MemCopy(&header, data.Data(), sizeof(ShaderCacheHeader));
+        }
+
+        if (header.magic != ShaderCacheMagic || header.version != ShaderCacheVersion || header.key != key || header.bytesSize > data.Size() - sizeof(ShaderCacheHeader))
+        {
+            cacheMisses++;
+            return false;
+        }
+
+        const u8*         info = data.Data() + sizeof(ShaderCacheHeader) + header.bytesSize;
+        BinaryAssetReader reader(Span<const u8>{info, info + (data.Size() - sizeof(ShaderCacheHeader) - header.bytesSize)});
+        ArchiveObject     root = reader.ReadObject();
+        if (!reader.IsValid() || !root)
+        {
+            cacheMisses++;
+            return false;
+        }
+
+        bytes.Resize(header.bytesSize);
+        MemCopy(bytes.Data(), data.Data() + sizeof(ShaderCacheHeader), header.bytesSize);
+
+        TypeHandler*  stageType = Registry::FindType<ShaderStageInfo>();
+        ArchiveObject stagesArr = reader.ReadObject(root, "stages");
+        stages.Clear();
+        stages.Reserve(reader.ArrSize(stagesArr));
+        for (ArchiveObject item = reader.Next(stagesArr, {}); item; item = reader.Next(stagesArr, item))
+        {
+            Serialization::Deserialize(stageType, reader, item, &stages.EmplaceBack());
+        }
+
+        shaderInfo = {};
+        Serialization::Deserialize(Registry::FindType<ShaderInfo>(), reader, reader.ReadObject(root, "shaderInfo"), &shaderInfo);
+
+        cacheHits++;
+        return true;
+    }
+
+    void ShaderManager::SaveToCache(u64 key, Span<u8> bytes, Span<ShaderStageInfo> stages, const ShaderInfo& shaderInfo)
+    {
+        if (cacheDirectory.Empty() || !FileSystem::CreateDirectory(cacheDirectory))
+        {
+            return;
+        }
+
+        BinaryAssetWriter writer;
+        ArchiveObject     root = writer.CreateObject();
+
+        TypeHandler*  stageType = Registry::FindType<ShaderStageInfo>();
+        ArchiveObject stagesArr = writer.CreateArray();
+        for (const ShaderStageInfo& stage : stages)
+        {
+            writer.AddValue(stagesArr, Serialization::Serialize(stageType, writer, &stage));
+        }
+        writer.WriteValue(root, "stages", stagesArr);
+        writer.WriteValue(root, "shaderInfo", Serialization::Serialize(Registry::FindType<ShaderInfo>(), writer, &shaderInfo));
+
+        Array<u8> info = writer.Encode(root);
+
+        ShaderCacheHeader header{
+            .magic = ShaderCacheMagic,
+            .version = ShaderCacheVersion,
+            .key = key,
+            .bytesSize = bytes.Size()
+        };
+
+        //written to a temp file first, a crash never leaves a truncated entry behind
+        String      path = GetCacheFilePath(key);
+        String      tempPath = String(path).Append(".").Append(static_cast<u64>(std::hash<std::thread::id>{}(std::this_thread::get_id()))).Append(".tmp");
+        FileHandler file = FileSystem::OpenFile(tempPath, AccessMode::WriteOnly);
+        if (!file)
+        {
+            return;
+        }
+        FileSystem::WriteFile(file, &header, sizeof(ShaderCacheHeader));
+        FileSystem::WriteFile(file, bytes.Data(), bytes.Size());
+        FileSystem::WriteFile(file, info.Data(), info.Size());
+        FileSystem::CloseFile(file);
+
+        FileSystem::Remove(path);
+        FileSystem::Rename(tempPath, path);
+    }
+
+    ShaderManager::ShaderCacheStats ShaderManager::GetCacheStats()
+    {
+        return ShaderCacheStats{
+            .hits = cacheHits.load(),
+            .misses = cacheMisses.load()
+        };
     }
 
     bool ShaderManager::CompileShader(const ShaderCreation& shaderCreation, Array<u8>& bytes)
     {
-        bool shaderCompilerValid = utils && compiler;
-        if (!shaderCompilerValid)
+        DxcInstance* dxc = GetDxcInstance();
+        if (!dxc)
         {
             logger.Warn("DxShaderCompiler not loaded");
             return false;
         }
 
         IDxcBlobEncoding* pSource = {};
-        utils->CreateBlob(shaderCreation.source.CStr(), shaderCreation.source.Size(), CP_UTF8, &pSource);
+        dxc->utils->CreateBlob(shaderCreation.source.CStr(), shaderCreation.source.Size(), CP_UTF8, &pSource);
 
         DxcBuffer source{};
         source.Ptr = pSource->GetBufferPointer();
@@ -187,26 +500,13 @@ namespace Fyrion
         std::wstring entryPoint = std::wstring{shaderCreation.entryPoint.begin(), shaderCreation.entryPoint.end()};
 
         Array<LPCWSTR> args;
-        args.EmplaceBack(L"-E");
-        args.EmplaceBack(entryPoint.c_str());
-        args.EmplaceBack(L"-Wno-ignored-attributes");
-
-        args.EmplaceBack(L"-T");
-        args.EmplaceBack(GetShaderStage(shaderCreation.shaderStage));
-
-        if (shaderCreation.renderApi != RenderApiType::D3D12)
-        {
-            args.EmplaceBack(L"-spirv");
-            args.EmplaceBack(L"-fspv-target-env=vulkan1.2");
-            args.EmplaceBack(L"-fvk-use-dx-layout");
-            args.EmplaceBack(L"-fvk-use-dx-position-w");
-        }
+        AddCompilerArgs(args, entryPoint.c_str(), shaderCreation.shaderStage, shaderCreation.renderApi);
 
         IDxcResult*    pResults{};
 
-        IncludeHandler includeHandler{shaderCreation.asset};
+        IncludeHandler includeHandler{shaderCreation.asset, dxc->utils};
 
-        compiler->Compile(&source, args.Data(), args.Size(), &includeHandler, IID_PPV_ARGS(&pResults));
+        dxc->compiler->Compile(&source, args.Data(), args.Size(), &includeHandler, IID_PPV_ARGS(&pResults));
 
         IDxcBlobUtf8* pErrors = {};
         pResults->GetOutput(DXC_OUT_ERRORS, IID_PPV_ARGS(&pErrors), nullptr);
@@ -249,6 +549,21 @@ namespace Fyrion
         return true;
     }
 
+    bool ShaderManager::CompileShaders(Span<ShaderCreation> shaderCreations, Span<Array<u8>> bytes)
+    {
+        FY_ASSERT(shaderCreations.Size() == bytes.Size(), "each shader creation needs its own output");
+
+        std::atomic<bool> compiled = true;
+        JobSystem::ParallelFor(shaderCreations.Size(), [&](usize index)
+        {
+            if (!CompileShader(shaderCreations[index], bytes[index]))
+            {
+                compiled = false;
+            }
+        }, 1);
+        return compiled;
+    }
+
     namespace SpirvUtils
     {
         Format CastFormat(const SpvReflectFormat& format)
@@ -639,16 +954,22 @@ namespace Fyrion
 
     void ShaderManagerShutdown()
     {
-        if (utils)
+        std::lock_guard lock(dxcInstancesMutex);
+        for (DxcInstance& dxc : dxcInstances)
         {
-            utils->Release();
-            utils = nullptr;
-        }
+            if (dxc.utils)
+            {
+                dxc.utils->Release();
+            }
 
-        if (compiler)
-        {
-            compiler->Release();
-            compiler = nullptr;
+            if (dxc.compiler)
+            {
+                dxc.compiler->Release();
+            }
         }
+        dxcInstances.Clear();
+
+        //instances cached by the threads are recreated on the next compilation
+        dxcGeneration++;
     }
 }
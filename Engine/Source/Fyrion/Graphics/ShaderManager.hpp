@@ -5,6 +5,21 @@
 
 namespace Fyrion::ShaderManager
 {
+    struct ShaderCacheStats
+    {
+        u64 hits{};
+        u64 misses{};
+    };
+
     FY_API bool       CompileShader(const ShaderCreation& shaderCreation, Array<u8>& bytes);
+    FY_API bool       CompileShaders(Span<ShaderCreation> shaderCreations, Span<Array<u8>> bytes);
     FY_API ShaderInfo ExtractShaderInfo(const Span<u8>& bytes, const Span<ShaderStageInfo>& stages, RenderApiType renderApi);
+
+    //compiled shaders are cached on disk by a hash of the source with its includes, the stages, the render api and the compiler arguments.
+    //GetCacheKey registers the shader as a dependency of its includes like the compilation does. an empty directory disables the cache.
+    FY_API void             SetCacheDirectory(StringView directory);
+    FY_API u64              GetCacheKey(ShaderAsset* shaderAsset, StringView source, Span<ShaderStageInfo> stages, RenderApiType renderApi);
+    FY_API bool             LoadFromCache(u64 key, Array<u8>& bytes, Array<ShaderStageInfo>& stages, ShaderInfo& shaderInfo);
+    FY_API void             SaveToCache(u64 key, Span<u8> bytes, Span<ShaderStageInfo> stages, const ShaderInfo& shaderInfo);
+    FY_API ShaderCacheStats GetCacheStats();
 }
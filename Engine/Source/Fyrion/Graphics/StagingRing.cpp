@@ -0,0 +1,88 @@
+#include "StagingRing.hpp"
+
+namespace Fyrion
+{
+    StagingRing::StagingRing(usize capacity)
+    {
+        Init(capacity);
+    }
+
+    void StagingRing::Init(usize capacity)
+    {
+        this->capacity = capacity;
+        head = 0;
+        used = 0;
+        pending = 0;
+        regions.Clear();
+    }
+
+    bool StagingRing::Allocate(usize size, usize alignment, usize& offset)
+    {
+        if (size == 0 || size > capacity)
+        {
+            return false;
+        }
+
+        alignment = alignment > 0 ? alignment : 1;
+
+        //the live regions are contiguous from the oldest one to head, the free space is after head and wraps to the oldest one
+        usize start = (head + alignment - 1) / alignment * alignment;
+        usize required = start - head + size;
+        if (start + size > capacity)
+        {
+            //the end of the buffer is skipped and counted as used until the region is released
+            start = 0;
+            required = capacity - head + size;
+        }
+
+        if (used + required > capacity)
+        {
+            return false;
+        }
+
+        offset = start;
+        head = start + size;
+        used += required;
+        pending += required;
+        return true;
+    }
+
+    void StagingRing::Submit(u64 submission)
+    {
+        if (pending > 0)
+        {
+            regions.EmplaceBack(Region{submission, pending});
+            pending = 0;
+        }
+    }
+
+    void StagingRing::Release(u64 completedSubmission)
+    {
+        usize count = 0;
+        while (count < regions.Size() && regions[count].submission <= completedSubmission)
+        {
+            used -= regions[count].size;
+            count++;
+        }
+
+        if (count > 0)
+        {
+            regions.Erase(regions.begin(), regions.begin() + count);
+        }
+
+        if (used == 0)
+        {
+            head = 0;
+        }
+    }
+
+    usize StagingRing::GetCapacity() const
+    {
+        return capacity;
+    }
+
+    usize StagingRing::GetUsed() const
+    {
+        return used;
+    }
+}
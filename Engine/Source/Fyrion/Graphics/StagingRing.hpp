@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Fyrion/Common.hpp"
+#include "Fyrion/Core/Array.hpp"
+
+namespace Fyrion
+{
+    //sub-allocates a persistent staging buffer in submission order.
+    //regions are grouped by Submit and reclaimed by Release once the GPU finished the submission.
+    class FY_API StagingRing
+    {
+    public:
+        explicit StagingRing(usize capacity = 0);
+
+        void  Init(usize capacity);
+        bool  Allocate(usize size, usize alignment, usize& offset);
+        void  Submit(u64 submission);
+        void  Release(u64 completedSubmission);
+        usize GetCapacity() const;
+        usize GetUsed() const;
+
+    private:
+        struct Region
+        {
+            u64   submission;
+            usize size;
+        };
+
+        usize         capacity = 0;
+        usize         head = 0;
+        usize         used = 0;
+        usize         pending = 0;
+        Array<Region> regions{};
+    };
+}
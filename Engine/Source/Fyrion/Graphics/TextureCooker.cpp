@@ -0,0 +1,807 @@
+#include "TextureCooker.hpp"
+
+#include <bit>
+#include <cmath>
+
+#include "Fyrion/Core/JobSystem.hpp"
+#include "Fyrion/Core/Math.hpp"
+
+namespace Fyrion
+{
+    namespace
+    {
+        constexpr f32   Pi = 3.14159265358979323846f;
+        constexpr u32   MaxKernelSize = 6;
+        constexpr usize TilePixels = 64 * 1024;
+        constexpr u32   RefineIterations = 3;
+        constexpr u16   MaxHalf = 0x7BFF;
+
+        //weights of the 4 bits indices used by BC6H and BC7
+        constexpr u32 Weights4[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+        //----- mip generation
+
+        struct MipKernel
+        {
+            i32 offset;
+            u32 size;
+            f32 weights[MaxKernelSize];
+        };
+
+        f32 BesselI0(f32 x)
+        {
+            f32 sum = 1.0f;
+            f32 term = 1.0f;
+            for (u32 k = 1; k < 16; ++k)
+            {
+                f32 value = x / (2.0f * static_cast<f32>(k));
+                term *= value * value;
+                sum += term;
+            }
+            return sum;
+        }
+
+        MipKernel CreateKernel(MipFilter filter)
+        {
+            if (filter == MipFilter::Box)
+            {
+                return MipKernel{.offset = 0, .size = 2, .weights = {0.5f, 0.5f}};
+            }
+
+            //kaiser windowed sinc with 6 taps, the destination pixel x is centered between source pixels 2x and 2x + 1
+            constexpr f32 alpha = 4.0f;
+            constexpr f32 width = 1.5f;
+
+            MipKernel kernel{.offset = -2, .size = 6};
+            f32       total = 0.0f;
+            for (u32 i = 0; i < kernel.size; ++i)
+            {
+                const f32 t = (static_cast<f32>(i) - 2.5f) * 0.5f;
+                const f32 x = t / width;
+                const f32 sinc = std::sin(Pi * t) / (Pi * t);
+                kernel.weights[i] = sinc * BesselI0(alpha * std::sqrt(1.0f - x * x)) / BesselI0(alpha);
+                total += kernel.weights[i];
+            }
+
+            for (u32 i = 0; i < kernel.size; ++i)
+            {
+                kernel.weights[i] /= total;
+            }
+            return kernel;
+        }
+
+        FY_FINLINE void StoreChannel(u8& dst, f32 value)
+        {
+            dst = static_cast<u8>(Math::Clamp(value + 0.5f, 0.0f, 255.0f));
+        }
+
+        FY_FINLINE void StoreChannel(f32& dst, f32 value)
+        {
+            //negative lobes of the kernel can ring below zero
+            dst = Math::Max(value, 0.0f);
+        }
+
+        //separable filter of the destination rows [y0, y1). the horizontal pass filters each source row used by the tile once.
+        template<typename T>
+        void DownsampleTile(const MipKernel& kernel, const T* src, Extent srcExtent, T* dst, Extent dstExtent, u32 y0, u32 y1)
+        {
+            const i32   srcWidth = static_cast<i32>(srcExtent.width);
+            const i32   srcHeight = static_cast<i32>(srcExtent.height);
+            const i32   firstRow = 2 * static_cast<i32>(y0) + kernel.offset;
+            const i32   lastRow = 2 * static_cast<i32>(y1 - 1) + kernel.offset + static_cast<i32>(kernel.size) - 1;
+            const usize rowStride = dstExtent.width * 4;
+
+            Array<f32> rows{};
+            rows.Resize((lastRow - firstRow + 1) * rowStride);
+
+            for (i32 r = firstRow; r <= lastRow; ++r)
+            {
+                const T* srcRow = src + Math::Clamp(r, 0, srcHeight - 1) * srcWidth * 4;
+                f32*     row = rows.Data() + (r - firstRow) * rowStride;
+
+                for (u32 x = 0; x < dstExtent.width; ++x)
+                {
+                    f32 acc[4] = {};
+                    for (u32 k = 0; k < kernel.size; ++k)
+                    {
+                        const T*  pixel = srcRow + Math::Clamp(2 * static_cast<i32>(x) + kernel.offset + static_cast<i32>(k), 0, srcWidth - 1) * 4;
+                        const f32 weight = kernel.weights[k];
+                        for (u32 c = 0; c < 4; ++c)
+                        {
+                            acc[c] += weight * static_cast<f32>(pixel[c]);
+                        }
+                    }
+
+                    for (u32 c = 0; c < 4; ++c)
+                    {
+                        row[x * 4 + c] = acc[c];
+                    }
+                }
+            }
+
+            for (u32 y = y0; y < y1; ++y)
+            {
+                const f32* firstTap = rows.Data() + (2 * static_cast<i32>(y) + kernel.offset - firstRow) * rowStride;
+                T*         dstRow = dst + y * rowStride;
+
+                for (usize i = 0; i < rowStride; ++i)
+                {
+                    f32 acc = 0.0f;
+                    for (u32 k = 0; k < kernel.size; ++k)
+                    {
+                        acc += kernel.weights[k] * firstTap[k * rowStride + i];
+                    }
+                    StoreChannel(dstRow[i], acc);
+                }
+            }
+        }
+
+        template<typename T>
+        void Downsample(MipFilter filter, const T* src, Extent srcExtent, T* dst)
+        {
+            const MipKernel kernel = CreateKernel(filter);
+            const Extent    dstExtent = TextureCooker::GetMipExtent(srcExtent, 1);
+            const u32       rowsPerTile = Math::Max(static_cast<u32>(TilePixels / dstExtent.width), 1u);
+            const u32       tileCount = (dstExtent.height + rowsPerTile - 1) / rowsPerTile;
+
+            JobSystem::ParallelFor(tileCount, [&](usize tile)
+            {
+                const u32 y0 = static_cast<u32>(tile) * rowsPerTile;
+                DownsampleTile(kernel, src, srcExtent, dst, dstExtent, y0, Math::Min(y0 + rowsPerTile, dstExtent.height));
+            }, 1);
+        }
+
+        //----- block compression
+
+        struct BitWriter
+        {
+            u8* data;
+            u32 position = 0;
+
+            void Write(u32 value, u32 bits)
+            {
+                for (u32 i = 0; i < bits; ++i, ++position)
+                {
+                    data[position >> 3] |= static_cast<u8>(((value >> i) & 1) << (position & 7));
+                }
+            }
+        };
+
+        typedef f32 BlockPixels[16][4];
+
+        //endpoints on the principal axis of the block, found with power iterations over the covariance matrix
+        void FitAxis(const BlockPixels& pixels, u32 channels, f32 (&e0)[4], f32 (&e1)[4])
+        {
+            f32 mean[4] = {};
+            f32 min[4] = {F32_MAX, F32_MAX, F32_MAX, F32_MAX};
+            f32 max[4] = {-F32_MAX, -F32_MAX, -F32_MAX, -F32_MAX};
+            for (u32 i = 0; i < 16; ++i)
+            {
+                for (u32 c = 0; c < channels; ++c)
+                {
+                    mean[c] += pixels[i][c] / 16.0f;
+                    min[c] = Math::Min(min[c], pixels[i][c]);
+                    max[c] = Math::Max(max[c], pixels[i][c]);
+                }
+            }
+
+            f32 covariance[4][4] = {};
+            for (u32 i = 0; i < 16; ++i)
+            {
+                for (u32 a = 0; a < channels; ++a)
+                {
+                    for (u32 b = 0; b < channels; ++b)
+                    {
+                        covariance[a][b] += (pixels[i][a] - mean[a]) * (pixels[i][b] - mean[b]);
+                    }
+                }
+            }
+
+            f32 axis[4] = {};
+            for (u32 c = 0; c < channels; ++c)
+            {
+                axis[c] = max[c] - min[c];
+            }
+
+            for (u32 iteration = 0; iteration < 8; ++iteration)
+            {
+                f32 next[4] = {};
+                f32 length = 0.0f;
+                for (u32 a = 0; a < channels; ++a)
+                {
+                    for (u32 b = 0; b < channels; ++b)
+                    {
+                        next[a] += covariance[a][b] * axis[b];
+                    }
+                    length = Math::Max(length, std::abs(next[a]));
+                }
+
+                if (length < 1e-8f)
+                {
+                    break;
+                }
+
+                for (u32 c = 0; c < channels; ++c)
+                {
+                    axis[c] = next[c] / length;
+                }
+            }
+
+            f32 length = 0.0f;
+            for (u32 c = 0; c < channels; ++c)
+            {
+                length += axis[c] * axis[c];
+            }
+
+            if (length < 1e-8f)
+            {
+                for (u32 c = 0; c < 4; ++c)
+                {
+                    e0[c] = e1[c] = mean[c];
+                }
+                return;
+            }
+
+            f32 minT = F32_MAX;
+            f32 maxT = -F32_MAX;
+            for (u32 i = 0; i < 16; ++i)
+            {
+                f32 t = 0.0f;
+                for (u32 c = 0; c < channels; ++c)
+                {
+                    t += (pixels[i][c] - mean[c]) * axis[c];
+                }
+                minT = Math::Min(minT, t);
+                maxT = Math::Max(maxT, t);
+            }
+
+            for (u32 c = 0; c < 4; ++c)
+            {
+                e0[c] = mean[c] + axis[c] * minT / length;
+                e1[c] = mean[c] + axis[c] * maxT / length;
+            }
+        }
+
+        //least squares endpoints for the current indices, weights are the contribution of e1 for each index
+        bool RefineEndpoints(const BlockPixels& pixels, u32 channels, const u8 (&indices)[16], const f32* weights, f32 (&e0)[4], f32 (&e1)[4])
+        {
+            f32 aa = 0.0f;
+            f32 ab = 0.0f;
+            f32 bb = 0.0f;
+            f32 ax[4] = {};
+            f32 bx[4] = {};
+
+            for (u32 i = 0; i < 16; ++i)
+            {
+                const f32 b = weights[indices[i]];
+                const f32 a = 1.0f - b;
+                aa += a * a;
+                ab += a * b;
+                bb += b * b;
+                for (u32 c = 0; c < channels; ++c)
+                {
+                    ax[c] += a * pixels[i][c];
+                    bx[c] += b * pixels[i][c];
+                }
+            }
+
+            const f32 det = aa * bb - ab * ab;
+            if (std::abs(det) < 1e-6f)
+            {
+                return false;
+            }
+
+            for (u32 c = 0; c < channels; ++c)
+            {
+                e0[c] = (ax[c] * bb - bx[c] * ab) / det;
+                e1[c] = (bx[c] * aa - ax[c] * ab) / det;
+            }
+            return true;
+        }
+
+        template<typename T>
+        FY_FINLINE f32 Distance(const f32* pixel, const T* color, u32 channels)
+        {
+            f32 distance = 0.0f;
+            for (u32 c = 0; c < channels; ++c)
+            {
+                const f32 diff = pixel[c] - static_cast<f32>(color[c]);
+                distance += diff * diff;
+            }
+            return distance;
+        }
+
+        //returns the squared error of the block
+        template<typename T>
+        f32 SelectIndices(const BlockPixels& pixels, u32 channels, const T (*palette)[4], u32 paletteSize, u8 (&indices)[16])
+        {
+            f32 error = 0.0f;
+            for (u32 i = 0; i < 16; ++i)
+            {
+                f32 best = F32_MAX;
+                for (u32 p = 0; p < paletteSize; ++p)
+                {
+                    f32 distance = Distance(pixels[i], palette[p], channels);
+                    if (distance < best)
+                    {
+                        best = distance;
+                        indices[i] = static_cast<u8>(p);
+                    }
+                }
+                error += best;
+            }
+            return error;
+        }
+
+        FY_FINLINE u16 To565(const f32 (&color)[4])
+        {
+            const u32 r = static_cast<u32>(Math::Clamp(color[0] * 31.0f / 255.0f + 0.5f, 0.0f, 31.0f));
+            const u32 g = static_cast<u32>(Math::Clamp(color[1] * 63.0f / 255.0f + 0.5f, 0.0f, 63.0f));
+            const u32 b = static_cast<u32>(Math::Clamp(color[2] * 31.0f / 255.0f + 0.5f, 0.0f, 31.0f));
+            return static_cast<u16>(r << 11 | g << 5 | b);
+        }
+
+        FY_FINLINE void From565(u16 value, i32 (&color)[4])
+        {
+            const i32 r = (value >> 11) & 31;
+            const i32 g = (value >> 5) & 63;
+            const i32 b = value & 31;
+            color[0] = r << 3 | r >> 2;
+            color[1] = g << 2 | g >> 4;
+            color[2] = b << 3 | b >> 2;
+            color[3] = 255;
+        }
+
+        void EncodeBC1(const BlockPixels& pixels, u8* dst)
+        {
+            constexpr f32 weights[4] = {0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f};
+
+            f32 e0[4];
+            f32 e1[4];
+            FitAxis(pixels, 3, e1, e0);
+
+            f32 bestError = F32_MAX;
+            for (u32 iteration = 0; iteration < RefineIterations; ++iteration)
+            {
+                u16 c0 = To565(e0);
+                u16 c1 = To565(e1);
+                if (c0 < c1)
+                {
+                    u16 tmp = c0;
+                    c0 = c1;
+                    c1 = tmp;
+                }
+
+                i32 palette[4][4];
+                From565(c0, palette[0]);
+                From565(c1, palette[1]);
+                for (u32 c = 0; c < 3; ++c)
+                {
+                    palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+                    palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+                }
+
+                //when both endpoints are the same the block is in 3 color mode, index 0 is the only safe one
+                u8  indices[16] = {};
+                f32 error = SelectIndices(pixels, 3, palette, c0 != c1 ? 4 : 1, indices);
+
+                if (error < bestError)
+                {
+                    bestError = error;
+
+                    u32 bits = 0;
+                    for (u32 i = 0; i < 16; ++i)
+                    {
+                        bits |= static_cast<u32>(indices[i]) << (i * 2);
+                    }
+
+                    dst[0] = static_cast<u8>(c0);
+                    dst[1] = static_cast<u8>(c0 >> 8);
+                    dst[2] = static_cast<u8>(c1);
+                    dst[3] = static_cast<u8>(c1 >> 8);
+                    dst[4] = static_cast<u8>(bits);
+                    dst[5] = static_cast<u8>(bits >> 8);
+                    dst[6] = static_cast<u8>(bits >> 16);
+                    dst[7] = static_cast<u8>(bits >> 24);
+                }
+
+                if (error == 0.0f || c0 == c1 || !RefineEndpoints(pixels, 3, indices, weights, e0, e1))
+                {
+                    break;
+                }
+            }
+        }
+
+        void EncodeBC4(const BlockPixels& pixels, u32 channel, u8* dst)
+        {
+            f32 min = 255.0f;
+            f32 max = 0.0f;
+            for (u32 i = 0; i < 16; ++i)
+            {
+                min = Math::Min(min, pixels[i][channel]);
+                max = Math::Max(max, pixels[i][channel]);
+            }
+
+            const i32 r0 = static_cast<i32>(max + 0.5f);
+            const i32 r1 = static_cast<i32>(min + 0.5f);
+
+            dst[0] = static_cast<u8>(r0);
+            dst[1] = static_cast<u8>(r1);
+
+            u64 bits = 0;
+            if (r0 > r1)
+            {
+                //8 values mode, index 0 is r0, index 1 is r1 and indices 2 to 7 interpolate from r0 to r1
+                const f32 scale = 7.0f / static_cast<f32>(r0 - r1);
+                for (u32 i = 0; i < 16; ++i)
+                {
+                    const u32 step = static_cast<u32>(Math::Clamp((static_cast<f32>(r0) - pixels[i][channel]) * scale + 0.5f, 0.0f, 7.0f));
+                    const u64 index = step == 0 ? 0 : step == 7 ? 1 : step + 1;
+                    bits |= index << (i * 3);
+                }
+            }
+
+            for (u32 i = 0; i < 6; ++i)
+            {
+                dst[2 + i] = static_cast<u8>(bits >> (i * 8));
+            }
+        }
+
+        FY_FINLINE void QuantizeBC7Endpoint(const f32 (&endpoint)[4], u32 (&quantized)[4], u32& pBit)
+        {
+            f32 bestError = F32_MAX;
+            for (u32 p = 0; p < 2; ++p)
+            {
+                u32 candidate[4];
+                f32 error = 0.0f;
+                for (u32 c = 0; c < 4; ++c)
+                {
+                    candidate[c] = static_cast<u32>(Math::Clamp((endpoint[c] - static_cast<f32>(p)) * 0.5f + 0.5f, 0.0f, 127.0f));
+                    const f32 diff = static_cast<f32>(candidate[c] << 1 | p) - endpoint[c];
+                    error += diff * diff;
+                }
+
+                if (error < bestError)
+                {
+                    bestError = error;
+                    pBit = p;
+                    for (u32 c = 0; c < 4; ++c)
+                    {
+                        quantized[c] = candidate[c];
+                    }
+                }
+            }
+        }
+
+        //BC7 mode 6: one subset, RGBA 7 bits endpoints with a p-bit each and 4 bits indices
+        void EncodeBC7(const BlockPixels& pixels, u8* dst)
+        {
+            f32 weights[16];
+            for (u32 i = 0; i < 16; ++i)
+            {
+                weights[i] = static_cast<f32>(Weights4[i]) / 64.0f;
+            }
+
+            f32 e0[4];
+            f32 e1[4];
+            FitAxis(pixels, 4, e0, e1);
+
+            f32 bestError = F32_MAX;
+            u32 bestEndpoints[2][4] = {};
+            u32 bestPBits[2] = {};
+            u8  bestIndices[16] = {};
+
+            for (u32 iteration = 0; iteration < RefineIterations; ++iteration)
+            {
+                u32 quantized[2][4];
+                u32 pBits[2];
+                QuantizeBC7Endpoint(e0, quantized[0], pBits[0]);
+                QuantizeBC7Endpoint(e1, quantized[1], pBits[1]);
+
+                i32 palette[16][4];
+                for (u32 c = 0; c < 4; ++c)
+                {
+                    const i32 v0 = static_cast<i32>(quantized[0][c] << 1 | pBits[0]);
+                    const i32 v1 = static_cast<i32>(quantized[1][c] << 1 | pBits[1]);
+                    for (u32 p = 0; p < 16; ++p)
+                    {
+                        palette[p][c] = ((64 - static_cast<i32>(Weights4[p])) * v0 + static_cast<i32>(Weights4[p]) * v1 + 32) >> 6;
+                    }
+                }
+
+                u8  indices[16];
+                f32 error = SelectIndices(pixels, 4, palette, 16, indices);
+                if (error < bestError)
+                {
+                    bestError = error;
+                    MemCopy(bestEndpoints, quantized, sizeof(quantized));
+                    MemCopy(bestPBits, pBits, sizeof(pBits));
+                    MemCopy(bestIndices, indices, sizeof(indices));
+                }
+
+                if (error == 0.0f || !RefineEndpoints(pixels, 4, indices, weights, e0, e1))
+                {
+                    break;
+                }
+            }
+
+            //the most significant bit of the first index is implicit zero
+            const bool swap = bestIndices[0] >= 8;
+
+            MemSet(dst, 0, 16);
+            BitWriter writer{dst};
+            writer.Write(1 << 6, 7);
+            for (u32 c = 0; c < 4; ++c)
+            {
+                writer.Write(bestEndpoints[swap ? 1 : 0][c], 7);
+                writer.Write(bestEndpoints[swap ? 0 : 1][c], 7);
+            }
+            writer.Write(bestPBits[swap ? 1 : 0], 1);
+            writer.Write(bestPBits[swap ? 0 : 1], 1);
+
+            for (u32 i = 0; i < 16; ++i)
+            {
+                writer.Write(swap ? 15 - bestIndices[i] : bestIndices[i], i == 0 ? 3 : 4);
+            }
+        }
+
+        FY_FINLINE u16 ToHalf(f32 value)
+        {
+            value = Math::Clamp(value, 0.0f, 65504.0f);
+            if (value < 6.103515625e-05f)
+            {
+                return static_cast<u16>(value * 16777216.0f + 0.5f);
+            }
+            const u32 bits = std::bit_cast<u32>(value);
+            return static_cast<u16>(Math::Min((bits - ((127u - 15u) << 23) + 0x1000u) >> 13, static_cast<u32>(MaxHalf)));
+        }
+
+        //BC6H unsigned endpoints are expanded to 16 bits, interpolated and scaled by 31/64 to half float bits.
+        FY_FINLINE i32 UnquantizeBC6H(u32 value)
+        {
+            if (value == 0) return 0;
+            if (value == 1023) return 0xFFFF;
+            return static_cast<i32>(((value << 16) + 0x8000) >> 10);
+        }
+
+        FY_FINLINE u32 QuantizeBC6H(f32 half)
+        {
+            const u32 base = static_cast<u32>(Math::Clamp((half - 15.0f) / 31.0f, 0.0f, 1023.0f));
+            const u32 next = Math::Min(base + 1, 1023u);
+            const f32 baseError = std::abs(static_cast<f32>((UnquantizeBC6H(base) * 31) >> 6) - half);
+            const f32 nextError = std::abs(static_cast<f32>((UnquantizeBC6H(next) * 31) >> 6) - half);
+            return nextError < baseError ? next : base;
+        }
+
+        //BC6H mode 11: one region, 10 bits endpoints without deltas and 4 bits indices
+        void EncodeBC6H(const BlockPixels& pixels, u8* dst)
+        {
+            f32 weights[16];
+            for (u32 i = 0; i < 16; ++i)
+            {
+                weights[i] = static_cast<f32>(Weights4[i]) / 64.0f;
+            }
+
+            //fit in the half float bits space, which is the space where the hardware interpolates
+            BlockPixels halfs;
+            for (u32 i = 0; i < 16; ++i)
+            {
+                for (u32 c = 0; c < 3; ++c)
+                {
+                    halfs[i][c] = static_cast<f32>(ToHalf(pixels[i][c]));
+                }
+                halfs[i][3] = 0.0f;
+            }
+
+            f32 e0[4];
+            f32 e1[4];
+            FitAxis(halfs, 3, e0, e1);
+
+            f32 bestError = F32_MAX;
+            u32 bestEndpoints[2][3] = {};
+            u8  bestIndices[16] = {};
+
+            for (u32 iteration = 0; iteration < RefineIterations; ++iteration)
+            {
+                u32 quantized[2][3];
+                i32 palette[16][4] = {};
+                for (u32 c = 0; c < 3; ++c)
+                {
+                    quantized[0][c] = QuantizeBC6H(e0[c]);
+                    quantized[1][c] = QuantizeBC6H(e1[c]);
+
+                    const i32 v0 = UnquantizeBC6H(quantized[0][c]);
+                    const i32 v1 = UnquantizeBC6H(quantized[1][c]);
+                    for (u32 p = 0; p < 16; ++p)
+                    {
+                        const i32 value = ((64 - static_cast<i32>(Weights4[p])) * v0 + static_cast<i32>(Weights4[p]) * v1 + 32) >> 6;
+                        palette[p][c] = (value * 31) >> 6;
+                    }
+                }
+
+                u8  indices[16];
+                f32 error = SelectIndices(halfs, 3, palette, 16, indices);
+                if (error < bestError)
+                {
+                    bestError = error;
+                    MemCopy(bestEndpoints, quantized, sizeof(quantized));
+                    MemCopy(bestIndices, indices, sizeof(indices));
+                }
+
+                if (error == 0.0f || !RefineEndpoints(halfs, 3, indices, weights, e0, e1))
+                {
+                    break;
+                }
+            }
+
+            const bool swap = bestIndices[0] >= 8;
+
+            MemSet(dst, 0, 16);
+            BitWriter writer{dst};
+            writer.Write(0x03, 5);
+            for (u32 c = 0; c < 3; ++c)
+            {
+                writer.Write(bestEndpoints[swap ? 1 : 0][c], 10);
+            }
+            for (u32 c = 0; c < 3; ++c)
+            {
+                writer.Write(bestEndpoints[swap ? 0 : 1][c], 10);
+            }
+
+            for (u32 i = 0; i < 16; ++i)
+            {
+                writer.Write(swap ? 15 - bestIndices[i] : bestIndices[i], i == 0 ? 3 : 4);
+            }
+        }
+
+        template<typename T, typename Encode>
+        void CompressBlocks(const T* src, Extent extent, u8* dst, u32 blockSize, const Encode& encode)
+        {
+            const u32 blocksX = (extent.width + 3) / 4;
+            const u32 blocksY = (extent.height + 3) / 4;
+
+            JobSystem::ParallelFor(blocksY, [&](usize blockY)
+            {
+                BlockPixels pixels;
+                for (u32 blockX = 0; blockX < blocksX; ++blockX)
+                {
+                    //blocks past the border replicate the last row and column
+                    for (u32 i = 0; i < 16; ++i)
+                    {
+                        const u32 x = Math::Min(blockX * 4 + (i & 3), extent.width - 1);
+                        const u32 y = Math::Min(static_cast<u32>(blockY) * 4 + (i >> 2), extent.height - 1);
+                        const T*  pixel = src + (y * extent.width + x) * 4;
+                        for (u32 c = 0; c < 4; ++c)
+                        {
+                            pixels[i][c] = static_cast<f32>(pixel[c]);
+                        }
+                    }
+                    encode(pixels, dst + (blockY * blocksX + blockX) * blockSize);
+                }
+            }, Math::Max(256 / blocksX, 1u));
+        }
+    }
+
+    bool TextureCooker::IsCompressed(Format format)
+    {
+        return GetBlockSize(format) > 0;
+    }
+
+    u32 TextureCooker::GetBlockSize(Format format)
+    {
+        switch (format)
+        {
+            case Format::BC1:
+            case Format::BC4:
+                return 8;
+            case Format::BC3:
+            case Format::BC5:
+            case Format::BC6H:
+            case Format::BC7:
+                return 16;
+            default:
+                return 0;
+        }
+    }
+
+    usize TextureCooker::GetImageSize(Format format, Extent extent)
+    {
+        if (u32 blockSize = GetBlockSize(format))
+        {
+            return static_cast<usize>((extent.width + 3) / 4) * ((extent.height + 3) / 4) * blockSize;
+        }
+
+        usize pixelSize = 0;
+        switch (format)
+        {
+            case Format::R: pixelSize = 1; break;
+            case Format::R16F:
+            case Format::RG: pixelSize = 2; break;
+            case Format::RGB: pixelSize = 3; break;
+            case Format::R32F:
+            case Format::RG16F:
+            case Format::RGBA:
+            case Format::BGRA:
+            case Format::RGBASNorm: pixelSize = 4; break;
+            case Format::RGB16F: pixelSize = 6; break;
+            case Format::RG32F:
+            case Format::RGBA16F: pixelSize = 8; break;
+            case Format::RGB32F: pixelSize = 12; break;
+            case Format::RGBA32F: pixelSize = 16; break;
+            default: break;
+        }
+        return static_cast<usize>(extent.width) * extent.height * pixelSize;
+    }
+
+    u32 TextureCooker::GetMipLevels(Extent extent)
+    {
+        return static_cast<u32>(std::floor(std::log2(Math::Max(extent.width, extent.height)))) + 1;
+    }
+
+    Extent TextureCooker::GetMipExtent(Extent extent, u32 mip)
+    {
+        return Extent{Math::Max(extent.width >> mip, 1u), Math::Max(extent.height >> mip, 1u)};
+    }
+
+    void TextureCooker::GenerateMip(MipFilter filter, const u8* src, Extent srcExtent, u8* dst)
+    {
+        Downsample(filter, src, srcExtent, dst);
+    }
+
+    void TextureCooker::GenerateMip(MipFilter filter, const f32* src, Extent srcExtent, f32* dst)
+    {
+        Downsample(filter, src, srcExtent, dst);
+    }
+
+    void TextureCooker::Compress(Format format, const u8* src, Extent extent, u8* dst)
+    {
+        const u32 blockSize = GetBlockSize(format);
+        switch (format)
+        {
+            case Format::BC1:
+                CompressBlocks(src, extent, dst, blockSize, [](const BlockPixels& pixels, u8* block)
+                {
+                    EncodeBC1(pixels, block);
+                });
+                break;
+            case Format::BC3:
+                CompressBlocks(src, extent, dst, blockSize, [](const BlockPixels& pixels, u8* block)
+                {
+                    EncodeBC4(pixels, 3, block);
+                    EncodeBC1(pixels, block + 8);
+                });
+                break;
+            case Format::BC4:
+                CompressBlocks(src, extent, dst, blockSize, [](const BlockPixels& pixels, u8* block)
+                {
+                    EncodeBC4(pixels, 0, block);
+                });
+                break;
+            case Format::BC5:
+                CompressBlocks(src, extent, dst, blockSize, [](const BlockPixels& pixels, u8* block)
+                {
+                    EncodeBC4(pixels, 0, block);
+                    EncodeBC4(pixels, 1, block + 8);
+                });
+                break;
+            case Format::BC7:
+                CompressBlocks(src, extent, dst, blockSize, [](const BlockPixels& pixels, u8* block)
+                {
+                    EncodeBC7(pixels, block);
+                });
+                break;
+            default:
+                FY_ASSERT(false, "format not supported");
+                break;
+        }
+    }
+
+    void TextureCooker::Compress(Format format, const f32* src, Extent extent, u8* dst)
+    {
+        FY_ASSERT(format == Format::BC6H, "format not supported");
+        CompressBlocks(src, extent, dst, GetBlockSize(format), [](const BlockPixels& pixels, u8* block)
+        {
+            EncodeBC6H(pixels, block);
+        });
+    }
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "GraphicsTypes.hpp"
+
+namespace Fyrion
+{
+    enum class MipFilter
+    {
+        Box,
+        Kaiser
+    };
+}
+
+//CPU side texture processing used when importing textures.
+namespace Fyrion::TextureCooker
+{
+    FY_API bool   IsCompressed(Format format);
+    FY_API u32    GetBlockSize(Format format); //bytes of a 4x4 block, 0 for uncompressed formats
+    FY_API usize  GetImageSize(Format format, Extent extent);
+    FY_API u32    GetMipLevels(Extent extent);
+    FY_API Extent GetMipExtent(Extent extent, u32 mip);
+
+    //generates the next mip of a RGBA8 or RGBA32F image, dst must have space for GetMipExtent(srcExtent, 1).
+    FY_API void GenerateMip(MipFilter filter, const u8* src, Extent srcExtent, u8* dst);
+    FY_API void GenerateMip(MipFilter filter, const f32* src, Extent srcExtent, f32* dst);
+
+    //encodes a RGBA8 image to BC1, BC3, BC4, BC5 or BC7. BC1 ignores alpha, BC4 uses red and BC5 red and green.
+    FY_API void Compress(Format format, const u8* src, Extent extent, u8* dst);
+
+    //encodes a RGBA32F image to BC6H, alpha is ignored and negative values are clamped to zero.
+    FY_API void Compress(Format format, const f32* src, Extent extent, u8* dst);
+}
@@ -10,9 +10,12 @@
 #include <pwd.h>
 #include <fcntl.h>
 #include <limits.h>
+#include <mutex>
+#include <sys/mman.h>
 
 #include "FileSystem.hpp"
 #include "Path.hpp"
+#include "Fyrion/Core/HashMap.hpp"
 
 namespace Fyrion
 {
@@ -24,6 +27,17 @@ namespace Fyrion
             i32 handler{};
             String path{};
         };
+
+        struct LinuxFileMapping
+        {
+            i32   handler{};
+            i32   protection{};
+            usize size{};
+        };
+
+        //munmap requires the size of the view
+        std::mutex            viewsMutex{};
+        HashMap<usize, usize> mappedViews{};
     }
 
     DirIterator& DirIterator::operator++()
@@ -164,24 +178,92 @@ namespace Fyrion
         return read(linuxFileHandler->handler, data, size);
     }
 
+    u64 FileSystem::ReadFileAt(FileHandler fileHandler, VoidPtr data, usize size, u64 offset)
+    {
+        LinuxFileHandler* linuxFileHandler = static_cast<LinuxFileHandler*>(fileHandler.handler);
+        return pread(linuxFileHandler->handler, data, size, static_cast<off_t>(offset));
+    }
+
     FileHandler FileSystem::CreateFileMapping(FileHandler fileHandler, AccessMode accessMode, usize size)
     {
-        return FileHandler{};
+        LinuxFileHandler* linuxFileHandler = static_cast<LinuxFileHandler*>(fileHandler.handler);
+        if (linuxFileHandler == nullptr)
+        {
+            return {};
+        }
+
+        i32 protection = PROT_READ;
+        if (accessMode == AccessMode::WriteOnly || accessMode == AccessMode::ReadAndWrite)
+        {
+            protection |= PROT_WRITE;
+        }
+
+        struct stat st{};
+        if (fstat(linuxFileHandler->handler, &st) != 0)
+        {
+            return {};
+        }
+
+        if (size == 0)
+        {
+            size = st.st_size;
+        }
+        else if (size > static_cast<usize>(st.st_size))
+        {
+            if ((protection & PROT_WRITE) == 0 || ftruncate(linuxFileHandler->handler, static_cast<off_t>(size)) != 0)
+            {
+                return {};
+            }
+        }
+
+        if (size == 0)
+        {
+            return {};
+        }
+
+        return {MemoryGlobals::GetDefaultAllocator().Alloc<LinuxFileMapping>(linuxFileHandler->handler, protection, size)};
     }
 
     VoidPtr FileSystem::MapViewOfFile(FileHandler fileHandler)
     {
-        return nullptr;
+        LinuxFileMapping* linuxFileMapping = static_cast<LinuxFileMapping*>(fileHandler.handler);
+        if (linuxFileMapping == nullptr)
+        {
+            return nullptr;
+        }
+
+        VoidPtr map = mmap(nullptr, linuxFileMapping->size, linuxFileMapping->protection, MAP_SHARED, linuxFileMapping->handler, 0);
+        if (map == MAP_FAILED)
+        {
+            return nullptr;
+        }
+
+        std::lock_guard lock(viewsMutex);
+        mappedViews.Insert(reinterpret_cast<usize>(map), linuxFileMapping->size);
+
+        return map;
     }
 
     bool FileSystem::UnmapViewOfFile(VoidPtr map)
     {
-        return false;
+        usize size = 0;
+        {
+            std::lock_guard lock(viewsMutex);
+            if (auto it = mappedViews.Find(reinterpret_cast<usize>(map)))
+            {
+                size = it->second;
+                mappedViews.Erase(it);
+            }
+        }
+        return size > 0 && munmap(map, size) == 0;
     }
 
     void FileSystem::CloseFileMapping(FileHandler fileHandler)
     {
-
+        if (LinuxFileMapping* linuxFileMapping = static_cast<LinuxFileMapping*>(fileHandler.handler))
+        {
+            MemoryGlobals::GetDefaultAllocator().DestroyAndFree(linuxFileMapping);
+        }
     }
 
     void FileSystem::CloseFile(FileHandler fileHandler)
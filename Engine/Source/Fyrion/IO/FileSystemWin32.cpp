@@ -190,6 +190,17 @@ namespace Fyrion
         return nRead;
     }
 
+    u64 FileSystem::ReadFileAt(FileHandler fileHandler, VoidPtr data, usize size, u64 offset)
+    {
+        OVERLAPPED overlapped{};
+        overlapped.Offset = static_cast<DWORD>(offset & 0xFFFFFFFF);
+        overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+        DWORD nRead{};
+        ::ReadFile(fileHandler.handler, data, size, &nRead, &overlapped);
+        return nRead;
+    }
+
 	FileHandler FileSystem::CreateFileMapping(FileHandler fileHandler, AccessMode accessMode, usize size)
     {
 		DWORD protect = 0;
@@ -215,7 +226,12 @@ namespace Fyrion
 
 	VoidPtr FileSystem::MapViewOfFile(FileHandler fileHandler)
     {
-    	return ::MapViewOfFile(fileHandler.handler, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+    	if (VoidPtr map = ::MapViewOfFile(fileHandler.handler, FILE_MAP_ALL_ACCESS, 0, 0, 0))
+    	{
+    		return map;
+    	}
+    	//read-only mappings can't be mapped with write access
+    	return ::MapViewOfFile(fileHandler.handler, FILE_MAP_READ, 0, 0, 0);
     }
 
 	bool FileSystem::UnmapViewOfFile(VoidPtr map)
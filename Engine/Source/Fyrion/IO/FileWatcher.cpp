@@ -1,20 +1,37 @@
 #include "FileWatcher.hpp"
 #include "FileSystem.hpp"
 
+#include <chrono>
 #include <mutex>
 #include <optional>
 #include <queue>
 #include <thread>
 
 #include "Path.hpp"
+#include "Fyrion/Core/HashMap.hpp"
 #include "Fyrion/Core/HashSet.hpp"
 #include "Fyrion/Core/Logger.hpp"
 
+#ifdef FY_LINUX
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+#endif
+
 namespace Fyrion
 {
     namespace
     {
         Logger& logger = Logger::GetLogger("Fyrion::FileWatcher");
+
+        typedef std::chrono::steady_clock Clock;
+
+        //writes to the same file are merged in a single Modified event if they happen within this window,
+        //but a file written continuously is still reported at least every MaxModifiedDelay.
+        constexpr auto ModifiedWindow = std::chrono::milliseconds(50);
+        constexpr auto MaxModifiedDelay = std::chrono::milliseconds(500);
     }
 
     struct FileWatcherData
@@ -27,19 +44,52 @@ namespace Fyrion
         HashSet<u64> children{};
     };
 
-    struct FileWatcherInternal
+    struct FileWatcherEvents
     {
-        bool                       running = true;
-        std::optional<std::thread> thread;
-
         std::mutex                      modifiedMutex{};
         std::queue<FileWatcherModified> modified{};
 
+        void Push(FileWatcherModified&& fileWatcherModified)
+        {
+            std::unique_lock lockQueue(modifiedMutex);
+            modified.emplace(Traits::Move(fileWatcherModified));
+        }
+    };
+
+    //checks the status of every watched path each 100 ms, used where there is no native backend
+    //or when the native backend cannot watch a path.
+    struct FileWatcherPolling
+    {
+        FileWatcherEvents&         events;
+        bool                       running = true;
+        std::optional<std::thread> thread;
+
         std::queue<FileWatcherData> newFiles{};
         std::mutex                  newFilesMutex{};
 
         Array<FileWatcherData> watchedFiles{};
 
+        explicit FileWatcherPolling(FileWatcherEvents& events) : events(events)
+        {
+            thread = std::make_optional(std::thread(&FileWatcherPolling::ThreadLoop, this));
+        }
+
+        ~FileWatcherPolling()
+        {
+            running = false;
+            if (thread->joinable())
+            {
+                thread->join();
+                thread.reset();
+            }
+        }
+
+        void Watch(FileWatcherData&& data)
+        {
+            std::unique_lock lock(newFilesMutex);
+            newFiles.emplace(Traits::Move(data));
+        }
+
         void ThreadLoop()
         {
             while (running)
@@ -77,8 +127,7 @@ namespace Fyrion
                         {
                             if (FileSystem::GetFileStatus(file).fileId == data.fileId)
                             {
-                                std::unique_lock lockQueue(modifiedMutex);
-                                modified.emplace(FileWatcherModified{
+                                events.Push(FileWatcherModified{
                                     .userData = data.userData,
                                     .oldName = Path::Name(data.path),
                                     .name = Path::Name(file),
@@ -98,8 +147,7 @@ namespace Fyrion
 
                         if (!renamed)
                         {
-                            std::unique_lock lockQueue(modifiedMutex);
-                            modified.emplace(FileWatcherModified{
+                            events.Push(FileWatcherModified{
                                 .userData = data.userData,
                                 .path = data.path,
                                 .event = FileNotifyEvent::Removed
@@ -122,8 +170,7 @@ namespace Fyrion
                             if (!data.children.Has(fileId))
                             {
                                 data.children.Emplace(fileId);
-                                std::unique_lock lockQueue(modifiedMutex);
-                                modified.emplace(FileWatcherModified{
+                                events.Push(FileWatcherModified{
                                     .userData = data.userData,
                                     .path = file,
                                     .event = FileNotifyEvent::Added
@@ -150,8 +197,7 @@ namespace Fyrion
                     else if (fileStatus.lastModifiedTime != data.lastModifiedTime)
                     {
                         data.lastModifiedTime = fileStatus.lastModifiedTime;
-                        std::unique_lock lockQueue(modifiedMutex);
-                        modified.emplace(FileWatcherModified{
+                        events.Push(FileWatcherModified{
                             .userData = data.userData,
                             .path = data.path,
                             .event = FileNotifyEvent::Modified
@@ -169,6 +215,430 @@ namespace Fyrion
         }
     };
 
+#ifdef FY_LINUX
+
+    //inotify only watches directories: the directory of each watched file and each watched directory itself.
+    //events of the entries are matched by path, so one watch serves all the files of a directory.
+    struct FileWatcherInotify
+    {
+        struct PendingModified
+        {
+            Clock::time_point first;
+            Clock::time_point last;
+        };
+
+        struct MovedFrom
+        {
+            u32    cookie;
+            String directory;
+            String path;
+        };
+
+        FileWatcherEvents&         events;
+        bool                       running = true;
+        i32                        inotifyFd = -1;
+        i32                        wakeFd[2] = {-1, -1};
+        std::optional<std::thread> thread;
+
+        std::mutex                       watchMutex{};
+        HashMap<i32, String>             directories{};
+        HashMap<String, FileWatcherData> entries{};
+        HashMap<String, PendingModified> pendingModified{};
+
+        explicit FileWatcherInotify(FileWatcherEvents& events) : events(events) {}
+
+        bool Start()
+        {
+            inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+            if (inotifyFd < 0)
+            {
+                logger.Warn("inotify_init1 failed with error {}, using polling file watcher", errno);
+                return false;
+            }
+
+            if (pipe2(wakeFd, O_NONBLOCK | O_CLOEXEC) != 0)
+            {
+                logger.Warn("pipe2 failed with error {}, using polling file watcher", errno);
+                return false;
+            }
+
+            thread = std::make_optional(std::thread(&FileWatcherInotify::ThreadLoop, this));
+            return true;
+        }
+
+        ~FileWatcherInotify()
+        {
+            running = false;
+            if (thread && thread->joinable())
+            {
+                Wake();
+                thread->join();
+                thread.reset();
+            }
+
+            if (inotifyFd >= 0) close(inotifyFd);
+            if (wakeFd[0] >= 0) close(wakeFd[0]);
+            if (wakeFd[1] >= 0) close(wakeFd[1]);
+        }
+
+        void Wake() const
+        {
+            char value = 1;
+            [[maybe_unused]] auto ret = write(wakeFd[1], &value, 1);
+        }
+
+        bool AddDirectory(const StringView& directory)
+        {
+            constexpr u32 mask = IN_CREATE | IN_DELETE | IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR;
+
+            //watching the same directory again returns the same descriptor
+            i32 wd = inotify_add_watch(inotifyFd, String{directory}.CStr(), mask);
+            if (wd < 0)
+            {
+                logger.Warn("inotify_add_watch failed on {} with error {}", directory, errno);
+                return false;
+            }
+            directories[wd] = directory;
+            return true;
+        }
+
+        bool Watch(FileWatcherData&& data)
+        {
+            std::unique_lock lock(watchMutex);
+
+            if (data.isDirectory && !AddDirectory(data.path))
+            {
+                return false;
+            }
+
+            if (!AddDirectory(Path::Parent(data.path)))
+            {
+                return false;
+            }
+
+            String path = data.path;
+            entries.Erase(path);
+            entries.Emplace(path, Traits::Move(data));
+            return true;
+        }
+
+        void OnAdded(const StringView& directory, const String& path)
+        {
+            if (auto it = entries.Find(path); it && !it->second.isDirectory)
+            {
+                //file replaced by another one, like editors that save to a temp file and rename it.
+                OnModified(path);
+                return;
+            }
+
+            if (auto it = entries.Find(directory); it && it->second.isDirectory)
+            {
+                events.Push(FileWatcherModified{
+                    .userData = it->second.userData,
+                    .path = path,
+                    .event = FileNotifyEvent::Added
+                });
+                logger.Debug("file {} added on {} ", path, directory);
+            }
+        }
+
+        void OnModified(const String& path)
+        {
+            if (auto it = entries.Find(path); it && !it->second.isDirectory)
+            {
+                Clock::time_point now = Clock::now();
+                if (auto pending = pendingModified.Find(path))
+                {
+                    pending->second.last = now;
+                }
+                else
+                {
+                    pendingModified.Insert(path, PendingModified{now, now});
+                }
+            }
+        }
+
+        void OnRemoved(const String& path)
+        {
+            pendingModified.Erase(path);
+
+            if (auto it = entries.Find(path))
+            {
+                events.Push(FileWatcherModified{
+                    .userData = it->second.userData,
+                    .path = path,
+                    .event = FileNotifyEvent::Removed
+                });
+                logger.Debug("file {} removed", path);
+                entries.Erase(it);
+            }
+        }
+
+        void OnRenamed(const String& oldPath, const StringView& directory, const String& newPath)
+        {
+            auto it = entries.Find(oldPath);
+            if (!it)
+            {
+                OnAdded(directory, newPath);
+                return;
+            }
+
+            FileWatcherData data = Traits::Move(it->second);
+            entries.Erase(it);
+
+            events.Push(FileWatcherModified{
+                .userData = data.userData,
+                .oldName = Path::Name(oldPath),
+                .name = Path::Name(newPath),
+                .path = newPath,
+                .event = FileNotifyEvent::Renamed
+            });
+            logger.Debug("file {} renamed to {}", oldPath, newPath);
+
+            if (pendingModified.Has(oldPath))
+            {
+                pendingModified.Erase(oldPath);
+                OnModified(newPath);
+            }
+
+            if (data.isDirectory)
+            {
+                //the watch descriptors follow the inodes, only the paths below the directory need to be updated.
+                String prefix = oldPath;
+                prefix.Append(FY_PATH_SEPARATOR);
+
+                for (auto& dirIt : directories)
+                {
+                    if (dirIt.second == oldPath || StringView{dirIt.second}.StartsWith(prefix))
+                    {
+                        dirIt.second = Path::Join(newPath, StringView{dirIt.second}.Substr(oldPath.Size()));
+                    }
+                }
+
+                Array<String> children{};
+                for (auto& entryIt : entries)
+                {
+                    if (StringView{entryIt.first}.StartsWith(prefix))
+                    {
+                        children.EmplaceBack(entryIt.first);
+                    }
+                }
+
+                for (const String& child : children)
+                {
+                    auto childIt = entries.Find(child);
+                    FileWatcherData childData = Traits::Move(childIt->second);
+                    entries.Erase(childIt);
+                    childData.path = Path::Join(newPath, StringView{child}.Substr(oldPath.Size()));
+                    String childPath = childData.path;
+                    entries.Emplace(childPath, Traits::Move(childData));
+                }
+            }
+
+            data.path = newPath;
+            entries.Emplace(newPath, Traits::Move(data));
+        }
+
+        //a rename inside watched directories is a IN_MOVED_FROM followed by a IN_MOVED_TO with the same cookie,
+        //the pair can be split between two reads, so unmatched IN_MOVED_FROM are kept in movedFrom until the queue is drained.
+        void ProcessEvents(const char* buffer, usize size, Array<MovedFrom>& movedFrom)
+        {
+            for (usize offset = 0; offset < size;)
+            {
+                const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+                offset += sizeof(inotify_event) + event->len;
+
+                if (event->mask & IN_Q_OVERFLOW)
+                {
+                    logger.Warn("inotify queue overflow, file changes were lost");
+                    continue;
+                }
+
+                auto dirIt = directories.Find(event->wd);
+                if (!dirIt) continue;
+
+                if (event->mask & IN_IGNORED)
+                {
+                    directories.Erase(dirIt);
+                    continue;
+                }
+
+                if (event->len == 0) continue;
+
+                String directory = dirIt->second;
+                String path = Path::Join(directory, StringView{event->name});
+
+                if (event->mask & IN_MOVED_FROM)
+                {
+                    movedFrom.EmplaceBack(MovedFrom{event->cookie, directory, path});
+                }
+                else if (event->mask & IN_MOVED_TO)
+                {
+                    bool renamed = false;
+                    for (auto it = movedFrom.begin(); it != movedFrom.end(); ++it)
+                    {
+                        if (it->cookie == event->cookie)
+                        {
+                            OnRenamed(it->path, directory, path);
+                            movedFrom.Erase(it);
+                            renamed = true;
+                            break;
+                        }
+                    }
+
+                    if (!renamed)
+                    {
+                        OnAdded(directory, path);
+                    }
+                }
+                else if (event->mask & IN_CREATE)
+                {
+                    OnAdded(directory, path);
+                }
+                else if (event->mask & IN_DELETE)
+                {
+                    OnRemoved(path);
+                }
+                else if (event->mask & (IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB))
+                {
+                    OnModified(path);
+                }
+            }
+        }
+
+        //returns the poll timeout in milliseconds until the next pending Modified is due, -1 if none
+        i32 FlushModified()
+        {
+            if (pendingModified.Empty())
+            {
+                return -1;
+            }
+
+            Clock::time_point now = Clock::now();
+            Clock::time_point next = Clock::time_point::max();
+
+            Array<String> ready{};
+            for (auto& it : pendingModified)
+            {
+                Clock::time_point due = std::min(it.second.last + ModifiedWindow, it.second.first + MaxModifiedDelay);
+                if (due <= now)
+                {
+                    ready.EmplaceBack(it.first);
+                }
+                else
+                {
+                    next = std::min(next, due);
+                }
+            }
+
+            for (const String& path : ready)
+            {
+                pendingModified.Erase(path);
+                if (auto it = entries.Find(path))
+                {
+                    events.Push(FileWatcherModified{
+                        .userData = it->second.userData,
+                        .path = path,
+                        .event = FileNotifyEvent::Modified
+                    });
+                    logger.Debug("file {} modified", path);
+                }
+            }
+
+            if (next == Clock::time_point::max())
+            {
+                return -1;
+            }
+            return static_cast<i32>(std::chrono::duration_cast<std::chrono::milliseconds>(next - now).count()) + 1;
+        }
+
+        void ThreadLoop()
+        {
+            alignas(inotify_event) char buffer[16 * 1024];
+            i32              timeout = -1;
+            Array<MovedFrom> movedFrom{};
+
+            while (running)
+            {
+                pollfd fds[2] = {
+                    {.fd = inotifyFd, .events = POLLIN},
+                    {.fd = wakeFd[0], .events = POLLIN}
+                };
+
+                if (poll(fds, 2, timeout) < 0 && errno != EINTR)
+                {
+                    logger.Error("poll failed with error {}, file watcher stopped", errno);
+                    break;
+                }
+
+                if (fds[1].revents & POLLIN)
+                {
+                    while (read(wakeFd[0], buffer, sizeof(buffer)) > 0) {}
+                }
+
+                std::unique_lock lock(watchMutex);
+
+                if (fds[0].revents & POLLIN)
+                {
+                    ssize_t len;
+                    while ((len = read(inotifyFd, buffer, sizeof(buffer))) > 0)
+                    {
+                        ProcessEvents(buffer, len, movedFrom);
+                    }
+
+                    //without its pair, the file was moved out of the watched directories
+                    for (const MovedFrom& moved : movedFrom)
+                    {
+                        OnRemoved(moved.path);
+                    }
+                    movedFrom.Clear();
+                }
+
+                timeout = FlushModified();
+            }
+        }
+    };
+
+#endif
+
+    struct FileWatcherInternal
+    {
+        FileWatcherEvents   events{};
+        FileWatcherPolling* polling{};
+#ifdef FY_LINUX
+        FileWatcherInotify* inotify{};
+#endif
+
+        void Watch(FileWatcherData&& data)
+        {
+#ifdef FY_LINUX
+            if (inotify && inotify->Watch(Traits::Move(data)))
+            {
+                return;
+            }
+#endif
+            if (polling == nullptr)
+            {
+                polling = MemoryGlobals::GetDefaultAllocator().Alloc<FileWatcherPolling>(events);
+            }
+            polling->Watch(Traits::Move(data));
+        }
+
+        ~FileWatcherInternal()
+        {
+#ifdef FY_LINUX
+            if (inotify)
+            {
+                MemoryGlobals::GetDefaultAllocator().DestroyAndFree(inotify);
+            }
+#endif
+            if (polling)
+            {
+                MemoryGlobals::GetDefaultAllocator().DestroyAndFree(polling);
+            }
+        }
+    };
+
 
     void FileWatcher::Watch(VoidPtr userData, const StringView& fileDir)
     {
@@ -176,7 +646,7 @@ namespace Fyrion
         {
             if (FileStatus fileStatus = FileSystem::GetFileStatus(fileDir); fileStatus.exists)
             {
-                internal->newFiles.emplace(FileWatcherData{
+                internal->Watch(FileWatcherData{
                     .path = fileDir,
                     .userData = userData,
                     .isDirectory = fileStatus.isDirectory,
@@ -192,12 +662,17 @@ namespace Fyrion
     {
         if (internal)
         {
-            std::unique_lock lockQueue(internal->modifiedMutex);
-            while (!internal->modified.empty())
+            //callbacks can watch new files, so they are called outside the lock.
+            std::queue<FileWatcherModified> modified{};
+            {
+                std::unique_lock lockQueue(internal->events.modifiedMutex);
+                modified.swap(internal->events.modified);
+            }
+
+            while (!modified.empty())
             {
-                FileWatcherModified& data = internal->modified.front();
-                watcherCallbackFn(data);
-                internal->modified.pop();
+                watcherCallbackFn(modified.front());
+                modified.pop();
             }
         }
     }
@@ -210,19 +685,21 @@ namespace Fyrion
     void FileWatcher::Start()
     {
         internal = MemoryGlobals::GetDefaultAllocator().Alloc<FileWatcherInternal>();
-        internal->thread = std::make_optional(std::thread(&FileWatcherInternal::ThreadLoop, internal));
+
+#ifdef FY_LINUX
+        internal->inotify = MemoryGlobals::GetDefaultAllocator().Alloc<FileWatcherInotify>(internal->events);
+        if (!internal->inotify->Start())
+        {
+            MemoryGlobals::GetDefaultAllocator().DestroyAndFree(internal->inotify);
+            internal->inotify = nullptr;
+        }
+#endif
     }
 
     void FileWatcher::Stop()
     {
         if (internal)
         {
-            internal->running = false;
-            if (internal->thread->joinable())
-            {
-                internal->thread->join();
-                internal->thread.reset();
-            }
             MemoryGlobals::GetDefaultAllocator().DestroyAndFree(internal);
             internal = nullptr;
         }
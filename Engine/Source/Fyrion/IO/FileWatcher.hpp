@@ -26,7 +26,7 @@ namespace Fyrion
 
     struct FileWatcherInternal;
 
-    class FileWatcher
+    class FY_API FileWatcher
     {
     public:
         FY_NO_COPY_CONSTRUCTOR(FileWatcher);
@@ -5,6 +5,7 @@
 #include "Fyrion/Core/Attributes.hpp"
 #include "Fyrion/Core/Color.hpp"
 #include "Fyrion/Core/Registry.hpp"
+#include "Fyrion/Core/StringUtils.hpp"
 #include "Lib/imgui_internal.h"
 
 namespace Fyrion
@@ -187,6 +188,47 @@ namespace Fyrion
         return true;
     }
 
+    bool ObjectRenderer(ImGui::DrawTypeContent* context, const TypeInfo& typeInfo, VoidPtr value, bool* hasChanged)
+    {
+        //only struct fields stored by value, pointers and array items are drawn by their own renderers
+        FieldHandler* fieldHandler = context->activeFieldHandler;
+        if (typeInfo.isEnum || typeInfo.apiId != 0 || fieldHandler == nullptr) return false;
+        if (fieldHandler->GetFieldInfo().isPointer || fieldHandler->GetFieldInfo().typeInfo.typeId != typeInfo.typeId) return false;
+
+        TypeHandler* typeHandler = Registry::FindTypeById(typeInfo.typeId);
+        if (!typeHandler) return false;
+
+        bool hasProperties = false;
+        for (FieldHandler* field : typeHandler->GetFields())
+        {
+            hasProperties = hasProperties || field->HasAttribute<UIProperty>();
+        }
+        if (!hasProperties) return false;
+
+        ImGui::Indent();
+        for (FieldHandler* field : typeHandler->GetFields())
+        {
+            if (!field->HasAttribute<UIProperty>()) continue;
+            context->activeFieldHandler = field;
+
+            ImGui::TableNextColumn();
+            ImGui::AlignTextToFramePadding();
+            String formattedName = FormatName(field->GetName());
+            ImGui::Text("%s", formattedName.CStr());
+            ImGui::TableNextColumn();
+
+            VoidPtr fieldPointer = field->GetFieldPointer(value);
+            for (ImGui::FieldRendererFn render : ImGui::GetFieldRenderers())
+            {
+                render(context, field->GetFieldInfo().typeInfo, fieldPointer, hasChanged);
+            }
+        }
+        ImGui::Unindent();
+
+        context->activeFieldHandler = fieldHandler;
+        return true;
+    }
+
     struct DrawAssetFieldUserData
     {
         ImGui::DrawTypeContent* context;
@@ -426,6 +468,28 @@ namespace Fyrion
         return true;
     }
 
+    bool U32Renderer(ImGui::DrawTypeContent* context, const TypeInfo& typeInfo, VoidPtr value, bool* hasChanged)
+    {
+        if (typeInfo.typeId != GetTypeID<u32>()) return false;
+
+        u32 id = context->ReserveID();
+
+        char str[25];
+        sprintf(str, "###txtid%d", id);
+
+        ImGui::SetNextItemWidth(-1);
+
+        u32 step = 1;
+        if (ImGui::InputScalar(str, ImGuiDataType_U32, value, &step))
+        {
+            if (hasChanged)
+            {
+                *hasChanged = true;
+            }
+        }
+        return true;
+    }
+
     bool BoolRenderer(ImGui::DrawTypeContent* context, const TypeInfo& typeInfo, VoidPtr value, bool* hasChanged)
     {
         if (typeInfo.typeId != GetTypeID<bool>()) return false;
@@ -522,6 +586,7 @@ namespace Fyrion
     {
         AddFieldRenderer(ColorRenderer);
         AddFieldRenderer(FloatRenderer);
+        AddFieldRenderer(U32Renderer);
         AddFieldRenderer(BoolRenderer);
         AddFieldRenderer(Vec3Renderer);
         AddFieldRenderer(Vec2Renderer);
@@ -529,5 +594,6 @@ namespace Fyrion
         AddFieldRenderer(DrawAssetField);
         AddFieldRenderer(DrawArrayField);
         AddFieldRenderer(EnumRenderer);
+        AddFieldRenderer(ObjectRenderer);
     }
 }
@@ -14,6 +14,7 @@ namespace Fyrion
     public:
         TypeHandler* typeHandler = nullptr;
         SceneObject* object = nullptr;
+        u32          updateIndex = U32_MAX; //index in the update pool of the type, managed by the ComponentScheduler
         virtual      ~Component() = default;
 
         virtual void OnStart() {}
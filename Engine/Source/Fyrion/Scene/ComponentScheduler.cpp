@@ -0,0 +1,208 @@
+#include "ComponentScheduler.hpp"
+
+#include "Fyrion/Core/FlatHashMap.hpp"
+#include "Fyrion/Core/JobSystem.hpp"
+#include "Fyrion/Core/Registry.hpp"
+
+namespace Fyrion
+{
+    namespace
+    {
+        struct UpdatePool
+        {
+            const ComponentUpdate* componentUpdate{};
+            Array<VoidPtr>         instances{};  //already cast to the component type
+            Array<Component*>      components{}; //same index as instances
+        };
+
+        Array<UpdatePool>              pools{};
+        FlatHashMap<TypeHandler*, u32> poolIndices{};
+        Array<Array<u32>>              stages{};
+        bool                           stagesDirty = false;
+        bool                           updating = false;
+        f64                            currentDeltaTime = 0;
+
+        bool Contains(const Array<TypeID>& types, TypeID typeId)
+        {
+            for (TypeID type : types)
+            {
+                if (type == typeId)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool HasConflict(const ComponentUpdate& left, const ComponentUpdate& right)
+        {
+            for (TypeID type : left.writes)
+            {
+                if (Contains(right.reads, type) || Contains(right.writes, type))
+                {
+                    return true;
+                }
+            }
+
+            for (TypeID type : right.writes)
+            {
+                if (Contains(left.reads, type))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        //conflicting types run in the order their pools were created, each one goes to the stage after its last conflict.
+        void BuildStages()
+        {
+            stages.Clear();
+
+            Array<u32> poolStages(pools.Size(), 0u);
+            for (u32 i = 0; i < pools.Size(); ++i)
+            {
+                for (u32 j = 0; j < i; ++j)
+                {
+                    if (poolStages[j] >= poolStages[i] && HasConflict(*pools[i].componentUpdate, *pools[j].componentUpdate))
+                    {
+                        poolStages[i] = poolStages[j] + 1;
+                    }
+                }
+
+                if (poolStages[i] >= stages.Size())
+                {
+                    stages.Resize(poolStages[i] + 1);
+                }
+                stages[poolStages[i]].EmplaceBack(i);
+            }
+
+            stagesDirty = false;
+        }
+
+        void UpdatePoolJob(VoidPtr userData)
+        {
+            UpdatePool& pool = *static_cast<UpdatePool*>(userData);
+            pool.componentUpdate->update(pool.instances.Data(), pool.instances.Size(), currentDeltaTime);
+        }
+    }
+
+    void ComponentScheduler::AddComponent(Component* component)
+    {
+        if (component->updateIndex != U32_MAX)
+        {
+            return;
+        }
+
+        const ComponentUpdate* componentUpdate = component->typeHandler->GetAttribute<ComponentUpdate>();
+        if (componentUpdate == nullptr)
+        {
+            return;
+        }
+
+        FY_ASSERT(!updating, "components can't be added during the update");
+
+        auto it = poolIndices.Find(component->typeHandler);
+        if (it == poolIndices.end())
+        {
+            it = poolIndices.Insert(component->typeHandler, static_cast<u32>(pools.Size())).first;
+            pools.EmplaceBack(UpdatePool{.componentUpdate = componentUpdate});
+            stagesDirty = true;
+        }
+
+        UpdatePool& pool = pools[it->second];
+        component->updateIndex = static_cast<u32>(pool.components.Size());
+        pool.instances.EmplaceBack(componentUpdate->cast(component));
+        pool.components.EmplaceBack(component);
+    }
+
+    void ComponentScheduler::RemoveComponent(Component* component)
+    {
+        if (component->updateIndex == U32_MAX)
+        {
+            return;
+        }
+
+        FY_ASSERT(!updating, "components can't be removed during the update");
+
+        UpdatePool& pool = pools[poolIndices.Find(component->typeHandler)->second];
+
+        const u32 index = component->updateIndex;
+        const u32 last = static_cast<u32>(pool.components.Size() - 1);
+        if (index != last)
+        {
+            pool.instances[index] = pool.instances[last];
+            pool.components[index] = pool.components[last];
+            pool.components[index]->updateIndex = index;
+        }
+
+        pool.instances.PopBack();
+        pool.components.PopBack();
+        component->updateIndex = U32_MAX;
+    }
+
+    void ComponentScheduler::Update(f64 deltaTime)
+    {
+        if (stagesDirty)
+        {
+            BuildStages();
+        }
+
+        updating = true;
+        currentDeltaTime = deltaTime;
+
+        Array<JobDecl> jobs{};
+        for (const Array<u32>& stage : stages)
+        {
+            jobs.Clear();
+            for (u32 poolIndex : stage)
+            {
+                if (!pools[poolIndex].instances.Empty())
+                {
+                    jobs.EmplaceBack(JobDecl{
+                        .function = UpdatePoolJob,
+                        .userData = &pools[poolIndex]
+                    });
+                }
+            }
+
+            if (jobs.Size() == 1)
+            {
+                UpdatePoolJob(jobs[0].userData);
+            }
+            else if (!jobs.Empty())
+            {
+                JobCounter counter{};
+                JobSystem::Run(jobs, &counter);
+                JobSystem::Wait(counter);
+            }
+        }
+
+        updating = false;
+    }
+
+    usize ComponentScheduler::GetStageCount()
+    {
+        if (stagesDirty)
+        {
+            BuildStages();
+        }
+        return stages.Size();
+    }
+
+    void ComponentScheduler::Clear()
+    {
+        for (UpdatePool& pool : pools)
+        {
+            for (Component* component : pool.components)
+            {
+                component->updateIndex = U32_MAX;
+            }
+        }
+
+        pools.Clear();
+        poolIndices.Clear();
+        stages.Clear();
+        stagesDirty = false;
+    }
+}
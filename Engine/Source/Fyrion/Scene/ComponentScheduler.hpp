@@ -0,0 +1,62 @@
+#pragma once
+
+#include "Component.hpp"
+#include "Fyrion/Core/Array.hpp"
+#include "Fyrion/Core/Span.hpp"
+
+namespace Fyrion
+{
+    //type attribute, the active components of the type get one batched T::Update(Span<T*>, f64) call per frame.
+    //types are updated in parallel when neither of them writes a type the other one reads or writes.
+    struct ComponentUpdate
+    {
+        typedef void (*FnUpdate)(VoidPtr* instances, usize count, f64 deltaTime);
+        typedef VoidPtr (*FnCast)(Component* component);
+
+        FnUpdate      update{};
+        FnCast        cast{};
+        Array<TypeID> reads{};
+        Array<TypeID> writes{}; //the type always writes itself
+
+        template <typename T>
+        static ComponentUpdate Of()
+        {
+            ComponentUpdate componentUpdate{};
+            componentUpdate.update = [](VoidPtr* instances, usize count, f64 deltaTime)
+            {
+                T::Update(Span<T*>{reinterpret_cast<T**>(instances), count}, deltaTime);
+            };
+            componentUpdate.cast = [](Component* component) -> VoidPtr
+            {
+                return static_cast<T*>(component);
+            };
+            componentUpdate.writes.EmplaceBack(GetTypeID<T>());
+            return componentUpdate;
+        }
+
+        template <typename... Types>
+        ComponentUpdate& Reads()
+        {
+            (reads.EmplaceBack(GetTypeID<Types>()), ...);
+            return *this;
+        }
+
+        template <typename... Types>
+        ComponentUpdate& Writes()
+        {
+            (writes.EmplaceBack(GetTypeID<Types>()), ...);
+            return *this;
+        }
+    };
+}
+
+//components are added when their object is activated and removed when it's deactivated.
+//update functions must not add or remove components, destroying objects is deferred by the SceneManager.
+namespace Fyrion::ComponentScheduler
+{
+    FY_API void  AddComponent(Component* component);
+    FY_API void  RemoveComponent(Component* component);
+    FY_API void  Update(f64 deltaTime);
+    FY_API usize GetStageCount();
+    FY_API void  Clear();
+}
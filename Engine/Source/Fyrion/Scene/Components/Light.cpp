@@ -30,25 +30,36 @@ namespace Fyrion
             }
             case SceneNotifications_OnDeactivated:
             {
-                switch (type)
-                {
-                    case LightType::Directional:
-                    {
-                        RenderStorage::RemoveDirectionalLight(reinterpret_cast<usize>(this));
-                        break;
-                    }
-                    case LightType::Point:
-                        break;
-                    case LightType::Spot:
-                        break;
-                    case LightType::Area:
-                        break;
-                }
+                RemoveLight(registeredType);
                 break;
             }
         }
     }
 
+    void Light::RemoveLight(LightType lightType)
+    {
+        switch (lightType)
+        {
+            case LightType::Directional:
+            {
+                RenderStorage::RemoveDirectionalLight(reinterpret_cast<usize>(this));
+                break;
+            }
+            case LightType::Point:
+            {
+                RenderStorage::RemovePointLight(reinterpret_cast<usize>(this));
+                break;
+            }
+            case LightType::Spot:
+            {
+                RenderStorage::RemoveSpotLight(reinterpret_cast<usize>(this));
+                break;
+            }
+            case LightType::Area:
+                break;
+        }
+    }
+
     LightType Light::GetType() const
     {
         return type;
@@ -93,10 +104,51 @@ namespace Fyrion
         OnChange();
     }
 
+    f32 Light::GetRange() const
+    {
+        return range;
+    }
+
+    void Light::SetRange(const f32 range)
+    {
+        this->range = range;
+        OnChange();
+    }
+
+    f32 Light::GetInnerConeAngle() const
+    {
+        return innerConeAngle;
+    }
+
+    void Light::SetInnerConeAngle(const f32 innerConeAngle)
+    {
+        this->innerConeAngle = innerConeAngle;
+        OnChange();
+    }
+
+    f32 Light::GetOuterConeAngle() const
+    {
+        return outerConeAngle;
+    }
+
+    void Light::SetOuterConeAngle(const f32 outerConeAngle)
+    {
+        this->outerConeAngle = outerConeAngle;
+        OnChange();
+    }
+
     void Light::OnChange()
     {
         if (object->IsActivated() && transformComponent)
         {
+            if (registeredType != type)
+            {
+                RemoveLight(registeredType);
+                registeredType = type;
+            }
+
+            const Mat4 worldTransform = transformComponent->GetWorldTransform();
+
             switch (type)
             {
                 case LightType::Directional:
@@ -111,9 +163,29 @@ namespace Fyrion
                     break;
                 }
                 case LightType::Point:
+                {
+                    RenderStorage::AddPointLight(reinterpret_cast<usize>(this), PointLight{
+                                                     .position = Math::MakeVec3(worldTransform[3]),
+                                                     .color = this->color,
+                                                     .intensity = this->intensity,
+                                                     .range = this->range
+                                                 });
                     break;
+                }
                 case LightType::Spot:
+                {
+                    const f32 outerAngle = Math::Radians(Math::Clamp(outerConeAngle, 0.0f, 89.0f));
+                    RenderStorage::AddSpotLight(reinterpret_cast<usize>(this), SpotLight{
+                                                    .position = Math::MakeVec3(worldTransform[3]),
+                                                    .direction = -Math::Normalize(Math::MakeVec3(worldTransform[1])),
+                                                    .color = this->color,
+                                                    .intensity = this->intensity,
+                                                    .range = this->range,
+                                                    .innerAngle = Math::Min(Math::Radians(innerConeAngle), outerAngle),
+                                                    .outerAngle = outerAngle
+                                                });
                     break;
+                }
                 case LightType::Area:
                     break;
             }
@@ -127,5 +199,8 @@ namespace Fyrion
         type.Field<&Light::intensity>("intensity").Attribute<UIProperty>();
         type.Field<&Light::indirectMultipler>("indirectMultipler").Attribute<UIProperty>();
         type.Field<&Light::castShadows>("castShadows").Attribute<UIProperty>();
+        type.Field<&Light::range>("range").Attribute<UIProperty>();
+        type.Field<&Light::innerConeAngle>("innerConeAngle").Attribute<UIProperty>();
+        type.Field<&Light::outerConeAngle>("outerConeAngle").Attribute<UIProperty>();
     }
 }
@@ -20,6 +20,12 @@ namespace Fyrion
         void      SetIndirectMultipler(f32 indirectMultipler);
         bool      IsCastShadows() const;
         void      SetCastShadows(bool castShadows);
+        f32       GetRange() const;
+        void      SetRange(f32 range);
+        f32       GetInnerConeAngle() const;
+        void      SetInnerConeAngle(f32 innerConeAngle);
+        f32       GetOuterConeAngle() const;
+        void      SetOuterConeAngle(f32 outerConeAngle);
 
 
         void OnNotify(const NotificationEvent& notificationEvent) override;
@@ -34,7 +40,13 @@ namespace Fyrion
         f32       intensity = 2.0;
         f32       indirectMultipler = 1.0;
         bool      castShadows = false;
+        f32       range = 10.0;
+        f32       innerConeAngle = 30.0; //degrees
+        f32       outerConeAngle = 45.0; //degrees
 
+        LightType           registeredType = LightType::Directional;
         TransformComponent* transformComponent = nullptr;
+
+        void RemoveLight(LightType lightType);
     };
 }
@@ -15,9 +15,15 @@ namespace Fyrion
 {
     MeshRender::~MeshRender()
     {
-        if (object && object->IsActivated())
+        RemoveFromRender();
+    }
+
+    void MeshRender::RemoveFromRender()
+    {
+        if (renderHandle)
         {
-            RenderStorage::RemoveMeshFromRender(reinterpret_cast<usize>(this));
+            RenderStorage::RemoveMeshFromRender(renderHandle);
+            renderHandle = {};
         }
     }
 
@@ -40,7 +46,7 @@ namespace Fyrion
 
             case SceneNotifications_OnDeactivated:
             {
-                RenderStorage::RemoveMeshFromRender(reinterpret_cast<usize>(this));
+                RemoveFromRender();
                 break;
             }
 
@@ -51,12 +57,13 @@ namespace Fyrion
                     transformComponent = nullptr;
                     OnChange();
                 }
+                break;
             }
 
             case SceneNotifications_TransformChanged:
             {
                 transformComponent = static_cast<TransformComponent*>(notificationEvent.component);
-                if (transformComponent && mesh)
+                if (!RenderStorage::UpdateMeshTransform(renderHandle, transformComponent->GetWorldTransform()) && mesh)
                 {
                     OnChange();
                 }
@@ -86,11 +93,14 @@ namespace Fyrion
 
             if (transformComponent != nullptr && mesh != nullptr)
             {
-                RenderStorage::AddOrUpdateMeshToRender(reinterpret_cast<usize>(this), transformComponent->GetWorldTransform(), mesh, materials);
+                if (!RenderStorage::UpdateMeshToRender(renderHandle, transformComponent->GetWorldTransform(), mesh, materials))
+                {
+                    renderHandle = RenderStorage::AddMeshToRender(transformComponent->GetWorldTransform(), mesh, materials);
+                }
             }
             else
             {
-                RenderStorage::RemoveMeshFromRender(reinterpret_cast<usize>(this));
+                RemoveFromRender();
             }
         }
     }
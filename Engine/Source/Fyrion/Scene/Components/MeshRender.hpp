@@ -1,4 +1,5 @@
 #pragma once
+#include "Fyrion/Graphics/GraphicsTypes.hpp"
 #include "Fyrion/Graphics/Assets/MaterialAsset.hpp"
 #include "Fyrion/Scene/Component.hpp"
 
@@ -28,5 +29,8 @@ namespace Fyrion
         TransformComponent*   transformComponent = nullptr;
         Array<MaterialAsset*> materials = {};
         MeshAsset*            activeMesh = nullptr;
+        MeshRenderHandle      renderHandle{};
+
+        void RemoveFromRender();
     };
 }
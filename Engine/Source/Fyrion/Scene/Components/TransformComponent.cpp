@@ -3,26 +3,141 @@
 #include <Fyrion/Scene/SceneTypes.hpp>
 
 #include "Fyrion/Core/Attributes.hpp"
+#include "Fyrion/Core/JobSystem.hpp"
 #include "Fyrion/Core/Registry.hpp"
 #include "Fyrion/Scene/SceneObject.hpp"
 
 namespace Fyrion
 {
+    namespace
+    {
+        constexpr u32   NoParent = U32_MAX;
+        constexpr usize TransformBatchSize = 256;
+
+        //transforms of all activated components, stored as SoA and sorted by hierarchy depth,
+        //so parents are always resolved before their children.
+        //entries of depth N are in the range [levels[N], levels[N + 1]).
+        struct TransformStorage
+        {
+            Array<Vec3>                positions{};
+            Array<Quat>                rotations{};
+            Array<Vec3>                scales{};
+            Array<Mat4>                worldTransforms{};
+            Array<u32>                 parents{};
+            Array<u8>                  dirty{};
+            Array<TransformComponent*> components{};
+            Array<TransformComponent*> parentComponents{};
+            Array<u32>                 levels{};
+            bool                       hierarchyDirty = false;
+        };
+
+        TransformStorage           storage{};
+        Array<TransformComponent*> changedComponents{};
+
+        FY_FINLINE Mat4 ComposeTransform(const Vec3& position, const Quat& rotation, const Vec3& scale)
+        {
+            Mat4 result = Math::ToMatrix4(rotation);
+            result[0] = result[0] * scale.x;
+            result[1] = result[1] * scale.y;
+            result[2] = result[2] * scale.z;
+            result[3] = Vec4{position, 1.0f};
+            return result;
+        }
+
+        //both matrices are affine, so the last row of local is always (0, 0, 0, 1).
+        FY_FINLINE Mat4 MultiplyAffine(const Mat4& parent, const Mat4& local)
+        {
+            Mat4 result;
+            for (u32 c = 0; c < 4; ++c)
+            {
+                result[c] = parent[0] * local[c][0] + parent[1] * local[c][1] + parent[2] * local[c][2];
+            }
+            result[3] = result[3] + parent[3];
+            return result;
+        }
+
+        void UpdateTransform(usize index)
+        {
+            const u32 parent = storage.parents[index];
+            if (parent != NoParent && storage.dirty[parent])
+            {
+                storage.dirty[index] = 1;
+            }
+
+            if (storage.dirty[index])
+            {
+                Mat4 local = ComposeTransform(storage.positions[index], storage.rotations[index], storage.scales[index]);
+                storage.worldTransforms[index] = parent != NoParent ? MultiplyAffine(storage.worldTransforms[parent], local) : local;
+            }
+        }
+
+        bool IsTransformDirty(u32 index)
+        {
+            for (u32 i = index; i != NoParent; i = storage.parents[i])
+            {
+                if (storage.dirty[i])
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        //transforms changed after the last UpdateTransforms are resolved on read, without touching the storage.
+        Mat4 ResolveWorldTransform(u32 index)
+        {
+            if (!IsTransformDirty(index))
+            {
+                return storage.worldTransforms[index];
+            }
+
+            const u32 parent = storage.parents[index];
+            Mat4      local = ComposeTransform(storage.positions[index], storage.rotations[index], storage.scales[index]);
+            return parent != NoParent ? MultiplyAffine(ResolveWorldTransform(parent), local) : local;
+        }
+    }
+
+    TransformComponent::~TransformComponent()
+    {
+        RemoveFromStorage();
+    }
+
+    Mat4 TransformComponent::GetWorldTransform() const
+    {
+        //storage parents are only valid after the hierarchy is rebuilt
+        if (storageIndex != U32_MAX && !storage.hierarchyDirty)
+        {
+            return ResolveWorldTransform(storageIndex);
+        }
+
+        if (object != nullptr && object->GetParent() != nullptr)
+        {
+            if (TransformComponent* parentTransform = object->GetParent()->GetComponent<TransformComponent>())
+            {
+                return parentTransform->GetWorldTransform() * GetLocalTransform();
+            }
+        }
+        return GetLocalTransform();
+    }
+
     void TransformComponent::OnNotify(const NotificationEvent& notificationEvent)
     {
         switch (notificationEvent.type)
         {
             case SceneNotifications_OnActivated:
             {
-                this->OnChange();
+                AddToStorage();
                 break;
             }
-            case SceneNotifications_ParentTransformChanged:
+            case SceneNotifications_OnDeactivated:
             {
-                worldTransform = static_cast<TransformComponent*>(notificationEvent.component)->GetWorldTransform() * GetLocalTransform();
-
-                object->NotifyComponents(NotificationEvent{.type = SceneNotifications_TransformChanged, .component = this});
-                object->NotifyChildren(NotificationEvent{.type = SceneNotifications_ParentTransformChanged, .component = this});
+                RemoveFromStorage();
+                break;
+            }
+            case SceneNotifications_ParentChanged:
+            {
+                storage.hierarchyDirty = true;
+                OnChange();
                 break;
             }
             default:
@@ -32,17 +147,202 @@ namespace Fyrion
 
     void TransformComponent::OnChange()
     {
-        if (TransformComponent* parentTransform = object->GetParent() != nullptr ? object->GetParent()->GetComponent<TransformComponent>() : nullptr)
+        if (storageIndex != U32_MAX)
         {
-            worldTransform = parentTransform->GetWorldTransform() * GetLocalTransform();
+            storage.positions[storageIndex] = position;
+            storage.rotations[storageIndex] = rotation;
+            storage.scales[storageIndex] = scale;
+            storage.dirty[storageIndex] = 1;
         }
-        else
+    }
+
+    void TransformComponent::AddToStorage()
+    {
+        if (storageIndex != U32_MAX)
         {
-            worldTransform = GetLocalTransform();
+            return;
         }
 
-        object->NotifyComponents(NotificationEvent{.type = SceneNotifications_TransformChanged, .component = this});
-        object->NotifyChildren(NotificationEvent{.type = SceneNotifications_ParentTransformChanged, .component = this});
+        storageIndex = static_cast<u32>(storage.components.Size());
+
+        storage.positions.EmplaceBack(position);
+        storage.rotations.EmplaceBack(rotation);
+        storage.scales.EmplaceBack(scale);
+        storage.worldTransforms.EmplaceBack(Mat4{1.0});
+        storage.parents.EmplaceBack(NoParent);
+        storage.dirty.EmplaceBack(1);
+        storage.components.EmplaceBack(this);
+        storage.parentComponents.EmplaceBack(nullptr);
+        storage.hierarchyDirty = true;
+    }
+
+    void TransformComponent::RemoveFromStorage()
+    {
+        if (storageIndex == U32_MAX)
+        {
+            return;
+        }
+
+        const u32 last = static_cast<u32>(storage.components.Size() - 1);
+        if (storageIndex != last)
+        {
+            storage.positions[storageIndex] = storage.positions[last];
+            storage.rotations[storageIndex] = storage.rotations[last];
+            storage.scales[storageIndex] = storage.scales[last];
+            storage.worldTransforms[storageIndex] = storage.worldTransforms[last];
+            storage.parents[storageIndex] = storage.parents[last];
+            storage.dirty[storageIndex] = storage.dirty[last];
+            storage.components[storageIndex] = storage.components[last];
+            storage.components[storageIndex]->storageIndex = storageIndex;
+            storage.parentComponents[storageIndex] = storage.parentComponents[last];
+        }
+
+        storage.positions.PopBack();
+        storage.rotations.PopBack();
+        storage.scales.PopBack();
+        storage.worldTransforms.PopBack();
+        storage.parents.PopBack();
+        storage.dirty.PopBack();
+        storage.components.PopBack();
+        storage.parentComponents.PopBack();
+
+        //the swap breaks the depth order and parent indices, they are resolved again on the next update.
+        storage.hierarchyDirty = true;
+        storageIndex = U32_MAX;
+    }
+
+    void TransformComponent::RebuildStorage()
+    {
+        const usize count = storage.components.Size();
+
+        Array<u32> parents(count, NoParent);
+        for (usize i = 0; i < count; ++i)
+        {
+            for (SceneObject* ancestor = storage.components[i]->object->GetParent(); ancestor != nullptr; ancestor = ancestor->GetParent())
+            {
+                TransformComponent* parentTransform = ancestor->GetComponent<TransformComponent>();
+                if (parentTransform && parentTransform->storageIndex != U32_MAX)
+                {
+                    parents[i] = parentTransform->storageIndex;
+                    break;
+                }
+            }
+        }
+
+        Array<u32> depths(count, NoParent);
+        Array<u32> path{};
+        u32        levelCount = 0;
+
+        for (usize i = 0; i < count; ++i)
+        {
+            u32 current = static_cast<u32>(i);
+            while (current != NoParent && depths[current] == NoParent)
+            {
+                path.EmplaceBack(current);
+                current = parents[current];
+            }
+
+            u32 depth = current != NoParent ? depths[current] + 1 : 0;
+            while (!path.Empty())
+            {
+                depths[path.Back()] = depth++;
+                path.PopBack();
+            }
+            levelCount = Math::Max(levelCount, depth);
+        }
+
+        //counting sort by depth
+        storage.levels.Clear();
+        storage.levels.Resize(levelCount + 1, 0);
+        for (usize i = 0; i < count; ++i)
+        {
+            storage.levels[depths[i] + 1]++;
+        }
+
+        for (usize l = 1; l < storage.levels.Size(); ++l)
+        {
+            storage.levels[l] += storage.levels[l - 1];
+        }
+
+        Array<u32> remap(count);
+        {
+            Array<u32> cursor(storage.levels);
+            for (usize i = 0; i < count; ++i)
+            {
+                remap[i] = cursor[depths[i]]++;
+            }
+        }
+
+        TransformStorage sorted{};
+        sorted.positions.Resize(count);
+        sorted.rotations.Resize(count);
+        sorted.scales.Resize(count);
+        sorted.worldTransforms.Resize(count);
+        sorted.parents.Resize(count);
+        sorted.dirty.Resize(count);
+        sorted.components.Resize(count);
+        sorted.parentComponents.Resize(count);
+
+        for (usize i = 0; i < count; ++i)
+        {
+            const u32           index = remap[i];
+            TransformComponent* parent = parents[i] != NoParent ? storage.components[parents[i]] : nullptr;
+
+            sorted.positions[index] = storage.positions[i];
+            sorted.rotations[index] = storage.rotations[i];
+            sorted.scales[index] = storage.scales[i];
+            sorted.worldTransforms[index] = storage.worldTransforms[i];
+            sorted.parents[index] = parents[i] != NoParent ? remap[parents[i]] : NoParent;
+            //entries that got a new parent need a new world transform even if their local one didn't change.
+            sorted.dirty[index] = storage.dirty[i] || storage.parentComponents[i] != parent;
+            sorted.components[index] = storage.components[i];
+            sorted.parentComponents[index] = parent;
+            sorted.components[index]->storageIndex = index;
+        }
+
+        storage.positions.Swap(sorted.positions);
+        storage.rotations.Swap(sorted.rotations);
+        storage.scales.Swap(sorted.scales);
+        storage.worldTransforms.Swap(sorted.worldTransforms);
+        storage.parents.Swap(sorted.parents);
+        storage.dirty.Swap(sorted.dirty);
+        storage.components.Swap(sorted.components);
+        storage.parentComponents.Swap(sorted.parentComponents);
+        storage.hierarchyDirty = false;
+    }
+
+    void TransformComponent::UpdateTransforms()
+    {
+        if (storage.hierarchyDirty)
+        {
+            RebuildStorage();
+        }
+
+        //each level only reads world transforms from the previous ones, so the entries of a level can be updated in parallel.
+        for (usize l = 0; l + 1 < storage.levels.Size(); ++l)
+        {
+            const usize begin = storage.levels[l];
+            JobSystem::ParallelFor(storage.levels[l + 1] - begin, [begin](usize i)
+            {
+                UpdateTransform(begin + i);
+            }, TransformBatchSize);
+        }
+
+        changedComponents.Clear();
+        for (usize i = 0; i < storage.components.Size(); ++i)
+        {
+            if (storage.dirty[i])
+            {
+                storage.dirty[i] = 0;
+                changedComponents.EmplaceBack(storage.components[i]);
+            }
+        }
+
+        //notifications are sent after the pass, listeners can change transforms again for the next frame.
+        for (TransformComponent* component : changedComponents)
+        {
+            component->object->NotifyComponents(NotificationEvent{.type = SceneNotifications_TransformChanged, .component = component});
+        }
     }
 
     void TransformComponent::RegisterType(NativeTypeHandler<TransformComponent>& type)
@@ -11,6 +11,8 @@ namespace Fyrion
     public:
         FY_BASE_TYPES(Component);
 
+        ~TransformComponent() override;
+
         FY_FINLINE void SetPosition(const Vec3& p_position)
         {
             position = p_position;
@@ -57,11 +59,6 @@ namespace Fyrion
             return scale;
         }
 
-        FY_FINLINE const Mat4& GetWorldTransform() const
-        {
-            return worldTransform;
-        }
-
         FY_FINLINE Mat4 GetLocalTransform() const
         {
             return Math::Translate(Mat4{1.0}, position) * Math::ToMatrix4(rotation) * Math::Scale(Mat4{1.0}, scale);
@@ -72,9 +69,14 @@ namespace Fyrion
             return {position, rotation, scale};
         }
 
+        Mat4 GetWorldTransform() const;
+
         void OnNotify(const NotificationEvent& notificationEvent) override;
         void OnChange() override;
 
+        //world transforms are resolved in a single batched pass, called once per frame by the SceneManager.
+        static void UpdateTransforms();
+
         static void RegisterType(NativeTypeHandler<TransformComponent>& type);
 
     private:
@@ -82,6 +84,11 @@ namespace Fyrion
         Quat rotation{0, 0, 0, 1};
         Vec3 scale{1, 1, 1};
 
-        Mat4 worldTransform{1.0};
+        u32 storageIndex = U32_MAX;
+
+        void AddToStorage();
+        void RemoveFromStorage();
+
+        static void RebuildStorage();
     };
 }
@@ -2,8 +2,10 @@
 
 #include <queue>
 
+#include "ComponentScheduler.hpp"
 #include "SceneObject.hpp"
 #include "Assets/SceneObjectAsset.hpp"
+#include "Components/TransformComponent.hpp"
 #include "Fyrion/Engine.hpp"
 #include "Fyrion/Core/Allocator.hpp"
 
@@ -36,8 +38,11 @@ namespace Fyrion
 
             if (activeSceneObject)
             {
-                //DO UPDATE.
+                ComponentScheduler::Update(deltaTime);
             }
+
+            //after the components, transforms changed by the update are resolved in the same frame
+            TransformComponent::UpdateTransforms();
         }
     }
 
@@ -84,5 +89,6 @@ namespace Fyrion
     void SceneManagerShutdown()
     {
         activeSceneObject = nullptr;
+        ComponentScheduler::Clear();
     }
 }
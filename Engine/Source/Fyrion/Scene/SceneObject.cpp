@@ -1,5 +1,6 @@
 #include "SceneObject.hpp"
 
+#include "ComponentScheduler.hpp"
 #include "SceneManager.hpp"
 #include "Assets/SceneObjectAsset.hpp"
 #include "Fyrion/Core/Registry.hpp"
@@ -18,6 +19,12 @@ namespace Fyrion
         {
             MemoryGlobals::GetDefaultAllocator().DestroyAndFree(child);
         }
+
+        for (Component* component : components)
+        {
+            ComponentScheduler::RemoveComponent(component);
+            component->typeHandler->Destroy(component);
+        }
     }
 
     Component& SceneObject::CreateComponent(TypeID typeId)
@@ -45,6 +52,8 @@ namespace Fyrion
 
         if (active)
         {
+            ComponentScheduler::AddComponent(component);
+
             component->OnNotify(NotificationEvent{
                 .type = SceneNotifications_OnActivated,
             });
@@ -63,6 +72,7 @@ namespace Fyrion
         Component*   component = typeHandler->Cast<Component>(typeHandler->NewInstance());
         typeHandler->DeepCopy(originComponent, component);
         component->typeHandler = typeHandler;
+        component->updateIndex = U32_MAX;
         AddComponent(component);
         return *component;
     }
@@ -74,6 +84,8 @@ namespace Fyrion
         {
             if (active)
             {
+                ComponentScheduler::RemoveComponent(component);
+
                 component->OnNotify(NotificationEvent{
                     .type = SceneNotifications_OnDeactivated,
                 });
@@ -232,6 +244,9 @@ namespace Fyrion
         sceneObject->parent = this;
         sceneObject->SetActive(active);
         children.EmplaceBack(sceneObject);
+        sceneObject->NotifyComponents(NotificationEvent{
+            .type = SceneNotifications_ParentChanged,
+        });
     }
 
     void SceneObject::AddChildAt(SceneObject* sceneObject, usize pos)
@@ -239,6 +254,9 @@ namespace Fyrion
         sceneObject->parent = this;
         sceneObject->SetActive(active);
         children.Insert(children.begin() + pos, &sceneObject, &sceneObject + 1);
+        sceneObject->NotifyComponents(NotificationEvent{
+            .type = SceneNotifications_ParentChanged,
+        });
     }
 
     void SceneObject::RemoveChild(SceneObject* sceneObject)
@@ -418,12 +436,22 @@ namespace Fyrion
                 .type = SceneNotifications_OnDeactivated,
             });
 
+            for (Component* component : components)
+            {
+                ComponentScheduler::RemoveComponent(component);
+            }
+
             active = false;
         }
         else if (p_active && !active)
         {
             active = true;
 
+            for (Component* component : components)
+            {
+                ComponentScheduler::AddComponent(component);
+            }
+
             this->NotifyComponents(NotificationEvent{
                 .type = SceneNotifications_OnActivated,
             });
@@ -548,7 +576,9 @@ namespace Fyrion
 
         if (Component* originalValue = prototype->FindComponentByUUID(component->GetPrototype()))
         {
+            const u32 updateIndex = component->updateIndex;
             component->typeHandler->DeepCopy(originalValue, component);
+            component->updateIndex = updateIndex;
             component->OnChange();
         }
     }
@@ -15,8 +15,8 @@ namespace Fyrion
         SceneNotifications_OnComponentAdded   = 1020,
         SceneNotifications_OnComponentRemoved = 1030,
 
-        SceneNotifications_TransformChanged       = 2000,
-        SceneNotifications_ParentTransformChanged = 2010
+        SceneNotifications_TransformChanged = 2000,
+        SceneNotifications_ParentChanged    = 2010
     };
 
     struct SceneObjectAssetProvider
@@ -0,0 +1,161 @@
+#include <doctest.h>
+
+#include "Fyrion/Engine.hpp"
+#include "Fyrion/Asset/AssetHandler.hpp"
+#include "Fyrion/Asset/AssetManager.hpp"
+#include "Fyrion/Asset/AssetPackage.hpp"
+#include "Fyrion/Asset/AssetTypes.hpp"
+#include "Fyrion/IO/FileSystem.hpp"
+#include "Fyrion/IO/Path.hpp"
+
+using namespace Fyrion;
+
+namespace
+{
+    TEST_CASE("Asset::Package")
+    {
+        String testDir = Path::Join(FY_TEST_FILES, "AssetPackageTest");
+        String assetsDir = Path::Join(testDir, "Assets");
+        String pakFile = Path::Join(testDir, "Test.pak");
+        String binFile = Path::Join(testDir, "Test.bin");
+
+        FileSystem::Remove(testDir);
+        REQUIRE(FileSystem::CreateDirectory(assetsDir));
+
+        Engine::Init();
+        {
+            DirectoryAssetHandler* directory = AssetManager::LoadFromDirectory("PackageTest", assetsDir);
+            REQUIRE(directory);
+
+            DirectoryAssetHandler* fontDirectory = AssetManager::CreateDirectory(directory, "Fonts");
+
+            Array<u8> bytes{};
+            for (u32 i = 0; i < 1000; ++i)
+            {
+                bytes.EmplaceBack(static_cast<u8>(i % 255));
+            }
+
+            UUID fontUUID{};
+            {
+                UIFontAsset* fontAsset = AssetManager::Create<UIFontAsset>(AssetCreation{
+                    .name = "Font",
+                    .directoryAsset = fontDirectory
+                });
+                REQUIRE(fontAsset);
+                fontAsset->SaveBuffer(fontAsset->fontBytes, bytes.Data(), bytes.Size());
+                fontAsset->GetHandler()->Save();
+                fontUUID = fontAsset->GetHandler()->GetUUID();
+
+                AssetBufferView view = fontAsset->MapBuffer(fontAsset->fontBytes);
+                REQUIRE(view.Size() == bytes.Size());
+                CHECK(view.Data()[999] == bytes[999]);
+
+                //saving replaces the file, views of the previous one keep their content
+                Array<u8> newBytes(500, 7);
+                fontAsset->SaveBuffer(fontAsset->fontBytes, newBytes.Data(), newBytes.Size());
+                CHECK(view.Data()[999] == bytes[999]);
+                CHECK(fontAsset->MapBuffer(fontAsset->fontBytes).Size() == newBytes.Size());
+                fontAsset->SaveBuffer(fontAsset->fontBytes, bytes.Data(), bytes.Size());
+            }
+
+            CHECK(AssetManager::SaveToPackage(directory, pakFile, binFile));
+
+            DirectoryAssetHandler* package = AssetManager::LoadFromPackage("Packaged", pakFile, binFile);
+            REQUIRE(package);
+            REQUIRE(package->GetChildren().Size() == 1);
+            CHECK(package->GetChildren()[0]->GetName() == "Fonts");
+
+            AssetHandler* handler = AssetManager::FindHandlerByPath("Packaged://Fonts/Font.fy_asset");
+            REQUIRE(handler);
+            CHECK(dynamic_cast<PackageAssetHandler*>(handler) != nullptr);
+            CHECK(handler->GetUUID() == fontUUID);
+
+            UIFontAsset* fontAsset = handler->LoadInstance()->Cast<UIFontAsset>();
+            REQUIRE(fontAsset);
+            CHECK(fontAsset->fontBytes);
+            CHECK(fontAsset->HasBuffer(fontAsset->fontBytes));
+            CHECK(!fontAsset->HasBuffer(AssetBuffer{fontAsset->fontBytes.id + 1}));
+
+            Array<u8> loaded = fontAsset->GetFont();
+            REQUIRE(loaded.Size() == bytes.Size());
+
+            bool equals = true;
+            for (usize i = 0; i < bytes.Size(); ++i)
+            {
+                if (loaded[i] != bytes[i])
+                {
+                    equals = false;
+                }
+            }
+            CHECK(equals);
+
+            AssetBufferView view = fontAsset->MapBuffer(fontAsset->fontBytes);
+            REQUIRE(view.Size() == bytes.Size());
+
+            AssetBufferView viewCopy = view;
+            view = {};
+            CHECK(!view);
+            CHECK(viewCopy);
+
+            for (usize i = 0; i < bytes.Size(); ++i)
+            {
+                if (viewCopy.Data()[i] != bytes[i])
+                {
+                    equals = false;
+                }
+            }
+            CHECK(equals);
+
+            CHECK(AssetManager::LoadFromPackage("Invalid", binFile, pakFile) == nullptr);
+
+            //buffers outside of the bin file
+            String      truncatedBinFile = Path::Join(testDir, "Truncated.bin");
+            FileHandler truncated = FileSystem::OpenFile(truncatedBinFile, AccessMode::WriteOnly);
+            FileSystem::WriteFile(truncated, bytes.Data(), 100);
+            FileSystem::CloseFile(truncated);
+
+            CHECK(AssetManager::LoadFromPackage("Truncated", pakFile, truncatedBinFile) == nullptr);
+
+            //corrupted tables
+            auto loadCorrupted = [&](auto corrupt) -> DirectoryAssetHandler*
+            {
+                Array<u8>                 index = FileSystem::ReadFileAsByteArray(pakFile);
+                const AssetPackageHeader& header = *reinterpret_cast<const AssetPackageHeader*>(index.Data());
+                AssetPackageEntry*        entries = reinterpret_cast<AssetPackageEntry*>(index.Data() + sizeof(AssetPackageHeader));
+
+                u32 directoryIndex = 0;
+                u32 assetIndex = 0;
+                for (u32 i = 0; i < header.entryCount; ++i)
+                {
+                    (entries[i].type == AssetPackageEntryType::Directory ? directoryIndex : assetIndex) = i;
+                }
+                corrupt(entries, directoryIndex, assetIndex);
+
+                String      corruptedPakFile = Path::Join(testDir, "Corrupted.pak");
+                FileHandler corrupted = FileSystem::OpenFile(corruptedPakFile, AccessMode::WriteOnly);
+                FileSystem::WriteFile(corrupted, index.Data(), index.Size());
+                FileSystem::CloseFile(corrupted);
+
+                return AssetManager::LoadFromPackage("Corrupted", corruptedPakFile, binFile);
+            };
+
+            CHECK(loadCorrupted([](AssetPackageEntry* entries, u32 directoryIndex, u32 assetIndex)
+            {
+                entries[assetIndex].name.offset = U32_MAX - 1;
+            }) == nullptr);
+
+            CHECK(loadCorrupted([](AssetPackageEntry* entries, u32 directoryIndex, u32 assetIndex)
+            {
+                entries[directoryIndex].parent = assetIndex;
+            }) == nullptr);
+
+            CHECK(loadCorrupted([](AssetPackageEntry* entries, u32 directoryIndex, u32 assetIndex)
+            {
+                entries[directoryIndex].parent = directoryIndex;
+            }) == nullptr);
+        }
+        Engine::Destroy();
+
+        FileSystem::Remove(testDir);
+    }
+}
@@ -0,0 +1,155 @@
+#include <doctest.h>
+
+#include "Fyrion/Engine.hpp"
+#include "Fyrion/Asset/AssetSerialization.hpp"
+#include "Fyrion/Core/Registry.hpp"
+
+using namespace Fyrion;
+
+namespace
+{
+    enum class SerializationTestEnum
+    {
+        First  = 1,
+        Second = 2
+    };
+
+    struct SerializationTestItem
+    {
+        i32 value{};
+        f32 weight{};
+
+        static void RegisterType(NativeTypeHandler<SerializationTestItem>& type)
+        {
+            type.Field<&SerializationTestItem::value>("value");
+            type.Field<&SerializationTestItem::weight>("weight");
+        }
+    };
+
+    struct SerializationTestStruct
+    {
+        u32                          uintValue{};
+        i64                          intValue{};
+        f32                          floatValue{};
+        f64                          doubleValue{};
+        bool                         boolValue{};
+        SerializationTestEnum        enumValue{};
+        SerializationTestItem        item{};
+        Array<u32>                   numbers{};
+        Array<SerializationTestItem> items{};
+
+        static void RegisterType(NativeTypeHandler<SerializationTestStruct>& type)
+        {
+            type.Field<&SerializationTestStruct::uintValue>("uintValue");
+            type.Field<&SerializationTestStruct::intValue>("intValue");
+            type.Field<&SerializationTestStruct::floatValue>("floatValue");
+            type.Field<&SerializationTestStruct::doubleValue>("doubleValue");
+            type.Field<&SerializationTestStruct::boolValue>("boolValue");
+            type.Field<&SerializationTestStruct::enumValue>("enumValue");
+            type.Field<&SerializationTestStruct::item>("item");
+            type.Field<&SerializationTestStruct::numbers>("numbers");
+            type.Field<&SerializationTestStruct::items>("items");
+        }
+    };
+
+    TEST_CASE("Asset::BinarySerialization")
+    {
+        Engine::Init();
+        {
+            auto enumType = Registry::Type<SerializationTestEnum>();
+            enumType.Value<SerializationTestEnum::First>("First");
+            enumType.Value<SerializationTestEnum::Second>("Second");
+
+            Registry::Type<SerializationTestItem>();
+            Registry::Type<SerializationTestStruct>();
+
+            TypeHandler* typeHandler = Registry::FindType<SerializationTestStruct>();
+            REQUIRE(typeHandler);
+
+            SerializationTestStruct value{};
+            value.uintValue = 300;
+            value.intValue = -123456789;
+            value.floatValue = 1.5f;
+            value.doubleValue = 0.1;
+            value.boolValue = true;
+            value.enumValue = SerializationTestEnum::Second;
+            value.item = {.value = -1, .weight = 0.25f};
+            value.numbers = {1, 200, 70000};
+            value.items = {{.value = 10, .weight = 1.0f}, {.value = 20, .weight = 2.0f}};
+
+            BinaryAssetWriter writer;
+            Array<u8> data = writer.Encode(Serialization::Serialize(typeHandler, writer, &value));
+            REQUIRE(!data.Empty());
+
+            BinaryAssetReader reader(data);
+            REQUIRE(reader.IsValid());
+
+            SerializationTestStruct loaded{};
+            Serialization::Deserialize(typeHandler, reader, reader.ReadObject(), &loaded);
+
+            CHECK(loaded.uintValue == 300);
+            CHECK(loaded.intValue == -123456789);
+            CHECK(loaded.floatValue == 1.5f);
+            CHECK(loaded.doubleValue == 0.1);
+            CHECK(loaded.boolValue);
+            CHECK(loaded.enumValue == SerializationTestEnum::Second);
+            CHECK(loaded.item.value == -1);
+            CHECK(loaded.item.weight == 0.25f);
+            REQUIRE(loaded.numbers.Size() == 3);
+            CHECK(loaded.numbers[2] == 70000);
+            REQUIRE(loaded.items.Size() == 2);
+            CHECK(loaded.items[1].value == 20);
+            CHECK(loaded.items[1].weight == 2.0f);
+
+            JsonAssetWriter jsonWriter;
+            String json = JsonAssetWriter::Stringify(Serialization::Serialize(typeHandler, jsonWriter, &value));
+            CHECK(data.Size() < json.Size());
+        }
+        Engine::Destroy();
+    }
+
+    TEST_CASE("Asset::BinarySerializationArchive")
+    {
+        BinaryAssetWriter writer;
+        ArchiveObject root = writer.CreateObject();
+        writer.WriteString(root, "name", "binary");
+        writer.WriteUInt(root, "big", U64_MAX);
+        writer.WriteInt(root, "negative", -1);
+
+        ArchiveObject array = writer.CreateArray();
+        writer.AddString(array, "a");
+        writer.AddString(array, "");
+        writer.AddBool(array, true);
+        writer.WriteValue(root, "array", array);
+        writer.WriteValue(root, "empty", {});
+
+        Array<u8> data = writer.Encode(root);
+
+        BinaryAssetReader reader(data);
+        REQUIRE(reader.IsValid());
+
+        ArchiveObject object = reader.ReadObject();
+        CHECK(reader.ReadInt(object, "negative") == -1);
+        CHECK(reader.ReadUInt(object, "big") == U64_MAX);
+        CHECK(reader.ReadString(object, "name") == "binary");
+        CHECK(reader.ReadString(object, "missing").Empty());
+        CHECK(!reader.ReadObject(object, "empty"));
+
+        ArchiveObject arr = reader.ReadObject(object, "array");
+        REQUIRE(reader.ArrSize(arr) == 3);
+
+        ArchiveObject item = reader.Next(arr, {});
+        CHECK(reader.GetString(item) == "a");
+        CHECK(reader.GetString(item).CStr()[1] == '\0');
+        item = reader.Next(arr, item);
+        CHECK(reader.GetString(item).Empty());
+        item = reader.Next(arr, item);
+        CHECK(reader.GetBool(item));
+        CHECK(!reader.Next(arr, item));
+
+        data.Resize(data.Size() - 1);
+        BinaryAssetReader truncated(data);
+        CHECK(!truncated.IsValid());
+        CHECK(!truncated.ReadObject());
+    }
+}
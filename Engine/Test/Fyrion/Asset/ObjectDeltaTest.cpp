@@ -0,0 +1,89 @@
+#include <doctest.h>
+
+#include "Fyrion/Engine.hpp"
+#include "Fyrion/Asset/ObjectDelta.hpp"
+#include "Fyrion/Core/Registry.hpp"
+
+using namespace Fyrion;
+
+namespace
+{
+    struct DeltaTestStruct
+    {
+        f32        roughness{};
+        f32        metallic{};
+        String     name{};
+        Array<u32> indices{};
+
+        static void RegisterType(NativeTypeHandler<DeltaTestStruct>& type)
+        {
+            type.Field<&DeltaTestStruct::roughness>("roughness");
+            type.Field<&DeltaTestStruct::metallic>("metallic");
+            type.Field<&DeltaTestStruct::name>("name");
+            type.Field<&DeltaTestStruct::indices>("indices");
+        }
+    };
+
+    TEST_CASE("Asset::ObjectDelta")
+    {
+        Engine::Init();
+        {
+            Registry::Type<DeltaTestStruct>();
+
+            TypeHandler* typeHandler = Registry::FindType<DeltaTestStruct>();
+            REQUIRE(typeHandler);
+
+            DeltaTestStruct oldValue{.roughness = 0.5f, .metallic = 1.0f, .name = "Material", .indices = {1, 2, 3}};
+            DeltaTestStruct newValue = oldValue;
+            newValue.roughness = 0.75f;
+
+            ObjectDelta delta(typeHandler, &oldValue, &newValue);
+            REQUIRE(delta.GetFields().Size() == 1);
+            CHECK(delta.GetFields()[0].name == "roughness");
+
+            DeltaTestStruct instance = oldValue;
+            delta.ApplyNew(&instance);
+            CHECK(instance.roughness == 0.75f);
+            CHECK(instance.name == "Material");
+            CHECK(instance.indices.Size() == 3);
+
+            delta.ApplyOld(&instance);
+            CHECK(instance.roughness == 0.5f);
+
+            CHECK(ObjectDelta(typeHandler, &oldValue, &oldValue).Empty());
+
+            SUBCASE("Merge")
+            {
+                DeltaTestStruct lastValue = newValue;
+                lastValue.roughness = 0.9f;
+                CHECK(delta.Merge(ObjectDelta(typeHandler, &newValue, &lastValue)));
+
+                delta.ApplyNew(&instance);
+                CHECK(instance.roughness == 0.9f);
+                delta.ApplyOld(&instance);
+                CHECK(instance.roughness == 0.5f);
+
+                //edits to other fields are kept as separated steps
+                lastValue.metallic = 0.0f;
+                CHECK_FALSE(delta.Merge(ObjectDelta(typeHandler, &newValue, &lastValue)));
+            }
+
+            SUBCASE("MemorySize")
+            {
+                DeltaTestStruct bigValue = oldValue;
+                bigValue.indices.Resize(10000);
+
+                //only the changed field is stored, the size doesn't depend on the other fields
+                DeltaTestStruct bigNewValue = bigValue;
+                bigNewValue.roughness = 0.1f;
+                ObjectDelta smallDelta(typeHandler, &bigValue, &bigNewValue);
+                CHECK(smallDelta.GetMemorySize() < 1024);
+
+                bigNewValue.indices[0] = 10;
+                ObjectDelta bigDelta(typeHandler, &bigValue, &bigNewValue);
+                CHECK(bigDelta.GetMemorySize() > smallDelta.GetMemorySize());
+            }
+        }
+        Engine::Destroy();
+    }
+}
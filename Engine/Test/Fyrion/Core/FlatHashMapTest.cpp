@@ -0,0 +1,252 @@
+#include "doctest.h"
+#include "Fyrion/Core/FlatHashMap.hpp"
+#include "Fyrion/Core/FlatHashSet.hpp"
+#include "Fyrion/Core/String.hpp"
+#include "Fyrion/Core/StringView.hpp"
+#include <string>
+
+using namespace Fyrion;
+
+namespace
+{
+    struct FlatTestStruct
+    {
+        int                              value{};
+        FlatHashMap<int, FlatTestStruct> map{};
+    };
+
+    TEST_CASE("Core::FlatHashMapTestBasics")
+    {
+        FlatHashMap<int, int> map{};
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            map.Insert(MakePair(i, i * 100));
+        }
+
+        CHECK(map.Size() == 1000);
+        CHECK(map.Has(100));
+        CHECK(!map.Has(1000));
+
+        bool check = true;
+        for (int i = 0; i < 1000; ++i)
+        {
+            FlatHashMap<int, int>::Iterator it = map.Find(i);
+            REQUIRE(it != map.end());
+
+            if (it->second != i * 100)
+            {
+                check = false;
+            }
+        }
+        CHECK(check);
+
+        CHECK(!map.Insert(10, 0).second);
+        CHECK(map[10] == 1000);
+
+        map.Clear();
+        CHECK(map.Empty());
+
+        FlatHashMap<int, int>::Iterator it = map.Find(1);
+        REQUIRE(it == map.end());
+    }
+
+    TEST_CASE("Core::FlatHashMapTestStruct")
+    {
+        FlatTestStruct mapStruct{};
+        mapStruct.map.Emplace(10, FlatTestStruct{120});
+        CHECK(mapStruct.map[10].value == 120);
+    }
+
+    TEST_CASE("Core::FlatHashMapTestForeach")
+    {
+        FlatHashMap<int, int> map{};
+        map.Insert(MakePair(1, 20));
+        map.Insert(MakePair(2, 40));
+
+        i32 sum = 0;
+        for (FlatHashMap<int, int>::Node& it : map)
+        {
+            sum += it.second;
+        }
+        CHECK(sum == 60);
+
+        const FlatHashMap<int, int>& constMap = map;
+        sum = 0;
+        for (const auto& it : constMap)
+        {
+            sum += it.second;
+        }
+        CHECK(sum == 60);
+    }
+
+    TEST_CASE("Core::FlatHashMapTestMove")
+    {
+        FlatHashMap<int, int> map{};
+        map.Insert(MakePair(1, 20));
+        map.Insert(MakePair(2, 40));
+
+        FlatHashMap<int, int> other{Traits::Move(map)};
+        CHECK(other[2] == 40);
+        CHECK(other.Size() == 2);
+        CHECK(map.Empty());
+
+        map = Traits::Move(other);
+        CHECK(map[1] == 20);
+        CHECK(other.Empty());
+    }
+
+    TEST_CASE("Core::FlatHashMapTestCopy")
+    {
+        FlatHashMap<int, String> map{};
+        map.Insert(1, "20");
+        map.Insert(2, "40");
+
+        FlatHashMap<int, String> other = map;
+
+        CHECK(map[1] == "20");
+        CHECK(map[2] == "40");
+
+        CHECK(other[1] == "20");
+        CHECK(other[2] == "40");
+        CHECK(other.Size() == 2);
+
+        other[1] = "30";
+        CHECK(map[1] == "20");
+    }
+
+    TEST_CASE("Core::FlatHashMapTestErase")
+    {
+        FlatHashMap<int, int> map{};
+        map.Insert(MakePair(1, 20));
+        map.Insert(MakePair(2, 40));
+
+        map.Erase(map.Find(1));
+
+        CHECK(map.Find(1) == map.end());
+        CHECK(map.Find(2) != map.end());
+
+        map.Erase(2);
+
+        CHECK(map.Find(2) == map.end());
+        CHECK(map.Empty());
+    }
+
+    TEST_CASE("Core::FlatHashMapTestEraseReinsert")
+    {
+        FlatHashMap<int, int> map{};
+
+        //erased slots are left as tombstones, the table must keep finding keys past them and reuse them.
+        for (int round = 0; round < 20; ++round)
+        {
+            for (int i = 0; i < 500; ++i)
+            {
+                map.Insert(round * 500 + i, i);
+            }
+
+            for (int i = 0; i < 500; ++i)
+            {
+                if (i % 5 != 0)
+                {
+                    map.Erase(round * 500 + i);
+                }
+            }
+        }
+
+        CHECK(map.Size() == 20 * 100);
+        CHECK(map.Capacity() <= 8192);
+
+        usize count = 0;
+        for (auto& it : map)
+        {
+            CHECK(it.first % 5 == 0);
+            count++;
+        }
+        CHECK(count == map.Size());
+
+        for (int i = 0; i < 20 * 500; ++i)
+        {
+            if (map.Has(i) != (i % 5 == 0))
+            {
+                REQUIRE(false);
+            }
+        }
+    }
+
+    TEST_CASE("Core::FlatHashMapTestStr")
+    {
+        FlatHashMap<String, String> map{};
+        map["AAAA"] = "BBBB";
+        map["CCCC"] = "DDDD";
+
+        for (int i = 0; i < 10000; ++i)
+        {
+            std::string str = std::to_string(i);
+            map.Insert(String{str.c_str()}, String{str.c_str()});
+        }
+
+        {
+            auto it = map.Find("CCCC");
+            REQUIRE(it != map.end());
+            CHECK(it->second == "DDDD");
+        }
+
+        {
+            StringView strView = {"AAAA"};
+            auto it = map.Find(strView);
+            REQUIRE(it != map.end());
+            CHECK(it->second == "BBBB");
+        }
+
+        {
+            auto it = map.Find(String{"9999"});
+            REQUIRE(it != map.end());
+            CHECK(it->second == "9999");
+        }
+    }
+
+    TEST_CASE("Core::FlatHashMapTestEmplace")
+    {
+        FlatHashMap<String, String> map{};
+        map.Emplace("AAA", "BBB");
+        CHECK(map.Has("AAA"));
+        CHECK(!map.Emplace("AAA", "CCC").second);
+        CHECK(map["AAA"] == "BBB");
+    }
+
+    TEST_CASE("Core::FlatHashSetBasics")
+    {
+        FlatHashSet<i32> set{};
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            set.Insert(i);
+        }
+
+        CHECK(set.Size() == 1000);
+        CHECK(!set.Insert(10).second);
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            REQUIRE(set.Find(i) != set.end());
+        }
+
+        i32 sum = 0;
+        for (FlatHashSet<i32>::Node& it : set)
+        {
+            sum += it.first;
+        }
+        CHECK(sum == 999 * 1000 / 2);
+
+        set.Erase(100);
+        CHECK(!set.Has(100));
+
+        FlatHashSet<i32> other{set};
+        CHECK(other.Size() == 999);
+        CHECK(other.Has(101));
+
+        set.Clear();
+        REQUIRE(set.Find(1) == set.end());
+        CHECK(other.Has(1));
+    }
+}
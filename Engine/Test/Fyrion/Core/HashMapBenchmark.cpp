@@ -0,0 +1,79 @@
+#include "doctest.h"
+#include "Fyrion/Core/Chronometer.hpp"
+#include "Fyrion/Core/FlatHashMap.hpp"
+#include "Fyrion/Core/HashMap.hpp"
+#include "Fyrion/Core/Hash.hpp"
+
+using namespace Fyrion;
+
+//run with: FyrionEngineTests --no-skip -tc="*Benchmark*"
+
+namespace
+{
+    template<typename Map>
+    void RunMapBenchmark(const doctest::String& name, const Array<u64>& keys)
+    {
+        Map map{};
+
+        {
+            Chronometer chronometer;
+            for (usize i = 0; i < keys.Size(); ++i)
+            {
+                map.Insert(keys[i], i);
+            }
+            MESSAGE(name, " insert: ", chronometer.Diff(), "ms");
+        }
+
+        usize sum = 0;
+        {
+            Chronometer chronometer;
+            for (u64 key : keys)
+            {
+                auto it = map.Find(key);
+                if (it)
+                {
+                    sum += it->second;
+                }
+            }
+            MESSAGE(name, " find hit: ", chronometer.Diff(), "ms");
+        }
+        CHECK(sum == keys.Size() * (keys.Size() - 1) / 2);
+
+        usize misses = 0;
+        {
+            Chronometer chronometer;
+            for (u64 key : keys)
+            {
+                misses += !map.Has(key + 1);
+            }
+            MESSAGE(name, " find miss: ", chronometer.Diff(), "ms");
+        }
+        CHECK(misses == keys.Size());
+
+        {
+            Chronometer chronometer;
+            for (usize i = 0; i < keys.Size(); i += 2)
+            {
+                map.Erase(keys[i]);
+            }
+            MESSAGE(name, " erase: ", chronometer.Diff(), "ms");
+        }
+        CHECK(map.Size() == keys.Size() / 2);
+    }
+
+    TEST_CASE("Core::HashMapBenchmark" * doctest::skip())
+    {
+        constexpr usize count = 1000000;
+
+        //even keys only, so key + 1 is always a miss
+        Array<u64> keys{};
+        keys.Resize(count);
+        for (usize i = 0; i < count; ++i)
+        {
+            keys[i] = Hash<u64>::Value(i) & ~1ull;
+        }
+
+        RunMapBenchmark<HashMap<u64, usize>>("HashMap", keys);
+        RunMapBenchmark<FlatHashMap<u64, usize>>("FlatHashMap", keys);
+    }
+}
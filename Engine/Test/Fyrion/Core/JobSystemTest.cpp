@@ -0,0 +1,145 @@
+#include "doctest.h"
+#include "Fyrion/Engine.hpp"
+#include "Fyrion/Core/JobSystem.hpp"
+
+#include <atomic>
+
+using namespace Fyrion;
+
+namespace
+{
+    std::atomic<u32> executedJobs{0};
+
+    void IncrementJob(VoidPtr userData)
+    {
+        executedJobs.fetch_add(1);
+    }
+
+    struct DependencyData
+    {
+        std::atomic<u32> firstDone{0};
+        std::atomic<u32> secondSawFirst{0};
+    };
+
+    TEST_CASE("Core::JobSystemRunAndWait")
+    {
+        Engine::Init();
+        {
+            CHECK(JobSystem::IsRunning());
+            CHECK(JobSystem::GetWorkerCount() >= 2);
+            CHECK(JobSystem::GetCurrentWorkerIndex() == 0);
+
+            executedJobs = 0;
+
+            Array<JobDecl> jobs{};
+            for (u32 i = 0; i < 10000; ++i)
+            {
+                jobs.EmplaceBack(JobDecl{IncrementJob, nullptr});
+            }
+
+            JobCounter counter{};
+            JobSystem::Run(jobs, &counter);
+            JobSystem::Wait(counter);
+
+            CHECK(counter.IsDone());
+            CHECK(executedJobs == 10000);
+        }
+        Engine::Destroy();
+    }
+
+    TEST_CASE("Core::JobSystemDependencies")
+    {
+        Engine::Init();
+        {
+            DependencyData data{};
+
+            JobDecl first{
+                [](VoidPtr userData)
+                {
+                    static_cast<DependencyData*>(userData)->firstDone.fetch_add(1);
+                },
+                &data
+            };
+
+            JobDecl second{
+                [](VoidPtr userData)
+                {
+                    DependencyData* data = static_cast<DependencyData*>(userData);
+                    if (data->firstDone.load() == 100)
+                    {
+                        data->secondSawFirst.fetch_add(1);
+                    }
+                },
+                &data
+            };
+
+            Array<JobDecl> firstJobs{};
+            firstJobs.Resize(100, first);
+
+            Array<JobDecl> secondJobs{};
+            secondJobs.Resize(10, second);
+
+            JobCounter firstCounter{};
+            JobCounter secondCounter{};
+
+            JobSystem::Run(firstJobs, &firstCounter);
+            JobSystem::RunAfter(firstCounter, secondJobs, &secondCounter);
+            JobSystem::Wait(secondCounter);
+
+            CHECK(data.firstDone == 100);
+            CHECK(data.secondSawFirst == 10);
+        }
+        Engine::Destroy();
+    }
+
+    TEST_CASE("Core::JobSystemParallelFor")
+    {
+        Engine::Init();
+        {
+            Array<u32> values{};
+            values.Resize(100000);
+
+            JobSystem::ParallelFor(Span<u32>{values}, [](u32& value)
+            {
+                value = 10;
+            });
+
+            bool check = true;
+            for (u32 value : values)
+            {
+                if (value != 10)
+                {
+                    check = false;
+                }
+            }
+            CHECK(check);
+
+            std::atomic<u64> sum{0};
+            JobSystem::ParallelFor(1000, [&](usize index)
+            {
+                sum.fetch_add(index);
+            });
+            CHECK(sum == 499500);
+        }
+        Engine::Destroy();
+    }
+
+    TEST_CASE("Core::JobSystemInlineWhenStopped")
+    {
+        CHECK(!JobSystem::IsRunning());
+
+        executedJobs = 0;
+
+        JobCounter counter{};
+        JobSystem::Run(IncrementJob, nullptr, &counter);
+        CHECK(counter.IsDone());
+        CHECK(executedJobs == 1);
+
+        u32 count = 0;
+        JobSystem::ParallelFor(100, [&](usize index)
+        {
+            count++;
+        });
+        CHECK(count == 100);
+    }
+}
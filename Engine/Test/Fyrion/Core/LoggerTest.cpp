@@ -2,6 +2,10 @@
 #include "Fyrion/Core/Format.hpp"
 #include "Fyrion/Core/Logger.hpp"
 
+#include <atomic>
+#include <cstdio>
+#include <thread>
+
 using namespace Fyrion;
 
 namespace
@@ -59,5 +63,112 @@ namespace
         Logger::UnregisterSink(testSink);
     }
 
+    //trace messages are not written by the StdOutSink of the tests
+    struct AsyncTestSink : LogSink
+    {
+        std::atomic_bool entered{false};
+        std::atomic_bool blocked{false};
+        Array<String>    messages{};
+
+        void SetLevel(LogLevel level) override {}
+
+        bool CanLog(LogLevel level) override
+        {
+            return true;
+        }
+
+        void DoLog(LogLevel level, const StringView& logName, const StringView& message) override
+        {
+            entered = true;
+            while (blocked)
+            {
+                std::this_thread::yield();
+            }
+            messages.EmplaceBack(message);
+        }
+    };
+
+    TEST_CASE("Core::AsyncLog")
+    {
+        constexpr u32 threadCount = 4;
+        constexpr u32 messageCount = 200;
+
+        AsyncTestSink testSink{};
+        Logger::RegisterSink(testSink);
+        Logger::EnableAsync(AsyncLogOptions{.threadBufferSize = 16});
+        CHECK(Logger::IsAsync());
+
+        Logger& logger = Logger::GetLogger("AsyncLogger", LogLevel::Trace);
+
+        Array<std::thread> threads{};
+        for (u32 t = 0; t < threadCount; ++t)
+        {
+            threads.EmplaceBack([&logger, t]
+            {
+                for (u32 i = 0; i < messageCount; ++i)
+                {
+                    logger.Trace("async {} {}", t, i);
+                }
+            });
+        }
+
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
 
+        Logger::Flush();
+
+        //nothing is lost when blocking and the messages of each thread keep their order
+        REQUIRE(testSink.messages.Size() == threadCount * messageCount);
+
+        u32 next[threadCount]{};
+        for (const String& message : testSink.messages)
+        {
+            u32 t = 0, i = 0;
+            REQUIRE(sscanf(strstr(message.CStr(), "async"), "async %u %u", &t, &i) == 2);
+            CHECK(i == next[t]);
+            next[t] = i + 1;
+        }
+
+        Logger::DisableAsync();
+        CHECK(!Logger::IsAsync());
+        Logger::UnregisterSink(testSink);
+    }
+
+    TEST_CASE("Core::AsyncLogOverflow")
+    {
+        AsyncTestSink testSink{};
+        Logger::RegisterSink(testSink);
+        Logger::EnableAsync(AsyncLogOptions{.threadBufferSize = 4, .overflow = LogOverflow::Count});
+
+        Logger& logger = Logger::GetLogger("AsyncLogger", LogLevel::Trace);
+        u64     dropped = Logger::GetDroppedCount();
+
+        //the log thread is held in the sink while the buffer fills up
+        testSink.blocked = true;
+        logger.Trace("first");
+        while (!testSink.entered)
+        {
+            std::this_thread::yield();
+        }
+
+        for (u32 i = 0; i < 20; ++i)
+        {
+            logger.Trace("overflow {}", i);
+        }
+
+        //the first message holds one of the 4 slots until the sink returns
+        CHECK(Logger::GetDroppedCount() - dropped == 17);
+
+        testSink.blocked = false;
+        Logger::Flush();
+
+        REQUIRE(testSink.messages.Size() == 5);
+        CHECK(Contains(StringView{testSink.messages[1]}, StringView{"17 log messages were dropped"}));
+        CHECK(Contains(StringView{testSink.messages[4]}, StringView{"overflow 2"}));
+
+        Logger::DisableAsync();
+        Logger::UnregisterSink(testSink);
+    }
 }
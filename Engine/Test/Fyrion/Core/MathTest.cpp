@@ -0,0 +1,42 @@
+#include <doctest.h>
+
+#include "Fyrion/Core/Math.hpp"
+
+using namespace Fyrion;
+
+namespace
+{
+    TEST_CASE("Core::MathTransformAABB")
+    {
+        AABB aabb{Vec3{-1, -1, -1}, Vec3{1, 1, 1}};
+
+        AABB translated = Math::TransformAABB(aabb, Math::Translate(Vec3{10, 0, 0}));
+        CHECK(translated.min == Vec3{9, -1, -1});
+        CHECK(translated.max == Vec3{11, 1, 1});
+
+        AABB scaled = Math::TransformAABB(aabb, Math::Scale(Mat4{1.0}, Vec3{2, 3, 4}));
+        CHECK(scaled.min == Vec3{-2, -3, -4});
+        CHECK(scaled.max == Vec3{2, 3, 4});
+    }
+
+    TEST_CASE("Core::MathFrustum")
+    {
+        //camera at the origin looking down -z
+        Mat4    projection = Math::Perspective(Math::Radians(90.f), 1.0f, 0.1f, 100.0f);
+        Frustum frustum = Math::ExtractFrustum(projection);
+
+        auto box = [](Vec3 center)
+        {
+            return AABB{center - Vec3{0.5f, 0.5f, 0.5f}, center + Vec3{0.5f, 0.5f, 0.5f}};
+        };
+
+        CHECK(Math::TestFrustumAABB(frustum, box(Vec3{0, 0, -10})));
+        CHECK(Math::TestFrustumAABB(frustum, box(Vec3{9, 0, -10})));
+        CHECK(Math::TestFrustumAABB(frustum, box(Vec3{0, 0, -100.2f})));
+
+        CHECK_FALSE(Math::TestFrustumAABB(frustum, box(Vec3{0, 0, 10})));
+        CHECK_FALSE(Math::TestFrustumAABB(frustum, box(Vec3{12, 0, -10})));
+        CHECK_FALSE(Math::TestFrustumAABB(frustum, box(Vec3{0, -12, -10})));
+        CHECK_FALSE(Math::TestFrustumAABB(frustum, box(Vec3{0, 0, -101})));
+    }
+}
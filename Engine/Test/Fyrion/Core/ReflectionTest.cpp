@@ -573,6 +573,36 @@ namespace ReflectionTest
         Engine::Destroy();
     }
 
+    TEST_CASE("Core::ReflectionSerializationPlan")
+    {
+        Engine::Init();
+        {
+            Registry::Type<TypeBase>();
+            Registry::Type<DerivedOne>();
+            Registry::Type<OtherBase>();
+            Registry::Type<DerivedTwo>();
+
+            TypeHandler* type = Registry::FindType<DerivedTwo>();
+            REQUIRE(type);
+
+            DerivedTwo derivedTwo{};
+
+            const SerializationPlan& plan = type->GetSerializationPlan();
+            REQUIRE(plan.fields.Size() == 3);
+            CHECK(&plan == &type->GetSerializationPlan());
+
+            for (const SerializationField& field : plan.fields)
+            {
+                CHECK(field.kind == SerializationFieldKind::Archive);
+                CHECK(reinterpret_cast<u8*>(&derivedTwo) + field.offset == type->FindField(field.name)->GetFieldPointer(&derivedTwo));
+            }
+
+            Registry::Type<PropertyTest>();
+            CHECK(type->GetSerializationPlan().revision == Registry::GetRevision());
+        }
+        Engine::Destroy();
+    }
+
     TEST_CASE("Core::ReflectionRuntimeTypes")
     {
         //TODO
@@ -0,0 +1,208 @@
+#include "doctest.h"
+#include "Fyrion/Engine.hpp"
+#include "Fyrion/Asset/AssetSerialization.hpp"
+#include "Fyrion/Core/Chronometer.hpp"
+#include "Fyrion/Core/Registry.hpp"
+
+using namespace Fyrion;
+
+//run with: FyrionEngineTests --no-skip -tc="*Benchmark*"
+
+namespace
+{
+    struct BenchmarkVec
+    {
+        f32 x;
+        f32 y;
+        f32 z;
+
+        static void RegisterType(NativeTypeHandler<BenchmarkVec>& type)
+        {
+            type.Field<&BenchmarkVec::x>("x");
+            type.Field<&BenchmarkVec::y>("y");
+            type.Field<&BenchmarkVec::z>("z");
+        }
+    };
+
+    struct BenchmarkStruct
+    {
+        u32          uint;
+        i32          iint;
+        f32          value;
+        bool         active;
+        BenchmarkVec position;
+        Array<u32>   ids;
+
+        static void RegisterType(NativeTypeHandler<BenchmarkStruct>& type)
+        {
+            type.Field<&BenchmarkStruct::uint>("uint");
+            type.Field<&BenchmarkStruct::iint>("iint");
+            type.Field<&BenchmarkStruct::value>("value");
+            type.Field<&BenchmarkStruct::active>("active");
+            type.Field<&BenchmarkStruct::position>("position");
+            type.Field<&BenchmarkStruct::ids>("ids");
+        }
+    };
+
+    //per-field dispatch used before serialization plans, kept as the benchmark baseline
+    ArchiveObject FieldSerialize(const TypeHandler* typeHandler, ArchiveWriter& writer, ConstPtr instance)
+    {
+        const ArchiveObject object = writer.CreateObject();
+        for (FieldHandler* field : typeHandler->GetFields())
+        {
+            const TypeInfo& typeInfo = field->GetFieldInfo().typeInfo;
+
+            if (FnArchiveWrite archiveWrite = typeInfo.archiveWrite)
+            {
+                archiveWrite(writer, object, field->GetName(), field->GetFieldPointer(instance));
+            }
+            else if (typeInfo.apiId == GetTypeID<ArrayApi>())
+            {
+                ArchiveObject array = writer.CreateArray();
+                ConstPtr      arrayPtr = field->GetFieldPointer(instance);
+                ArrayApi      arrayApi{};
+                typeInfo.extractApi(&arrayApi);
+                TypeInfo itemInfo = arrayApi.getTypeInfo();
+                for (usize i = 0; i < arrayApi.size(arrayPtr); ++i)
+                {
+                    itemInfo.archiveAdd(writer, array, arrayApi.getConst(arrayPtr, i));
+                }
+                writer.WriteValue(object, field->GetName(), array);
+            }
+            else if (const TypeHandler* fieldType = Registry::FindTypeById(typeInfo.typeId))
+            {
+                writer.WriteValue(object, field->GetName(), FieldSerialize(fieldType, writer, field->GetFieldPointer(instance)));
+            }
+        }
+        return object;
+    }
+
+    void FieldDeserialize(const TypeHandler* typeHandler, ArchiveReader& reader, ArchiveObject object, VoidPtr instance)
+    {
+        for (FieldHandler* field : typeHandler->GetFields())
+        {
+            const TypeInfo& typeInfo = field->GetFieldInfo().typeInfo;
+
+            if (FnArchiveRead archiveRead = typeInfo.archiveRead)
+            {
+                archiveRead(reader, object, field->GetName(), field->GetFieldPointer(instance));
+            }
+            else if (typeInfo.apiId == GetTypeID<ArrayApi>())
+            {
+                VoidPtr  arrPtr = field->GetFieldPointer(instance);
+                ArrayApi arrayApi{};
+                typeInfo.extractApi(&arrayApi);
+                arrayApi.clear(arrPtr);
+
+                ArchiveObject arr = reader.ReadObject(object, field->GetName());
+                TypeInfo      itemInfo = arrayApi.getTypeInfo();
+                ArchiveObject item{};
+                for (usize i = 0; i < reader.ArrSize(arr); ++i)
+                {
+                    item = reader.Next(arr, item);
+                    itemInfo.archiveGet(reader, item, arrayApi.pushNew(arrPtr));
+                }
+            }
+            else if (const TypeHandler* fieldType = Registry::FindTypeById(typeInfo.typeId))
+            {
+                FieldDeserialize(fieldType, reader, reader.ReadObject(object, field->GetName()), field->GetFieldPointer(instance));
+            }
+        }
+    }
+
+    TEST_CASE("Core::SerializationBenchmark" * doctest::skip())
+    {
+        constexpr usize count = 50000;
+
+        Engine::Init();
+        {
+            Registry::Type<BenchmarkVec>();
+            Registry::Type<BenchmarkStruct>();
+
+            TypeHandler* typeHandler = Registry::FindType<BenchmarkStruct>();
+            REQUIRE(typeHandler);
+
+            Array<BenchmarkStruct> values{};
+            values.Resize(count);
+            for (usize i = 0; i < count; ++i)
+            {
+                values[i].uint = static_cast<u32>(i);
+                values[i].iint = -static_cast<i32>(i);
+                values[i].value = static_cast<f32>(i) * 0.5f;
+                values[i].active = i % 2 == 0;
+                values[i].position = {1.0f, static_cast<f32>(i), 3.0f};
+                values[i].ids = {1, 2, static_cast<u32>(i)};
+            }
+
+            Array<u8> fieldBytes{};
+            {
+                BinaryAssetWriter writer;
+                ArchiveObject     array = writer.CreateArray();
+
+                Chronometer chronometer;
+                for (const BenchmarkStruct& value : values)
+                {
+                    writer.AddValue(array, FieldSerialize(typeHandler, writer, &value));
+                }
+                MESSAGE("per-field serialize: ", chronometer.Diff(), "ms");
+
+                ArchiveObject root = writer.CreateObject();
+                writer.WriteValue(root, "values", array);
+                fieldBytes = writer.Encode(root);
+            }
+
+            Array<u8> planBytes{};
+            {
+                BinaryAssetWriter writer;
+                ArchiveObject     array = writer.CreateArray();
+
+                Chronometer chronometer;
+                for (const BenchmarkStruct& value : values)
+                {
+                    writer.AddValue(array, Serialization::Serialize(typeHandler, writer, &value));
+                }
+                MESSAGE("plan serialize: ", chronometer.Diff(), "ms");
+
+                ArchiveObject root = writer.CreateObject();
+                writer.WriteValue(root, "values", array);
+                planBytes = writer.Encode(root);
+            }
+
+            REQUIRE(fieldBytes.Size() == planBytes.Size());
+
+            BinaryAssetReader reader(planBytes);
+            ArchiveObject     arr = reader.ReadObject(reader.ReadObject(), "values");
+            REQUIRE(reader.ArrSize(arr) == count);
+
+            Array<BenchmarkStruct> loaded{};
+            loaded.Resize(count);
+
+            {
+                Chronometer   chronometer;
+                ArchiveObject item{};
+                for (usize i = 0; i < count; ++i)
+                {
+                    item = reader.Next(arr, item);
+                    FieldDeserialize(typeHandler, reader, item, &loaded[i]);
+                }
+                MESSAGE("per-field deserialize: ", chronometer.Diff(), "ms");
+            }
+
+            {
+                Chronometer   chronometer;
+                ArchiveObject item{};
+                for (usize i = 0; i < count; ++i)
+                {
+                    item = reader.Next(arr, item);
+                    Serialization::Deserialize(typeHandler, reader, item, &loaded[i]);
+                }
+                MESSAGE("plan deserialize: ", chronometer.Diff(), "ms");
+            }
+
+            CHECK(loaded[count - 1].uint == count - 1);
+            CHECK(loaded[count - 1].position.y == static_cast<f32>(count - 1));
+            CHECK(loaded[count - 1].ids.Size() == 3);
+        }
+        Engine::Destroy();
+    }
+}
@@ -0,0 +1,209 @@
+#include <doctest.h>
+
+#include <cmath>
+
+#include "Fyrion/Engine.hpp"
+#include "Fyrion/Asset/AssetHandler.hpp"
+#include "Fyrion/Asset/AssetManager.hpp"
+#include "Fyrion/Core/Chronometer.hpp"
+#include "Fyrion/Core/JobSystem.hpp"
+#include "Fyrion/Graphics/Assets/DCCAsset.hpp"
+#include "Fyrion/IO/FileSystem.hpp"
+#include "Fyrion/IO/Path.hpp"
+
+using namespace Fyrion;
+
+//run with: FyrionEngineTests --no-skip -tc="*GLTFImportBenchmark*"
+//the scaling can be compared limiting the cores, ex: taskset -c 0 FyrionEngineTests ...
+
+namespace
+{
+    constexpr u32 MeshCount = 16;
+    constexpr u32 TextureCount = 16;
+    constexpr u32 TextureSize = 512;
+    constexpr u32 Rings = 96;
+    constexpr u32 Segments = 192;
+
+    struct BufferView
+    {
+        usize offset;
+        usize size;
+    };
+
+    BufferView Append(Array<u8>& buffer, const void* data, usize size)
+    {
+        while (buffer.Size() % 4 != 0)
+        {
+            buffer.EmplaceBack(0);
+        }
+
+        BufferView view{buffer.Size(), size};
+        const u8*  bytes = static_cast<const u8*>(data);
+        for (usize i = 0; i < size; ++i)
+        {
+            buffer.EmplaceBack(bytes[i]);
+        }
+        return view;
+    }
+
+    //uncompressed 32 bits TGA, decoded by the same path as PNG and JPG
+    Array<u8> CreateTGA(u32 seed)
+    {
+        Array<u8> tga(18 + TextureSize * TextureSize * 4, 0);
+        tga[2] = 2;
+        tga[12] = TextureSize & 0xFF;
+        tga[13] = TextureSize >> 8;
+        tga[14] = TextureSize & 0xFF;
+        tga[15] = TextureSize >> 8;
+        tga[16] = 32;
+        tga[17] = 0x28;
+
+        for (u32 y = 0; y < TextureSize; ++y)
+        {
+            for (u32 x = 0; x < TextureSize; ++x)
+            {
+                u8* pixel = &tga[18 + (y * TextureSize + x) * 4];
+                pixel[0] = static_cast<u8>(x ^ seed);
+                pixel[1] = static_cast<u8>(y + seed);
+                pixel[2] = static_cast<u8>((x * y) >> 4);
+                pixel[3] = 255;
+            }
+        }
+        return tga;
+    }
+
+    void CreateGLTF(StringView directory)
+    {
+        Array<u8> buffer{};
+        String    bufferViews{};
+        String    accessors{};
+        String    meshes{};
+        String    images{};
+        String    textures{};
+        u32       viewCount = 0;
+
+        auto addView = [&](const BufferView& view)
+        {
+            bufferViews.Append(viewCount > 0 ? "," : "").Append(R"({"buffer":0,"byteOffset":)").Append(view.offset).Append(R"(,"byteLength":)").Append(view.size).Append("}");
+            return viewCount++;
+        };
+
+        Array<f32> positions{};
+        Array<f32> normals{};
+        Array<f32> uvs{};
+        Array<u32> indices{};
+
+        for (u32 r = 0; r <= Rings; ++r)
+        {
+            const f32 phi = 3.14159265f * static_cast<f32>(r) / static_cast<f32>(Rings);
+            for (u32 s = 0; s <= Segments; ++s)
+            {
+                const f32 theta = 2.0f * 3.14159265f * static_cast<f32>(s) / static_cast<f32>(Segments);
+                const f32 normal[3] = {std::sin(phi) * std::cos(theta), std::cos(phi), std::sin(phi) * std::sin(theta)};
+                for (f32 value : normal)
+                {
+                    positions.EmplaceBack(value);
+                    normals.EmplaceBack(value);
+                }
+                uvs.EmplaceBack(static_cast<f32>(s) / static_cast<f32>(Segments));
+                uvs.EmplaceBack(static_cast<f32>(r) / static_cast<f32>(Rings));
+            }
+        }
+
+        for (u32 r = 0; r < Rings; ++r)
+        {
+            for (u32 s = 0; s < Segments; ++s)
+            {
+                const u32 i0 = r * (Segments + 1) + s;
+                const u32 i1 = i0 + Segments + 1;
+                for (u32 index : {i0, i0 + 1, i1, i1, i0 + 1, i1 + 1})
+                {
+                    indices.EmplaceBack(index);
+                }
+            }
+        }
+
+        const usize vertexCount = positions.Size() / 3;
+
+        //each mesh has its own copy of the data, like the meshes of a real scene
+        for (u32 m = 0; m < MeshCount; ++m)
+        {
+            const u32 position = addView(Append(buffer, positions.Data(), positions.Size() * sizeof(f32)));
+            const u32 normal = addView(Append(buffer, normals.Data(), normals.Size() * sizeof(f32)));
+            const u32 uv = addView(Append(buffer, uvs.Data(), uvs.Size() * sizeof(f32)));
+            const u32 index = addView(Append(buffer, indices.Data(), indices.Size() * sizeof(u32)));
+
+            accessors.Append(m > 0 ? "," : "")
+                     .Append(R"({"bufferView":)").Append(position).Append(R"(,"componentType":5126,"count":)").Append(vertexCount).Append(R"(,"type":"VEC3","min":[-1,-1,-1],"max":[1,1,1]},)")
+                     .Append(R"({"bufferView":)").Append(normal).Append(R"(,"componentType":5126,"count":)").Append(vertexCount).Append(R"(,"type":"VEC3"},)")
+                     .Append(R"({"bufferView":)").Append(uv).Append(R"(,"componentType":5126,"count":)").Append(vertexCount).Append(R"(,"type":"VEC2"},)")
+                     .Append(R"({"bufferView":)").Append(index).Append(R"(,"componentType":5125,"count":)").Append(indices.Size()).Append(R"(,"type":"SCALAR"})");
+
+            const u32 firstAccessor = m * 4;
+            meshes.Append(m > 0 ? "," : "")
+                  .Append(R"({"name":"Mesh_)").Append(m).Append(R"(","primitives":[{"attributes":{"POSITION":)").Append(firstAccessor)
+                  .Append(R"(,"NORMAL":)").Append(firstAccessor + 1)
+                  .Append(R"(,"TEXCOORD_0":)").Append(firstAccessor + 2)
+                  .Append(R"(},"indices":)").Append(firstAccessor + 3).Append(R"(,"material":0}]})");
+        }
+
+        for (u32 t = 0; t < TextureCount; ++t)
+        {
+            Array<u8> tga = CreateTGA(t);
+            const u32 view = addView(Append(buffer, tga.Data(), tga.Size()));
+
+            images.Append(t > 0 ? "," : "").Append(R"({"bufferView":)").Append(view).Append(R"(,"mimeType":"image/tga"})");
+            textures.Append(t > 0 ? "," : "").Append(R"({"name":"Texture_)").Append(t).Append(R"(","source":)").Append(t).Append("}");
+        }
+
+        String gltf{};
+        gltf.Append(R"({"asset":{"version":"2.0"},"buffers":[{"uri":"Benchmark.bin","byteLength":)").Append(buffer.Size()).Append("}],")
+            .Append(R"("bufferViews":[)").Append(bufferViews).Append("],")
+            .Append(R"("accessors":[)").Append(accessors).Append("],")
+            .Append(R"("images":[)").Append(images).Append("],")
+            .Append(R"("textures":[)").Append(textures).Append("],")
+            .Append(R"("materials":[{"name":"Material_0","pbrMetallicRoughness":{"baseColorTexture":{"index":0}}}],)")
+            .Append(R"("meshes":[)").Append(meshes).Append("]}");
+
+        FileSystem::SaveFileAsString(Path::Join(directory, "Benchmark.gltf"), gltf);
+
+        FileHandler file = FileSystem::OpenFile(Path::Join(directory, "Benchmark.bin"), AccessMode::WriteOnly);
+        FileSystem::WriteFile(file, buffer.Data(), buffer.Size());
+        FileSystem::CloseFile(file);
+    }
+
+    TEST_CASE("Graphics::GLTFImportBenchmark" * doctest::skip())
+    {
+        String testDir = Path::Join(FY_TEST_FILES, "GLTFImportBenchmark");
+        String assetsDir = Path::Join(testDir, "Assets");
+
+        FileSystem::Remove(testDir);
+        REQUIRE(FileSystem::CreateDirectory(assetsDir));
+        CreateGLTF(assetsDir);
+
+        Engine::Init();
+        {
+            REQUIRE(AssetManager::LoadFromDirectory("GLTFImportBenchmark", assetsDir));
+
+            AssetHandler* handler = AssetManager::FindHandlerByPath("GLTFImportBenchmark://Benchmark.gltf");
+            REQUIRE(handler);
+
+            Chronometer chronometer;
+            DCCAsset*   dccAsset = handler->LoadInstance()->Cast<DCCAsset>();
+            MESSAGE("import ", MeshCount, " meshes and ", TextureCount, " textures with ", JobSystem::GetWorkerCount(), " workers: ", chronometer.Diff(), "ms");
+
+            REQUIRE(dccAsset);
+            for (u32 m = 0; m < MeshCount; ++m)
+            {
+                CHECK(dccAsset->FindMeshByName(String{"Mesh_"}.Append(m)));
+            }
+            for (u32 t = 0; t < TextureCount; ++t)
+            {
+                CHECK(dccAsset->FindTextureByName(String{"Texture_"}.Append(t)));
+            }
+        }
+        Engine::Destroy();
+
+        FileSystem::Remove(testDir);
+    }
+}
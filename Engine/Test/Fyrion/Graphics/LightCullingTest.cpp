@@ -0,0 +1,168 @@
+#include <doctest.h>
+
+#include "Fyrion/Core/Array.hpp"
+#include "Fyrion/Graphics/LightCulling.hpp"
+
+using namespace Fyrion;
+
+namespace
+{
+    f32 Random(u32& seed, f32 min, f32 max)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        return min + (max - min) * static_cast<f32>(seed >> 8) / static_cast<f32>(1u << 24);
+    }
+
+    CameraData CreateCamera()
+    {
+        CameraData cameraData{};
+        //camera at (0, 2, 10) looking to -z
+        cameraData.view = Math::Translate(Vec3{0.0f, -2.0f, -10.0f});
+        cameraData.viewInverse = Math::Inverse(cameraData.view);
+        cameraData.projection = Math::Perspective(Math::Radians(60.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+        cameraData.projectionInverse = Math::Inverse(cameraData.projection);
+        cameraData.nearClip = 0.1f;
+        cameraData.farClip = 100.0f;
+        return cameraData;
+    }
+
+    TEST_CASE("Graphics::LightCullingClusters")
+    {
+        CameraData cameraData = CreateCamera();
+
+        for (f32 depth : {0.1f, 0.5f, 3.0f, 42.0f, 99.0f})
+        {
+            const u32 slice = LightCulling::GetSlice(depth, cameraData.nearClip, cameraData.farClip);
+            CHECK(LightCulling::GetSliceDepth(slice, cameraData.nearClip, cameraData.farClip) <= depth * 1.0001f);
+            CHECK(LightCulling::GetSliceDepth(slice + 1, cameraData.nearClip, cameraData.farClip) >= depth * 0.9999f);
+        }
+
+        //the shader finds the cluster of a pixel with the projection, the position must be inside the bounds
+        u32 seed = 7;
+        u32 outside = 0;
+        for (u32 i = 0; i < 1000; ++i)
+        {
+            const f32  depth = Random(seed, 0.2f, 90.0f);
+            const Vec4 clip = cameraData.projection * Vec4{Random(seed, -1.0f, 1.0f) * depth, Random(seed, -0.5f, 0.5f) * depth, -depth, 1.0f};
+            const f32  ndcX = clip.x / clip.w;
+            const f32  ndcY = clip.y / clip.w;
+            if (ndcX <= -1.0f || ndcX >= 1.0f || ndcY <= -1.0f || ndcY >= 1.0f)
+            {
+                continue;
+            }
+
+            const u32  x = static_cast<u32>((ndcX * 0.5f + 0.5f) * LightCulling::ClusterCountX);
+            const u32  y = static_cast<u32>((ndcY * 0.5f + 0.5f) * LightCulling::ClusterCountY);
+            const u32  z = LightCulling::GetSlice(depth, cameraData.nearClip, cameraData.farClip);
+            const AABB bounds = LightCulling::GetClusterBounds(cameraData, x, y, z);
+
+            const Vec4 position = cameraData.projectionInverse * Vec4{ndcX, ndcY, clip.z / clip.w, 1.0f};
+            const Vec3 viewPos = Math::MakeVec3(position) / position.w;
+            for (i32 axis = 0; axis < 3; ++axis)
+            {
+                const f32 epsilon = 0.001f * depth;
+                if (viewPos[axis] < bounds.min[axis] - epsilon || viewPos[axis] > bounds.max[axis] + epsilon)
+                {
+                    outside++;
+                }
+            }
+        }
+        CHECK(outside == 0);
+    }
+
+    TEST_CASE("Graphics::LightCullingBuildClusters")
+    {
+        CameraData cameraData = CreateCamera();
+
+        u32               seed = 42;
+        Array<PointLight> pointLights{};
+        Array<SpotLight>  spotLights{};
+
+        for (u32 i = 0; i < 200; ++i)
+        {
+            pointLights.EmplaceBack(PointLight{
+                .position = Vec3{Random(seed, -30.0f, 30.0f), Random(seed, -5.0f, 10.0f), Random(seed, -80.0f, 12.0f)},
+                .color = Color::WHITE,
+                .intensity = 1.0f,
+                .range = Random(seed, 0.5f, 6.0f)
+            });
+        }
+
+        for (u32 i = 0; i < 100; ++i)
+        {
+            spotLights.EmplaceBack(SpotLight{
+                .position = Vec3{Random(seed, -30.0f, 30.0f), Random(seed, -5.0f, 10.0f), Random(seed, -80.0f, 12.0f)},
+                .direction = Vec3{Random(seed, -1.0f, 1.0f), Random(seed, -1.0f, 0.1f), Random(seed, -1.0f, 1.0f)},
+                .color = Color::WHITE,
+                .intensity = 1.0f,
+                .range = Random(seed, 2.0f, 15.0f),
+                .innerAngle = Math::Radians(15.0f),
+                .outerAngle = Math::Radians(Random(seed, 20.0f, 60.0f))
+            });
+        }
+
+        Array<LightCulling::LightData> lights{};
+        LightCulling::PackLights(pointLights, spotLights, lights);
+        REQUIRE(lights.Size() == 300);
+        CHECK(lights[0].direction.w == 0.0f);
+        CHECK(lights[200].direction.w == 1.0f);
+
+        LightCulling::LightClusterList list{};
+        LightCulling::BuildClusters(cameraData, lights, list);
+        REQUIRE(list.clusters.Size() == LightCulling::ClusterCount);
+
+        //same lists as testing every light against every cluster
+        u32 mismatches = 0;
+        u32 totalLights = 0;
+        for (u32 z = 0; z < LightCulling::ClusterCountZ; ++z)
+        {
+            for (u32 y = 0; y < LightCulling::ClusterCountY; ++y)
+            {
+                for (u32 x = 0; x < LightCulling::ClusterCountX; ++x)
+                {
+                    const AABB                       bounds = LightCulling::GetClusterBounds(cameraData, x, y, z);
+                    const LightCulling::LightCluster& cluster = list.clusters[LightCulling::GetClusterIndex(x, y, z)];
+
+                    Array<u32> expected{};
+                    for (u32 i = 0; i < lights.Size() && expected.Size() < LightCulling::MaxLightsPerCluster; ++i)
+                    {
+                        if (LightCulling::TestLight(lights[i], cameraData.view, bounds))
+                        {
+                            expected.EmplaceBack(i);
+                        }
+                    }
+
+                    if (cluster.count != expected.Size())
+                    {
+                        mismatches++;
+                        continue;
+                    }
+
+                    for (u32 i = 0; i < cluster.count; ++i)
+                    {
+                        if (list.lightIndices[cluster.offset + i] != expected[i])
+                        {
+                            mismatches++;
+                        }
+                    }
+                    totalLights += cluster.count;
+                }
+            }
+        }
+
+        CHECK(mismatches == 0);
+        CHECK(totalLights == list.lightIndices.Size());
+        CHECK(totalLights > 0);
+
+        //a light is always in the cluster of its position
+        const Vec4 lightView = cameraData.view * Vec4{0.0f, 2.0f, 0.0f, 1.0f};
+        const f32  depth = -lightView.z;
+        lights.Clear();
+        lights.EmplaceBack(LightCulling::LightData{.positionRange = Vec4{0.0f, 2.0f, 0.0f, 0.5f}});
+        LightCulling::BuildClusters(cameraData, lights, list);
+
+        const u32 center = LightCulling::GetClusterIndex(LightCulling::ClusterCountX / 2, LightCulling::ClusterCountY / 2, LightCulling::GetSlice(depth, cameraData.nearClip, cameraData.farClip));
+        CHECK(list.clusters[center].count == 1);
+        CHECK(list.lightIndices.Size() < 20);
+    }
+}
@@ -0,0 +1,449 @@
+#include <doctest.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include "Fyrion/Core/Array.hpp"
+#include "Fyrion/Graphics/MeshOptimizer.hpp"
+
+using namespace Fyrion;
+
+namespace
+{
+    //grid of size x size quads with 4 unique vertices per quad, so all the shared vertices are duplicated.
+    void CreateGrid(u32 size, Array<VertexStride>& vertices, Array<u32>& indices)
+    {
+        for (u32 y = 0; y < size; ++y)
+        {
+            for (u32 x = 0; x < size; ++x)
+            {
+                const u32 first = static_cast<u32>(vertices.Size());
+                for (u32 corner = 0; corner < 4; ++corner)
+                {
+                    const f32 px = static_cast<f32>(x + corner % 2);
+                    const f32 py = static_cast<f32>(y + corner / 2);
+                    vertices.EmplaceBack(VertexStride{
+                        .position = Vec3{px, py, 0.0f},
+                        .normal = Vec3{0.0f, 0.0f, 1.0f},
+                        .color = Vec3{1.0f, 1.0f, 1.0f},
+                        .uv = Vec2{px / static_cast<f32>(size), py / static_cast<f32>(size)},
+                        .tangent = Vec4{1.0f, 0.0f, 0.0f, 1.0f}
+                    });
+                }
+
+                for (u32 index : {0u, 1u, 2u, 2u, 1u, 3u})
+                {
+                    indices.EmplaceBack(first + index);
+                }
+            }
+        }
+    }
+
+    //triangles as sorted position triples, independent of vertex and triangle order
+    Array<Array<f32>> GetTriangles(const Array<VertexStride>& vertices, const Array<u32>& indices)
+    {
+        Array<Array<f32>> triangles{};
+        for (usize t = 0; t < indices.Size(); t += 3)
+        {
+            //rotate the triangle so the lowest position is first, winding is preserved
+            u32 rotation = 0;
+            for (u32 k = 1; k < 3; ++k)
+            {
+                const Vec3& a = vertices[indices[t + k]].position;
+                const Vec3& b = vertices[indices[t + rotation]].position;
+                if (a.x < b.x || (a.x == b.x && a.y < b.y))
+                {
+                    rotation = k;
+                }
+            }
+
+            Array<f32> triangle{};
+            for (u32 k = 0; k < 3; ++k)
+            {
+                const Vec3& position = vertices[indices[t + (rotation + k) % 3]].position;
+                triangle.EmplaceBack(position.x);
+                triangle.EmplaceBack(position.y);
+            }
+            triangles.EmplaceBack(triangle);
+        }
+
+        std::sort(triangles.begin(), triangles.end(), [](const Array<f32>& a, const Array<f32>& b)
+        {
+            return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end());
+        });
+        return triangles;
+    }
+
+    void ShuffleTriangles(Array<u32>& indices)
+    {
+        u64 seed = 42;
+        for (usize t = indices.Size() / 3 - 1; t > 0; --t)
+        {
+            seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+            const usize other = (seed >> 33) % (t + 1);
+            for (u32 k = 0; k < 3; ++k)
+            {
+                std::swap(indices[t * 3 + k], indices[other * 3 + k]);
+            }
+        }
+    }
+
+    TEST_CASE("Graphics::MeshOptimizerRemap")
+    {
+        Array<VertexStride> vertices{};
+        Array<u32>          indices{};
+        CreateGrid(4, vertices, indices);
+        vertices.EmplaceBack(VertexStride{.position = Vec3{100, 100, 100}}); //not referenced
+
+        Array<Array<f32>> triangles = GetTriangles(vertices, indices);
+
+        Array<u32> remap{};
+        const u32  vertexCount = MeshOptimizer::GenerateVertexRemap(vertices, indices, remap);
+        CHECK(vertexCount == 25);
+        CHECK(remap.Back() == U32_MAX);
+
+        MeshOptimizer::RemapIndices(indices, remap);
+        MeshOptimizer::RemapVertices(vertices, remap, vertexCount);
+        REQUIRE(vertices.Size() == 25);
+        CHECK(GetTriangles(vertices, indices) == triangles);
+
+        //first use order
+        CHECK(indices[0] == 0);
+        CHECK(indices[1] == 1);
+        CHECK(indices[2] == 2);
+    }
+
+    TEST_CASE("Graphics::MeshOptimizerVertexCache")
+    {
+        Array<VertexStride> vertices{};
+        Array<u32>          indices{};
+        CreateGrid(32, vertices, indices);
+
+        Array<u32> remap{};
+        const u32  vertexCount = MeshOptimizer::GenerateVertexRemap(vertices, indices, remap);
+        MeshOptimizer::RemapIndices(indices, remap);
+        MeshOptimizer::RemapVertices(vertices, remap, vertexCount);
+
+        ShuffleTriangles(indices);
+        Array<Array<f32>> triangles = GetTriangles(vertices, indices);
+
+        const f32 shuffledACMR = MeshOptimizer::CalculateACMR(indices, vertices.Size());
+        CHECK(shuffledACMR > 2.0f);
+
+        MeshOptimizer::OptimizeVertexCache(indices);
+        const f32 optimizedACMR = MeshOptimizer::CalculateACMR(indices, vertices.Size());
+        CHECK(optimizedACMR < 0.8f);
+        CHECK(GetTriangles(vertices, indices) == triangles);
+
+        MeshOptimizer::OptimizeOverdraw(indices, vertices, 1.05f);
+        CHECK(MeshOptimizer::CalculateACMR(indices, vertices.Size()) <= optimizedACMR * 1.05f + 0.01f);
+        CHECK(GetTriangles(vertices, indices) == triangles);
+
+        MeshOptimizer::OptimizeVertexFetch(vertices, indices);
+        CHECK(GetTriangles(vertices, indices) == triangles);
+
+        u32 maxIndex = 0;
+        for (u32 index : indices)
+        {
+            //a vertex is only used after all the vertices before it
+            CHECK(index <= maxIndex + 1);
+            maxIndex = std::max(maxIndex, index);
+        }
+        CHECK(maxIndex + 1 == vertices.Size());
+    }
+
+    TEST_CASE("Graphics::MeshOptimizerOverdraw")
+    {
+        //two quads facing +z, at z = 0 and z = 1. the outer one must be drawn first.
+        Array<VertexStride> vertices{};
+        Array<u32>          indices{};
+        for (f32 z : {0.0f, 1.0f})
+        {
+            const u32 first = static_cast<u32>(vertices.Size());
+            vertices.EmplaceBack(VertexStride{.position = Vec3{0, 0, z}});
+            vertices.EmplaceBack(VertexStride{.position = Vec3{1, 0, z}});
+            vertices.EmplaceBack(VertexStride{.position = Vec3{0, 1, z}});
+            vertices.EmplaceBack(VertexStride{.position = Vec3{1, 1, z}});
+            for (u32 index : {0u, 1u, 2u, 2u, 1u, 3u})
+            {
+                indices.EmplaceBack(first + index);
+            }
+        }
+
+        MeshOptimizer::OptimizeOverdraw(indices, vertices, 1.05f);
+        CHECK(vertices[indices[0]].position.z == 1.0f);
+        CHECK(vertices[indices[11]].position.z == 0.0f);
+    }
+
+    void CreateSphere(u32 rings, u32 segments, Array<VertexStride>& vertices, Array<u32>& indices)
+    {
+        //one vertex per position, the poles are single vertices
+        vertices.EmplaceBack(VertexStride{.position = Vec3{0, 1, 0}, .normal = Vec3{0, 1, 0}});
+        for (u32 r = 1; r < rings; ++r)
+        {
+            const f32 phi = 3.14159265f * static_cast<f32>(r) / static_cast<f32>(rings);
+            for (u32 s = 0; s < segments; ++s)
+            {
+                const f32 theta = 2.0f * 3.14159265f * static_cast<f32>(s) / static_cast<f32>(segments);
+                const Vec3 position{std::sin(phi) * std::cos(theta), std::cos(phi), std::sin(phi) * std::sin(theta)};
+                vertices.EmplaceBack(VertexStride{.position = position, .normal = position});
+            }
+        }
+        vertices.EmplaceBack(VertexStride{.position = Vec3{0, -1, 0}, .normal = Vec3{0, -1, 0}});
+
+        const u32 last = static_cast<u32>(vertices.Size() - 1);
+        auto      ring = [&](u32 r, u32 s)
+        {
+            return 1 + (r - 1) * segments + s % segments;
+        };
+
+        for (u32 s = 0; s < segments; ++s)
+        {
+            indices.EmplaceBack(0);
+            indices.EmplaceBack(ring(1, s + 1));
+            indices.EmplaceBack(ring(1, s));
+
+            indices.EmplaceBack(last);
+            indices.EmplaceBack(ring(rings - 1, s));
+            indices.EmplaceBack(ring(rings - 1, s + 1));
+        }
+
+        for (u32 r = 1; r + 1 < rings; ++r)
+        {
+            for (u32 s = 0; s < segments; ++s)
+            {
+                indices.EmplaceBack(ring(r, s));
+                indices.EmplaceBack(ring(r, s + 1));
+                indices.EmplaceBack(ring(r + 1, s));
+
+                indices.EmplaceBack(ring(r + 1, s));
+                indices.EmplaceBack(ring(r, s + 1));
+                indices.EmplaceBack(ring(r + 1, s + 1));
+            }
+        }
+    }
+
+    f32 TotalArea(const Array<VertexStride>& vertices, const Array<u32>& indices)
+    {
+        f32 area = 0.0f;
+        for (usize t = 0; t < indices.Size(); t += 3)
+        {
+            const Vec3& p0 = vertices[indices[t]].position;
+            const Vec3& p1 = vertices[indices[t + 1]].position;
+            const Vec3& p2 = vertices[indices[t + 2]].position;
+            area += static_cast<f32>(Math::Len(Math::Cross(p1 - p0, p2 - p0))) * 0.5f;
+        }
+        return area;
+    }
+
+    TEST_CASE("Graphics::MeshOptimizerSimplify")
+    {
+        SUBCASE("Plane")
+        {
+            Array<VertexStride> vertices{};
+            Array<u32>          indices{};
+            CreateGrid(16, vertices, indices);
+
+            Array<u32> remap{};
+            const u32  vertexCount = MeshOptimizer::GenerateVertexRemap(vertices, indices, remap);
+            MeshOptimizer::RemapIndices(indices, remap);
+            MeshOptimizer::RemapVertices(vertices, remap, vertexCount);
+
+            //the error includes the uv change, the area shows the plane is kept
+            Array<u32> simplified{};
+            const f32  error = MeshOptimizer::Simplify(indices, vertices, indices.Size() / 4, 0.1f, simplified);
+            CHECK(simplified.Size() <= indices.Size() / 4);
+            CHECK(error < 0.1f);
+            CHECK(TotalArea(vertices, simplified) == doctest::Approx(256.0f));
+        }
+
+        SUBCASE("Sphere")
+        {
+            Array<VertexStride> vertices{};
+            Array<u32>          indices{};
+            CreateSphere(32, 64, vertices, indices);
+
+            Array<u32> simplified{};
+            const f32  error = MeshOptimizer::Simplify(indices, vertices, indices.Size() / 4, 1.0f, simplified);
+            CHECK(simplified.Size() <= indices.Size() / 4);
+            CHECK(error > 0.0f);
+            CHECK(error < 0.05f);
+
+            for (usize t = 0; t < simplified.Size(); t += 3)
+            {
+                const Vec3& p0 = vertices[simplified[t]].position;
+                const Vec3& p1 = vertices[simplified[t + 1]].position;
+                const Vec3& p2 = vertices[simplified[t + 2]].position;
+                CHECK(Math::Dot(Math::Cross(p1 - p0, p2 - p0), p0 + p1 + p2) > 0.0f);
+            }
+
+            //the error limit stops the simplification
+            const f32 limitedError = MeshOptimizer::Simplify(indices, vertices, 0, 0.001f, simplified);
+            CHECK(limitedError <= 0.001f);
+            CHECK(simplified.Size() > indices.Size() / 2);
+        }
+
+        SUBCASE("Seams")
+        {
+            Array<VertexStride> vertices{};
+            Array<u32>          indices{};
+            CreateGrid(4, vertices, indices);
+
+            Array<u32> remap{};
+            const u32  vertexCount = MeshOptimizer::GenerateVertexRemap(vertices, indices, remap);
+            MeshOptimizer::RemapIndices(indices, remap);
+            MeshOptimizer::RemapVertices(vertices, remap, vertexCount);
+
+            //the right half gets its own uvs, splitting the vertices at x = 2
+            Array<u32> split(vertexCount, U32_MAX);
+            for (usize t = 0; t < indices.Size(); t += 3)
+            {
+                const f32 centroid = vertices[indices[t]].position.x + vertices[indices[t + 1]].position.x + vertices[indices[t + 2]].position.x;
+                if (centroid <= 6.0f)
+                {
+                    continue;
+                }
+
+                for (usize i = t; i < t + 3; ++i)
+                {
+                    const u32 index = indices[i];
+                    if (vertices[index].position.x != 2.0f)
+                    {
+                        continue;
+                    }
+                    if (split[index] == U32_MAX)
+                    {
+                        VertexStride vertex = vertices[index];
+                        vertex.uv.x += 1.0f;
+                        split[index] = static_cast<u32>(vertices.Size());
+                        vertices.EmplaceBack(vertex);
+                    }
+                    indices[i] = split[index];
+                }
+            }
+
+            Array<u32> simplified{};
+            MeshOptimizer::Simplify(indices, vertices, 0, 1.0f, simplified);
+            CHECK(simplified.Size() < indices.Size());
+
+            for (u32 v = 0; v < vertices.Size(); ++v)
+            {
+                if (vertices[v].position.x == 2.0f)
+                {
+                    CHECK(std::find(simplified.begin(), simplified.end(), v) != simplified.end());
+                }
+            }
+        }
+    }
+
+    TEST_CASE("Graphics::MeshOptimizerMeshlets")
+    {
+        Array<VertexStride> vertices{};
+        Array<u32>          indices{};
+        CreateSphere(32, 64, vertices, indices);
+        MeshOptimizer::OptimizeVertexCache(indices);
+
+        Array<u32> source = indices;
+
+        Array<Meshlet>       meshlets{};
+        Array<MeshletBounds> bounds{};
+        MeshOptimizer::BuildMeshlets(indices, vertices, meshlets, bounds);
+
+        REQUIRE(meshlets.Size() == bounds.Size());
+        CHECK(meshlets.Size() <= indices.Size() / 3 / 80);
+
+        //the triangles are the same, only reordered
+        auto sortedTriangles = [](const Array<u32>& triangleIndices)
+        {
+            Array<u64> triangles{};
+            for (usize t = 0; t < triangleIndices.Size(); t += 3)
+            {
+                u32 rotation = 0;
+                for (u32 k = 1; k < 3; ++k)
+                {
+                    if (triangleIndices[t + k] < triangleIndices[t + rotation])
+                    {
+                        rotation = k;
+                    }
+                }
+                u64 key = 0;
+                for (u32 k = 0; k < 3; ++k)
+                {
+                    key = key << 21 | triangleIndices[t + (rotation + k) % 3];
+                }
+                triangles.EmplaceBack(key);
+            }
+            std::sort(triangles.begin(), triangles.end());
+            return triangles;
+        };
+        CHECK(sortedTriangles(source) == sortedTriangles(indices));
+
+        u32 nextIndex = 0;
+        for (usize m = 0; m < meshlets.Size(); ++m)
+        {
+            const Meshlet&       meshlet = meshlets[m];
+            const MeshletBounds& meshletBounds = bounds[m];
+
+            CHECK(meshlet.firstIndex == nextIndex);
+            CHECK(meshlet.indexCount <= MeshOptimizer::MaxMeshletTriangles * 3);
+            CHECK(meshlet.vertexCount <= MeshOptimizer::MaxMeshletVertices);
+            nextIndex += meshlet.indexCount;
+
+            Array<u32> unique(indices.begin() + meshlet.firstIndex, indices.begin() + meshlet.firstIndex + meshlet.indexCount);
+            std::sort(unique.begin(), unique.end());
+            CHECK(std::unique(unique.begin(), unique.end()) - unique.begin() == meshlet.vertexCount);
+
+            for (u32 i = meshlet.firstIndex; i < meshlet.firstIndex + meshlet.indexCount; i += 3)
+            {
+                const Vec3& p0 = vertices[indices[i]].position;
+                const Vec3& p1 = vertices[indices[i + 1]].position;
+                const Vec3& p2 = vertices[indices[i + 2]].position;
+                for (const Vec3* p : {&p0, &p1, &p2})
+                {
+                    CHECK(Math::Len(*p - meshletBounds.center) <= meshletBounds.radius + 1e-5f);
+                }
+
+                //the normals are inside the cone
+                if (meshletBounds.coneCutoff < 1.0f)
+                {
+                    const Vec3 normal = Math::Normalize(Math::Cross(p1 - p0, p2 - p0));
+                    CHECK(Math::Dot(normal, meshletBounds.coneAxis) >= std::sqrt(1.0f - meshletBounds.coneCutoff * meshletBounds.coneCutoff) - 1e-4f);
+                }
+            }
+        }
+        CHECK(nextIndex == indices.Size());
+    }
+
+    TEST_CASE("Graphics::MeshOptimizerQuantize")
+    {
+        Array<VertexStride> vertices{};
+        vertices.EmplaceBack(VertexStride{
+            .position = Vec3{1.5f, -2.0f, 3.0f},
+            .normal = Vec3{0.0f, -1.0f, 0.5f},
+            .color = Vec3{1.0f, 0.5f, 0.0f},
+            .uv = Vec2{0.5f, -2.0f},
+            .tangent = Vec4{1.0f, 0.0f, 0.0f, -1.0f}
+        });
+
+        Array<VertexStrideQuantized> quantized{};
+        MeshOptimizer::Quantize(vertices, quantized);
+        REQUIRE(quantized.Size() == 1);
+
+        CHECK(sizeof(VertexStrideQuantized) == 28);
+        CHECK(quantized[0].position == vertices[0].position);
+        CHECK(quantized[0].uv[0] == 0x3800);
+        CHECK(quantized[0].uv[1] == 0xC000);
+        CHECK(quantized[0].normal[1] == -127);
+        CHECK(quantized[0].normal[2] == 64);
+        CHECK(quantized[0].color[0] == 255);
+        CHECK(quantized[0].color[1] == 128);
+        CHECK(quantized[0].tangent[0] == 127);
+        CHECK(quantized[0].tangent[3] == -127);
+
+        u32 stride = MeshOptimizer::GetVertexSize(MeshVertexFormat::Quantized);
+        for (const VertexInputAttribute& input : MeshOptimizer::GetVertexInputs(MeshVertexFormat::Quantized))
+        {
+            CHECK(input.offset + GetFormatSize(input.format) / 8 <= stride);
+        }
+    }
+}
@@ -0,0 +1,181 @@
+#include <doctest.h>
+
+#include <cmath>
+
+#include "Fyrion/Core/Array.hpp"
+#include "Fyrion/Graphics/MeshletCulling.hpp"
+#include "Fyrion/Graphics/MeshOptimizer.hpp"
+
+using namespace Fyrion;
+
+namespace
+{
+    void CreateSphere(u32 rings, u32 segments, Array<VertexStride>& vertices, Array<u32>& indices)
+    {
+        for (u32 r = 0; r <= rings; ++r)
+        {
+            const f32 phi = 3.14159265f * static_cast<f32>(r) / static_cast<f32>(rings);
+            for (u32 s = 0; s <= segments; ++s)
+            {
+                const f32  theta = 2.0f * 3.14159265f * static_cast<f32>(s) / static_cast<f32>(segments);
+                const Vec3 position{std::sin(phi) * std::cos(theta), std::cos(phi), std::sin(phi) * std::sin(theta)};
+                vertices.EmplaceBack(VertexStride{.position = position, .normal = position});
+            }
+        }
+
+        for (u32 r = 0; r < rings; ++r)
+        {
+            for (u32 s = 0; s < segments; ++s)
+            {
+                const u32 i0 = r * (segments + 1) + s;
+                const u32 i1 = i0 + segments + 1;
+                for (u32 index : {i0, i0 + 1, i1, i1, i0 + 1, i1 + 1})
+                {
+                    indices.EmplaceBack(index);
+                }
+            }
+        }
+    }
+
+    //a meshlet must be drawn when one of its triangles faces the camera and has a point inside the frustum
+    bool BruteForceVisible(const Array<VertexStride>& vertices, const Array<u32>& indices, const Meshlet& meshlet, const Mat4& transform, const Frustum& frustum, const Vec3& viewPos)
+    {
+        for (u32 i = meshlet.firstIndex; i < meshlet.firstIndex + meshlet.indexCount; i += 3)
+        {
+            Vec3 p[3];
+            for (u32 k = 0; k < 3; ++k)
+            {
+                const Vec3& position = vertices[indices[i + k]].position;
+                p[k] = Math::MakeVec3(transform * Vec4{position.x, position.y, position.z, 1.0f});
+            }
+
+            const Vec3 normal = Math::Cross(p[1] - p[0], p[2] - p[0]);
+            if (Math::Dot(p[0] - viewPos, normal) >= 0.0f)
+            {
+                continue;
+            }
+
+            for (const Vec3& point : {p[0], p[1], p[2], (p[0] + p[1] + p[2]) / 3.0f})
+            {
+                bool inside = true;
+                for (const Vec4& plane : frustum.planes)
+                {
+                    inside = inside && plane.x * point.x + plane.y * point.y + plane.z * point.z + plane.w >= 0.0f;
+                }
+                if (inside)
+                {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    TEST_CASE("Graphics::MeshletCulling")
+    {
+        Array<VertexStride> vertices{};
+        Array<u32>          indices{};
+        CreateSphere(32, 64, vertices, indices);
+        MeshOptimizer::OptimizeVertexCache(indices);
+
+        Array<Meshlet>       meshlets{};
+        Array<MeshletBounds> bounds{};
+        MeshOptimizer::BuildMeshlets(indices, vertices, meshlets, bounds);
+
+        //a row of spheres along x, the last ones are scaled and mirrored to test the cone fallback
+        Array<Mat4> transforms{};
+        for (u32 i = 0; i < 8; ++i)
+        {
+            transforms.EmplaceBack(Math::Translate(Vec3{static_cast<f32>(i) * 3.0f, 0.0f, 0.0f}));
+        }
+        transforms.EmplaceBack(Math::Scale(Math::Translate(Vec3{0.0f, 3.0f, 0.0f}), Vec3{2.0f, 2.0f, 2.0f}));
+        transforms.EmplaceBack(Math::Scale(Math::Translate(Vec3{3.0f, 3.0f, 0.0f}), Vec3{1.0f, 2.0f, 1.0f}));
+        transforms.EmplaceBack(Math::Scale(Math::Translate(Vec3{6.0f, 3.0f, 0.0f}), Vec3{-1.0f, 1.0f, 1.0f}));
+
+        //two batches using different meshlet ranges, the second one skips some instances
+        const u32 half = static_cast<u32>(meshlets.Size() / 2);
+
+        Array<u32> batchInstances{};
+        for (u32 i = 0; i < transforms.Size(); ++i)
+        {
+            batchInstances.EmplaceBack(i);
+        }
+        for (u32 i = 0; i < transforms.Size(); i += 2)
+        {
+            batchInstances.EmplaceBack(i);
+        }
+
+        const u32 firstInstanceCount = static_cast<u32>(transforms.Size());
+        const u32 secondInstanceCount = static_cast<u32>(batchInstances.Size()) - firstInstanceCount;
+
+        Array<MeshletBatch> batches{};
+        batches.EmplaceBack(MeshletBatch{.firstCommand = 0, .firstMeshlet = 0, .meshletCount = half, .firstInstance = 0});
+        batches.EmplaceBack(MeshletBatch{
+            .firstCommand = half * firstInstanceCount,
+            .firstMeshlet = half,
+            .meshletCount = static_cast<u32>(meshlets.Size()) - half,
+            .firstInstance = firstInstanceCount
+        });
+        const u32 commandCount = batches.Back().firstCommand + batches.Back().meshletCount * secondInstanceCount;
+
+        Mat4 projection = Math::Perspective(Math::Radians(60.0f), 1.0f, 0.1f, 100.0f);
+
+        usize drawn = 0;
+        usize visible = 0;
+        usize total = 0;
+
+        for (const Vec3& viewPos : {Vec3{10.0f, 2.0f, 12.0f}, Vec3{-6.0f, 1.0f, 0.5f}, Vec3{3.0f, 1.5f, 0.0f}, Vec3{25.0f, -4.0f, -6.0f}})
+        {
+            //Math::LookAt maps the target to +z and the projection looks down -z, so the target is mirrored
+            const Vec3 target{9.0f, 1.0f, 0.0f};
+            const Mat4 viewProjection = projection * Math::LookAt(viewPos, viewPos * 2.0f - target, Vec3{0.0f, 1.0f, 0.0f});
+
+            MeshletCulling::Input input{
+                .transforms = transforms,
+                .meshlets = meshlets,
+                .bounds = bounds,
+                .batches = batches,
+                .batchInstances = batchInstances,
+                .frustum = Math::ExtractFrustum(viewProjection),
+                .viewPos = viewPos,
+                .commandCount = commandCount
+            };
+
+            Array<DrawIndexedIndirectCommand> commands{};
+            MeshletCulling::BuildDrawCommands(input, commands);
+            REQUIRE(commands.Size() == commandCount);
+
+            //commands are laid out by batch, instance and meshlet
+            u32 command = 0;
+            for (const MeshletBatch& batch : batches)
+            {
+                const u32 instanceCount = &batch == &batches.Back() ? secondInstanceCount : firstInstanceCount;
+                for (u32 instance = 0; instance < instanceCount; ++instance)
+                {
+                    const u32 transformIndex = batchInstances[batch.firstInstance + instance];
+                    for (u32 m = batch.firstMeshlet; m < batch.firstMeshlet + batch.meshletCount; ++m, ++command)
+                    {
+                        const DrawIndexedIndirectCommand& draw = commands[command];
+                        CHECK(draw.firstIndex == meshlets[m].firstIndex);
+                        CHECK(draw.indexCount == meshlets[m].indexCount);
+                        CHECK(draw.firstInstance == transformIndex);
+
+                        //never culls a visible meshlet
+                        if (BruteForceVisible(vertices, indices, meshlets[m], transforms[transformIndex], input.frustum, viewPos))
+                        {
+                            CHECK(draw.instanceCount == 1);
+                            visible++;
+                        }
+
+                        drawn += draw.instanceCount;
+                        total++;
+                    }
+                }
+            }
+        }
+
+        //the spheres outside the view and the meshlets facing away are culled, without drawing much more than needed
+        CHECK(drawn < total * 3 / 4);
+        CHECK(drawn < visible * 3 / 2);
+    }
+}
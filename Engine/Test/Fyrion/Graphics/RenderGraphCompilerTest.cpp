@@ -0,0 +1,185 @@
+#include <doctest.h>
+
+#include "Fyrion/Graphics/RenderGraphCompiler.hpp"
+
+using namespace Fyrion;
+
+namespace
+{
+    RenderGraphResourceCreation Attachment(StringView name, Format format)
+    {
+        return RenderGraphResourceCreation{.name = name, .type = RenderGraphResourceType::Attachment, .scale = {1.0, 1.0}, .format = format};
+    }
+
+    RenderGraphResourceCreation Texture(StringView name, f32 scale, Format format)
+    {
+        return RenderGraphResourceCreation{.name = name, .type = RenderGraphResourceType::Texture, .scale = {scale, scale}, .format = format};
+    }
+
+    RenderGraphResourceCreation Input(StringView name, Format format)
+    {
+        return RenderGraphResourceCreation{.name = name, .type = RenderGraphResourceType::Texture, .format = format};
+    }
+
+    RenderGraphEdge Edge(StringView nodeOutput, StringView output, StringView nodeInput, StringView input)
+    {
+        return RenderGraphEdge{.output = output, .nodeOutput = nodeOutput, .input = input, .nodeInput = nodeInput};
+    }
+
+    const RenderGraphCompiledPass* FindPass(const CompiledRenderGraph& graph, Span<const RenderGraphPassCreation> passes, StringView name)
+    {
+        for (const RenderGraphCompiledPass& pass : graph.passes)
+        {
+            if (passes[pass.pass].name == name)
+            {
+                return &pass;
+            }
+        }
+        return nullptr;
+    }
+
+    TEST_CASE("Graphics::RenderGraphCompiler")
+    {
+        Array<RenderGraphPassCreation> passes{
+            RenderGraphPassCreation{.name = "Scene", .outputs = {Attachment("Color", Format::RGBA16F), Attachment("Depth", Format::Depth)}, .type = RenderGraphPassType::Graphics},
+            RenderGraphPassCreation{.name = "Debug", .inputs = {Input("Depth", Format::Depth)}, .outputs = {Texture("DebugView", 1.0, Format::RGBA32F)}, .type = RenderGraphPassType::Compute},
+            RenderGraphPassCreation{.name = "Bright", .inputs = {Input("Color", Format::RGBA16F)}, .outputs = {Texture("Bright", 0.5, Format::RGBA16F)}, .type = RenderGraphPassType::Compute},
+            RenderGraphPassCreation{.name = "BlurH", .inputs = {Input("Bright", Format::RGBA16F)}, .outputs = {Texture("BlurH", 0.5, Format::RGBA16F)}, .type = RenderGraphPassType::Compute},
+            RenderGraphPassCreation{.name = "BlurV", .inputs = {Input("BlurH", Format::RGBA16F)}, .outputs = {Texture("BlurV", 0.5, Format::RGBA16F)}, .type = RenderGraphPassType::Compute},
+            RenderGraphPassCreation{.name = "Composite", .inputs = {Input("Color", Format::RGBA16F), Input("BlurV", Format::RGBA16F)}, .outputs = {Texture("Output", 1.0, Format::RGBA16F)}, .type = RenderGraphPassType::Compute},
+        };
+
+        Array<RenderGraphEdge> edges{
+            Edge("Scene", "Depth", "Debug", "Depth"),
+            Edge("Scene", "Color", "Bright", "Color"),
+            Edge("Bright", "Bright", "BlurH", "Bright"),
+            Edge("BlurH", "BlurH", "BlurV", "BlurH"),
+            Edge("Scene", "Color", "Composite", "Color"),
+            Edge("BlurV", "BlurV", "Composite", "BlurV"),
+        };
+
+        RenderGraphCompileInfo info{
+            .passes = {passes.Data(), passes.Size()},
+            .edges = {edges.Data(), edges.Size()},
+            .colorOutput = "Composite#Output",
+            .depthOutput = "Scene#Depth",
+            .viewportExtent = {1000, 500}
+        };
+
+        const usize fullSize = 1000 * 500 * 8;
+        const usize halfSize = 500 * 250 * 8;
+
+        CompiledRenderGraph graph = RenderGraphCompiler::Compile(info);
+
+        //Debug doesn't contribute to the outputs
+        REQUIRE(graph.passes.Size() == 5);
+        CHECK(FindPass(graph, info.passes, "Debug") == nullptr);
+        CHECK(graph.FindResource("Debug#DebugView") == U32_MAX);
+
+        CHECK(passes[graph.passes[0].pass].name == "Scene");
+        CHECK(passes[graph.passes[4].pass].name == "Composite");
+
+        u32 color = graph.FindResource("Scene#Color");
+        u32 bright = graph.FindResource("Bright#Bright");
+        u32 blurH = graph.FindResource("BlurH#BlurH");
+        u32 blurV = graph.FindResource("BlurV#BlurV");
+        REQUIRE(color != U32_MAX);
+        REQUIRE(bright != U32_MAX);
+        REQUIRE(blurH != U32_MAX);
+        REQUIRE(blurV != U32_MAX);
+
+        CHECK(graph.resources[color].firstPass == 0);
+        CHECK(graph.resources[color].lastPass == 4);
+        CHECK(graph.resources[bright].lastPass == 2);
+        CHECK_FALSE(graph.resources[graph.colorOutput].transient);
+        CHECK_FALSE(graph.resources[graph.depthOutput].transient);
+
+        SUBCASE("Aliasing")
+        {
+            //bright is released before blurV is written, blurH overlaps with both
+            CHECK(graph.resources[bright].aliasSlot != U32_MAX);
+            CHECK(graph.resources[bright].aliasSlot == graph.resources[blurV].aliasSlot);
+            CHECK(graph.resources[blurH].aliasSlot == U32_MAX);
+            CHECK(graph.resources[color].aliasSlot == U32_MAX);
+            CHECK(graph.aliasSlots.Size() == 1);
+
+            CHECK(graph.transientMemory == fullSize + 3 * halfSize + 1000 * 500 * 16);
+            CHECK(graph.aliasedMemory == fullSize + 2 * halfSize);
+
+            info.aliasing = false;
+            CompiledRenderGraph noAliasing = RenderGraphCompiler::Compile(info);
+            CHECK(noAliasing.aliasSlots.Empty());
+            CHECK(noAliasing.aliasedMemory == fullSize + 3 * halfSize);
+        }
+
+        SUBCASE("Barriers")
+        {
+            const RenderGraphCompiledPass* scene = FindPass(graph, info.passes, "Scene");
+            REQUIRE(scene);
+            REQUIRE(scene->barriers.Size() == 1);
+            CHECK(scene->barriers[0].resource == color);
+            CHECK(scene->barriers[0].oldLayout == ResourceLayout::Undefined);
+            CHECK(scene->barriers[0].newLayout == ResourceLayout::ColorAttachment);
+
+            //depth ends each frame as attachment, no barrier is needed
+            CHECK(graph.resources[graph.depthOutput].initialLayout == ResourceLayout::DepthStencilAttachment);
+
+            const RenderGraphCompiledPass* brightPass = FindPass(graph, info.passes, "Bright");
+            REQUIRE(brightPass);
+            REQUIRE(brightPass->barriers.Size() == 2);
+            CHECK(brightPass->barriers[0].resource == color);
+            CHECK(brightPass->barriers[0].oldLayout == ResourceLayout::ColorAttachment);
+            CHECK(brightPass->barriers[0].newLayout == ResourceLayout::ShaderReadOnly);
+            CHECK(brightPass->barriers[1].resource == bright);
+            CHECK(brightPass->barriers[1].oldLayout == ResourceLayout::Undefined);
+            CHECK(brightPass->barriers[1].newLayout == ResourceLayout::General);
+
+            //color is already readable
+            const RenderGraphCompiledPass* composite = FindPass(graph, info.passes, "Composite");
+            REQUIRE(composite);
+            REQUIRE(composite->barriers.Size() == 2);
+            CHECK(composite->barriers[0].resource == blurV);
+            CHECK(composite->barriers[0].newLayout == ResourceLayout::ShaderReadOnly);
+            CHECK(composite->barriers[1].resource == graph.colorOutput);
+            CHECK(composite->barriers[1].oldLayout == ResourceLayout::ShaderReadOnly);
+            CHECK(composite->barriers[1].newLayout == ResourceLayout::General);
+
+            REQUIRE(graph.finalBarriers.Size() == 1);
+            CHECK(graph.finalBarriers[0].resource == graph.colorOutput);
+            CHECK(graph.finalBarriers[0].newLayout == ResourceLayout::ShaderReadOnly);
+        }
+    }
+
+    TEST_CASE("Graphics::RenderGraphCompilerInPlace")
+    {
+        Array<RenderGraphPassCreation> passes{
+            RenderGraphPassCreation{.name = "Light", .outputs = {Texture("LightColor", 1.0, Format::RGBA16F)}, .type = RenderGraphPassType::Compute},
+            RenderGraphPassCreation{.name = "Sky", .inputs = {Input("LightColor", Format::RGBA16F)}, .outputs = {Texture("LightColor", 1.0, Format::RGBA16F)}, .type = RenderGraphPassType::Compute},
+            RenderGraphPassCreation{.name = "Post", .inputs = {Input("LightColor", Format::RGBA16F)}, .outputs = {Texture("OutputColor", 1.0, Format::RGBA16F)}, .type = RenderGraphPassType::Compute},
+        };
+
+        Array<RenderGraphEdge> edges{
+            Edge("Light", "LightColor", "Sky", "LightColor"),
+            Edge("Sky", "LightColor", "Post", "LightColor"),
+        };
+
+        CompiledRenderGraph graph = RenderGraphCompiler::Compile(RenderGraphCompileInfo{
+            .passes = {passes.Data(), passes.Size()},
+            .edges = {edges.Data(), edges.Size()},
+            .colorOutput = "Post#OutputColor",
+            .viewportExtent = {64, 64}
+        });
+
+        REQUIRE(graph.passes.Size() == 3);
+        REQUIRE(graph.resources.Size() == 2);
+
+        u32 lightColor = graph.FindResource("Light#LightColor");
+        CHECK(graph.FindResource("Sky#LightColor") == lightColor);
+        CHECK(graph.resources[lightColor].lastPass == 2);
+
+        //read and written by sky, only the storage barrier is recorded
+        REQUIRE(graph.passes[1].barriers.Size() == 1);
+        CHECK(graph.passes[1].barriers[0].oldLayout == ResourceLayout::General);
+        CHECK(graph.passes[1].barriers[0].newLayout == ResourceLayout::General);
+    }
+}
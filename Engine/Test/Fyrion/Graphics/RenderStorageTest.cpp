@@ -0,0 +1,50 @@
+#include <doctest.h>
+
+#include "Fyrion/Graphics/RenderStorage.hpp"
+
+using namespace Fyrion;
+
+namespace
+{
+    TEST_CASE("Graphics::RenderStorageMeshes")
+    {
+        MaterialAsset* materials[3] = {
+            reinterpret_cast<MaterialAsset*>(0x10),
+            reinterpret_cast<MaterialAsset*>(0x20),
+            reinterpret_cast<MaterialAsset*>(0x30)
+        };
+
+        MeshRenderHandle first = RenderStorage::AddMeshToRender(Math::Translate(Vec3{1, 0, 0}), nullptr, Span<MaterialAsset*>(materials, 1));
+        MeshRenderHandle second = RenderStorage::AddMeshToRender(Math::Translate(Vec3{2, 0, 0}), nullptr, Span<MaterialAsset*>(materials, 3));
+        REQUIRE(first);
+        REQUIRE(second);
+
+        MeshRenderList list = RenderStorage::GetMeshesToRender();
+        REQUIRE(list.Size() == 2);
+        CHECK(list.GetMaterial(1, 2) == materials[2]);
+        CHECK(list.GetMaterial(0, 1) == nullptr);
+
+        RenderStorage::RemoveMeshFromRender(first);
+        CHECK(!RenderStorage::UpdateMeshTransform(first, Mat4{1.0}));
+
+        list = RenderStorage::GetMeshesToRender();
+        REQUIRE(list.Size() == 1);
+        CHECK(list.transforms[0][3].x == 2);
+        CHECK(list.GetMaterial(0, 0) == materials[0]);
+
+        MeshRenderHandle third = RenderStorage::AddMeshToRender(Mat4{1.0}, nullptr, {});
+        CHECK(third.index == first.index);
+        CHECK(third.generation != first.generation);
+
+        CHECK(RenderStorage::UpdateMeshToRender(second, Math::Translate(Vec3{3, 0, 0}), nullptr, Span<MaterialAsset*>(materials + 1, 2)));
+        list = RenderStorage::GetMeshesToRender();
+        CHECK(list.transforms[0][3].x == 3);
+        CHECK(list.GetMaterial(0, 0) == materials[1]);
+        CHECK(list.GetMaterial(0, 2) == nullptr);
+
+        RenderStorage::RemoveMeshFromRender(second);
+        RenderStorage::RemoveMeshFromRender(third);
+        RenderStorage::RemoveMeshFromRender(third);
+        CHECK(RenderStorage::GetMeshesToRender().Size() == 0);
+    }
+}
@@ -87,6 +87,95 @@ namespace
         Engine::Destroy();
     }
 
+    TEST_CASE("Graphics::ShaderManager::CompileShaders")
+    {
+        Engine::Init();
+        {
+            Array<ShaderCreation> shaderCreations{};
+            for (u32 i = 0; i < 4; ++i)
+            {
+                shaderCreations.EmplaceBack(ShaderCreation{.source = simpleShader, .entryPoint = "MainVS", .shaderStage = ShaderStage::Vertex, .renderApi = RenderApiType::Vulkan});
+                shaderCreations.EmplaceBack(ShaderCreation{.source = simpleShader, .entryPoint = "MainPS", .shaderStage = ShaderStage::Pixel, .renderApi = RenderApiType::Vulkan});
+            }
+
+            Array<Array<u8>> bytes(shaderCreations.Size());
+            CHECK(ShaderManager::CompileShaders(shaderCreations, bytes));
+
+            //compiled in parallel, the output is the same as compiling one by one
+            for (usize i = 0; i < shaderCreations.Size(); ++i)
+            {
+                Array<u8> expected{};
+                REQUIRE(ShaderManager::CompileShader(shaderCreations[i], expected));
+                CHECK(bytes[i] == expected);
+            }
+
+            shaderCreations.Back().entryPoint = "MissingPS";
+            CHECK(!ShaderManager::CompileShaders(shaderCreations, bytes));
+        }
+        Engine::Destroy();
+    }
+
+    TEST_CASE("Graphics::ShaderManager::Cache")
+    {
+        Engine::Init();
+        {
+            String cacheDir = Path::Join(FY_TEST_FILES, "ShaderCacheTest");
+            FileSystem::Remove(cacheDir);
+            ShaderManager::SetCacheDirectory(cacheDir);
+
+            Array<ShaderStageInfo> stages{};
+            stages.EmplaceBack(ShaderStageInfo{.stage = ShaderStage::Vertex, .entryPoint = "MainVS"});
+            stages.EmplaceBack(ShaderStageInfo{.stage = ShaderStage::Pixel, .entryPoint = "MainPS"});
+
+            u64 key = ShaderManager::GetCacheKey(nullptr, simpleShader, stages, RenderApiType::Vulkan);
+            CHECK(key == ShaderManager::GetCacheKey(nullptr, simpleShader, stages, RenderApiType::Vulkan));
+            CHECK(key != ShaderManager::GetCacheKey(nullptr, simpleShader, stages, RenderApiType::D3D12));
+            CHECK(key != ShaderManager::GetCacheKey(nullptr, "float4 MainPS() : SV_TARGET { return 0; }", stages, RenderApiType::Vulkan));
+            CHECK(key != ShaderManager::GetCacheKey(nullptr, simpleShader, Span<ShaderStageInfo>{stages.Data(), 1}, RenderApiType::Vulkan));
+
+            ShaderManager::ShaderCacheStats initialStats = ShaderManager::GetCacheStats();
+
+            Array<u8>              bytes{};
+            Array<ShaderStageInfo> cachedStages{};
+            ShaderInfo             cachedInfo{};
+            CHECK(!ShaderManager::LoadFromCache(key, bytes, cachedStages, cachedInfo));
+
+            Array<u8> compiled{};
+            for (u32 i = 0; i < 100; ++i)
+            {
+                compiled.EmplaceBack(static_cast<u8>(i * 7));
+            }
+            stages[0].size = 60;
+            stages[1].offset = 60;
+            stages[1].size = 40;
+
+            ShaderInfo shaderInfo{};
+            shaderInfo.stride = 24;
+            shaderInfo.pushConstants.EmplaceBack(ShaderPushConstant{.name = "camera", .size = 128, .stage = ShaderStage::Vertex});
+
+            ShaderManager::SaveToCache(key, compiled, stages, shaderInfo);
+
+            REQUIRE(ShaderManager::LoadFromCache(key, bytes, cachedStages, cachedInfo));
+            CHECK(bytes == compiled);
+            REQUIRE(cachedStages.Size() == 2);
+            CHECK(cachedStages[1].stage == ShaderStage::Pixel);
+            CHECK(cachedStages[1].entryPoint == "MainPS");
+            CHECK(cachedStages[1].offset == 60);
+            CHECK(cachedStages[1].size == 40);
+            CHECK(cachedInfo.stride == 24);
+            REQUIRE(cachedInfo.pushConstants.Size() == 1);
+            CHECK(cachedInfo.pushConstants[0].name == "camera");
+            CHECK(cachedInfo.pushConstants[0].size == 128);
+
+            ShaderManager::ShaderCacheStats stats = ShaderManager::GetCacheStats();
+            CHECK(stats.hits - initialStats.hits == 1);
+            CHECK(stats.misses - initialStats.misses == 1);
+
+            FileSystem::Remove(cacheDir);
+        }
+        Engine::Destroy();
+    }
+
 	TEST_CASE("Graphics::ShaderAsset")
     {
 #if 0
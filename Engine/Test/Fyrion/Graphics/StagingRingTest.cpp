@@ -0,0 +1,53 @@
+#include <doctest.h>
+
+#include "Fyrion/Graphics/StagingRing.hpp"
+
+using namespace Fyrion;
+
+namespace
+{
+    TEST_CASE("Graphics::StagingRing")
+    {
+        StagingRing ring(1024);
+
+        usize offset = 0;
+        CHECK(ring.Allocate(100, 16, offset));
+        CHECK(offset == 0);
+        CHECK(ring.Allocate(100, 16, offset));
+        CHECK(offset == 112);
+        ring.Submit(1);
+
+        CHECK(ring.Allocate(600, 16, offset));
+        CHECK(offset == 224);
+        ring.Submit(2);
+
+        //the 192 bytes left at the end are not enough, the start is still used by submission 1
+        CHECK_FALSE(ring.Allocate(200, 16, offset));
+        CHECK_FALSE(ring.Allocate(2048, 16, offset));
+
+        //wraps to the start once submission 1 is finished, the end of the buffer is skipped
+        ring.Release(1);
+        CHECK(ring.Allocate(200, 16, offset));
+        CHECK(offset == 0);
+        CHECK(ring.GetUsed() == 612 + 200 + 200);
+
+        //only the 12 bytes between the wrapped head and submission 2 are free
+        CHECK_FALSE(ring.Allocate(16, 16, offset));
+        CHECK(ring.Allocate(8, 4, offset));
+        CHECK(offset == 200);
+        ring.Submit(3);
+
+        //releasing a later submission releases the previous ones, the ring restarts when empty
+        ring.Release(3);
+        CHECK(ring.GetUsed() == 0);
+        CHECK(ring.Allocate(1024, 16, offset));
+        CHECK(offset == 0);
+
+        //regions are released only once their submission is complete
+        ring.Submit(4);
+        ring.Release(3);
+        CHECK(ring.GetUsed() == 1024);
+        ring.Release(4);
+        CHECK(ring.GetUsed() == 0);
+    }
+}
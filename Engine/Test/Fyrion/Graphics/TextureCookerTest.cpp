@@ -0,0 +1,394 @@
+#include <doctest.h>
+
+#include <cmath>
+
+#include "Fyrion/Core/Array.hpp"
+#include "Fyrion/Graphics/TextureCooker.hpp"
+
+using namespace Fyrion;
+
+namespace
+{
+    constexpr u32 Weights4[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+    u32 ReadBits(const u8* data, u32& position, u32 count)
+    {
+        u32 value = 0;
+        for (u32 i = 0; i < count; ++i, ++position)
+        {
+            value |= ((data[position / 8] >> (position % 8)) & 1) << i;
+        }
+        return value;
+    }
+
+    u32 Interpolate(u32 e0, u32 e1, u32 weight)
+    {
+        return ((64 - weight) * e0 + weight * e1 + 32) >> 6;
+    }
+
+    f32 HalfToFloat(u32 half)
+    {
+        const u32 exponent = (half >> 10) & 0x1F;
+        const u32 mantissa = half & 0x3FF;
+        if (exponent == 0)
+        {
+            return std::ldexp(static_cast<f32>(mantissa), -24);
+        }
+        return std::ldexp(static_cast<f32>(mantissa | 0x400), static_cast<i32>(exponent) - 25);
+    }
+
+    //reference decoders, each one writes the 16 pixels of one block as RGBA
+
+    void DecodeBC1(const u8* block, u8* pixels)
+    {
+        const u32 c0 = block[0] | block[1] << 8;
+        const u32 c1 = block[2] | block[3] << 8;
+
+        u32 colors[4][3];
+        for (u32 i = 0; i < 2; ++i)
+        {
+            const u32 c = i == 0 ? c0 : c1;
+            colors[i][0] = (c >> 11) * 255 / 31;
+            colors[i][1] = ((c >> 5) & 63) * 255 / 63;
+            colors[i][2] = (c & 31) * 255 / 31;
+        }
+
+        REQUIRE(c0 > c1);
+        for (u32 c = 0; c < 3; ++c)
+        {
+            colors[2][c] = (2 * colors[0][c] + colors[1][c]) / 3;
+            colors[3][c] = (colors[0][c] + 2 * colors[1][c]) / 3;
+        }
+
+        for (u32 i = 0; i < 16; ++i)
+        {
+            const u32 index = (block[4 + i / 4] >> ((i % 4) * 2)) & 3;
+            for (u32 c = 0; c < 3; ++c)
+            {
+                pixels[i * 4 + c] = static_cast<u8>(colors[index][c]);
+            }
+            pixels[i * 4 + 3] = 255;
+        }
+    }
+
+    void DecodeBC4(const u8* block, u8* pixels, u32 channel)
+    {
+        u32 values[8] = {block[0], block[1]};
+        if (values[0] > values[1])
+        {
+            for (u32 i = 1; i < 7; ++i)
+            {
+                values[i + 1] = ((7 - i) * values[0] + i * values[1]) / 7;
+            }
+        }
+        else
+        {
+            for (u32 i = 1; i < 5; ++i)
+            {
+                values[i + 1] = ((5 - i) * values[0] + i * values[1]) / 5;
+            }
+            values[6] = 0;
+            values[7] = 255;
+        }
+
+        u32 position = 16;
+        for (u32 i = 0; i < 16; ++i)
+        {
+            pixels[i * 4 + channel] = static_cast<u8>(values[ReadBits(block, position, 3)]);
+        }
+    }
+
+    void DecodeBC7Mode6(const u8* block, u8* pixels)
+    {
+        u32 position = 0;
+        REQUIRE(ReadBits(block, position, 7) == 1 << 6);
+
+        u32 endpoints[2][4];
+        for (u32 c = 0; c < 4; ++c)
+        {
+            endpoints[0][c] = ReadBits(block, position, 7) << 1;
+            endpoints[1][c] = ReadBits(block, position, 7) << 1;
+        }
+
+        for (u32 e = 0; e < 2; ++e)
+        {
+            const u32 pBit = ReadBits(block, position, 1);
+            for (u32 c = 0; c < 4; ++c)
+            {
+                endpoints[e][c] |= pBit;
+            }
+        }
+
+        for (u32 i = 0; i < 16; ++i)
+        {
+            const u32 index = ReadBits(block, position, i == 0 ? 3 : 4);
+            for (u32 c = 0; c < 4; ++c)
+            {
+                pixels[i * 4 + c] = static_cast<u8>(Interpolate(endpoints[0][c], endpoints[1][c], Weights4[index]));
+            }
+        }
+    }
+
+    void DecodeBC6HMode11(const u8* block, f32* pixels)
+    {
+        u32 position = 0;
+        REQUIRE(ReadBits(block, position, 5) == 0x03);
+
+        u32 endpoints[2][3];
+        for (u32 e = 0; e < 2; ++e)
+        {
+            for (u32 c = 0; c < 3; ++c)
+            {
+                const u32 value = ReadBits(block, position, 10);
+                endpoints[e][c] = value == 0 ? 0 : value == 1023 ? 0xFFFF : ((value << 16) + 0x8000) >> 10;
+            }
+        }
+
+        for (u32 i = 0; i < 16; ++i)
+        {
+            const u32 index = ReadBits(block, position, i == 0 ? 3 : 4);
+            for (u32 c = 0; c < 3; ++c)
+            {
+                pixels[i * 4 + c] = HalfToFloat((Interpolate(endpoints[0][c], endpoints[1][c], Weights4[index]) * 31) >> 6);
+            }
+            pixels[i * 4 + 3] = 1.0f;
+        }
+    }
+
+    template<typename T, typename Decode>
+    Array<T> DecodeImage(const Array<u8>& data, Extent extent, u32 blockSize, Decode decode)
+    {
+        Array<T> image(extent.width * extent.height * 4, T{});
+        const u32 blocksX = (extent.width + 3) / 4;
+        for (u32 by = 0; by < (extent.height + 3) / 4; ++by)
+        {
+            for (u32 bx = 0; bx < blocksX; ++bx)
+            {
+                T pixels[64] = {};
+                decode(data.Data() + (by * blocksX + bx) * blockSize, pixels);
+                for (u32 i = 0; i < 16; ++i)
+                {
+                    const u32 x = bx * 4 + i % 4;
+                    const u32 y = by * 4 + i / 4;
+                    if (x < extent.width && y < extent.height)
+                    {
+                        for (u32 c = 0; c < 4; ++c)
+                        {
+                            image[(y * extent.width + x) * 4 + c] = pixels[i * 4 + c];
+                        }
+                    }
+                }
+            }
+        }
+        return image;
+    }
+
+    Array<u8> CreateGradient(Extent extent, bool opaque)
+    {
+        Array<u8> image(extent.width * extent.height * 4);
+        for (u32 y = 0; y < extent.height; ++y)
+        {
+            for (u32 x = 0; x < extent.width; ++x)
+            {
+                u8* pixel = &image[(y * extent.width + x) * 4];
+                pixel[0] = static_cast<u8>(x * 255 / (extent.width - 1));
+                pixel[1] = static_cast<u8>(y * 255 / (extent.height - 1));
+                pixel[2] = static_cast<u8>(128 + 100 * std::sin(static_cast<f32>(x) * 0.3f + static_cast<f32>(y) * 0.2f));
+                pixel[3] = opaque ? 255 : static_cast<u8>((x + y) * 255 / (extent.width + extent.height - 2));
+            }
+        }
+        return image;
+    }
+
+    f32 RMSE(const Array<u8>& a, const Array<u8>& b, u32 firstChannel, u32 channelCount)
+    {
+        f64 sum = 0;
+        for (usize i = 0; i < a.Size(); i += 4)
+        {
+            for (u32 c = firstChannel; c < firstChannel + channelCount; ++c)
+            {
+                const f64 diff = static_cast<f64>(a[i + c]) - static_cast<f64>(b[i + c]);
+                sum += diff * diff;
+            }
+        }
+        return static_cast<f32>(std::sqrt(sum / static_cast<f64>(a.Size() / 4 * channelCount)));
+    }
+
+    TEST_CASE("Graphics::TextureCookerSizes")
+    {
+        CHECK(TextureCooker::GetImageSize(Format::BC1, Extent{5, 5}) == 32);
+        CHECK(TextureCooker::GetImageSize(Format::BC7, Extent{8, 4}) == 32);
+        CHECK(TextureCooker::GetImageSize(Format::RGBA, Extent{5, 5}) == 100);
+        CHECK(TextureCooker::GetMipLevels(Extent{256, 64}) == 9);
+        CHECK(TextureCooker::GetMipLevels(Extent{1, 1}) == 1);
+        CHECK(TextureCooker::GetMipExtent(Extent{5, 3}, 1) == Extent{2, 1});
+        CHECK(TextureCooker::GetMipExtent(Extent{5, 3}, 4) == Extent{1, 1});
+        CHECK(!TextureCooker::IsCompressed(Format::RGBA));
+        CHECK(TextureCooker::IsCompressed(Format::BC6H));
+    }
+
+    TEST_CASE("Graphics::TextureCookerMips")
+    {
+        SUBCASE("Box")
+        {
+            Array<u8> src(4 * 4 * 4);
+            for (usize i = 0; i < src.Size(); ++i)
+            {
+                src[i] = static_cast<u8>(i * 3);
+            }
+
+            Array<u8> dst(2 * 2 * 4);
+            TextureCooker::GenerateMip(MipFilter::Box, src.Data(), Extent{4, 4}, dst.Data());
+
+            for (u32 y = 0; y < 2; ++y)
+            {
+                for (u32 x = 0; x < 2; ++x)
+                {
+                    for (u32 c = 0; c < 4; ++c)
+                    {
+                        u32 sum = 0;
+                        for (u32 s = 0; s < 4; ++s)
+                        {
+                            sum += src[((2 * y + s / 2) * 4 + 2 * x + s % 2) * 4 + c];
+                        }
+                        CHECK(dst[(y * 2 + x) * 4 + c] == (sum + 2) / 4);
+                    }
+                }
+            }
+        }
+
+        SUBCASE("KaiserConstant")
+        {
+            const Extent extent{37, 21};
+            Array<u8>    src(extent.width * extent.height * 4);
+            for (usize i = 0; i < src.Size(); ++i)
+            {
+                src[i] = static_cast<u8>(40 + (i % 4) * 50);
+            }
+
+            const Extent mipExtent = TextureCooker::GetMipExtent(extent, 1);
+            Array<u8>    dst(mipExtent.width * mipExtent.height * 4);
+            TextureCooker::GenerateMip(MipFilter::Kaiser, src.Data(), extent, dst.Data());
+
+            for (usize i = 0; i < dst.Size(); ++i)
+            {
+                CHECK(dst[i] == 40 + (i % 4) * 50);
+            }
+        }
+
+        SUBCASE("HDRChain")
+        {
+            Extent     extent{13, 7};
+            Array<f32> src(extent.width * extent.height * 4, 8.0f);
+
+            for (u32 mip = 1; mip < TextureCooker::GetMipLevels(Extent{13, 7}); ++mip)
+            {
+                const Extent mipExtent = TextureCooker::GetMipExtent(extent, 1);
+                Array<f32>   dst(mipExtent.width * mipExtent.height * 4);
+                TextureCooker::GenerateMip(MipFilter::Kaiser, src.Data(), extent, dst.Data());
+
+                for (f32 value : dst)
+                {
+                    CHECK(value == doctest::Approx(8.0f));
+                }
+
+                src = dst;
+                extent = mipExtent;
+            }
+            CHECK(extent == Extent{1, 1});
+        }
+    }
+
+    TEST_CASE("Graphics::TextureCookerBC")
+    {
+        const Extent extent{30, 22};
+
+        SUBCASE("BC1")
+        {
+            Array<u8> src = CreateGradient(extent, true);
+            Array<u8> data(TextureCooker::GetImageSize(Format::BC1, extent));
+            TextureCooker::Compress(Format::BC1, src.Data(), extent, data.Data());
+
+            Array<u8> decoded = DecodeImage<u8>(data, extent, 8, DecodeBC1);
+            CHECK(RMSE(src, decoded, 0, 3) < 10.0f);
+        }
+
+        SUBCASE("BC3")
+        {
+            Array<u8> src = CreateGradient(extent, false);
+            Array<u8> data(TextureCooker::GetImageSize(Format::BC3, extent));
+            TextureCooker::Compress(Format::BC3, src.Data(), extent, data.Data());
+
+            Array<u8> decoded = DecodeImage<u8>(data, extent, 16, [](const u8* block, u8* pixels)
+            {
+                DecodeBC1(block + 8, pixels);
+                DecodeBC4(block, pixels, 3);
+            });
+            CHECK(RMSE(src, decoded, 0, 3) < 10.0f);
+            CHECK(RMSE(src, decoded, 3, 1) < 2.0f);
+        }
+
+        SUBCASE("BC4andBC5")
+        {
+            Array<u8> src = CreateGradient(extent, true);
+            Array<u8> data(TextureCooker::GetImageSize(Format::BC5, extent));
+            TextureCooker::Compress(Format::BC5, src.Data(), extent, data.Data());
+
+            Array<u8> decoded = DecodeImage<u8>(data, extent, 16, [](const u8* block, u8* pixels)
+            {
+                DecodeBC4(block, pixels, 0);
+                DecodeBC4(block + 8, pixels, 1);
+            });
+            CHECK(RMSE(src, decoded, 0, 2) < 2.0f);
+
+            data.Resize(TextureCooker::GetImageSize(Format::BC4, extent));
+            TextureCooker::Compress(Format::BC4, src.Data(), extent, data.Data());
+            decoded = DecodeImage<u8>(data, extent, 8, [](const u8* block, u8* pixels)
+            {
+                DecodeBC4(block, pixels, 0);
+            });
+            CHECK(RMSE(src, decoded, 0, 1) < 2.0f);
+        }
+
+        SUBCASE("BC7")
+        {
+            Array<u8> src = CreateGradient(extent, false);
+            Array<u8> data(TextureCooker::GetImageSize(Format::BC7, extent));
+            TextureCooker::Compress(Format::BC7, src.Data(), extent, data.Data());
+
+            Array<u8> decoded = DecodeImage<u8>(data, extent, 16, DecodeBC7Mode6);
+            CHECK(RMSE(src, decoded, 0, 4) < 7.0f);
+        }
+
+        SUBCASE("BC6H")
+        {
+            Array<f32> src(extent.width * extent.height * 4);
+            for (u32 y = 0; y < extent.height; ++y)
+            {
+                for (u32 x = 0; x < extent.width; ++x)
+                {
+                    f32* pixel = &src[(y * extent.width + x) * 4];
+                    pixel[0] = static_cast<f32>(x) * 0.5f;
+                    pixel[1] = static_cast<f32>(y) / 22.0f;
+                    pixel[2] = 2.0f + std::sin(static_cast<f32>(x + y) * 0.3f);
+                    pixel[3] = 1.0f;
+                }
+            }
+
+            Array<u8> data(TextureCooker::GetImageSize(Format::BC6H, extent));
+            TextureCooker::Compress(Format::BC6H, src.Data(), extent, data.Data());
+
+            Array<f32> decoded = DecodeImage<f32>(data, extent, 16, DecodeBC6HMode11);
+
+            f64 error = 0;
+            for (usize i = 0; i < src.Size(); i += 4)
+            {
+                for (u32 c = 0; c < 3; ++c)
+                {
+                    error += std::abs(decoded[i + c] - src[i + c]) / (src[i + c] + 0.25f);
+                }
+            }
+            CHECK(error / static_cast<f64>(src.Size() / 4 * 3) < 0.05);
+        }
+    }
+}
@@ -45,12 +45,20 @@ namespace
             FileSystem::CloseFile(fileHandler);
         }
 
+        {
+            FileHandler fileHandler = FileSystem::OpenFile(path, AccessMode::ReadOnly);
+            REQUIRE(fileHandler);
+            String newString{4};
+            CHECK(FileSystem::ReadFileAt(fileHandler, newString.begin(), 4, 12) == 4);
+            CHECK(newString == "zzzz");
+            FileSystem::CloseFile(fileHandler);
+        }
+
         CHECK(FileSystem::Remove(path));
     }
 
     TEST_CASE("IO:FileSystemMapFile")
     {
-#ifdef FY_WIN
         constexpr usize fileSize = 128;
 
         String path = Path::Join(FY_TEST_FILES, "TestMapFile.bin");
@@ -61,7 +69,7 @@ namespace
             CHECK(mapFile);
 
             CharPtr memory = (CharPtr) FileSystem::MapViewOfFile(mapFile);
-            CHECK(mapFile);
+            REQUIRE(memory);
 
             for (int i = 0; i < fileSize; ++i)
             {
@@ -81,12 +89,12 @@ namespace
             if (mapFile)
             {
                 CharPtr memory = (CharPtr) FileSystem::MapViewOfFile(mapFile);
-                CHECK(mapFile);
+                CHECK(memory);
                 if (memory)
                 {
                     for (int i = 0; i < fileSize; ++i)
                     {
-                        CHECK(memory[i] == i * 2);
+                        CHECK(memory[i] == static_cast<char>(i * 2));
                     }
 
                     FileSystem::UnmapViewOfFile(memory);
@@ -97,6 +105,5 @@ namespace
         }
 
         CHECK(FileSystem::Remove(path));
-#endif
     }
 }
\ No newline at end of file
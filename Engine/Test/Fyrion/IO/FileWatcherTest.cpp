@@ -0,0 +1,122 @@
+#include <doctest.h>
+#include <thread>
+
+#include "Fyrion/IO/FileSystem.hpp"
+#include "Fyrion/IO/FileWatcher.hpp"
+#include "Fyrion/IO/Path.hpp"
+
+using namespace Fyrion;
+
+namespace
+{
+    Array<FileWatcherModified> watcherEvents{};
+
+    void OnFileModified(const FileWatcherModified& modified)
+    {
+        watcherEvents.EmplaceBack(modified);
+    }
+
+    usize CountEvents(FileNotifyEvent event)
+    {
+        usize count = 0;
+        for (const FileWatcherModified& modified : watcherEvents)
+        {
+            count += modified.event == event;
+        }
+        return count;
+    }
+
+    //waits until the event arrives or the timeout expires
+    const FileWatcherModified* WaitForEvent(FileWatcher& fileWatcher, FileNotifyEvent event)
+    {
+        for (u32 i = 0; i < 100; ++i)
+        {
+            fileWatcher.CheckForUpdates(OnFileModified);
+            for (const FileWatcherModified& modified : watcherEvents)
+            {
+                if (modified.event == event)
+                {
+                    return &modified;
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+        return nullptr;
+    }
+
+    TEST_CASE("IO::FileWatcher")
+    {
+        i32 directoryTag = 0;
+        i32 fileTag = 0;
+
+        String directory = Path::Join(FY_TEST_FILES, "FileWatcherTest");
+        String file = Path::Join(directory, "WatchedFile.txt");
+
+        FileSystem::Remove(directory);
+        REQUIRE(FileSystem::CreateDirectory(directory));
+        FileSystem::SaveFileAsString(file, "initial");
+
+        FileWatcher fileWatcher{};
+        fileWatcher.Start();
+        fileWatcher.Watch(&directoryTag, directory);
+        fileWatcher.Watch(&fileTag, file);
+
+        //gives the polling fallback a cycle to register the paths
+        std::this_thread::sleep_for(std::chrono::milliseconds(150));
+
+        {
+            for (u32 i = 0; i < 5; ++i)
+            {
+                FileSystem::SaveFileAsString(file, "changed");
+            }
+
+            const FileWatcherModified* modified = WaitForEvent(fileWatcher, FileNotifyEvent::Modified);
+            REQUIRE(modified);
+            CHECK(modified->userData == &fileTag);
+            CHECK(modified->path == file);
+
+            //rapid writes are coalesced
+            std::this_thread::sleep_for(std::chrono::milliseconds(300));
+            fileWatcher.CheckForUpdates(OnFileModified);
+            CHECK(CountEvents(FileNotifyEvent::Modified) == 1);
+            watcherEvents.Clear();
+        }
+
+        {
+            String newFile = Path::Join(directory, "NewFile.txt");
+            FileSystem::SaveFileAsString(newFile, "new");
+
+            const FileWatcherModified* added = WaitForEvent(fileWatcher, FileNotifyEvent::Added);
+            REQUIRE(added);
+            CHECK(added->userData == &directoryTag);
+            CHECK(added->path == newFile);
+            watcherEvents.Clear();
+        }
+
+        String renamedFile = Path::Join(directory, "RenamedFile.txt");
+        {
+            REQUIRE(FileSystem::Rename(file, renamedFile));
+
+            const FileWatcherModified* renamed = WaitForEvent(fileWatcher, FileNotifyEvent::Renamed);
+            REQUIRE(renamed);
+            CHECK(renamed->userData == &fileTag);
+            CHECK(renamed->oldName == "WatchedFile");
+            CHECK(renamed->name == "RenamedFile");
+            CHECK(renamed->path == renamedFile);
+            watcherEvents.Clear();
+        }
+
+        {
+            REQUIRE(FileSystem::Remove(renamedFile));
+
+            const FileWatcherModified* removed = WaitForEvent(fileWatcher, FileNotifyEvent::Removed);
+            REQUIRE(removed);
+            CHECK(removed->userData == &fileTag);
+            CHECK(removed->path == renamedFile);
+            watcherEvents.Clear();
+        }
+
+        fileWatcher.Stop();
+        CHECK(FileSystem::Remove(directory));
+    }
+}
@@ -0,0 +1,166 @@
+#include <doctest.h>
+
+#include "Fyrion/Engine.hpp"
+#include "Fyrion/Core/Registry.hpp"
+#include "Fyrion/Scene/ComponentScheduler.hpp"
+#include "Fyrion/Scene/SceneManager.hpp"
+#include "Fyrion/Scene/SceneObject.hpp"
+
+using namespace Fyrion;
+
+namespace
+{
+    struct CounterComponent : Component
+    {
+        FY_BASE_TYPES(Component);
+
+        f64 value = 0;
+
+        inline static u32 updateCalls = 0;
+
+        static void Update(Span<CounterComponent*> components, f64 deltaTime)
+        {
+            updateCalls++;
+            for (CounterComponent* component : components)
+            {
+                component->value += deltaTime;
+            }
+        }
+
+        static void RegisterType(NativeTypeHandler<CounterComponent>& type)
+        {
+            type.Attribute<ComponentUpdate>(ComponentUpdate::Of<CounterComponent>());
+        }
+    };
+
+    struct FollowerComponent : Component
+    {
+        FY_BASE_TYPES(Component);
+
+        CounterComponent* target = nullptr;
+        f64               value = 0;
+
+        static void Update(Span<FollowerComponent*> components, f64 deltaTime)
+        {
+            for (FollowerComponent* component : components)
+            {
+                component->value = component->target->value;
+            }
+        }
+
+        static void RegisterType(NativeTypeHandler<FollowerComponent>& type)
+        {
+            type.Attribute<ComponentUpdate>(ComponentUpdate::Of<FollowerComponent>().Reads<CounterComponent>());
+        }
+    };
+
+    struct IndependentComponent : Component
+    {
+        FY_BASE_TYPES(Component);
+
+        static void Update(Span<IndependentComponent*> components, f64 deltaTime) {}
+
+        static void RegisterType(NativeTypeHandler<IndependentComponent>& type)
+        {
+            type.Attribute<ComponentUpdate>(ComponentUpdate::Of<IndependentComponent>());
+        }
+    };
+
+    struct StaticComponent : Component
+    {
+        FY_BASE_TYPES(Component);
+
+        static void RegisterType(NativeTypeHandler<StaticComponent>& type) {}
+    };
+
+    TEST_CASE("Scene::ComponentSchedulerBatches")
+    {
+        Engine::Init();
+        {
+            Registry::Type<CounterComponent>();
+            Registry::Type<StaticComponent>();
+
+            SceneObject* root = SceneManager::CreateObject();
+            SceneObject* first = SceneManager::CreateObject();
+            SceneObject* second = SceneManager::CreateObject();
+
+            CounterComponent& rootCounter = root->CreateComponent<CounterComponent>();
+            CounterComponent& firstCounter = first->CreateComponent<CounterComponent>();
+            CounterComponent& secondCounter = second->CreateComponent<CounterComponent>();
+            StaticComponent&  staticComponent = root->CreateComponent<StaticComponent>();
+
+            root->AddChild(first);
+            root->AddChild(second);
+
+            //inactive objects are not updated
+            CounterComponent::updateCalls = 0;
+            ComponentScheduler::Update(1.0);
+            CHECK(rootCounter.value == 0.0);
+
+            root->SetActive(true);
+            CHECK(staticComponent.updateIndex == U32_MAX);
+
+            ComponentScheduler::Update(0.5);
+            CHECK(CounterComponent::updateCalls == 1);
+            CHECK(rootCounter.value == 0.5);
+            CHECK(firstCounter.value == 0.5);
+            CHECK(secondCounter.value == 0.5);
+
+            root->RemoveChild(first);
+            ComponentScheduler::Update(0.5);
+            CHECK(rootCounter.value == 1.0);
+            CHECK(firstCounter.value == 0.5);
+            CHECK(secondCounter.value == 1.0);
+
+            root->RemoveComponent(&rootCounter);
+            CHECK(rootCounter.updateIndex == U32_MAX);
+            ComponentScheduler::Update(0.5);
+            CHECK(rootCounter.value == 1.0);
+            CHECK(secondCounter.value == 1.5);
+
+            second->AddComponent(&rootCounter);
+            ComponentScheduler::Update(0.5);
+            CHECK(rootCounter.value == 1.5);
+            CHECK(secondCounter.value == 2.0);
+
+            root->SetActive(false);
+            CHECK(secondCounter.updateIndex == U32_MAX);
+
+            MemoryGlobals::GetDefaultAllocator().DestroyAndFree(first);
+            MemoryGlobals::GetDefaultAllocator().DestroyAndFree(root);
+            ComponentScheduler::Clear();
+        }
+        Engine::Destroy();
+    }
+
+    TEST_CASE("Scene::ComponentSchedulerStages")
+    {
+        Engine::Init();
+        {
+            Registry::Type<CounterComponent>();
+            Registry::Type<FollowerComponent>();
+            Registry::Type<IndependentComponent>();
+
+            SceneObject* root = SceneManager::CreateObject();
+
+            CounterComponent&  counter = root->CreateComponent<CounterComponent>();
+            FollowerComponent& follower = root->CreateComponent<FollowerComponent>();
+            follower.target = &counter;
+            root->CreateComponent<IndependentComponent>();
+
+            root->SetActive(true);
+
+            //the follower reads the counter, the independent type runs with the counter
+            CHECK(ComponentScheduler::GetStageCount() == 2);
+
+            ComponentScheduler::Update(2.0);
+            CHECK(counter.value == 2.0);
+            CHECK(follower.value == 2.0);
+
+            root->SetActive(false);
+            MemoryGlobals::GetDefaultAllocator().DestroyAndFree(root);
+            ComponentScheduler::Clear();
+        }
+        Engine::Destroy();
+    }
+}
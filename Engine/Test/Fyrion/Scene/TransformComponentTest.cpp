@@ -0,0 +1,70 @@
+#include <doctest.h>
+
+#include "Fyrion/Engine.hpp"
+#include "Fyrion/Core/Allocator.hpp"
+#include "Fyrion/Scene/SceneManager.hpp"
+#include "Fyrion/Scene/SceneObject.hpp"
+#include "Fyrion/Scene/Components/TransformComponent.hpp"
+
+using namespace Fyrion;
+
+namespace
+{
+    Vec3 GetWorldPosition(TransformComponent& transform)
+    {
+        return Math::MakeVec3(transform.GetWorldTransform()[3]);
+    }
+
+    TEST_CASE("Scene::TransformHierarchy")
+    {
+        Engine::Init();
+        {
+            SceneObject* root = SceneManager::CreateObject();
+            SceneObject* child = SceneManager::CreateObject();
+            SceneObject* grandchild = SceneManager::CreateObject();
+
+            TransformComponent& rootTransform = root->CreateComponent<TransformComponent>();
+            TransformComponent& childTransform = child->CreateComponent<TransformComponent>();
+            TransformComponent& grandchildTransform = grandchild->CreateComponent<TransformComponent>();
+
+            rootTransform.SetPosition({1, 0, 0});
+            childTransform.SetPosition({0, 2, 0});
+            grandchildTransform.SetPosition({0, 0, 3});
+
+            child->AddChild(grandchild);
+            root->AddChild(child);
+            root->SetActive(true);
+
+            TransformComponent::UpdateTransforms();
+            CHECK(GetWorldPosition(grandchildTransform) == Vec3{1, 2, 3});
+
+            rootTransform.SetPosition({5, 0, 0});
+            CHECK(GetWorldPosition(grandchildTransform) == Vec3{5, 2, 3});
+
+            TransformComponent::UpdateTransforms();
+            CHECK(GetWorldPosition(childTransform) == Vec3{5, 2, 0});
+            CHECK(GetWorldPosition(grandchildTransform) == Vec3{5, 2, 3});
+
+            rootTransform.SetScale({2, 2, 2});
+            TransformComponent::UpdateTransforms();
+            CHECK(GetWorldPosition(grandchildTransform) == Vec3{5, 4, 6});
+
+            child->RemoveChild(grandchild);
+            root->AddChild(grandchild);
+            TransformComponent::UpdateTransforms();
+            CHECK(GetWorldPosition(grandchildTransform) == Vec3{5, 0, 6});
+
+            root->RemoveComponent(&rootTransform);
+            TransformComponent::UpdateTransforms();
+            CHECK(GetWorldPosition(childTransform) == Vec3{0, 2, 0});
+            CHECK(GetWorldPosition(grandchildTransform) == Vec3{0, 0, 3});
+
+            root->AddComponent(&rootTransform);
+            TransformComponent::UpdateTransforms();
+            CHECK(GetWorldPosition(grandchildTransform) == Vec3{5, 0, 6});
+
+            MemoryGlobals::GetDefaultAllocator().DestroyAndFree(root);
+        }
+        Engine::Destroy();
+    }
+}
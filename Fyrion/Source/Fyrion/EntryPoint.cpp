@@ -12,6 +12,7 @@ int main(i32 argc, char** argv)
     RenderGraph::SetRegisterSwapchainRenderEvent(false);
     StdOutSink stdOutSink{};
     Logger::RegisterSink(stdOutSink);
+    Logger::EnableAsync();
 
     ArgParser args{};
     args.Parse(argc, argv);
@@ -48,5 +49,6 @@ int main(i32 argc, char** argv)
         Engine::Destroy();
     }
 
+    Logger::DisableAsync();
     return 0;
 }
\ No newline at end of file
@@ -8,6 +8,7 @@ int main(i32 argc, char** argv)
 {
     StdOutSink stdOutSink{};
     Logger::RegisterSink(stdOutSink);
+    Logger::EnableAsync();
 
     Engine::Init(argc, argv);
 
@@ -23,5 +24,6 @@ int main(i32 argc, char** argv)
     Engine::Run();
     Engine::Destroy();
 
+    Logger::DisableAsync();
     return 0;
 }
\ No newline at end of file